@@ -4,6 +4,8 @@
 
 #include "flutter/assets/asset_manager.h"
 
+#include <unordered_set>
+
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/assets/jar_asset_bundle.h"
 #include "flutter/fml/trace_event.h"
@@ -62,6 +64,23 @@ std::deque<std::unique_ptr<AssetResolver>> AssetManager::TakeResolvers() {
   return std::move(resolvers_);
 }
 
+std::vector<std::string> AssetManager::GetRequestedAssetNames() const {
+  std::vector<std::string> asset_names;
+  std::unordered_set<std::string> seen;
+  for (const auto& resolver : resolvers_) {
+    auto bundle = resolver->as_directory_asset_bundle();
+    if (!bundle) {
+      continue;
+    }
+    for (auto& asset_name : bundle->GetRequestedAssetNames()) {
+      if (seen.insert(asset_name).second) {
+        asset_names.push_back(std::move(asset_name));
+      }
+    }
+  }
+  return asset_names;
+}
+
 // |AssetResolver|
 std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
     const std::string& asset_name) const {
@@ -70,6 +70,14 @@ class AssetManager final : public AssetResolver {
 
   std::deque<std::unique_ptr<AssetResolver>> TakeResolvers();
 
+  //--------------------------------------------------------------------------
+  /// @brief      Returns the names of the assets requested from the directory
+  ///             asset bundles of this manager so far, in the order of their
+  ///             first request. See
+  ///             |DirectoryAssetBundle::GetRequestedAssetNames|.
+  ///
+  std::vector<std::string> GetRequestedAssetNames() const;
+
   // |AssetResolver|
   bool IsValid() const override;
 
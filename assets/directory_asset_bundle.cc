@@ -4,20 +4,49 @@
 
 #include "flutter/assets/directory_asset_bundle.h"
 
+#include <algorithm>
 #include <regex>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "flutter/fml/eintr_wrapper.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
 
+struct DirectoryAssetBundle::PrefetchCache {
+  std::mutex mutex;
+  // Set when the bundle is destroyed, so that pending batches are skipped.
+  bool cancelled = false;
+  std::unordered_map<std::string, std::unique_ptr<fml::FileMapping>> mappings;
+  // The assets passed to |GetAsMapping| so far. Their prefetched mappings
+  // would never be handed out, so they are not prefetched anymore.
+  std::unordered_set<std::string> requested;
+};
+
+namespace {
+
+// Faults in the pages of |mapping| so that the first reader does not.
+void TouchPages(const fml::Mapping& mapping) {
+  constexpr size_t kPageSize = 4096;
+  const volatile uint8_t* bytes = mapping.GetMapping();
+  for (size_t offset = 0; offset < mapping.GetSize(); offset += kPageSize) {
+    bytes[offset];
+  }
+}
+
+}  // namespace
+
 DirectoryAssetBundle::DirectoryAssetBundle(
     fml::UniqueFD descriptor,
     bool is_valid_after_asset_manager_change)
-    : descriptor_(std::move(descriptor)) {
+    : descriptor_(std::move(descriptor)),
+      prefetch_cache_(std::make_shared<PrefetchCache>()) {
   if (!fml::IsDirectory(descriptor_)) {
     return;
   }
@@ -25,7 +54,106 @@ DirectoryAssetBundle::DirectoryAssetBundle(
   is_valid_ = true;
 }
 
-DirectoryAssetBundle::~DirectoryAssetBundle() = default;
+DirectoryAssetBundle::~DirectoryAssetBundle() {
+  std::scoped_lock lock(prefetch_cache_->mutex);
+  prefetch_cache_->cancelled = true;
+  prefetch_cache_->mappings.clear();
+}
+
+bool DirectoryAssetBundle::Prefetch(const std::vector<std::string>& asset_names,
+                                    fml::BasicTaskRunner& task_runner) {
+  if (!is_valid_ || asset_names.empty()) {
+    return false;
+  }
+
+  // The tasks may outlive the bundle and its descriptor.
+  auto directory = std::make_shared<fml::UniqueFD>(
+      fml::Duplicate(descriptor_.get()));
+  if (!directory->is_valid()) {
+    FML_DLOG(WARNING) << "Could not duplicate the asset directory descriptor.";
+    return false;
+  }
+
+  for (size_t begin = 0; begin < asset_names.size();
+       begin += kPrefetchBatchSize) {
+    size_t end = std::min(begin + kPrefetchBatchSize, asset_names.size());
+    std::vector<std::string> batch(asset_names.begin() + begin,
+                                   asset_names.begin() + end);
+    task_runner.PostTask([cache = prefetch_cache_, directory,
+                          batch = std::move(batch)]() {
+      TRACE_EVENT0("flutter", "DirectoryAssetBundle::Prefetch");
+      for (const std::string& asset_name : batch) {
+        {
+          std::scoped_lock lock(cache->mutex);
+          if (cache->cancelled) {
+            return;
+          }
+          if (cache->requested.count(asset_name) > 0) {
+            continue;
+          }
+        }
+        auto mapping = std::make_unique<fml::FileMapping>(
+            fml::OpenFile(*directory, asset_name.c_str(), false,
+                          fml::FilePermission::kRead));
+        if (!mapping->IsValid()) {
+          continue;
+        }
+        TouchPages(*mapping);
+        // The asset may have been requested while it was being read.
+        std::scoped_lock lock(cache->mutex);
+        if (!cache->cancelled && cache->requested.count(asset_name) == 0) {
+          cache->mappings.emplace(asset_name, std::move(mapping));
+        }
+      }
+    });
+  }
+  return true;
+}
+
+std::vector<std::string> DirectoryAssetBundle::GetRequestedAssetNames() const {
+  std::scoped_lock lock(requested_assets_mutex_);
+  return requested_asset_names_;
+}
+
+std::vector<std::string> DirectoryAssetBundle::ReadPrefetchManifest(
+    const std::string& path) {
+  std::vector<std::string> asset_names;
+  auto mapping = fml::FileMapping::CreateReadOnly(path);
+  if (!mapping || mapping->GetSize() == 0) {
+    return asset_names;
+  }
+  std::istringstream stream(
+      std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                  mapping->GetSize()));
+  std::string asset_name;
+  while (std::getline(stream, asset_name)) {
+    if (!asset_name.empty()) {
+      asset_names.push_back(std::move(asset_name));
+    }
+  }
+  return asset_names;
+}
+
+bool DirectoryAssetBundle::WritePrefetchManifest(
+    const std::string& path,
+    const std::vector<std::string>& asset_names) {
+  std::ostringstream stream;
+  for (const std::string& asset_name : asset_names) {
+    stream << asset_name << "\n";
+  }
+  std::string directory_name = fml::paths::GetDirectoryName(path);
+  if (directory_name.empty()) {
+    directory_name = ".";
+  }
+  auto directory = fml::OpenDirectory(directory_name.c_str(), false,
+                                      fml::FilePermission::kReadWrite);
+  if (!directory.is_valid()) {
+    return false;
+  }
+  const std::string file_name = path.substr(path.find_last_of("/\\") + 1);
+  return fml::WriteAtomically(directory, file_name.c_str(),
+                              fml::DataMapping(stream.str()));
+}
 
 // |AssetResolver|
 bool DirectoryAssetBundle::IsValid() const {
@@ -50,11 +178,33 @@ std::unique_ptr<fml::Mapping> DirectoryAssetBundle::GetAsMapping(
     return nullptr;
   }
 
-  auto mapping = std::make_unique<fml::FileMapping>(fml::OpenFile(
-      descriptor_, asset_name.c_str(), false, fml::FilePermission::kRead));
+  std::unique_ptr<fml::Mapping> mapping;
+  {
+    // Prefetched mappings are handed out once, so that the bundle does not
+    // keep assets that are only used at startup resident.
+    std::scoped_lock lock(prefetch_cache_->mutex);
+    prefetch_cache_->requested.insert(asset_name);
+    auto found = prefetch_cache_->mappings.find(asset_name);
+    if (found != prefetch_cache_->mappings.end()) {
+      mapping = std::move(found->second);
+      prefetch_cache_->mappings.erase(found);
+    }
+  }
 
-  if (!mapping->IsValid()) {
-    return nullptr;
+  if (!mapping) {
+    auto file_mapping = std::make_unique<fml::FileMapping>(fml::OpenFile(
+        descriptor_, asset_name.c_str(), false, fml::FilePermission::kRead));
+    if (!file_mapping->IsValid()) {
+      return nullptr;
+    }
+    mapping = std::move(file_mapping);
+  }
+
+  {
+    std::scoped_lock lock(requested_assets_mutex_);
+    if (requested_asset_set_.insert(asset_name).second) {
+      requested_asset_names_.push_back(asset_name);
+    }
   }
 
   return mapping;
@@ -5,10 +5,15 @@
 #ifndef FLUTTER_ASSETS_DIRECTORY_ASSET_BUNDLE_H_
 #define FLUTTER_ASSETS_DIRECTORY_ASSET_BUNDLE_H_
 
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <unordered_set>
+
 #include "flutter/assets/asset_resolver.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/unique_fd.h"
 
 namespace flutter {
@@ -20,10 +25,64 @@ class DirectoryAssetBundle : public AssetResolver {
 
   ~DirectoryAssetBundle() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Maps the given assets and reads them into memory on
+  ///             |task_runner|, in batches of |kPrefetchBatchSize| assets per
+  ///             task, so that the first |GetAsMapping| call for each of them
+  ///             returns without blocking on the disk. Assets requested
+  ///             before their batch is done are mapped on the calling thread
+  ///             as usual.
+  ///
+  ///             Assets that have already been requested are skipped, since
+  ///             their prefetched mappings would never be handed out.
+  ///
+  /// @param[in]  asset_names  The assets to prefetch, usually the result of
+  ///             |GetRequestedAssetNames| in a previous launch.
+  /// @param[in]  task_runner  The runner to read the assets on, such as the
+  ///             IO task runner or the concurrent worker task runner.
+  ///
+  /// @return     Whether the assets are being prefetched.
+  ///
+  bool Prefetch(const std::vector<std::string>& asset_names,
+                fml::BasicTaskRunner& task_runner);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the names of the assets that were found by
+  ///             |GetAsMapping| so far, in the order of their first request.
+  ///             Embedders can persist them as the manifest to |Prefetch| in
+  ///             the next launch.
+  ///
+  std::vector<std::string> GetRequestedAssetNames() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads a manifest written by |WritePrefetchManifest|. Returns
+  ///             no asset names if there is no manifest at |path|.
+  ///
+  static std::vector<std::string> ReadPrefetchManifest(
+      const std::string& path);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Atomically replaces the manifest at |path| with the given
+  ///             asset names, one per line.
+  ///
+  static bool WritePrefetchManifest(
+      const std::string& path,
+      const std::vector<std::string>& asset_names);
+
+  static constexpr size_t kPrefetchBatchSize = 8;
+
  private:
+  struct PrefetchCache;
+
   const fml::UniqueFD descriptor_;
   bool is_valid_ = false;
   bool is_valid_after_asset_manager_change_ = false;
+  // Shared with the prefetch tasks, which may outlive the bundle.
+  const std::shared_ptr<PrefetchCache> prefetch_cache_;
+
+  mutable std::mutex requested_assets_mutex_;
+  mutable std::vector<std::string> requested_asset_names_;
+  mutable std::unordered_set<std::string> requested_asset_set_;
 
   // |AssetResolver|
   bool IsValid() const override;
@@ -250,6 +250,42 @@ struct Settings {
   // Enable GPU tracing in Vulkan backends.
   bool enable_vulkan_gpu_tracing = false;
 
+  // Rewrite the DisplayLists of pictures that are retained across frames
+  // with the DisplayListOptimizer before they are rendered.
+  bool enable_display_list_optimizer = false;
+
+  // The name of a DlCostModel (e.g. "bootstrap") that the raster
+  // cache should use to estimate the cost of rendering display lists. If
+  // empty, or there is no model with that name, the hand-tuned calculator
+  // for the rendering backend is used.
+  std::string raster_cache_cost_model;
+
+  // Whether raster cache entries for display lists are rasterized on a
+  // worker thread and swapped in on a later frame, rather than rasterized
+  // inline in the first frame in which they are cached.
+  bool enable_raster_cache_background_population = false;
+
+  // The ratio between the scale at which a raster cache entry was
+  // rasterized and the scale at which it is drawn that the raster cache
+  // tolerates before rasterizing the entry again. 1 requires an exact match.
+  double raster_cache_scale_band = 1.0;
+
+  // Whether the layer trees of multiple views rendered in the same frame are
+  // prerolled and painted on worker threads concurrently. Views that contain
+  // platform views or external textures are always rasterized serially, as
+  // are all views of surfaces that use the raster cache.
+  bool enable_parallel_view_rasterization = false;
+
+  // The bounds within which the depth of the frame pipeline is adapted to the
+  // build and raster durations of recent frames. The pipeline depth is fixed
+  // when |frame_pipeline_max_depth| is 0.
+  uint32_t frame_pipeline_min_depth = 1;
+  uint32_t frame_pipeline_max_depth = 0;
+
+  // Whether subtrees retained from an earlier frame skip their Preroll when
+  // they are drawn under the same transform and cull rect.
+  bool enable_incremental_preroll = false;
+
   // Data set by platform-specific embedders for use in font initialization.
   uint32_t font_initialization_data = 0;
 
@@ -323,6 +359,11 @@ struct Settings {
   fml::UniqueFD::element_type assets_dir =
       fml::UniqueFD::traits_type::InvalidValue();
   std::string assets_path;
+  // The file that lists the assets to prefetch from the assets directory at
+  // launch, one per line. Once the first frame is rasterized, it is replaced
+  // with the assets requested so far, i.e. those needed to start up. Assets
+  // aren't prefetched if this is empty.
+  std::string asset_prefetch_manifest_path;
 
   // Callback to handle the timings of a rasterized frame. This is called as
   // soon as a frame is rasterized.
@@ -3,7 +3,10 @@
 // found in the LICENSE file.
 
 #include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/dl_builder_pool.h"
+#include "flutter/display_list/dl_optimizer.h"
 #include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
 
 namespace flutter {
 
@@ -11,6 +14,11 @@ DlOpReceiver& DisplayListBuilderBenchmarkAccessor(DisplayListBuilder& builder) {
   return builder.asReceiver();
 }
 
+uint32_t DisplayListBuilderBenchmarkStorageAllocations(
+    DisplayListBuilder& builder) {
+  return builder.storage_allocation_count_;
+}
+
 namespace {
 
 static std::vector<testing::DisplayListInvocationGroup> allRenderingOps =
@@ -171,6 +179,142 @@ static void BM_DisplayListBuilderWithSaveLayerAndImageFilter(
   }
 }
 
+enum class DisplayListBuilderStorageType {
+  // A fresh builder per frame that grows its storage from zero.
+  kFresh,
+  // Builders acquired from a DisplayListBuilderPool.
+  kPooled,
+  // Builders acquired from a DisplayListBuilderPool with a DlStorageSlab.
+  kPooledWithSlab,
+};
+
+// Simulates a frame recording the same pictures as the frame before it
+// and reports how many times the op storage was (re)allocated per frame.
+static void BM_DisplayListBuilderStorage(benchmark::State& state,
+                                         DisplayListBuilderStorageType type) {
+  const int pictures_per_frame = state.range(0);
+  std::shared_ptr<DlStorageSlab> slab;
+  if (type == DisplayListBuilderStorageType::kPooledWithSlab) {
+    slab = std::make_shared<DlStorageSlab>();
+  }
+  DisplayListBuilderPool pool(slab);
+  size_t allocations = 0u;
+  size_t frames = 0u;
+  while (state.KeepRunning()) {
+    pool.BeginFrame();
+    for (int i = 0; i < pictures_per_frame; i++) {
+      sk_sp<DisplayListBuilder> builder;
+      DisplayListBuilderPool::CallSite site = pool.NextCallSite();
+      if (type == DisplayListBuilderStorageType::kFresh) {
+        builder = sk_make_sp<DisplayListBuilder>(true);
+      } else {
+        builder = pool.Acquire(site, DisplayListBuilder::kMaxCullRect, true);
+      }
+      InvokeAllRenderingOps(*builder);
+      allocations += DisplayListBuilderBenchmarkStorageAllocations(*builder);
+      auto display_list = builder->Build();
+      if (type != DisplayListBuilderStorageType::kFresh) {
+        pool.Record(site, *display_list);
+      }
+    }
+    frames++;
+  }
+  state.counters["AllocationsPerFrame"] =
+      frames ? static_cast<double>(allocations) / frames : 0.0;
+  if (slab) {
+    auto stats = slab->GetStats();
+    state.counters["SlabReuseRatio"] =
+        stats.allocations ? static_cast<double>(stats.reused) /
+                                static_cast<double>(stats.allocations)
+                          : 0.0;
+  }
+}
+
+BENCHMARK_CAPTURE(BM_DisplayListBuilderStorage,
+                  kFresh,
+                  DisplayListBuilderStorageType::kFresh)
+    ->RangeMultiplier(4)
+    ->Range(1, 64)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderStorage,
+                  kPooled,
+                  DisplayListBuilderStorageType::kPooled)
+    ->RangeMultiplier(4)
+    ->Range(1, 64)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderStorage,
+                  kPooledWithSlab,
+                  DisplayListBuilderStorageType::kPooledWithSlab)
+    ->RangeMultiplier(4)
+    ->Range(1, 64)
+    ->Unit(benchmark::kMicrosecond);
+
+// A receiver that does nothing with the ops so that the benchmarks below
+// measure only the cost of dispatching the list.
+class NullDispatcher final : public virtual DlOpReceiver,
+                             public IgnoreAttributeDispatchHelper,
+                             public IgnoreClipDispatchHelper,
+                             public IgnoreTransformDispatchHelper,
+                             public IgnoreDrawDispatchHelper {};
+
+// Records a picture typical of a retained scene: several full screen
+// backgrounds painted over each other, followed by content that is
+// faded in through opacity-only saveLayers.
+static sk_sp<DisplayList> MakeOverdrawnPicture(int layers, bool rtree) {
+  const SkRect bounds = SkRect::MakeWH(1000, 1000);
+  DisplayListBuilder builder(bounds, rtree);
+  DlPaint paint;
+  for (int layer = 0; layer < layers; layer++) {
+    builder.DrawRect(bounds, paint.setColor(DlColor::kBlue()));
+    for (int i = 0; i < 100; i++) {
+      SkRect rect = SkRect::MakeXYWH((i % 10) * 100, (i / 10) * 100, 80, 80);
+      builder.DrawOval(rect, paint.setColor(DlColor::kGreen()));
+      DlPaint layer_paint = DlPaint().setOpacity(0.5f);
+      builder.SaveLayer(&rect, &layer_paint);
+      builder.DrawRRect(SkRRect::MakeRectXY(rect, 5, 5),
+                        paint.setColor(DlColor::kRed()));
+      builder.Restore();
+    }
+  }
+  return builder.Build();
+}
+
+static void BM_DisplayListOptimizerDispatch(benchmark::State& state,
+                                            bool optimize) {
+  auto display_list = MakeOverdrawnPicture(state.range(0), true);
+  auto result = DisplayListOptimizer::Optimize(display_list);
+  if (optimize) {
+    display_list = result.display_list;
+  }
+  NullDispatcher dispatcher;
+  while (state.KeepRunning()) {
+    display_list->Dispatch(dispatcher);
+  }
+  state.counters["Ops"] = display_list->op_count();
+  state.counters["OpsRemoved"] = optimize ? result.ops_removed() : 0u;
+}
+
+static void BM_DisplayListOptimizerOptimize(benchmark::State& state) {
+  auto display_list = MakeOverdrawnPicture(state.range(0), true);
+  while (state.KeepRunning()) {
+    auto result = DisplayListOptimizer::Optimize(display_list);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_DisplayListOptimizerDispatch, Original, false)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListOptimizerDispatch, Optimized, true)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DisplayListOptimizerOptimize)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_CAPTURE(BM_DisplayListBuilderDefault,
                   kDefault,
                   DisplayListBuilderBenchmarkType::kDefault)
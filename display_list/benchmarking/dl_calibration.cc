@@ -0,0 +1,157 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/benchmarking/dl_calibration.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+const char* DlCostOpName(DlCostOp op) {
+  switch (op) {
+#define DL_COST_OP_NAME(name) \
+  case DlCostOp::name:        \
+    return #name;
+
+    DL_COST_OP_NAME(kSaveLayer)
+    DL_COST_OP_NAME(kDrawColor)
+    DL_COST_OP_NAME(kDrawPaint)
+    DL_COST_OP_NAME(kDrawLine)
+    DL_COST_OP_NAME(kDrawFillRect)
+    DL_COST_OP_NAME(kDrawStrokeRect)
+    DL_COST_OP_NAME(kDrawFillOval)
+    DL_COST_OP_NAME(kDrawStrokeOval)
+    DL_COST_OP_NAME(kDrawFillCircle)
+    DL_COST_OP_NAME(kDrawStrokeCircle)
+    DL_COST_OP_NAME(kDrawFillRRect)
+    DL_COST_OP_NAME(kDrawStrokeRRect)
+    DL_COST_OP_NAME(kDrawFillDRRect)
+    DL_COST_OP_NAME(kDrawStrokeDRRect)
+    DL_COST_OP_NAME(kDrawFillArc)
+    DL_COST_OP_NAME(kDrawStrokeArc)
+    DL_COST_OP_NAME(kDrawFillPath)
+    DL_COST_OP_NAME(kDrawStrokePath)
+    DL_COST_OP_NAME(kDrawPoints)
+    DL_COST_OP_NAME(kDrawLines)
+    DL_COST_OP_NAME(kDrawPolygon)
+    DL_COST_OP_NAME(kDrawVertices)
+    DL_COST_OP_NAME(kDrawImage)
+    DL_COST_OP_NAME(kDrawImageRect)
+    DL_COST_OP_NAME(kDrawImageNine)
+    DL_COST_OP_NAME(kDrawText)
+    DL_COST_OP_NAME(kDrawShadow)
+
+#undef DL_COST_OP_NAME
+  }
+  FML_UNREACHABLE();
+}
+
+DlCostCoefficients FitDlCostCoefficients(
+    const std::vector<DlCostSample>& samples) {
+  if (samples.empty()) {
+    return {};
+  }
+  double n = samples.size();
+  double sum_x = 0.0;
+  double sum_y = 0.0;
+  double sum_xx = 0.0;
+  double sum_xy = 0.0;
+  for (const DlCostSample& sample : samples) {
+    sum_x += sample.units;
+    sum_y += sample.nanoseconds;
+    sum_xx += static_cast<double>(sample.units) * sample.units;
+    sum_xy += sample.units * sample.nanoseconds;
+  }
+  double mean = sum_y / n;
+
+  double denominator = n * sum_xx - sum_x * sum_x;
+  if (denominator <= 0.0) {
+    // All of the samples have the same size, so only the fixed cost can
+    // be determined.
+    return {static_cast<float>(std::max(mean, 0.0)), 0.0f};
+  }
+  double per_unit = (n * sum_xy - sum_x * sum_y) / denominator;
+  double fixed = (sum_y - per_unit * sum_x) / n;
+  if (per_unit < 0.0) {
+    return {static_cast<float>(std::max(mean, 0.0)), 0.0f};
+  }
+  if (fixed < 0.0) {
+    // Refit through the origin.
+    per_unit = sum_xy / sum_xx;
+    return {0.0f, static_cast<float>(std::max(per_unit, 0.0))};
+  }
+  return {static_cast<float>(fixed), static_cast<float>(per_unit)};
+}
+
+namespace {
+
+// Formats |value| as a float literal, e.g. "12.0f" or "1.5e-05f".
+std::string FloatLiteral(float value) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+  std::string literal = buffer;
+  if (literal.find_first_of(".e") == std::string::npos) {
+    literal += ".0";
+  }
+  return literal + "f";
+}
+
+void WriteCoefficients(std::ostringstream& source,
+                       const DlCostCoefficients coefficients[]) {
+  for (int i = 0; i < kDlCostOpCount; i++) {
+    source << "            {" << FloatLiteral(coefficients[i].fixed) << ", "
+           << FloatLiteral(coefficients[i].per_unit) << "},  // "
+           << DlCostOpName(static_cast<DlCostOp>(i)) << "\n";
+  }
+}
+
+}  // namespace
+
+std::string GenerateDlCostModelSource(const std::vector<DlCostModel>& models) {
+  FML_DCHECK(!models.empty());
+  std::ostringstream source;
+  source << "// Copyright 2013 The Flutter Authors. All rights reserved.\n"
+            "// Use of this source code is governed by a BSD-style license "
+            "that can be\n"
+            "// found in the LICENSE file.\n"
+            "\n"
+            "// GENERATED FILE - DO NOT EDIT.\n"
+            "// Generated by display_list_calibration, see\n"
+            "// flutter/display_list/benchmarking/dl_calibration_main.cc.\n"
+            "\n"
+            "#include "
+            "\"flutter/display_list/benchmarking/dl_complexity_model.h\"\n"
+            "\n"
+            "namespace flutter {\n"
+            "\n"
+            "// The coefficients are {fixed, per_unit} in nanoseconds.\n"
+            "const DlCostModel DlCostModel::kModels[] = {\n";
+  for (const DlCostModel& model : models) {
+    source << "    {\n"
+           << "        \"" << model.name << "\",\n"
+           << "        // aliased\n"
+           << "        {\n";
+    WriteCoefficients(source, model.aliased);
+    source << "        },\n"
+           << "        // anti_aliased\n"
+           << "        {\n";
+    WriteCoefficients(source, model.anti_aliased);
+    source << "        },\n"
+           << "    },\n";
+  }
+  source << "};\n"
+            "\n"
+            "const int DlCostModel::kModelCount =\n"
+            "    sizeof(DlCostModel::kModels) / "
+            "sizeof(DlCostModel);\n"
+            "\n"
+            "}  // namespace flutter\n";
+  return source.str();
+}
+
+}  // namespace flutter
@@ -0,0 +1,41 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_CALIBRATION_H_
+#define FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_CALIBRATION_H_
+
+#include <string>
+#include <vector>
+
+#include "flutter/display_list/benchmarking/dl_complexity_model.h"
+
+namespace flutter {
+
+// A single timing of an op drawn with a given size in the units of the
+// op (see |DlCostOp|), averaged over all of the ops drawn in the run.
+struct DlCostSample {
+  float units;
+  double nanoseconds;
+};
+
+// Returns the name of the DlCostOp enum value, e.g. "kDrawFillRect".
+const char* DlCostOpName(DlCostOp op);
+
+// Fits |fixed| + |per_unit| * units to the samples by least squares.
+//
+// Neither coefficient of the result is ever negative. If the unconstrained
+// fit produces a negative coefficient then the samples are refit with that
+// coefficient held at 0, so noisy timings of an op whose cost does not
+// depend on its size produce a constant cost rather than a cost that
+// decreases with size.
+DlCostCoefficients FitDlCostCoefficients(
+    const std::vector<DlCostSample>& samples);
+
+// Returns the C++ source for dl_complexity_models.cc defining
+// |DlCostModel::kModels| as the given models.
+std::string GenerateDlCostModelSource(const std::vector<DlCostModel>& models);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_CALIBRATION_H_
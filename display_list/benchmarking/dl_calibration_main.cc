@@ -0,0 +1,440 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Times each DlCostOp over a range of sizes on one or more rendering
+// backends, fits the cost coefficients of each op and writes the resulting
+// cost models as the C++ source of dl_complexity_models.cc.
+//
+// Usage:
+//   display_list_calibration [--backends=software,vulkan] [--repetitions=N]
+//                            [--output=<path>]
+//
+// The "vulkan" backend renders with Skia on the SwiftShader Vulkan ICD so
+// that its model describes SwiftShader rather than any particular GPU.
+// Without --output the source is written to stdout.
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+#include "flutter/display_list/benchmarking/dl_calibration.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/display_list/testing/dl_test_surface_provider.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
+
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+constexpr size_t kCanvasSize = 1024;
+constexpr int kOpsPerRun = 100;
+constexpr int kDefaultRepetitions = 7;
+
+// Records |kOpsPerRun| ops of the given size with the given paint and
+// returns the size of each op in the units of its DlCostOp.
+using OpRecorder =
+    std::function<float(DlCanvas& canvas, float size, const DlPaint& paint)>;
+
+struct OpCalibration {
+  DlCostOp op;
+  DlDrawStyle style;
+  std::vector<float> sizes;
+  OpRecorder record;
+};
+
+SkRect RectOfSize(int i, float size) {
+  // Stagger the ops slightly so that consecutive ops do not exactly
+  // overlap, while keeping them within the canvas.
+  float offset = (i % 16) * (kCanvasSize - size) / 16;
+  return SkRect::MakeXYWH(offset, offset, size, size);
+}
+
+SkPath PathWithVerbs(int verb_count) {
+  SkPath path;
+  path.moveTo(0, 0);
+  for (int i = 1; i < verb_count; i++) {
+    float x = (i * 37) % 512;
+    float y = (i * 91) % 512;
+    if (i % 2) {
+      path.lineTo(x, y);
+    } else {
+      path.cubicTo(x, 0, 0, y, x, y);
+    }
+  }
+  return path;
+}
+
+std::vector<SkPoint> PointsOfCount(int count) {
+  std::vector<SkPoint> points(count);
+  for (int i = 0; i < count; i++) {
+    points[i] = SkPoint::Make((i * 37) % kCanvasSize, (i * 91) % kCanvasSize);
+  }
+  return points;
+}
+
+sk_sp<DlImage> ImageOfSize(float size) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(size, size);
+  bitmap.eraseColor(SK_ColorBLUE);
+  bitmap.setImmutable();
+  return DlImage::Make(bitmap.asImage());
+}
+
+OpRecorder ForEachRect(
+    const std::function<void(DlCanvas&, const SkRect&, const DlPaint&)>& draw,
+    bool area_units) {
+  return [draw, area_units](DlCanvas& canvas, float size,
+                            const DlPaint& paint) {
+    for (int i = 0; i < kOpsPerRun; i++) {
+      draw(canvas, RectOfSize(i, size), paint);
+    }
+    return area_units ? size * size : size;
+  };
+}
+
+std::vector<OpCalibration> MakeCalibrations() {
+  const std::vector<float> kRectSizes = {16, 64, 256, 512, 1024};
+  const std::vector<float> kCountSizes = {4, 16, 64, 256};
+  const std::vector<float> kImageSizes = {32, 128, 512};
+  const std::vector<float> kNoSizes = {0};
+
+  auto draw_rect = [](DlCanvas& canvas, const SkRect& rect,
+                      const DlPaint& paint) { canvas.DrawRect(rect, paint); };
+  auto draw_oval = [](DlCanvas& canvas, const SkRect& rect,
+                      const DlPaint& paint) { canvas.DrawOval(rect, paint); };
+  auto draw_rrect = [](DlCanvas& canvas, const SkRect& rect,
+                       const DlPaint& paint) {
+    canvas.DrawRRect(
+        SkRRect::MakeRectXY(rect, rect.width() / 8, rect.height() / 8), paint);
+  };
+  auto draw_drrect = [](DlCanvas& canvas, const SkRect& rect,
+                        const DlPaint& paint) {
+    SkRect inner = rect.makeInset(rect.width() / 4, rect.height() / 4);
+    canvas.DrawDRRect(
+        SkRRect::MakeRectXY(rect, rect.width() / 8, rect.height() / 8),
+        SkRRect::MakeRectXY(inner, inner.width() / 8, inner.height() / 8),
+        paint);
+  };
+  auto draw_arc = [](DlCanvas& canvas, const SkRect& rect,
+                     const DlPaint& paint) {
+    canvas.DrawArc(rect, 0, 270, false, paint);
+  };
+  auto record_circles = [](DlCanvas& canvas, float size,
+                           const DlPaint& paint) {
+    float radius = size / 2;
+    for (int i = 0; i < kOpsPerRun; i++) {
+      canvas.DrawCircle(RectOfSize(i, size).center(), radius, paint);
+    }
+    return paint.getDrawStyle() == DlDrawStyle::kFill ? radius * radius
+                                                      : radius;
+  };
+  auto record_paths = [](DlCanvas& canvas, float size, const DlPaint& paint) {
+    SkPath path = PathWithVerbs(size);
+    for (int i = 0; i < kOpsPerRun; i++) {
+      canvas.DrawPath(path, paint);
+    }
+    return static_cast<float>(path.countVerbs());
+  };
+  auto record_points = [](DlCanvas::PointMode mode) -> OpRecorder {
+    return [mode](DlCanvas& canvas, float size, const DlPaint& paint) {
+      auto points = PointsOfCount(size);
+      for (int i = 0; i < kOpsPerRun; i++) {
+        canvas.DrawPoints(mode, points.size(), points.data(), paint);
+      }
+      return size;
+    };
+  };
+
+  return {
+      {DlCostOp::kSaveLayer, DlDrawStyle::kFill, kRectSizes,
+       [](DlCanvas& canvas, float size, const DlPaint& paint) {
+         DlPaint layer_paint = DlPaint().setOpacity(0.5f);
+         for (int i = 0; i < kOpsPerRun; i++) {
+           SkRect bounds = RectOfSize(i, size);
+           canvas.SaveLayer(&bounds, &layer_paint);
+           canvas.DrawRect(bounds.makeInset(1, 1), paint);
+           canvas.Restore();
+         }
+         return size * size;
+       }},
+      {DlCostOp::kDrawColor, DlDrawStyle::kFill, kNoSizes,
+       [](DlCanvas& canvas, float size, const DlPaint& paint) {
+         for (int i = 0; i < kOpsPerRun; i++) {
+           canvas.DrawColor(paint.getColor().withAlpha(0x7f));
+         }
+         return 0.0f;
+       }},
+      {DlCostOp::kDrawPaint, DlDrawStyle::kFill, kNoSizes,
+       [](DlCanvas& canvas, float size, const DlPaint& paint) {
+         DlPaint translucent = paint;
+         translucent.setAlpha(0x7f);
+         for (int i = 0; i < kOpsPerRun; i++) {
+           canvas.DrawPaint(translucent);
+         }
+         return 0.0f;
+       }},
+      {DlCostOp::kDrawLine, DlDrawStyle::kStroke, kRectSizes,
+       [](DlCanvas& canvas, float size, const DlPaint& paint) {
+         for (int i = 0; i < kOpsPerRun; i++) {
+           SkRect rect = RectOfSize(i, size);
+           canvas.DrawLine({rect.fLeft, rect.fTop}, {rect.fRight, rect.fTop},
+                           paint);
+         }
+         return size;
+       }},
+      {DlCostOp::kDrawFillRect, DlDrawStyle::kFill, kRectSizes,
+       ForEachRect(draw_rect, true)},
+      {DlCostOp::kDrawStrokeRect, DlDrawStyle::kStroke, kRectSizes,
+       ForEachRect(draw_rect, false)},
+      {DlCostOp::kDrawFillOval, DlDrawStyle::kFill, kRectSizes,
+       ForEachRect(draw_oval, true)},
+      {DlCostOp::kDrawStrokeOval, DlDrawStyle::kStroke, kRectSizes,
+       ForEachRect(draw_oval, false)},
+      {DlCostOp::kDrawFillCircle, DlDrawStyle::kFill, kRectSizes,
+       record_circles},
+      {DlCostOp::kDrawStrokeCircle, DlDrawStyle::kStroke, kRectSizes,
+       record_circles},
+      {DlCostOp::kDrawFillRRect, DlDrawStyle::kFill, kRectSizes,
+       ForEachRect(draw_rrect, true)},
+      {DlCostOp::kDrawStrokeRRect, DlDrawStyle::kStroke, kRectSizes,
+       ForEachRect(draw_rrect, false)},
+      {DlCostOp::kDrawFillDRRect, DlDrawStyle::kFill, kRectSizes,
+       ForEachRect(draw_drrect, true)},
+      {DlCostOp::kDrawStrokeDRRect, DlDrawStyle::kStroke, kRectSizes,
+       ForEachRect(draw_drrect, false)},
+      {DlCostOp::kDrawFillArc, DlDrawStyle::kFill, kRectSizes,
+       ForEachRect(draw_arc, true)},
+      {DlCostOp::kDrawStrokeArc, DlDrawStyle::kStroke, kRectSizes,
+       ForEachRect(draw_arc, false)},
+      {DlCostOp::kDrawFillPath, DlDrawStyle::kFill, kCountSizes, record_paths},
+      {DlCostOp::kDrawStrokePath, DlDrawStyle::kStroke, kCountSizes,
+       record_paths},
+      {DlCostOp::kDrawPoints, DlDrawStyle::kStroke, kCountSizes,
+       record_points(DlCanvas::PointMode::kPoints)},
+      {DlCostOp::kDrawLines, DlDrawStyle::kStroke, kCountSizes,
+       record_points(DlCanvas::PointMode::kLines)},
+      {DlCostOp::kDrawPolygon, DlDrawStyle::kStroke, kCountSizes,
+       record_points(DlCanvas::PointMode::kPolygon)},
+      {DlCostOp::kDrawVertices, DlDrawStyle::kFill, {30, 300, 3000},
+       [](DlCanvas& canvas, float size, const DlPaint& paint) {
+         auto points = PointsOfCount(size);
+         auto vertices = DlVertices::Make(DlVertexMode::kTriangles,
+                                          points.size(), points.data(),
+                                          nullptr, nullptr);
+         for (int i = 0; i < kOpsPerRun; i++) {
+           canvas.DrawVertices(vertices, DlBlendMode::kSrcOver, paint);
+         }
+         return static_cast<float>(vertices->vertex_count());
+       }},
+      {DlCostOp::kDrawImage, DlDrawStyle::kFill, kImageSizes,
+       [](DlCanvas& canvas, float size, const DlPaint& paint) {
+         auto image = ImageOfSize(size);
+         for (int i = 0; i < kOpsPerRun; i++) {
+           SkRect dst = RectOfSize(i, size);
+           canvas.DrawImage(image, {dst.fLeft, dst.fTop},
+                            DlImageSampling::kNearestNeighbor, &paint);
+         }
+         return size * size;
+       }},
+      {DlCostOp::kDrawImageRect, DlDrawStyle::kFill, kImageSizes,
+       [](DlCanvas& canvas, float size, const DlPaint& paint) {
+         auto image = ImageOfSize(size);
+         for (int i = 0; i < kOpsPerRun; i++) {
+           canvas.DrawImageRect(image, RectOfSize(i, size),
+                                DlImageSampling::kLinear, &paint);
+         }
+         return size * size;
+       }},
+      {DlCostOp::kDrawImageNine, DlDrawStyle::kFill, kImageSizes,
+       [](DlCanvas& canvas, float size, const DlPaint& paint) {
+         auto image = ImageOfSize(size);
+         SkIRect center = SkIRect::MakeLTRB(size / 4, size / 4,  //
+                                            size * 3 / 4, size * 3 / 4);
+         for (int i = 0; i < kOpsPerRun; i++) {
+           canvas.DrawImageNine(image, center, RectOfSize(i, size),
+                                DlFilterMode::kLinear, &paint);
+         }
+         return size * size;
+       }},
+      {DlCostOp::kDrawText, DlDrawStyle::kFill, kNoSizes,
+       [](DlCanvas& canvas, float size, const DlPaint& paint) {
+         auto blob =
+             SkTextBlob::MakeFromString("Flutter", CreateTestFontOfSize(20));
+         for (int i = 0; i < kOpsPerRun; i++) {
+           canvas.DrawTextBlob(blob, (i % 16) * 50, (i / 16) * 30 + 20, paint);
+         }
+         return 0.0f;
+       }},
+      {DlCostOp::kDrawShadow, DlDrawStyle::kFill, kCountSizes,
+       [](DlCanvas& canvas, float size, const DlPaint& paint) {
+         SkPath path = PathWithVerbs(size);
+         path.close();
+         for (int i = 0; i < kOpsPerRun; i++) {
+           canvas.DrawShadow(path, DlColor::kBlack(), 10, false, 1);
+         }
+         return static_cast<float>(path.countVerbs());
+       }},
+  };
+}
+
+void FlushSubmitCpuSync(const sk_sp<SkSurface>& surface) {
+  if (GrDirectContext* direct_context =
+          GrAsDirectContext(surface->recordingContext())) {
+    direct_context->flushAndSubmit(surface.get(), GrSyncCpu::kYes);
+  }
+}
+
+// Returns the median time in nanoseconds that it takes to render and
+// flush the display list onto the surface.
+double TimeDisplayList(const sk_sp<SkSurface>& surface,
+                       const sk_sp<DisplayList>& display_list,
+                       int repetitions) {
+  DlSkCanvasAdapter canvas(surface->getCanvas());
+  // Warm up any caches or pipelines that the first draw populates.
+  canvas.DrawDisplayList(display_list);
+  FlushSubmitCpuSync(surface);
+
+  std::vector<double> timings;
+  for (int i = 0; i < repetitions; i++) {
+    fml::TimePoint start = fml::TimePoint::Now();
+    canvas.DrawDisplayList(display_list);
+    FlushSubmitCpuSync(surface);
+    timings.push_back((fml::TimePoint::Now() - start).ToNanosecondsF());
+  }
+  std::sort(timings.begin(), timings.end());
+  return timings[timings.size() / 2];
+}
+
+bool CalibrateBackend(DlSurfaceProvider::BackendType type,
+                      int repetitions,
+                      DlCostModel* model) {
+  auto provider = DlSurfaceProvider::Create(type);
+  if (!provider || !provider->InitializeSurface(kCanvasSize, kCanvasSize)) {
+    FML_LOG(ERROR) << "Backend " << DlSurfaceProvider::BackendName(type)
+                   << " is not available.";
+    return false;
+  }
+  auto surface = provider->GetPrimarySurface()->sk_surface();
+
+  for (const OpCalibration& calibration : MakeCalibrations()) {
+    for (bool anti_alias : {false, true}) {
+      DlPaint paint;
+      paint.setColor(DlColor::kBlue());
+      paint.setDrawStyle(calibration.style);
+      paint.setStrokeWidth(1.0f);
+      paint.setAntiAlias(anti_alias);
+
+      std::vector<DlCostSample> samples;
+      for (float size : calibration.sizes) {
+        DisplayListBuilder builder(SkRect::MakeWH(kCanvasSize, kCanvasSize));
+        float units = calibration.record(builder, size, paint);
+        double nanoseconds =
+            TimeDisplayList(surface, builder.Build(), repetitions);
+        samples.push_back({units, nanoseconds / kOpsPerRun});
+      }
+
+      DlCostCoefficients coefficients = FitDlCostCoefficients(samples);
+      int index = static_cast<int>(calibration.op);
+      (anti_alias ? model->anti_aliased : model->aliased)[index] =
+          coefficients;
+      FML_LOG(INFO) << provider->backend_name() << " "
+                    << DlCostOpName(calibration.op)
+                    << (anti_alias ? " (AA)" : "")
+                    << ": fixed = " << coefficients.fixed
+                    << "ns, per_unit = " << coefficients.per_unit << "ns";
+    }
+  }
+  return true;
+}
+
+std::vector<std::string> SplitCommaSeparated(const std::string& input) {
+  std::vector<std::string> result;
+  std::stringstream stream(input);
+  std::string token;
+  while (std::getline(stream, token, ',')) {
+    if (!token.empty()) {
+      result.push_back(token);
+    }
+  }
+  return result;
+}
+
+int Main(int argc, char** argv) {
+  auto command_line = fml::CommandLineFromArgcArgv(argc, argv);
+
+  std::string backends = "software,vulkan";
+  command_line.GetOptionValue("backends", &backends);
+
+  int repetitions = kDefaultRepetitions;
+  std::string repetitions_value;
+  if (command_line.GetOptionValue("repetitions", &repetitions_value)) {
+    repetitions = std::max(std::atoi(repetitions_value.c_str()), 1);
+  }
+
+  // The model names must outlive the models.
+  std::vector<std::string> names;
+  std::vector<DlCostModel> models;
+  for (const std::string& backend : SplitCommaSeparated(backends)) {
+    DlSurfaceProvider::BackendType type;
+    std::string name;
+    if (backend == "software") {
+      type = DlSurfaceProvider::kSoftwareBackend;
+      name = "software";
+    } else if (backend == "vulkan") {
+      type = DlSurfaceProvider::kVulkanBackend;
+      name = "vulkan_swiftshader";
+    } else {
+      FML_LOG(ERROR) << "Unknown backend \"" << backend << "\".";
+      return 1;
+    }
+    DlCostModel model = {};
+    if (!CalibrateBackend(type, repetitions, &model)) {
+      return 1;
+    }
+    names.push_back(name);
+    models.push_back(model);
+  }
+  if (models.empty()) {
+    FML_LOG(ERROR) << "No backends to calibrate.";
+    return 1;
+  }
+  for (size_t i = 0; i < models.size(); i++) {
+    models[i].name = names[i].c_str();
+  }
+
+  std::string source = GenerateDlCostModelSource(models);
+  std::string output;
+  if (command_line.GetOptionValue("output", &output)) {
+    std::ofstream file(output);
+    file << source;
+    if (!file.good()) {
+      FML_LOG(ERROR) << "Could not write " << output;
+      return 1;
+    }
+  } else {
+    std::cout << source;
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace flutter
+
+int main(int argc, char** argv) {
+  return flutter::testing::Main(argc, argv);
+}
@@ -0,0 +1,269 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/benchmarking/dl_complexity_model.h"
+
+#include <cmath>
+#include <map>
+#include <mutex>
+
+namespace flutter {
+
+const DlCostModel* DlCostModel::Find(const std::string& name) {
+  for (int i = 0; i < kModelCount; i++) {
+    if (name == kModels[i].name) {
+      return &kModels[i];
+    }
+  }
+  return nullptr;
+}
+
+DisplayListModelComplexityCalculator*
+DisplayListModelComplexityCalculator::GetInstance(const std::string& name) {
+  static std::mutex mutex;
+  static std::map<const DlCostModel*, DisplayListModelComplexityCalculator*>
+      instances;
+
+  const DlCostModel* model = DlCostModel::Find(name);
+  if (model == nullptr) {
+    return nullptr;
+  }
+  std::scoped_lock lock(mutex);
+  auto& instance = instances[model];
+  if (instance == nullptr) {
+    instance = new DisplayListModelComplexityCalculator(*model);
+  }
+  return instance;
+}
+
+unsigned int DisplayListModelComplexityCalculator::Compute(
+    const DisplayList* display_list) {
+  ModelHelper helper(model_, ceiling_);
+  display_list->Dispatch(helper);
+  return helper.ComplexityScore();
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::AccumulateOp(
+    DlCostOp op,
+    float units) {
+  if (IsComplex()) {
+    return;
+  }
+  const DlCostCoefficients& coefficients = model_.Get(op, IsAntiAliased());
+  float nanoseconds = coefficients.fixed + coefficients.per_unit * units;
+  if (!(nanoseconds > 0.0f)) {
+    return;
+  }
+  float score = nanoseconds / kNanosecondsPerScore;
+  if (score >= static_cast<float>(Ceiling())) {
+    AccumulateComplexity(Ceiling());
+  } else {
+    AccumulateComplexity(static_cast<unsigned int>(score));
+  }
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::saveLayer(
+    const SkRect& bounds,
+    const SaveLayerOptions options,
+    const DlImageFilter* backdrop) {
+  if (backdrop) {
+    // As with the other calculators, backdrop filters are not expected in
+    // the pictures that are evaluated for caching.
+    AccumulateComplexity(Ceiling());
+    return;
+  }
+  AccumulateOp(DlCostOp::kSaveLayer, bounds.width() * bounds.height());
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawColor(
+    DlColor color,
+    DlBlendMode mode) {
+  AccumulateOp(DlCostOp::kDrawColor, 0.0f);
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawPaint() {
+  AccumulateOp(DlCostOp::kDrawPaint, 0.0f);
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawLine(
+    const SkPoint& p0,
+    const SkPoint& p1) {
+  AccumulateOp(DlCostOp::kDrawLine,
+               std::abs(p0.x() - p1.x()) + std::abs(p0.y() - p1.y()));
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawDashedLine(
+    const DlPoint& p0,
+    const DlPoint& p1,
+    DlScalar on_length,
+    DlScalar off_length) {
+  drawLine(ToSkPoint(p0), ToSkPoint(p1));
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawRect(
+    const SkRect& rect) {
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    AccumulateOp(DlCostOp::kDrawFillRect, rect.width() * rect.height());
+  } else {
+    AccumulateOp(DlCostOp::kDrawStrokeRect,
+                 (rect.width() + rect.height()) / 2);
+  }
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawOval(
+    const SkRect& bounds) {
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    AccumulateOp(DlCostOp::kDrawFillOval, bounds.width() * bounds.height());
+  } else {
+    AccumulateOp(DlCostOp::kDrawStrokeOval,
+                 (bounds.width() + bounds.height()) / 2);
+  }
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawCircle(
+    const SkPoint& center,
+    SkScalar radius) {
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    AccumulateOp(DlCostOp::kDrawFillCircle, radius * radius);
+  } else {
+    AccumulateOp(DlCostOp::kDrawStrokeCircle, radius);
+  }
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawRRect(
+    const SkRRect& rrect) {
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    AccumulateOp(DlCostOp::kDrawFillRRect, rrect.width() * rrect.height());
+  } else {
+    AccumulateOp(DlCostOp::kDrawStrokeRRect,
+                 (rrect.width() + rrect.height()) / 2);
+  }
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawDRRect(
+    const SkRRect& outer,
+    const SkRRect& inner) {
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    AccumulateOp(DlCostOp::kDrawFillDRRect, outer.width() * outer.height());
+  } else {
+    AccumulateOp(DlCostOp::kDrawStrokeDRRect,
+                 (outer.width() + outer.height()) / 2);
+  }
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawPath(
+    const SkPath& path) {
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    AccumulateOp(DlCostOp::kDrawFillPath, path.countVerbs());
+  } else {
+    AccumulateOp(DlCostOp::kDrawStrokePath, path.countVerbs());
+  }
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawArc(
+    const SkRect& oval_bounds,
+    SkScalar start_degrees,
+    SkScalar sweep_degrees,
+    bool use_center) {
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    AccumulateOp(DlCostOp::kDrawFillArc,
+                 oval_bounds.width() * oval_bounds.height());
+  } else {
+    AccumulateOp(DlCostOp::kDrawStrokeArc,
+                 (oval_bounds.width() + oval_bounds.height()) / 2);
+  }
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawPoints(
+    DlCanvas::PointMode mode,
+    uint32_t count,
+    const SkPoint points[]) {
+  switch (mode) {
+    case DlCanvas::PointMode::kPoints:
+      AccumulateOp(DlCostOp::kDrawPoints, count);
+      break;
+    case DlCanvas::PointMode::kLines:
+      AccumulateOp(DlCostOp::kDrawLines, count);
+      break;
+    case DlCanvas::PointMode::kPolygon:
+      AccumulateOp(DlCostOp::kDrawPolygon, count);
+      break;
+  }
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawVertices(
+    const std::shared_ptr<DlVertices>& vertices,
+    DlBlendMode mode) {
+  AccumulateOp(DlCostOp::kDrawVertices, vertices->vertex_count());
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawImage(
+    const sk_sp<DlImage> image,
+    const SkPoint point,
+    DlImageSampling sampling,
+    bool render_with_attributes) {
+  SkISize dimensions = image->dimensions();
+  AccumulateOp(DlCostOp::kDrawImage,
+               static_cast<float>(dimensions.width()) * dimensions.height());
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::ImageRect(
+    const SkISize& size,
+    bool texture_backed,
+    bool render_with_attributes,
+    bool enforce_src_edges) {
+  AccumulateOp(DlCostOp::kDrawImageRect,
+               static_cast<float>(size.width()) * size.height());
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawImageNine(
+    const sk_sp<DlImage> image,
+    const SkIRect& center,
+    const SkRect& dst,
+    DlFilterMode filter,
+    bool render_with_attributes) {
+  SkISize dimensions = image->dimensions();
+  AccumulateOp(DlCostOp::kDrawImageNine,
+               static_cast<float>(dimensions.width()) * dimensions.height());
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawDisplayList(
+    const sk_sp<DisplayList> display_list,
+    SkScalar opacity) {
+  if (IsComplex()) {
+    return;
+  }
+  ModelHelper helper(model_, Ceiling() - CurrentComplexityScore());
+  if (opacity < SK_Scalar1 && !display_list->can_apply_group_opacity()) {
+    auto bounds = display_list->bounds();
+    helper.saveLayer(bounds, SaveLayerOptions::kWithAttributes, nullptr);
+  }
+  display_list->Dispatch(helper);
+  AccumulateComplexity(helper.ComplexityScore());
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawTextBlob(
+    const sk_sp<SkTextBlob> blob,
+    SkScalar x,
+    SkScalar y) {
+  AccumulateOp(DlCostOp::kDrawText, 0.0f);
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawTextFrame(
+    const std::shared_ptr<impeller::TextFrame>& text_frame,
+    SkScalar x,
+    SkScalar y) {
+  AccumulateOp(DlCostOp::kDrawText, 0.0f);
+}
+
+void DisplayListModelComplexityCalculator::ModelHelper::drawShadow(
+    const SkPath& path,
+    const DlColor color,
+    const SkScalar elevation,
+    bool transparent_occluder,
+    SkScalar dpr) {
+  AccumulateOp(DlCostOp::kDrawShadow, path.countVerbs());
+}
+
+}  // namespace flutter
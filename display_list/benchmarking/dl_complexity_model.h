@@ -0,0 +1,197 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_MODEL_H_
+#define FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_MODEL_H_
+
+#include <limits>
+#include <string>
+
+#include "flutter/display_list/benchmarking/dl_complexity_helper.h"
+
+namespace flutter {
+
+// The rendering ops (and op variants) whose cost is modeled separately by
+// a DlCostModel. The comment on each entry describes the unit that the
+// per_unit coefficient of the op is multiplied by.
+enum class DlCostOp {
+  kSaveLayer,         // area of the layer bounds
+  kDrawColor,         // none
+  kDrawPaint,         // none
+  kDrawLine,          // length of the line (manhattan distance)
+  kDrawFillRect,      // area
+  kDrawStrokeRect,    // average of width and height
+  kDrawFillOval,      // area of the bounds
+  kDrawStrokeOval,    // average of width and height
+  kDrawFillCircle,    // square of the radius
+  kDrawStrokeCircle,  // radius
+  kDrawFillRRect,     // area of the bounds
+  kDrawStrokeRRect,   // average of width and height
+  kDrawFillDRRect,    // area of the outer bounds
+  kDrawStrokeDRRect,  // average of the outer width and height
+  kDrawFillArc,       // area of the oval bounds
+  kDrawStrokeArc,     // average of the oval width and height
+  kDrawFillPath,      // number of verbs
+  kDrawStrokePath,    // number of verbs
+  kDrawPoints,        // number of points
+  kDrawLines,         // number of points
+  kDrawPolygon,       // number of points
+  kDrawVertices,      // number of vertices
+  kDrawImage,         // area of the image
+  kDrawImageRect,     // area of the image, or of each sprite of an atlas
+  kDrawImageNine,     // area of the image
+  kDrawText,          // none
+  kDrawShadow,        // number of verbs of the occluder path
+
+  kLast = kDrawShadow,
+};
+
+static constexpr int kDlCostOpCount = static_cast<int>(DlCostOp::kLast) + 1;
+
+// The estimated cost of a single op in nanoseconds is
+// |fixed| + |per_unit| * units, where the units depend on the op as
+// described in |DlCostOp|.
+struct DlCostCoefficients {
+  float fixed = 0.0f;
+  float per_unit = 0.0f;
+};
+
+// A table of per-op cost coefficients for a rendering backend.
+//
+// Cost models are meant to be fit by the display_list_calibration tool,
+// which times each DlCostOp over a range of sizes on the backend and emits
+// the models as C++ source (see dl_complexity_models.cc).
+struct DlCostModel {
+  const char* name;
+  DlCostCoefficients aliased[kDlCostOpCount];
+  DlCostCoefficients anti_aliased[kDlCostOpCount];
+
+  const DlCostCoefficients& Get(DlCostOp op, bool anti_alias) const {
+    int index = static_cast<int>(op);
+    return anti_alias ? anti_aliased[index] : aliased[index];
+  }
+
+  // Returns the model with the given |name|, or nullptr if there is no
+  // such model.
+  static const DlCostModel* Find(const std::string& name);
+
+  // The models in dl_complexity_models.cc. Until
+  // display_list_calibration has been run on reference devices, this only
+  // holds the "bootstrap" model, which was converted by hand from the
+  // constants of DisplayListGLComplexityCalculator and was never measured.
+  static const DlCostModel kModels[];
+  static const int kModelCount;
+};
+
+// A DisplayListComplexityCalculator that scores each op with the cost
+// predicted by a DlCostModel instead of hand-tuned formulas.
+//
+// Scores use the same scale as the GL and Metal calculators, where a score
+// of 100 is roughly equivalent to 0.0005ms (see dl_complexity_helper.h).
+class DisplayListModelComplexityCalculator
+    : public DisplayListComplexityCalculator {
+ public:
+  // Each score unit corresponds to this many nanoseconds.
+  static constexpr float kNanosecondsPerScore = 5.0f;
+
+  // Returns a calculator for the model with the given |name|,
+  // or nullptr if there is no such model. The calculators are created
+  // once per model and never destroyed, like the other calculators.
+  static DisplayListModelComplexityCalculator* GetInstance(
+      const std::string& name);
+
+  explicit DisplayListModelComplexityCalculator(const DlCostModel& model)
+      : model_(model) {}
+
+  const DlCostModel& model() const { return model_; }
+
+  unsigned int Compute(const DisplayList* display_list) override;
+
+  bool ShouldBeCached(unsigned int complexity_score) override {
+    // Set cache threshold at 1ms
+    return complexity_score > 200000u;
+  }
+
+  void SetComplexityCeiling(unsigned int ceiling) override {
+    ceiling_ = ceiling;
+  }
+
+ private:
+  class ModelHelper : public ComplexityCalculatorHelper {
+   public:
+    ModelHelper(const DlCostModel& model, unsigned int ceiling)
+        : ComplexityCalculatorHelper(ceiling), model_(model) {}
+
+    void saveLayer(const SkRect& bounds,
+                   const SaveLayerOptions options,
+                   const DlImageFilter* backdrop) override;
+
+    void drawColor(DlColor color, DlBlendMode mode) override;
+    void drawPaint() override;
+    void drawLine(const SkPoint& p0, const SkPoint& p1) override;
+    void drawDashedLine(const DlPoint& p0,
+                        const DlPoint& p1,
+                        DlScalar on_length,
+                        DlScalar off_length) override;
+    void drawRect(const SkRect& rect) override;
+    void drawOval(const SkRect& bounds) override;
+    void drawCircle(const SkPoint& center, SkScalar radius) override;
+    void drawRRect(const SkRRect& rrect) override;
+    void drawDRRect(const SkRRect& outer, const SkRRect& inner) override;
+    void drawPath(const SkPath& path) override;
+    void drawArc(const SkRect& oval_bounds,
+                 SkScalar start_degrees,
+                 SkScalar sweep_degrees,
+                 bool use_center) override;
+    void drawPoints(DlCanvas::PointMode mode,
+                    uint32_t count,
+                    const SkPoint points[]) override;
+    void drawVertices(const std::shared_ptr<DlVertices>& vertices,
+                      DlBlendMode mode) override;
+    void drawImage(const sk_sp<DlImage> image,
+                   const SkPoint point,
+                   DlImageSampling sampling,
+                   bool render_with_attributes) override;
+    void drawImageNine(const sk_sp<DlImage> image,
+                       const SkIRect& center,
+                       const SkRect& dst,
+                       DlFilterMode filter,
+                       bool render_with_attributes) override;
+    void drawDisplayList(const sk_sp<DisplayList> display_list,
+                         SkScalar opacity) override;
+    void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                      SkScalar x,
+                      SkScalar y) override;
+    void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                       SkScalar x,
+                       SkScalar y) override;
+    void drawShadow(const SkPath& path,
+                    const DlColor color,
+                    const SkScalar elevation,
+                    bool transparent_occluder,
+                    SkScalar dpr) override;
+
+   protected:
+    void ImageRect(const SkISize& size,
+                   bool texture_backed,
+                   bool render_with_attributes,
+                   bool enforce_src_edges) override;
+
+    unsigned int BatchedComplexity() override { return 0u; }
+
+   private:
+    // Accumulates the modeled cost of one |op| covering |units|, using
+    // the coefficients for the current anti-alias setting.
+    void AccumulateOp(DlCostOp op, float units);
+
+    const DlCostModel& model_;
+  };
+
+  const DlCostModel& model_;
+  unsigned int ceiling_ = std::numeric_limits<unsigned int>::max();
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_MODEL_H_
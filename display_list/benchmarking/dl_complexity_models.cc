@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This file was written by hand, not by display_list_calibration. It holds a
+// single "bootstrap" model whose {fixed, per_unit} coefficients are the
+// constants of DisplayListGLComplexityCalculator (dl_complexity_gl.cc)
+// converted to nanoseconds at kNanosecondsPerScore. None of them were
+// measured. Running display_list_calibration (see dl_calibration_main.cc) on
+// a reference device replaces this file with measured models for each
+// backend.
+
+#include "flutter/display_list/benchmarking/dl_complexity_model.h"
+
+namespace flutter {
+
+// The coefficients are {fixed, per_unit} in nanoseconds.
+const DlCostModel DlCostModel::kModels[] = {
+    {
+        "bootstrap",
+        // aliased
+        {
+            {200000.0f, 0.0f},  // kSaveLayer
+            {250.0f, 0.0f},  // kDrawColor
+            {250.0f, 0.0f},  // kDrawPaint
+            {1300.0f, 2.5f},  // kDrawLine
+            {0.0f, 0.0571f},  // kDrawFillRect
+            {0.0f, 10.0f},  // kDrawStrokeRect
+            {0.0f, 0.167f},  // kDrawFillOval
+            {0.0f, 13.3f},  // kDrawStrokeOval
+            {10800.0f, 0.411f},  // kDrawFillCircle
+            {4000.0f, 20.0f},  // kDrawStrokeCircle
+            {100.0f, 0.0625f},  // kDrawFillRRect
+            {150.0f, 4.0f},  // kDrawStrokeRRect
+            {1000.0f, 0.313f},  // kDrawFillDRRect
+            {250.0f, 18.5f},  // kDrawStrokeDRRect
+            {889.0f, 0.0171f},  // kDrawFillArc
+            {500.0f, 2.0f},  // kDrawStrokeArc
+            {250000.0f, 800.0f},  // kDrawFillPath
+            {250000.0f, 800.0f},  // kDrawStrokePath
+            {250000.0f, 55.6f},  // kDrawPoints
+            {250000.0f, 111.0f},  // kDrawLines
+            {250000.0f, 133.0f},  // kDrawPolygon
+            {1e+06f, 625.0f},  // kDrawVertices
+            {20000.0f, 0.1f},  // kDrawImage
+            {10000.0f, 0.5f},  // kDrawImageRect
+            {6000.0f, 0.556f},  // kDrawImageNine
+            {4170.0f, 0.0f},  // kDrawText
+            {0.0f, 100000.0f},  // kDrawShadow
+        },
+        // anti_aliased
+        {
+            {200000.0f, 0.0f},  // kSaveLayer
+            {250.0f, 0.0f},  // kDrawColor
+            {250.0f, 0.0f},  // kDrawPaint
+            {2600.0f, 5.0f},  // kDrawLine
+            {0.0f, 0.0571f},  // kDrawFillRect
+            {0.0f, 6.67f},  // kDrawStrokeRect
+            {0.0f, 0.167f},  // kDrawFillOval
+            {0.0f, 25.0f},  // kDrawStrokeOval
+            {10000.0f, 0.381f},  // kDrawFillCircle
+            {2000.0f, 66.7f},  // kDrawStrokeCircle
+            {100.0f, 0.0625f},  // kDrawFillRRect
+            {200.0f, 8.0f},  // kDrawStrokeRRect
+            {1000.0f, 0.313f},  // kDrawFillDRRect
+            {500.0f, 33.3f},  // kDrawStrokeDRRect
+            {1110.0f, 0.111f},  // kDrawFillArc
+            {1330.0f, 2.9f},  // kDrawStrokeArc
+            {1e+06f, 2000.0f},  // kDrawFillPath
+            {1e+06f, 2000.0f},  // kDrawStrokePath
+            {0.0f, 2000.0f},  // kDrawPoints
+            {0.0f, 2000.0f},  // kDrawLines
+            {0.0f, 4000.0f},  // kDrawPolygon
+            {1e+06f, 625.0f},  // kDrawVertices
+            {20000.0f, 0.1f},  // kDrawImage
+            {10000.0f, 0.5f},  // kDrawImageRect
+            {6000.0f, 0.556f},  // kDrawImageNine
+            {4170.0f, 0.0f},  // kDrawText
+            {0.0f, 100000.0f},  // kDrawShadow
+        },
+    },
+};
+
+const int DlCostModel::kModelCount =
+    sizeof(DlCostModel::kModels) / sizeof(DlCostModel);
+
+}  // namespace flutter
@@ -2,9 +2,11 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "flutter/display_list/benchmarking/dl_calibration.h"
 #include "flutter/display_list/benchmarking/dl_complexity.h"
 #include "flutter/display_list/benchmarking/dl_complexity_gl.h"
 #include "flutter/display_list/benchmarking/dl_complexity_metal.h"
+#include "flutter/display_list/benchmarking/dl_complexity_model.h"
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/display_list/dl_sampling_options.h"
@@ -440,5 +442,99 @@ TEST(DisplayListComplexity, DrawAtlas) {
   }
 }
 
+TEST(DisplayListComplexity, BootstrapModelExists) {
+  ASSERT_NE(DlCostModel::Find("bootstrap"), nullptr);
+  ASSERT_EQ(DlCostModel::Find("unknown"), nullptr);
+
+  ASSERT_NE(DisplayListModelComplexityCalculator::GetInstance("bootstrap"),
+            nullptr);
+  ASSERT_EQ(DisplayListModelComplexityCalculator::GetInstance("bootstrap"),
+            DisplayListModelComplexityCalculator::GetInstance("bootstrap"));
+  ASSERT_EQ(DisplayListModelComplexityCalculator::GetInstance("unknown"),
+            nullptr);
+}
+
+TEST(DisplayListComplexity, ModelScoresScaleWithSize) {
+  DlCostModel model = {};
+  model.name = "test";
+  model.aliased[static_cast<int>(DlCostOp::kDrawFillRect)] = {100.0f, 1.0f};
+  DisplayListModelComplexityCalculator calculator(model);
+
+  DisplayListBuilder builder_small;
+  builder_small.DrawRect(SkRect::MakeWH(10, 10), DlPaint());
+  auto display_list_small = builder_small.Build();
+
+  DisplayListBuilder builder_large;
+  builder_large.DrawRect(SkRect::MakeWH(100, 100), DlPaint());
+  auto display_list_large = builder_large.Build();
+
+  // (100ns + 1ns * 100) / 5ns and (100ns + 1ns * 10000) / 5ns.
+  ASSERT_EQ(calculator.Compute(display_list_small.get()), 40u);
+  ASSERT_EQ(calculator.Compute(display_list_large.get()), 2020u);
+}
+
+TEST(DisplayListComplexity, ModelCeiling) {
+  DlCostModel model = {};
+  model.name = "test";
+  model.aliased[static_cast<int>(DlCostOp::kDrawFillRect)] = {100.0f, 1.0f};
+  DisplayListModelComplexityCalculator calculator(model);
+
+  DisplayListBuilder builder;
+  for (int i = 0; i < 10; i++) {
+    builder.DrawRect(SkRect::MakeWH(100, 100), DlPaint());
+  }
+  auto display_list = builder.Build();
+
+  calculator.SetComplexityCeiling(1000u);
+  ASSERT_EQ(calculator.Compute(display_list.get()), 1000u);
+}
+
+TEST(DisplayListComplexity, FitCostCoefficients) {
+  std::vector<DlCostSample> samples = {
+      {10.0f, 70.0},
+      {20.0f, 120.0},
+      {40.0f, 220.0},
+  };
+  DlCostCoefficients coefficients = FitDlCostCoefficients(samples);
+  EXPECT_NEAR(coefficients.fixed, 20.0f, 1e-3);
+  EXPECT_NEAR(coefficients.per_unit, 5.0f, 1e-4);
+}
+
+TEST(DisplayListComplexity, FitCostCoefficientsNeverNegative) {
+  // A decreasing cost is treated as a constant cost.
+  std::vector<DlCostSample> decreasing = {
+      {10.0f, 30.0},
+      {20.0f, 20.0},
+      {30.0f, 10.0},
+  };
+  DlCostCoefficients coefficients = FitDlCostCoefficients(decreasing);
+  EXPECT_NEAR(coefficients.fixed, 20.0f, 1e-3);
+  EXPECT_EQ(coefficients.per_unit, 0.0f);
+
+  // A negative intercept is refit through the origin.
+  std::vector<DlCostSample> steep = {
+      {10.0f, 0.0},
+      {20.0f, 100.0},
+  };
+  coefficients = FitDlCostCoefficients(steep);
+  EXPECT_EQ(coefficients.fixed, 0.0f);
+  EXPECT_NEAR(coefficients.per_unit, 4.0f, 1e-4);
+
+  EXPECT_EQ(FitDlCostCoefficients({}).fixed, 0.0f);
+  EXPECT_EQ(FitDlCostCoefficients({}).per_unit, 0.0f);
+}
+
+TEST(DisplayListComplexity, GenerateCostModelSource) {
+  DlCostModel model = {};
+  model.name = "generated";
+  model.anti_aliased[static_cast<int>(DlCostOp::kDrawShadow)] = {1.5f, 2.0f};
+
+  std::string source = GenerateDlCostModelSource({model});
+  EXPECT_NE(source.find("\"generated\""), std::string::npos);
+  EXPECT_NE(source.find("{1.5f, 2.0f},  // kDrawShadow"), std::string::npos);
+  EXPECT_NE(source.find("DlCostModel::kModelCount"),
+            std::string::npos);
+}
+
 }  // namespace testing
 }  // namespace flutter
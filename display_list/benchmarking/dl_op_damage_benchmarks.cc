@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/display_list/dl_builder.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr SkScalar kCellSize = 10;
+constexpr int kColumns = 100;
+
+enum class PictureChange {
+  // Nothing changed, the lists are different instances of the same content.
+  kNone,
+  // The color of a single cell changed, e.g. a blinking cursor.
+  kColor,
+  // The geometry of a single cell changed, e.g. a ticking counter.
+  kGeometry,
+  // A transform in the middle of the list changed, which affects every op
+  // that follows it.
+  kTransform,
+};
+
+// Records a grid of |cell_count| cells of which the one in the middle may
+// be modified according to |change| and |frame|.
+sk_sp<DisplayList> MakeGridPicture(int cell_count,
+                                   PictureChange change,
+                                   int frame) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  const int changed_cell = cell_count / 2;
+  DlPaint paint;
+  for (int i = 0; i < cell_count; i++) {
+    SkRect cell = SkRect::MakeXYWH((i % kColumns) * kCellSize,
+                                   (i / kColumns) * kCellSize,  //
+                                   kCellSize - 1, kCellSize - 1);
+    paint.setColor(i % 2 ? DlColor::kBlue() : DlColor::kGreen());
+    if (i == changed_cell) {
+      switch (change) {
+        case PictureChange::kNone:
+          break;
+        case PictureChange::kColor:
+          paint.setColor(frame % 2 ? DlColor::kRed() : DlColor::kWhite());
+          break;
+        case PictureChange::kGeometry:
+          cell.fRight -= frame % 5;
+          break;
+        case PictureChange::kTransform:
+          builder.Translate(0, frame % 2);
+          break;
+      }
+    }
+    builder.DrawRect(cell, paint);
+  }
+  return builder.Build();
+}
+
+}  // namespace
+
+// Measures the cost of computing the damage between two consecutive frames
+// of a picture and reports the fraction of the picture bounds that is
+// damaged, which would otherwise always be 1.
+static void BM_DisplayListOpDamage(benchmark::State& state,
+                                   PictureChange change) {
+  const int cell_count = state.range(0);
+  auto previous = MakeGridPicture(cell_count, change, 0);
+  auto current = MakeGridPicture(cell_count, change, 1);
+  SkRect damage;
+  while (state.KeepRunning()) {
+    bool computed = current->ComputeOpDamage(*previous, &damage);
+    benchmark::DoNotOptimize(computed);
+  }
+  const SkRect& bounds = current->bounds();
+  state.counters["Ops"] = current->op_count();
+  state.counters["DamageRatio"] =
+      (damage.width() * damage.height()) / (bounds.width() * bounds.height());
+}
+
+// The deep comparison that DisplayListLayer performs for small pictures,
+// for reference.
+static void BM_DisplayListEquals(benchmark::State& state) {
+  const int cell_count = state.range(0);
+  auto previous = MakeGridPicture(cell_count, PictureChange::kNone, 0);
+  auto current = MakeGridPicture(cell_count, PictureChange::kNone, 1);
+  while (state.KeepRunning()) {
+    bool equal = current->Equals(previous);
+    benchmark::DoNotOptimize(equal);
+  }
+  state.counters["Ops"] = current->op_count();
+}
+
+BENCHMARK_CAPTURE(BM_DisplayListOpDamage, None, PictureChange::kNone)
+    ->RangeMultiplier(4)
+    ->Range(16, 16384)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListOpDamage, Color, PictureChange::kColor)
+    ->RangeMultiplier(4)
+    ->Range(16, 16384)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListOpDamage, Geometry, PictureChange::kGeometry)
+    ->RangeMultiplier(4)
+    ->Range(16, 16384)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListOpDamage,
+                  Transform,
+                  PictureChange::kTransform)
+    ->RangeMultiplier(4)
+    ->Range(16, 16384)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DisplayListEquals)
+    ->RangeMultiplier(4)
+    ->Range(16, 16384)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/display_list/geometry/dl_rtree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace flutter {
+
+namespace {
+
+constexpr SkScalar kViewportWidth = 1000;
+constexpr SkScalar kViewportHeight = 2000;
+
+// Lays out |count| rects the way a long scroll view or a tiled map would
+// record them: mostly in reading order, 10 per viewport-wide row, with
+// some jitter in their position and size.
+std::vector<SkRect> GeneratePageRects(int count) {
+  std::mt19937 rng(count);
+  std::uniform_real_distribution<SkScalar> jitter(0, 20);
+  std::uniform_real_distribution<SkScalar> size(10, 120);
+  std::vector<SkRect> rects;
+  rects.reserve(count);
+  for (int i = 0; i < count; i++) {
+    SkScalar x = (i % 10) * (kViewportWidth / 10) + jitter(rng);
+    SkScalar y = (i / 10) * 50 + jitter(rng);
+    rects.push_back(SkRect::MakeXYWH(x, y, size(rng), size(rng)));
+  }
+  return rects;
+}
+
+}  // namespace
+
+static void BM_DlRTreeBuild(benchmark::State& state) {
+  const int count = state.range(0);
+  auto rects = GeneratePageRects(count);
+  while (state.KeepRunning()) {
+    DlRTree tree(rects.data(), count);
+    benchmark::DoNotOptimize(tree.leaf_count());
+  }
+  DlRTree tree(rects.data(), count);
+  state.counters["Nodes"] = tree.node_count();
+  state.counters["Bytes"] = tree.bytes_used();
+}
+
+// Searches for a viewport sized query scrolled to a different position
+// through the picture on every iteration, the way a retained picture is
+// culled each frame.
+static void BM_DlRTreeSearch(benchmark::State& state) {
+  const int count = state.range(0);
+  auto rects = GeneratePageRects(count);
+  DlRTree tree(rects.data(), count);
+  const SkScalar scroll_extent =
+      std::max(tree.bounds().height() - kViewportHeight, 1.0f);
+  std::vector<int> results;
+  size_t hits = 0;
+  int frame = 0;
+  while (state.KeepRunning()) {
+    SkScalar scroll = std::fmod(frame++ * 997.0f, scroll_extent);
+    results.clear();
+    tree.search(SkRect::MakeXYWH(0, scroll, kViewportWidth, kViewportHeight),
+                &results);
+    hits += results.size();
+  }
+  state.counters["Hits"] =
+      benchmark::Counter(hits, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_DlRTreeBuild)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DlRTreeSearch)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
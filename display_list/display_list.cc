@@ -2,10 +2,13 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstring>
 #include <type_traits>
+#include <vector>
 
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_op_records.h"
+#include "flutter/display_list/utils/dl_storage_slab.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -14,6 +17,61 @@ const SaveLayerOptions SaveLayerOptions::kNoAttributes = SaveLayerOptions();
 const SaveLayerOptions SaveLayerOptions::kWithAttributes =
     kNoAttributes.with_renders_with_attributes();
 
+DisplayListStorage::DisplayListStorage(DisplayListStorage&& other)
+    : ptr_(other.ptr_),
+      capacity_(other.capacity_),
+      slab_(std::move(other.slab_)) {
+  other.ptr_ = nullptr;
+  other.capacity_ = 0u;
+}
+
+DisplayListStorage& DisplayListStorage::operator=(DisplayListStorage&& other) {
+  if (this != &other) {
+    reset();
+    ptr_ = other.ptr_;
+    capacity_ = other.capacity_;
+    slab_ = std::move(other.slab_);
+    other.ptr_ = nullptr;
+    other.capacity_ = 0u;
+  }
+  return *this;
+}
+
+DisplayListStorage::~DisplayListStorage() {
+  reset();
+}
+
+void DisplayListStorage::reset() {
+  if (slab_) {
+    slab_->Free(ptr_, capacity_);
+  } else {
+    std::free(ptr_);
+  }
+  ptr_ = nullptr;
+  capacity_ = 0u;
+}
+
+void DisplayListStorage::realloc(size_t count) {
+  if (!slab_) {
+    ptr_ = static_cast<uint8_t*>(std::realloc(ptr_, count));
+    FML_CHECK(ptr_);
+    capacity_ = count;
+    return;
+  }
+  if (ptr_ && count <= capacity_) {
+    return;
+  }
+  size_t capacity;
+  uint8_t* block = slab_->Allocate(count, &capacity);
+  FML_CHECK(block);
+  if (ptr_) {
+    memcpy(block, ptr_, capacity_);
+    slab_->Free(ptr_, capacity_);
+  }
+  ptr_ = block;
+  capacity_ = capacity;
+}
+
 DisplayList::DisplayList()
     : byte_count_(0),
       op_count_(0),
@@ -323,4 +381,255 @@ bool DisplayList::Equals(const DisplayList* other) const {
   return CompareOps(ptr, ptr + byte_count_, o_ptr, o_ptr + other->byte_count_);
 }
 
+namespace {
+
+bool IsRenderingOp(DisplayListOpType type) {
+  return type >= DisplayListOpType::kDrawPaint &&
+         type <= DisplayListOpType::kDrawShadowTransparentOccluder;
+}
+
+// The paint attribute that an op sets, attribute ops that set the same
+// attribute to the same value leave the rendering state of the ops that
+// follow them identical.
+enum class OpAttribute {
+  kNone = -1,
+  kAntiAlias,
+  kInvertColors,
+  kStrokeCap,
+  kStrokeJoin,
+  kStyle,
+  kStrokeWidth,
+  kStrokeMiter,
+  kColor,
+  kBlendMode,
+  kColorFilter,
+  kColorSource,
+  kImageFilter,
+  kMaskFilter,
+  kCount,
+};
+
+OpAttribute GetOpAttribute(DisplayListOpType type) {
+  switch (type) {
+    case DisplayListOpType::kSetAntiAlias:
+      return OpAttribute::kAntiAlias;
+    case DisplayListOpType::kSetInvertColors:
+      return OpAttribute::kInvertColors;
+    case DisplayListOpType::kSetStrokeCap:
+      return OpAttribute::kStrokeCap;
+    case DisplayListOpType::kSetStrokeJoin:
+      return OpAttribute::kStrokeJoin;
+    case DisplayListOpType::kSetStyle:
+      return OpAttribute::kStyle;
+    case DisplayListOpType::kSetStrokeWidth:
+      return OpAttribute::kStrokeWidth;
+    case DisplayListOpType::kSetStrokeMiter:
+      return OpAttribute::kStrokeMiter;
+    case DisplayListOpType::kSetColor:
+      return OpAttribute::kColor;
+    case DisplayListOpType::kSetBlendMode:
+      return OpAttribute::kBlendMode;
+    case DisplayListOpType::kClearColorFilter:
+    case DisplayListOpType::kSetPodColorFilter:
+      return OpAttribute::kColorFilter;
+    case DisplayListOpType::kClearColorSource:
+    case DisplayListOpType::kSetPodColorSource:
+    case DisplayListOpType::kSetImageColorSource:
+    case DisplayListOpType::kSetRuntimeEffectColorSource:
+#ifdef IMPELLER_ENABLE_3D
+    case DisplayListOpType::kSetSceneColorSource:
+#endif  // IMPELLER_ENABLE_3D
+      return OpAttribute::kColorSource;
+    case DisplayListOpType::kClearImageFilter:
+    case DisplayListOpType::kSetPodImageFilter:
+    case DisplayListOpType::kSetSharedImageFilter:
+      return OpAttribute::kImageFilter;
+    case DisplayListOpType::kClearMaskFilter:
+    case DisplayListOpType::kSetPodMaskFilter:
+      return OpAttribute::kMaskFilter;
+    default:
+      return OpAttribute::kNone;
+  }
+}
+
+bool OpEquals(const DLOp* a, const DLOp* b) {
+  if (a->type != b->type || a->size != b->size) {
+    return false;
+  }
+  DisplayListCompare result;
+  switch (a->type) {
+#define DL_OP_EQUALS(name)                             \
+  case DisplayListOpType::k##name:                     \
+    result = static_cast<const name##Op*>(a)->equals( \
+        static_cast<const name##Op*>(b));              \
+    break;
+
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_EQUALS)
+#ifdef IMPELLER_ENABLE_3D
+    DL_OP_EQUALS(SetSceneColorSource)
+#endif  // IMPELLER_ENABLE_3D
+
+#undef DL_OP_EQUALS
+
+    default:
+      FML_DCHECK(false);
+      return false;
+  }
+  switch (result) {
+    case DisplayListCompare::kNotEqual:
+      return false;
+    case DisplayListCompare::kUseBulkCompare:
+      return memcmp(a, b, a->size) == 0;
+    case DisplayListCompare::kEqual:
+      return true;
+  }
+  FML_UNREACHABLE();
+}
+
+// The ops of one of the DisplayLists being compared by ComputeOpDamage
+// along with the area that each of them renders to.
+class OpDamageList {
+ public:
+  OpDamageList(const uint8_t* ptr,
+               const uint8_t* end,
+               uint32_t op_count,
+               const DlRTree& rtree) {
+    ops_.reserve(op_count);
+    while (ptr < end) {
+      auto op = reinterpret_cast<const DLOp*>(ptr);
+      ptr += op->size;
+      FML_DCHECK(ptr <= end);
+      ops_.push_back(op);
+      if (op->type == DisplayListOpType::kSaveLayerBackdrop) {
+        has_backdrop_ = true;
+      }
+    }
+
+    // The builder has already expanded the RTree rects of ops inside of
+    // layers with an image filter by that filter, so they cover every
+    // pixel that the op affects.
+    damage_.resize(ops_.size(), SkRect::MakeEmpty());
+    for (int i = 0; i < rtree.leaf_count(); i++) {
+      size_t id = static_cast<size_t>(rtree.id(i));
+      if (id < damage_.size() && IsRenderingOp(ops_[id]->type)) {
+        damage_[id].join(rtree.bounds(i));
+      }
+    }
+  }
+
+  size_t size() const { return ops_.size(); }
+  const DLOp* op(size_t index) const { return ops_[index]; }
+  bool has_backdrop() const { return has_backdrop_; }
+
+  void JoinDamage(size_t index, SkRect* damage) const {
+    damage->join(damage_[index]);
+  }
+
+  void JoinDamage(size_t start, size_t end, SkRect* damage) const {
+    for (size_t i = start; i < end; i++) {
+      damage->join(damage_[i]);
+    }
+  }
+
+  bool HasStateOps(size_t start, size_t end) const {
+    for (size_t i = start; i < end; i++) {
+      if (!IsRenderingOp(ops_[i]->type)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  std::vector<const DLOp*> ops_;
+  std::vector<SkRect> damage_;
+  bool has_backdrop_ = false;
+};
+
+}  // namespace
+
+bool DisplayList::ComputeOpDamage(const DisplayList& old,
+                                  SkRect* damage) const {
+  TRACE_EVENT0("flutter", "DisplayList::ComputeOpDamage");
+  *damage = SkRect::MakeEmpty();
+  if (!has_rtree() || !old.has_rtree()) {
+    return false;
+  }
+  const uint8_t* ptr = storage_.get();
+  const uint8_t* old_ptr = old.storage_.get();
+  OpDamageList ops(ptr, ptr + byte_count_, op_count_, *rtree_);
+  OpDamageList old_ops(old_ptr, old_ptr + old.byte_count_, old.op_count_,
+                       *old.rtree_);
+  if (ops.has_backdrop() || old_ops.has_backdrop()) {
+    return false;
+  }
+
+  // Skip the common prefix and suffix of both op sequences.
+  size_t top = 0;
+  while (top < ops.size() && top < old_ops.size() &&
+         OpEquals(ops.op(top), old_ops.op(top))) {
+    top++;
+  }
+  size_t bottom = ops.size();
+  size_t old_bottom = old_ops.size();
+  while (bottom > top && old_bottom > top &&
+         OpEquals(ops.op(bottom - 1), old_ops.op(old_bottom - 1))) {
+    bottom--;
+    old_bottom--;
+  }
+
+  if (bottom - top == old_bottom - top) {
+    // The same number of ops differ on both sides, compare them in pairs.
+    // A changed attribute op affects the rendering ops that follow it,
+    // including those in the common suffix, until both lists set that
+    // attribute to the same value again.
+    FML_DCHECK(ops.size() == old_ops.size());
+    bool attribute_differs[static_cast<int>(OpAttribute::kCount)] = {};
+    int differing_attributes = 0;
+    for (size_t i = top; i < ops.size(); i++) {
+      if (i >= bottom && differing_attributes == 0) {
+        break;
+      }
+      const DLOp* op = ops.op(i);
+      const DLOp* old_op = old_ops.op(i);
+      bool equal = OpEquals(op, old_op);
+      if (IsRenderingOp(op->type) && IsRenderingOp(old_op->type)) {
+        if (!equal || differing_attributes > 0) {
+          ops.JoinDamage(i, damage);
+          old_ops.JoinDamage(i, damage);
+        }
+        continue;
+      }
+      OpAttribute attribute = GetOpAttribute(op->type);
+      if (attribute != OpAttribute::kNone &&
+          attribute == GetOpAttribute(old_op->type)) {
+        bool& differs = attribute_differs[static_cast<int>(attribute)];
+        if (differs != !equal) {
+          differs = !equal;
+          differing_attributes += differs ? 1 : -1;
+        }
+        continue;
+      }
+      if (!equal) {
+        // The transform, clip or layer state diverges from here on.
+        ops.JoinDamage(i, ops.size(), damage);
+        old_ops.JoinDamage(i, old_ops.size(), damage);
+        return true;
+      }
+    }
+    return true;
+  }
+
+  if (ops.HasStateOps(top, bottom) || old_ops.HasStateOps(top, old_bottom)) {
+    // Inserting or removing state ops changes the rendering state of the
+    // common suffix as well.
+    ops.JoinDamage(top, ops.size(), damage);
+    old_ops.JoinDamage(top, old_ops.size(), damage);
+    return true;
+  }
+  ops.JoinDamage(top, bottom, damage);
+  old_ops.JoinDamage(top, old_bottom, damage);
+  return true;
+}
+
 }  // namespace flutter
@@ -12,6 +12,7 @@
 #include "flutter/display_list/dl_sampling_options.h"
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
 
 // The Flutter DisplayList mechanism encapsulates a persistent sequence of
 // rendering operations.
@@ -238,26 +239,43 @@ class SaveLayerOptions {
   };
 };
 
-// Manages a buffer allocated with malloc.
+class DlStorageSlab;
+
+// Manages a buffer allocated with malloc or, optionally, with a
+// |DlStorageSlab| that recycles buffers across DisplayLists.
 class DisplayListStorage {
  public:
   DisplayListStorage() = default;
-  DisplayListStorage(DisplayListStorage&&) = default;
+  explicit DisplayListStorage(std::shared_ptr<DlStorageSlab> slab)
+      : slab_(std::move(slab)) {}
+  DisplayListStorage(DisplayListStorage&& other);
+  DisplayListStorage& operator=(DisplayListStorage&& other);
+  ~DisplayListStorage();
 
-  uint8_t* get() { return ptr_.get(); }
+  uint8_t* get() { return ptr_; }
 
-  const uint8_t* get() const { return ptr_.get(); }
+  const uint8_t* get() const { return ptr_; }
 
-  void realloc(size_t count) {
-    ptr_.reset(static_cast<uint8_t*>(std::realloc(ptr_.release(), count)));
-    FML_CHECK(ptr_);
-  }
+  // The number of bytes addressable at |get()|, which may be larger
+  // than the count most recently passed to |realloc| when the buffer
+  // comes from a slab.
+  size_t capacity() const { return capacity_; }
+
+  const std::shared_ptr<DlStorageSlab>& slab() const { return slab_; }
+
+  // Resizes the buffer to hold at least |count| bytes, preserving its
+  // contents. Slab-backed buffers are never shrunk since their size
+  // class is already within a factor of 2 of the requested size.
+  void realloc(size_t count);
 
  private:
-  struct FreeDeleter {
-    void operator()(uint8_t* p) { std::free(p); }
-  };
-  std::unique_ptr<uint8_t, FreeDeleter> ptr_;
+  void reset();
+
+  uint8_t* ptr_ = nullptr;
+  size_t capacity_ = 0u;
+  std::shared_ptr<DlStorageSlab> slab_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListStorage);
 };
 
 class Culler;
@@ -302,6 +320,23 @@ class DisplayList : public SkRefCnt {
     return Equals(other.get());
   }
 
+  /// @brief     Computes the area in which the rendering of this DisplayList
+  ///            may differ from the rendering of |old|.
+  ///
+  /// The op sequences of both lists are aligned by skipping their common
+  /// prefix and suffix and the remaining ops are compared one to one when
+  /// both sides have the same number of them. The bounds of every rendering
+  /// op that was added, removed or changed, as recorded in the RTree of its
+  /// list, are joined into |damage|. A change to an attribute, transform,
+  /// clip or save/restore op affects every rendering op that follows it in
+  /// both lists.
+  ///
+  /// @return    false if the lists cannot be compared op by op, which is
+  ///            the case if either of them has no RTree or contains a
+  ///            backdrop filter, in which case the entire bounds of both
+  ///            lists must be considered damaged.
+  bool ComputeOpDamage(const DisplayList& old, SkRect* damage) const;
+
   bool can_apply_group_opacity() const { return can_apply_group_opacity_; }
   bool isUIThreadSafe() const { return is_ui_thread_safe_; }
 
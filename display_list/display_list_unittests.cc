@@ -4724,5 +4724,117 @@ TEST_F(DisplayListTest, RecordLargeVertices) {
   }
 }
 
+TEST_F(DisplayListTest, OpDamageOfEqualListsIsEmpty) {
+  DisplayListBuilder builder1(true);
+  DisplayListBuilder builder2(true);
+  for (DisplayListBuilder* builder : {&builder1, &builder2}) {
+    builder->DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+    builder->DrawOval(SkRect::MakeLTRB(20, 20, 30, 30), DlPaint());
+  }
+  SkRect damage;
+  EXPECT_TRUE(builder2.Build()->ComputeOpDamage(*builder1.Build(), &damage));
+  EXPECT_TRUE(damage.isEmpty());
+}
+
+TEST_F(DisplayListTest, OpDamageRequiresRTree) {
+  DisplayListBuilder builder1(false);
+  builder1.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+  DisplayListBuilder builder2(true);
+  builder2.DrawRect(SkRect::MakeLTRB(0, 0, 20, 20), DlPaint());
+  SkRect damage;
+  EXPECT_FALSE(builder2.Build()->ComputeOpDamage(*builder1.Build(), &damage));
+}
+
+TEST_F(DisplayListTest, OpDamageOfChangedRenderOps) {
+  DisplayListBuilder builder1(true);
+  builder1.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+  builder1.DrawRect(SkRect::MakeLTRB(20, 20, 30, 30), DlPaint());
+  builder1.DrawRect(SkRect::MakeLTRB(40, 40, 50, 50), DlPaint());
+  DisplayListBuilder builder2(true);
+  builder2.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+  builder2.DrawOval(SkRect::MakeLTRB(25, 25, 35, 35), DlPaint());
+  builder2.DrawRect(SkRect::MakeLTRB(40, 40, 50, 50), DlPaint());
+  SkRect damage;
+  EXPECT_TRUE(builder2.Build()->ComputeOpDamage(*builder1.Build(), &damage));
+  EXPECT_EQ(damage, SkRect::MakeLTRB(20, 20, 35, 35));
+}
+
+TEST_F(DisplayListTest, OpDamageOfInsertedRenderOps) {
+  DisplayListBuilder builder1(true);
+  builder1.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+  builder1.DrawRect(SkRect::MakeLTRB(40, 40, 50, 50), DlPaint());
+  DisplayListBuilder builder2(true);
+  builder2.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+  builder2.DrawRect(SkRect::MakeLTRB(20, 20, 30, 30), DlPaint());
+  builder2.DrawRect(SkRect::MakeLTRB(40, 40, 50, 50), DlPaint());
+  SkRect damage;
+  EXPECT_TRUE(builder2.Build()->ComputeOpDamage(*builder1.Build(), &damage));
+  EXPECT_EQ(damage, SkRect::MakeLTRB(20, 20, 30, 30));
+}
+
+TEST_F(DisplayListTest, OpDamageOfChangedAttributeEndsWhenResynchronized) {
+  auto make = [](DlColor color) {
+    DisplayListBuilder builder(true);
+    builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10),
+                     DlPaint(DlColor::kBlue()));
+    builder.DrawRect(SkRect::MakeLTRB(20, 20, 30, 30), DlPaint(color));
+    builder.DrawRect(SkRect::MakeLTRB(40, 40, 50, 50),
+                     DlPaint(DlColor::kBlue()));
+    return builder.Build();
+  };
+  SkRect damage;
+  EXPECT_TRUE(make(DlColor::kRed())->ComputeOpDamage(*make(DlColor::kGreen()),
+                                                     &damage));
+  EXPECT_EQ(damage, SkRect::MakeLTRB(20, 20, 30, 30));
+}
+
+TEST_F(DisplayListTest, OpDamageOfChangedTransformIncludesFollowingOps) {
+  auto make = [](SkScalar tx) {
+    DisplayListBuilder builder(true);
+    builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+    builder.Save();
+    builder.Translate(tx, 0);
+    builder.DrawRect(SkRect::MakeLTRB(20, 20, 30, 30), DlPaint());
+    builder.Restore();
+    builder.DrawRect(SkRect::MakeLTRB(40, 40, 50, 50), DlPaint());
+    return builder.Build();
+  };
+  SkRect damage;
+  EXPECT_TRUE(make(5)->ComputeOpDamage(*make(10), &damage));
+  EXPECT_EQ(damage, SkRect::MakeLTRB(25, 20, 50, 50));
+}
+
+TEST_F(DisplayListTest, OpDamageInsideFilteredLayerIncludesLayerBounds) {
+  auto blur = DlBlurImageFilter::Make(5, 5, DlTileMode::kDecal);
+  auto make = [&blur](DlColor color) {
+    DisplayListBuilder builder(true);
+    DlPaint layer_paint;
+    layer_paint.setImageFilter(blur);
+    builder.SaveLayer(nullptr, &layer_paint);
+    builder.DrawRect(SkRect::MakeLTRB(20, 20, 30, 30), DlPaint(color));
+    builder.Restore();
+    return builder.Build();
+  };
+  auto display_list = make(DlColor::kRed());
+  SkRect damage;
+  EXPECT_TRUE(display_list->ComputeOpDamage(*make(DlColor::kGreen()),
+                                            &damage));
+  EXPECT_EQ(damage, display_list->bounds());
+}
+
+TEST_F(DisplayListTest, OpDamageWithBackdropFilterIsNotComputed) {
+  auto blur = DlBlurImageFilter::Make(5, 5, DlTileMode::kDecal);
+  auto make = [&blur](DlColor color) {
+    DisplayListBuilder builder(true);
+    builder.DrawRect(SkRect::MakeLTRB(20, 20, 30, 30), DlPaint(color));
+    builder.SaveLayer(nullptr, nullptr, blur.get());
+    builder.Restore();
+    return builder.Build();
+  };
+  SkRect damage;
+  EXPECT_FALSE(make(DlColor::kRed())->ComputeOpDamage(*make(DlColor::kGreen()),
+                                                      &damage));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -44,13 +44,7 @@ void* DisplayListBuilder::Push(size_t pod, Args&&... args) {
   size_t size = SkAlignPtr(sizeof(T) + pod);
   FML_CHECK(size < (1 << 24));
   if (used_ + size > allocated_) {
-    static_assert(is_power_of_two(DL_BUILDER_PAGE),
-                  "This math needs updating for non-pow2.");
-    // Next greater multiple of DL_BUILDER_PAGE.
-    allocated_ = (used_ + size + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
-    storage_.realloc(allocated_);
-    FML_CHECK(storage_.get());
-    memset(storage_.get() + used_, 0, allocated_ - used_);
+    GrowStorage(used_ + size);
   }
   FML_CHECK(used_ + size <= allocated_);
   auto op = reinterpret_cast<T*>(storage_.get() + used_);
@@ -64,6 +58,36 @@ void* DisplayListBuilder::Push(size_t pod, Args&&... args) {
   return op + 1;
 }
 
+void DisplayListBuilder::GrowStorage(size_t required) {
+  static_assert(is_power_of_two(DL_BUILDER_PAGE),
+                "This math needs updating for non-pow2.");
+  // Next greater multiple of DL_BUILDER_PAGE.
+  size_t request = (required + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
+  storage_.realloc(request);
+  FML_CHECK(storage_.get());
+  storage_allocation_count_++;
+  // A slab may hand back more room than was asked for, all of which
+  // can be used before the next reallocation.
+  allocated_ = storage_.capacity();
+  FML_DCHECK(allocated_ >= request);
+  memset(storage_.get() + used_, 0, allocated_ - used_);
+}
+
+void DisplayListBuilder::Reserve(size_t bytes) {
+  if (bytes > allocated_) {
+    GrowStorage(bytes);
+  }
+}
+
+void DisplayListBuilder::SetStorageSlab(std::shared_ptr<DlStorageSlab> slab) {
+  FML_DCHECK(used_ == 0u);
+  if (storage_.slab() == slab) {
+    return;
+  }
+  storage_ = DisplayListStorage(std::move(slab));
+  allocated_ = 0u;
+}
+
 sk_sp<DisplayList> DisplayListBuilder::Build() {
   while (save_stack_.size() > 1) {
     restore();
@@ -107,11 +131,15 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
   save_stack_.pop_back();
   Init(rtree != nullptr);
 
+  std::shared_ptr<DlStorageSlab> slab = storage_.slab();
   storage_.realloc(bytes);
-  return sk_sp<DisplayList>(new DisplayList(
+  sk_sp<DisplayList> display_list(new DisplayList(
       std::move(storage_), bytes, count, nested_bytes, nested_count,
       total_depth, bounds, opacity_compatible, is_safe, affects_transparency,
       max_root_blend_mode, root_has_backdrop_filter, std::move(rtree)));
+  // Keep recording into the same slab if the builder is reused.
+  storage_ = DisplayListStorage(std::move(slab));
+  return display_list;
 }
 
 static constexpr DlRect kEmpty = DlRect();
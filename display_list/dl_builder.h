@@ -251,6 +251,17 @@ class DisplayListBuilder final : public virtual DlCanvas,
 
   sk_sp<DisplayList> Build();
 
+  /// Ensures that at least |bytes| bytes of op storage are allocated so
+  /// that recording that many bytes of ops will not reallocate. Typically
+  /// called with a size hint from a |DisplayListBuilderPool|.
+  void Reserve(size_t bytes);
+
+  /// Allocates all subsequent op storage, including the storage handed
+  /// off to the DisplayList objects produced by |Build|, from the given
+  /// slab. A null slab reverts to plain malloc/realloc storage. Must be
+  /// called before any ops are recorded.
+  void SetStorageSlab(std::shared_ptr<DlStorageSlab> slab);
+
  private:
   void Init(bool prepare_rtree);
 
@@ -267,6 +278,10 @@ class DisplayListBuilder final : public virtual DlCanvas,
   friend DlPaint DisplayListBuilderTestingAttributes(
       DisplayListBuilder& builder);
   friend int DisplayListBuilderTestingLastOpIndex(DisplayListBuilder& builder);
+  friend uint32_t DisplayListBuilderBenchmarkStorageAllocations(
+      DisplayListBuilder& builder);
+  friend uint32_t DisplayListBuilderTestingStorageAllocations(
+      DisplayListBuilder& builder);
 
   void SetAttributesFromPaint(const DlPaint& paint,
                               const DisplayListAttributeFlags flags);
@@ -510,9 +525,15 @@ class DisplayListBuilder final : public virtual DlCanvas,
 
   bool is_ui_thread_safe_ = true;
 
+  // Number of times |storage_| has been (re)allocated over the lifetime
+  // of this builder.
+  uint32_t storage_allocation_count_ = 0u;
+
   template <typename T, typename... Args>
   void* Push(size_t extra, Args&&... args);
 
+  void GrowStorage(size_t required);
+
   struct RTreeData {
     std::vector<SkRect> rects;
     std::vector<int> indices;
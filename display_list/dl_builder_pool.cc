@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_builder_pool.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+DisplayListBuilderPool::DisplayListBuilderPool(
+    std::shared_ptr<DlStorageSlab> slab)
+    : slab_(std::move(slab)) {}
+
+DisplayListBuilderPool::~DisplayListBuilderPool() = default;
+
+void DisplayListBuilderPool::BeginFrame() {
+  for (auto it = sites_.begin(); it != sites_.end();) {
+    SiteHistory& history = it->second;
+    if (history.current_frame_bytes == 0u) {
+      it = sites_.erase(it);
+      continue;
+    }
+    history.previous_frame_bytes = history.current_frame_bytes;
+    history.current_frame_bytes = 0u;
+    ++it;
+  }
+  next_ordinal_ = 0u;
+}
+
+sk_sp<DisplayListBuilder> DisplayListBuilderPool::Acquire(
+    CallSite site,
+    const SkRect& cull_rect,
+    bool prepare_rtree) {
+  auto builder = sk_make_sp<DisplayListBuilder>(cull_rect, prepare_rtree);
+  if (slab_) {
+    builder->SetStorageSlab(slab_);
+  }
+  stats_.acquired++;
+  size_t hint = GetSizeHint(site);
+  if (hint > 0u) {
+    builder->Reserve(hint);
+    stats_.presized++;
+    stats_.reserved_bytes += hint;
+  }
+  return builder;
+}
+
+void DisplayListBuilderPool::Record(CallSite site,
+                                    const DisplayList& display_list) {
+  auto it = sites_.find(site);
+  if (it == sites_.end()) {
+    if (sites_.size() >= kMaxCallSites) {
+      return;
+    }
+    it = sites_.emplace(site, SiteHistory()).first;
+  }
+  // Only the op storage is pre-allocated by the builder, nested display
+  // lists are shared by reference.
+  size_t bytes = display_list.bytes(false) - sizeof(DisplayList);
+  SiteHistory& history = it->second;
+  history.current_frame_bytes = std::max(history.current_frame_bytes, bytes);
+}
+
+size_t DisplayListBuilderPool::GetSizeHint(CallSite site) const {
+  auto it = sites_.find(site);
+  if (it == sites_.end()) {
+    return 0u;
+  }
+  return std::max(it->second.previous_frame_bytes,
+                  it->second.current_frame_bytes);
+}
+
+}  // namespace flutter
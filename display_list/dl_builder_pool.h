@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_BUILDER_POOL_H_
+#define FLUTTER_DISPLAY_LIST_DL_BUILDER_POOL_H_
+
+#include <memory>
+#include <unordered_map>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/utils/dl_storage_slab.h"
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+// Hands out DisplayListBuilder objects whose op storage has already been
+// sized from the high-water mark recorded for the same call site during
+// the previous frame, so that recording a picture of a similar size to
+// last frame's does not pay for a series of growing reallocations.
+//
+// A call site is an opaque key chosen by the caller. Callers that have no
+// better way to identify the code recording a picture can use
+// |NextCallSite|, which numbers recordings in the order they are started
+// within a frame. That order is stable whenever a frame records the same
+// pictures as the frame before it, which is the case the pool targets.
+//
+// The pool itself is not thread-safe and is expected to live on the UI
+// thread. The optional |DlStorageSlab| is thread-safe so that the
+// resulting DisplayLists may be released on any thread.
+class DisplayListBuilderPool {
+ public:
+  using CallSite = uint64_t;
+
+  // Upper bound on the number of call sites tracked at once. Call sites
+  // beyond this limit are still served, just without a size hint.
+  static constexpr size_t kMaxCallSites = 1024;
+
+  struct Stats {
+    // Number of builders handed out by |Acquire|.
+    size_t acquired = 0u;
+    // The subset of |acquired| builders that were reserved from a hint.
+    size_t presized = 0u;
+    // Total bytes of op storage reserved ahead of recording.
+    size_t reserved_bytes = 0u;
+  };
+
+  explicit DisplayListBuilderPool(
+      std::shared_ptr<DlStorageSlab> slab = nullptr);
+
+  ~DisplayListBuilderPool();
+
+  // Marks a frame boundary. The sizes recorded since the previous call
+  // become the hints for the coming frame and call sites that were not
+  // used during the frame that just ended are forgotten.
+  void BeginFrame();
+
+  // Returns a call site key derived from the order of recordings within
+  // the current frame.
+  CallSite NextCallSite() { return next_ordinal_++; }
+
+  // Creates a builder for |site| and reserves enough op storage for the
+  // largest DisplayList recorded for that site during the previous frame.
+  sk_sp<DisplayListBuilder> Acquire(CallSite site,
+                                    const SkRect& cull_rect,
+                                    bool prepare_rtree);
+
+  // Records the size of a DisplayList built from a builder obtained from
+  // |Acquire| for the same |site|.
+  void Record(CallSite site, const DisplayList& display_list);
+
+  // Returns the number of bytes a builder acquired for |site| right now
+  // would be pre-sized to, or 0 if there is no history for the site.
+  size_t GetSizeHint(CallSite site) const;
+
+  const std::shared_ptr<DlStorageSlab>& slab() const { return slab_; }
+
+  const Stats& stats() const { return stats_; }
+
+ private:
+  struct SiteHistory {
+    size_t previous_frame_bytes = 0u;
+    size_t current_frame_bytes = 0u;
+  };
+
+  const std::shared_ptr<DlStorageSlab> slab_;
+  std::unordered_map<CallSite, SiteHistory> sites_;
+  CallSite next_ordinal_ = 0u;
+  Stats stats_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListBuilderPool);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_BUILDER_POOL_H_
@@ -0,0 +1,108 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_builder_pool.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+uint32_t DisplayListBuilderTestingStorageAllocations(
+    DisplayListBuilder& builder) {
+  return builder.storage_allocation_count_;
+}
+
+namespace testing {
+
+static constexpr SkRect kCullRect = SkRect::MakeWH(100, 100);
+
+static void RecordRects(DisplayListBuilder& builder, int count) {
+  for (int i = 0; i < count; i++) {
+    builder.DrawRect(SkRect::MakeXYWH(i % 90, i % 90, 10, 10), DlPaint());
+  }
+}
+
+TEST(DisplayListBuilderPool, FirstFrameHasNoHint) {
+  DisplayListBuilderPool pool;
+  auto site = pool.NextCallSite();
+  EXPECT_EQ(pool.GetSizeHint(site), 0u);
+
+  auto builder = pool.Acquire(site, kCullRect, false);
+  EXPECT_EQ(pool.stats().acquired, 1u);
+  EXPECT_EQ(pool.stats().presized, 0u);
+  EXPECT_EQ(DisplayListBuilderTestingStorageAllocations(*builder), 0u);
+}
+
+TEST(DisplayListBuilderPool, SecondFrameIsPresized) {
+  DisplayListBuilderPool pool;
+
+  pool.BeginFrame();
+  auto site = pool.NextCallSite();
+  auto builder = pool.Acquire(site, kCullRect, false);
+  RecordRects(*builder, 1000);
+  EXPECT_GT(DisplayListBuilderTestingStorageAllocations(*builder), 1u);
+  auto display_list = builder->Build();
+  pool.Record(site, *display_list);
+
+  size_t bytes = display_list->bytes(false) - sizeof(DisplayList);
+  EXPECT_EQ(pool.GetSizeHint(site), bytes);
+
+  pool.BeginFrame();
+  auto next_site = pool.NextCallSite();
+  EXPECT_EQ(next_site, site);
+  EXPECT_EQ(pool.GetSizeHint(next_site), bytes);
+  auto next_builder = pool.Acquire(next_site, kCullRect, false);
+  EXPECT_EQ(pool.stats().presized, 1u);
+  EXPECT_EQ(pool.stats().reserved_bytes, bytes);
+  EXPECT_EQ(DisplayListBuilderTestingStorageAllocations(*next_builder), 1u);
+  RecordRects(*next_builder, 1000);
+  EXPECT_EQ(DisplayListBuilderTestingStorageAllocations(*next_builder), 1u);
+  auto next_display_list = next_builder->Build();
+  EXPECT_TRUE(next_display_list->Equals(display_list));
+}
+
+TEST(DisplayListBuilderPool, UnusedCallSitesAreForgotten) {
+  DisplayListBuilderPool pool;
+  auto site = pool.NextCallSite();
+  auto builder = pool.Acquire(site, kCullRect, false);
+  RecordRects(*builder, 10);
+  pool.Record(site, *builder->Build());
+
+  pool.BeginFrame();
+  EXPECT_GT(pool.GetSizeHint(site), 0u);
+  pool.BeginFrame();
+  EXPECT_EQ(pool.GetSizeHint(site), 0u);
+}
+
+TEST(DisplayListBuilderPool, HintIsHighWaterMarkOfSite) {
+  DisplayListBuilderPool pool;
+  DisplayListBuilderPool::CallSite site = 42u;
+
+  auto small = pool.Acquire(site, kCullRect, false);
+  RecordRects(*small, 10);
+  auto small_list = small->Build();
+  pool.Record(site, *small_list);
+
+  auto large = pool.Acquire(site, kCullRect, false);
+  RecordRects(*large, 100);
+  auto large_list = large->Build();
+  pool.Record(site, *large_list);
+
+  pool.BeginFrame();
+  EXPECT_EQ(pool.GetSizeHint(site),
+            large_list->bytes(false) - sizeof(DisplayList));
+}
+
+TEST(DisplayListBuilderPool, AcquiredBuildersUseSlab) {
+  auto slab = std::make_shared<DlStorageSlab>();
+  DisplayListBuilderPool pool(slab);
+  auto site = pool.NextCallSite();
+  auto builder = pool.Acquire(site, kCullRect, true);
+  RecordRects(*builder, 10);
+  auto display_list = builder->Build();
+  EXPECT_EQ(display_list->GetStorage().slab(), slab);
+  EXPECT_TRUE(display_list->has_rtree());
+}
+
+}  // namespace testing
+}  // namespace flutter
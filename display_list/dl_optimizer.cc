@@ -0,0 +1,836 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_optimizer.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_op_receiver.h"
+#include "flutter/display_list/utils/dl_matrix_clip_tracker.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// Returns true if rendering with the paint replaces every pixel it covers
+// regardless of what was rendered underneath it.
+bool PaintIsOpaque(const DlPaint& paint) {
+  if (paint.getMaskFilter() || paint.getImageFilter() ||
+      paint.getColorFilter() || paint.isInvertColors()) {
+    return false;
+  }
+  switch (paint.getBlendMode()) {
+    case DlBlendMode::kSrc:
+      return true;
+    case DlBlendMode::kSrcOver: {
+      if (!paint.getColor().isOpaque()) {
+        return false;
+      }
+      auto source = paint.getColorSource();
+      return !source || source->is_opaque();
+    }
+    default:
+      return false;
+  }
+}
+
+// The first pass over the DisplayList which numbers every op in the same
+// way that the builder numbered them for the RTree and records:
+// - which ops are rendering ops that could be removed if occluded,
+// - the root-level opaque ops and the area that they cover,
+// - which saveLayer ops can be folded into their content.
+class OptimizerAnalyzer final : public virtual DlOpReceiver {
+ public:
+  struct Occluder {
+    int op_index;
+    SkRect coverage;
+  };
+
+  explicit OptimizerAnalyzer(const DisplayListOptimizer::Options& options)
+      : options_(options), state_(DisplayListBuilder::kMaxCullRect) {}
+
+  int op_count() const { return index_; }
+
+  // Returns true if the op at the index is a rendering op that does not
+  // contribute to the output of any image filter.
+  bool is_cullable_op(int index) const {
+    return index >= 0 && index < index_ && cullable_ops_[index];
+  }
+
+  // Returns true if nothing between the op and the occluder reads back the
+  // pixels that the op rendered, which would be the case for a backdrop
+  // filter.
+  bool can_occlude(int op_index, int occluder_index) const {
+    auto barrier = std::upper_bound(backdrop_layers_.begin(),
+                                    backdrop_layers_.end(), op_index);
+    return barrier == backdrop_layers_.end() || *barrier > occluder_index;
+  }
+
+  const std::vector<Occluder>& occluders() const { return occluders_; }
+  const std::unordered_map<int, SkScalar>& foldable_layers() const {
+    return foldable_layers_;
+  }
+
+  void setAntiAlias(bool aa) override { Attribute().setAntiAlias(aa); }
+  void setDrawStyle(DlDrawStyle style) override {
+    Attribute().setDrawStyle(style);
+  }
+  void setColor(DlColor color) override { Attribute().setColor(color); }
+  void setStrokeWidth(float width) override {
+    Attribute().setStrokeWidth(width);
+  }
+  void setStrokeMiter(float limit) override {
+    Attribute().setStrokeMiter(limit);
+  }
+  void setStrokeCap(DlStrokeCap cap) override { Attribute().setStrokeCap(cap); }
+  void setStrokeJoin(DlStrokeJoin join) override {
+    Attribute().setStrokeJoin(join);
+  }
+  void setColorSource(const DlColorSource* source) override {
+    Attribute().setColorSource(source);
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    Attribute().setColorFilter(filter);
+  }
+  void setInvertColors(bool invert) override {
+    Attribute().setInvertColors(invert);
+  }
+  void setBlendMode(DlBlendMode mode) override {
+    Attribute().setBlendMode(mode);
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    Attribute().setMaskFilter(filter);
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    Attribute().setImageFilter(filter);
+  }
+
+  void save() override {
+    saves_.push_back({
+        .state = state_,
+        .clip_is_rect = clip_is_rect_,
+        .is_layer = false,
+    });
+    NonRender();
+  }
+  void saveLayer(const SkRect& bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    // The layer itself renders into its parent on restore.
+    CountContentRender(/*is_layer=*/true);
+    SaveInfo info = {
+        .state = state_,
+        .clip_is_rect = clip_is_rect_,
+        .is_layer = true,
+        .layer_index = index_,
+        .has_filter = options.renders_with_attributes() &&
+                      paint_.getImageFilter() != nullptr,
+    };
+    if (backdrop) {
+      backdrop_layers_.push_back(index_);
+    }
+    if (options_.fold_opacity_layers && !backdrop &&
+        options.can_distribute_opacity() && !options.content_is_clipped()) {
+      if (!options.renders_with_attributes()) {
+        info.fold_candidate = true;
+        info.fold_opacity = SK_Scalar1;
+      } else if (paint_.getBlendMode() == DlBlendMode::kSrcOver &&
+                 !paint_.getColorFilter() && !paint_.getImageFilter() &&
+                 !paint_.isInvertColors()) {
+        info.fold_candidate = true;
+        info.fold_opacity = paint_.getOpacity();
+      }
+    }
+    saves_.push_back(info);
+    layer_depth_++;
+    if (info.has_filter) {
+      filtered_layer_depth_++;
+    }
+    NonRender();
+  }
+  void restore() override {
+    if (!saves_.empty()) {
+      SaveInfo& info = saves_.back();
+      if (info.is_layer) {
+        layer_depth_--;
+        if (info.has_filter) {
+          filtered_layer_depth_--;
+        }
+        if (info.fold_candidate && info.content_renders == 1 &&
+            !info.has_nested_layer) {
+          foldable_layers_[info.layer_index] = info.fold_opacity;
+        }
+      }
+      state_ = info.state;
+      clip_is_rect_ = info.clip_is_rect;
+      saves_.pop_back();
+    }
+    NonRender();
+  }
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    state_.translate(tx, ty);
+    NonRender();
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    state_.scale(sx, sy);
+    NonRender();
+  }
+  void rotate(SkScalar degrees) override {
+    state_.rotate(degrees);
+    NonRender();
+  }
+  void skew(SkScalar sx, SkScalar sy) override {
+    state_.skew(sx, sy);
+    NonRender();
+  }
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    state_.transform2DAffine(mxx, mxy, mxt, myx, myy, myt);
+    NonRender();
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    state_.transformFullPerspective(mxx, mxy, mxz, mxt,
+                                    myx, myy, myz, myt,
+                                    mzx, mzy, mzz, mzt,
+                                    mwx, mwy, mwz, mwt);
+    NonRender();
+  }
+  // clang-format on
+  void transformReset() override {
+    state_.setIdentity();
+    NonRender();
+  }
+
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override {
+    // Only intersecting clips with an axis-aligned transform leave the
+    // tracked cull rect an exact description of the clip.
+    if (clip_op != ClipOp::kIntersect || !state_.matrix().IsAligned2D()) {
+      clip_is_rect_ = false;
+    }
+    state_.clipRect(rect, clip_op, is_aa);
+    NonRender();
+  }
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    clip_is_rect_ = false;
+    state_.clipRRect(rrect, clip_op, is_aa);
+    NonRender();
+  }
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override {
+    clip_is_rect_ = false;
+    state_.clipPath(path, clip_op, is_aa);
+    NonRender();
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    bool opaque = mode == DlBlendMode::kSrc ||
+                  (mode == DlBlendMode::kSrcOver && color.isOpaque());
+    if (opaque) {
+      Occlude(state_.device_cull_rect());
+    }
+    Render();
+  }
+  void drawPaint() override {
+    if (PaintIsOpaque(paint_)) {
+      Occlude(state_.device_cull_rect());
+    }
+    Render();
+  }
+  void drawRect(const SkRect& rect) override {
+    if (paint_.getDrawStyle() == DlDrawStyle::kFill && PaintIsOpaque(paint_)) {
+      SkRect coverage;
+      if (state_.mapRect(rect, &coverage) &&
+          coverage.intersect(state_.device_cull_rect())) {
+        Occlude(coverage);
+      }
+    }
+    Render();
+  }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override { Render(); }
+  void drawDashedLine(const DlPoint& p0,
+                      const DlPoint& p1,
+                      DlScalar on_length,
+                      DlScalar off_length) override {
+    Render();
+  }
+  void drawOval(const SkRect& bounds) override { Render(); }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    Render();
+  }
+  void drawRRect(const SkRRect& rrect) override { Render(); }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    Render();
+  }
+  void drawPath(const SkPath& path) override { Render(); }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    Render();
+  }
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    Render();
+  }
+  void drawVertices(const std::shared_ptr<DlVertices>& vertices,
+                    DlBlendMode mode) override {
+    Render();
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    Render();
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override {
+    Render();
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    Render();
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    Render();
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override {
+    Render();
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    Render();
+  }
+  void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                     SkScalar x,
+                     SkScalar y) override {
+    Render();
+  }
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    Render();
+  }
+
+ private:
+  struct SaveInfo {
+    DisplayListMatrixClipState state;
+    bool clip_is_rect = true;
+    bool is_layer = false;
+    int layer_index = -1;
+    bool has_filter = false;
+    bool fold_candidate = false;
+    SkScalar fold_opacity = SK_Scalar1;
+    int content_renders = 0;
+    bool has_nested_layer = false;
+  };
+
+  DlPaint& Attribute() {
+    NonRender();
+    return paint_;
+  }
+
+  void NonRender() {
+    cullable_ops_.push_back(false);
+    index_++;
+  }
+
+  void Render() {
+    CountContentRender(/*is_layer=*/false);
+    cullable_ops_.push_back(filtered_layer_depth_ == 0);
+    index_++;
+  }
+
+  void CountContentRender(bool is_layer) {
+    for (SaveInfo& info : saves_) {
+      if (info.is_layer) {
+        info.content_renders++;
+        info.has_nested_layer = info.has_nested_layer || is_layer;
+      }
+    }
+  }
+
+  void Occlude(const SkRect& coverage) {
+    if (options_.cull_occluded_ops && layer_depth_ == 0 && clip_is_rect_ &&
+        !coverage.isEmpty()) {
+      occluders_.push_back({index_, coverage});
+    }
+  }
+
+  const DisplayListOptimizer::Options options_;
+  DlPaint paint_;
+  DisplayListMatrixClipState state_;
+  bool clip_is_rect_ = true;
+  int layer_depth_ = 0;
+  int filtered_layer_depth_ = 0;
+  std::vector<SaveInfo> saves_;
+  int index_ = 0;
+  std::vector<bool> cullable_ops_;
+  std::vector<int> backdrop_layers_;
+  std::vector<Occluder> occluders_;
+  std::unordered_map<int, SkScalar> foldable_layers_;
+};
+
+// The second pass which re-records the DisplayList through the DlCanvas
+// interface of a new builder, skipping the ops that the analysis found to
+// be occluded and replacing foldable saveLayers with a save whose opacity
+// is applied to the content instead.
+class OptimizerRecorder final : public virtual DlOpReceiver {
+ public:
+  OptimizerRecorder(DisplayListBuilder& builder,
+                    const std::vector<bool>& culled_ops,
+                    const std::unordered_map<int, SkScalar>& foldable_layers)
+      : builder_(builder),
+        culled_ops_(culled_ops),
+        foldable_layers_(foldable_layers) {
+    opacity_stack_.push_back(SK_Scalar1);
+  }
+
+  void setAntiAlias(bool aa) override { Attribute().setAntiAlias(aa); }
+  void setDrawStyle(DlDrawStyle style) override {
+    Attribute().setDrawStyle(style);
+  }
+  void setColor(DlColor color) override { Attribute().setColor(color); }
+  void setStrokeWidth(float width) override {
+    Attribute().setStrokeWidth(width);
+  }
+  void setStrokeMiter(float limit) override {
+    Attribute().setStrokeMiter(limit);
+  }
+  void setStrokeCap(DlStrokeCap cap) override { Attribute().setStrokeCap(cap); }
+  void setStrokeJoin(DlStrokeJoin join) override {
+    Attribute().setStrokeJoin(join);
+  }
+  void setColorSource(const DlColorSource* source) override {
+    Attribute().setColorSource(source);
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    Attribute().setColorFilter(filter);
+  }
+  void setInvertColors(bool invert) override {
+    Attribute().setInvertColors(invert);
+  }
+  void setBlendMode(DlBlendMode mode) override {
+    Attribute().setBlendMode(mode);
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    Attribute().setMaskFilter(filter);
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    Attribute().setImageFilter(filter);
+  }
+
+  void save() override {
+    builder_.Save();
+    opacity_stack_.push_back(opacity());
+    index_++;
+  }
+  void saveLayer(const SkRect& bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    auto folded = foldable_layers_.find(index_);
+    if (folded != foldable_layers_.end()) {
+      builder_.Save();
+      opacity_stack_.push_back(opacity() * folded->second);
+    } else {
+      const SkRect* layer_bounds =
+          options.bounds_from_caller() ? &bounds : nullptr;
+      if (options.renders_with_attributes()) {
+        DlPaint layer_paint = paint();
+        builder_.SaveLayer(layer_bounds, &layer_paint, backdrop);
+      } else if (opacity() < SK_Scalar1) {
+        DlPaint layer_paint = DlPaint().setOpacity(opacity());
+        builder_.SaveLayer(layer_bounds, &layer_paint, backdrop);
+      } else {
+        builder_.SaveLayer(layer_bounds, nullptr, backdrop);
+      }
+      opacity_stack_.push_back(SK_Scalar1);
+    }
+    index_++;
+  }
+  void restore() override {
+    builder_.Restore();
+    if (opacity_stack_.size() > 1) {
+      opacity_stack_.pop_back();
+    }
+    index_++;
+  }
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    builder_.Translate(tx, ty);
+    index_++;
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    builder_.Scale(sx, sy);
+    index_++;
+  }
+  void rotate(SkScalar degrees) override {
+    builder_.Rotate(degrees);
+    index_++;
+  }
+  void skew(SkScalar sx, SkScalar sy) override {
+    builder_.Skew(sx, sy);
+    index_++;
+  }
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    builder_.Transform2DAffine(mxx, mxy, mxt, myx, myy, myt);
+    index_++;
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    builder_.TransformFullPerspective(mxx, mxy, mxz, mxt,
+                                      myx, myy, myz, myt,
+                                      mzx, mzy, mzz, mzt,
+                                      mwx, mwy, mwz, mwt);
+    index_++;
+  }
+  // clang-format on
+  void transformReset() override {
+    builder_.TransformReset();
+    index_++;
+  }
+
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override {
+    builder_.ClipRect(rect, clip_op, is_aa);
+    index_++;
+  }
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    builder_.ClipRRect(rrect, clip_op, is_aa);
+    index_++;
+  }
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override {
+    builder_.ClipPath(path, clip_op, is_aa);
+    index_++;
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    if (Keep()) {
+      builder_.DrawColor(color.modulateOpacity(opacity()), mode);
+    }
+  }
+  void drawPaint() override {
+    if (Keep()) {
+      builder_.DrawPaint(paint());
+    }
+  }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    if (Keep()) {
+      builder_.DrawLine(p0, p1, paint());
+    }
+  }
+  void drawDashedLine(const DlPoint& p0,
+                      const DlPoint& p1,
+                      DlScalar on_length,
+                      DlScalar off_length) override {
+    if (Keep()) {
+      builder_.DrawDashedLine(p0, p1, on_length, off_length, paint());
+    }
+  }
+  void drawRect(const SkRect& rect) override {
+    if (Keep()) {
+      builder_.DrawRect(rect, paint());
+    }
+  }
+  void drawOval(const SkRect& bounds) override {
+    if (Keep()) {
+      builder_.DrawOval(bounds, paint());
+    }
+  }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    if (Keep()) {
+      builder_.DrawCircle(center, radius, paint());
+    }
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    if (Keep()) {
+      builder_.DrawRRect(rrect, paint());
+    }
+  }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    if (Keep()) {
+      builder_.DrawDRRect(outer, inner, paint());
+    }
+  }
+  void drawPath(const SkPath& path) override {
+    if (Keep()) {
+      builder_.DrawPath(path, paint());
+    }
+  }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    if (Keep()) {
+      builder_.DrawArc(oval_bounds, start_degrees, sweep_degrees, use_center,
+                       paint());
+    }
+  }
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    if (Keep()) {
+      builder_.DrawPoints(mode, count, points, paint());
+    }
+  }
+  void drawVertices(const std::shared_ptr<DlVertices>& vertices,
+                    DlBlendMode mode) override {
+    if (Keep()) {
+      builder_.DrawVertices(vertices, mode, paint());
+    }
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    if (Keep()) {
+      DlPaint image_paint;
+      builder_.DrawImage(image, point, sampling,
+                         ImagePaint(render_with_attributes, image_paint));
+    }
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override {
+    if (Keep()) {
+      DlPaint image_paint;
+      builder_.DrawImageRect(image, src, dst, sampling,
+                             ImagePaint(render_with_attributes, image_paint),
+                             constraint);
+    }
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    if (Keep()) {
+      DlPaint image_paint;
+      builder_.DrawImageNine(image, center, dst, filter,
+                             ImagePaint(render_with_attributes, image_paint));
+    }
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    if (Keep()) {
+      DlPaint atlas_paint;
+      builder_.DrawAtlas(atlas, xform, tex, colors, count, mode, sampling,
+                         cull_rect,
+                         ImagePaint(render_with_attributes, atlas_paint));
+    }
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override {
+    if (Keep()) {
+      builder_.DrawDisplayList(display_list, opacity * this->opacity());
+    }
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    if (Keep()) {
+      builder_.DrawTextBlob(blob, x, y, paint());
+    }
+  }
+  void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                     SkScalar x,
+                     SkScalar y) override {
+    if (Keep()) {
+      builder_.DrawTextFrame(text_frame, x, y, paint());
+    }
+  }
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    if (Keep()) {
+      builder_.DrawShadow(path, color.modulateOpacity(opacity()), elevation,
+                          transparent_occluder, dpr);
+    }
+  }
+
+ private:
+  DlPaint& Attribute() {
+    index_++;
+    return paint_;
+  }
+
+  // Returns true if the rendering op at the current index should be
+  // recorded and advances the index.
+  bool Keep() {
+    int index = index_++;
+    return !culled_ops_[index];
+  }
+
+  SkScalar opacity() const { return opacity_stack_.back(); }
+
+  DlPaint paint() const {
+    if (opacity() < SK_Scalar1) {
+      DlPaint paint = paint_;
+      return paint.setOpacity(paint.getOpacity() * opacity());
+    }
+    return paint_;
+  }
+
+  const DlPaint* ImagePaint(bool render_with_attributes, DlPaint& storage) {
+    if (render_with_attributes) {
+      storage = paint();
+      return &storage;
+    }
+    if (opacity() < SK_Scalar1) {
+      storage.setOpacity(opacity());
+      return &storage;
+    }
+    return nullptr;
+  }
+
+  DisplayListBuilder& builder_;
+  const std::vector<bool>& culled_ops_;
+  const std::unordered_map<int, SkScalar>& foldable_layers_;
+  DlPaint paint_;
+  std::vector<SkScalar> opacity_stack_;
+  int index_ = 0;
+};
+
+}  // namespace
+
+DisplayListOptimizer::Result DisplayListOptimizer::Optimize(
+    const sk_sp<DisplayList>& display_list) {
+  return Optimize(display_list, Options());
+}
+
+DisplayListOptimizer::Result DisplayListOptimizer::Optimize(
+    const sk_sp<DisplayList>& display_list,
+    const Options& options) {
+  TRACE_EVENT0("flutter", "DisplayListOptimizer::Optimize");
+  Result result;
+  result.display_list = display_list;
+  if (!display_list) {
+    return result;
+  }
+
+  OptimizerAnalyzer analyzer(options);
+  display_list->Dispatch(analyzer);
+  result.ops_before = result.ops_after = analyzer.op_count();
+
+  std::vector<bool> culled_ops(analyzer.op_count(), false);
+  const auto& occluders = analyzer.occluders();
+  if (!occluders.empty()) {
+    if (display_list->has_rtree()) {
+      const DlRTree* rtree = display_list->rtree().get();
+      // An op that was a DrawDisplayList will have forwarded all of the
+      // child's rects with the same index, so first gather the union of
+      // the rects for every op.
+      std::unordered_map<int, SkRect> op_bounds;
+      for (int i = 0; i < rtree->leaf_count(); i++) {
+        int id = rtree->id(i);
+        if (analyzer.is_cullable_op(id)) {
+          op_bounds[id].join(rtree->bounds(i));
+        }
+      }
+      std::vector<int> hits;
+      for (const auto& occluder : occluders) {
+        hits.clear();
+        rtree->search(occluder.coverage, &hits);
+        for (int hit : hits) {
+          int id = rtree->id(hit);
+          if (id < occluder.op_index && !culled_ops[id] &&
+              analyzer.is_cullable_op(id) &&
+              analyzer.can_occlude(id, occluder.op_index) &&
+              occluder.coverage.contains(op_bounds[id])) {
+            culled_ops[id] = true;
+            result.culled_ops++;
+          }
+        }
+      }
+    } else {
+      // Without an RTree we only know the bounds of the entire list so
+      // we can only cull everything rendered before an op that covers
+      // all of it.
+      int cull_before = -1;
+      for (const auto& occluder : occluders) {
+        if (occluder.coverage.contains(display_list->bounds())) {
+          cull_before = occluder.op_index;
+        }
+      }
+      for (int i = 0; i < cull_before; i++) {
+        if (analyzer.is_cullable_op(i) &&
+            analyzer.can_occlude(i, cull_before)) {
+          culled_ops[i] = true;
+          result.culled_ops++;
+        }
+      }
+    }
+  }
+
+  result.folded_layers = analyzer.foldable_layers().size();
+  if (result.culled_ops == 0u && result.folded_layers == 0u) {
+    // The re-recording would still remove any redundant attribute ops,
+    // but that alone is rarely worth a new copy of the list.
+    return result;
+  }
+
+  DisplayListBuilder builder(display_list->has_rtree());
+  OptimizerRecorder recorder(builder, culled_ops, analyzer.foldable_layers());
+  display_list->Dispatch(recorder);
+  sk_sp<DisplayList> optimized = builder.Build();
+
+  OptimizerAnalyzer counter(Options{
+      .cull_occluded_ops = false,
+      .fold_opacity_layers = false,
+  });
+  optimized->Dispatch(counter);
+  result.ops_after = counter.op_count();
+  result.display_list = std::move(optimized);
+
+  TRACE_EVENT_INSTANT2("flutter", "DisplayListOptimizer result",  //
+                       "ops_removed", result.ops_removed(),           //
+                       "culled_ops", result.culled_ops);
+  return result;
+}
+
+}  // namespace flutter
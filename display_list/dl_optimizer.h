@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_OPTIMIZER_H_
+#define FLUTTER_DISPLAY_LIST_DL_OPTIMIZER_H_
+
+#include "flutter/display_list/display_list.h"
+
+namespace flutter {
+
+// Rewrites a DisplayList into an equivalent one that is cheaper to
+// dispatch.
+//
+// The DisplayListBuilder records operations exactly as they are issued
+// which is the right tradeoff for pictures that are rendered once. Pictures
+// that are retained and rendered over many frames can amortize a more
+// thorough analysis, which this class provides as an explicit, optional
+// pass. The following rewrites are performed:
+//
+// - Occlusion culling: rendering ops whose bounds (as recorded in the
+//   DlRTree, or the overall DisplayList bounds if there is no RTree) are
+//   entirely covered by a later opaque drawPaint, drawColor or axis-aligned
+//   filled drawRect at the root layer are removed. Ops that feed an image
+//   filter, or whose pixels may be read by a backdrop filter before they
+//   are covered, are never removed.
+// - Opacity folding: a saveLayer whose only attribute is an opacity and
+//   whose content consists of a single rendering op that can accept that
+//   opacity (as determined by the builder's SaveLayerOptions) is replaced
+//   by a save and the opacity is folded into the op's own paint.
+// - Redundant attributes: the list is re-recorded through the DlCanvas
+//   interface of a new DisplayListBuilder which only records attribute
+//   changes that are actually consumed by a subsequent op, according to
+//   its DlOpFlags.
+//
+// All rewrites preserve the rendered output up to the rounding of folded
+// alpha values, which matches what the dispatchers already do when they
+// distribute a group opacity.
+class DisplayListOptimizer {
+ public:
+  struct Options {
+    bool cull_occluded_ops = true;
+    bool fold_opacity_layers = true;
+  };
+
+  struct Result {
+    // The optimized DisplayList, or the original DisplayList if none of the
+    // rewrites applied.
+    sk_sp<DisplayList> display_list;
+
+    // Total number of recorded ops, including attribute, transform, clip
+    // and save/restore ops, before and after optimization.
+    uint32_t ops_before = 0u;
+    uint32_t ops_after = 0u;
+
+    // Number of rendering ops removed because they were occluded.
+    uint32_t culled_ops = 0u;
+
+    // Number of saveLayer ops folded into their content.
+    uint32_t folded_layers = 0u;
+
+    uint32_t ops_removed() const {
+      return ops_before > ops_after ? ops_before - ops_after : 0u;
+    }
+  };
+
+  static Result Optimize(const sk_sp<DisplayList>& display_list);
+  static Result Optimize(const sk_sp<DisplayList>& display_list,
+                         const Options& options);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_OPTIMIZER_H_
@@ -0,0 +1,193 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_optimizer.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/effects/dl_image_filter.h"
+#include "flutter/testing/display_list_testing.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static constexpr SkRect kBackground = SkRect::MakeLTRB(0, 0, 100, 100);
+static constexpr SkRect kContent = SkRect::MakeLTRB(10, 10, 20, 20);
+static constexpr SkRect kOtherContent = SkRect::MakeLTRB(30, 30, 40, 40);
+
+TEST(DisplayListOptimizer, UnchangedListIsReturnedAsIs) {
+  DisplayListBuilder builder(true);
+  builder.DrawRect(kContent, DlPaint(DlColor::kRed()));
+  builder.DrawRect(kOtherContent, DlPaint(DlColor::kGreen()));
+  auto display_list = builder.Build();
+
+  auto result = DisplayListOptimizer::Optimize(display_list);
+  EXPECT_EQ(result.display_list, display_list);
+  EXPECT_EQ(result.ops_removed(), 0u);
+  EXPECT_EQ(result.culled_ops, 0u);
+  EXPECT_EQ(result.folded_layers, 0u);
+}
+
+TEST(DisplayListOptimizer, CullsOpsCoveredByOpaqueRectWithRTree) {
+  DisplayListBuilder builder(true);
+  builder.DrawRect(kContent, DlPaint(DlColor::kRed()));
+  builder.DrawRect(kBackground, DlPaint(DlColor::kBlue()));
+  builder.DrawRect(kOtherContent, DlPaint(DlColor::kGreen()));
+  auto display_list = builder.Build();
+
+  DisplayListBuilder expected_builder(true);
+  expected_builder.DrawRect(kBackground, DlPaint(DlColor::kBlue()));
+  expected_builder.DrawRect(kOtherContent, DlPaint(DlColor::kGreen()));
+  auto expected = expected_builder.Build();
+
+  auto result = DisplayListOptimizer::Optimize(display_list);
+  EXPECT_EQ(result.culled_ops, 1u);
+  EXPECT_GT(result.ops_removed(), 0u);
+  EXPECT_TRUE(DisplayListsEQ_Verbose(result.display_list, expected));
+  EXPECT_TRUE(result.display_list->has_rtree());
+}
+
+TEST(DisplayListOptimizer, CullsOpsCoveredByOpaquePaintWithoutRTree) {
+  DisplayListBuilder builder(false);
+  builder.DrawRect(kContent, DlPaint(DlColor::kRed()));
+  builder.DrawPaint(DlPaint(DlColor::kBlue()));
+  auto display_list = builder.Build();
+
+  DisplayListBuilder expected_builder(false);
+  expected_builder.DrawPaint(DlPaint(DlColor::kBlue()));
+  auto expected = expected_builder.Build();
+
+  auto result = DisplayListOptimizer::Optimize(display_list);
+  EXPECT_EQ(result.culled_ops, 1u);
+  EXPECT_TRUE(DisplayListsEQ_Verbose(result.display_list, expected));
+}
+
+TEST(DisplayListOptimizer, TranslucentOpsDoNotOcclude) {
+  DisplayListBuilder builder(true);
+  builder.DrawRect(kContent, DlPaint(DlColor::kRed()));
+  builder.DrawRect(kBackground, DlPaint(DlColor::kBlue().withAlpha(0x7f)));
+  builder.DrawColor(DlColor::kGreen().withAlpha(0x7f), DlBlendMode::kSrcOver);
+  builder.DrawRect(kBackground, DlPaint(DlColor::kBlue())
+                                    .setDrawStyle(DlDrawStyle::kStroke));
+  auto display_list = builder.Build();
+
+  auto result = DisplayListOptimizer::Optimize(display_list);
+  EXPECT_EQ(result.culled_ops, 0u);
+  EXPECT_EQ(result.display_list, display_list);
+}
+
+TEST(DisplayListOptimizer, NonRectClipPreventsOcclusion) {
+  DisplayListBuilder builder(true);
+  builder.DrawRect(kContent, DlPaint(DlColor::kRed()));
+  builder.Save();
+  builder.ClipRRect(SkRRect::MakeRectXY(kBackground, 10, 10));
+  builder.DrawPaint(DlPaint(DlColor::kBlue()));
+  builder.Restore();
+  auto display_list = builder.Build();
+
+  auto result = DisplayListOptimizer::Optimize(display_list);
+  EXPECT_EQ(result.culled_ops, 0u);
+}
+
+TEST(DisplayListOptimizer, OccluderInsideLayerIsIgnored) {
+  DisplayListBuilder builder(true);
+  builder.DrawRect(kContent, DlPaint(DlColor::kRed()));
+  DlPaint layer_paint;
+  layer_paint.setBlendMode(DlBlendMode::kMultiply);
+  builder.SaveLayer(nullptr, &layer_paint);
+  builder.DrawRect(kBackground, DlPaint(DlColor::kBlue()));
+  builder.Restore();
+  auto display_list = builder.Build();
+
+  auto result = DisplayListOptimizer::Optimize(display_list);
+  EXPECT_EQ(result.culled_ops, 0u);
+}
+
+TEST(DisplayListOptimizer, BackdropFilterPreventsOcclusion) {
+  auto blur = DlBlurImageFilter::Make(5, 5, DlTileMode::kClamp);
+  DisplayListBuilder builder(true);
+  builder.DrawRect(kContent, DlPaint(DlColor::kRed()));
+  builder.SaveLayer(&kOtherContent, nullptr, blur.get());
+  builder.Restore();
+  builder.DrawRect(kBackground, DlPaint(DlColor::kBlue()));
+  auto display_list = builder.Build();
+
+  auto result = DisplayListOptimizer::Optimize(display_list);
+  EXPECT_EQ(result.culled_ops, 0u);
+}
+
+TEST(DisplayListOptimizer, ImageFilteredContentIsNotCulled) {
+  auto blur = DlBlurImageFilter::Make(5, 5, DlTileMode::kDecal);
+  DisplayListBuilder builder(true);
+  DlPaint layer_paint;
+  layer_paint.setImageFilter(blur);
+  builder.SaveLayer(nullptr, &layer_paint);
+  builder.DrawRect(kContent, DlPaint(DlColor::kRed()));
+  builder.Restore();
+  builder.DrawRect(kBackground, DlPaint(DlColor::kBlue()));
+  auto display_list = builder.Build();
+
+  // The blurred layer is entirely covered, but its content is not
+  // individually removable so the layer survives.
+  auto result = DisplayListOptimizer::Optimize(display_list);
+  EXPECT_EQ(result.culled_ops, 0u);
+}
+
+TEST(DisplayListOptimizer, FoldsOpacityLayerWithSingleOp) {
+  DisplayListBuilder builder(true);
+  DlPaint layer_paint = DlPaint().setOpacity(0.5f);
+  builder.SaveLayer(&kBackground, &layer_paint);
+  builder.DrawRect(kContent, DlPaint(DlColor::kRed()));
+  builder.Restore();
+  auto display_list = builder.Build();
+
+  DisplayListBuilder expected_builder(true);
+  expected_builder.Save();
+  expected_builder.DrawRect(kContent,
+                            DlPaint(DlColor::kRed()).setOpacity(0.5f));
+  expected_builder.Restore();
+  auto expected = expected_builder.Build();
+
+  auto result = DisplayListOptimizer::Optimize(display_list);
+  EXPECT_EQ(result.folded_layers, 1u);
+  EXPECT_TRUE(DisplayListsEQ_Verbose(result.display_list, expected));
+}
+
+TEST(DisplayListOptimizer, DoesNotFoldLayerWithOverlappingOps) {
+  DisplayListBuilder builder(true);
+  DlPaint layer_paint = DlPaint().setOpacity(0.5f);
+  builder.SaveLayer(&kBackground, &layer_paint);
+  builder.DrawRect(kContent, DlPaint(DlColor::kRed()));
+  builder.DrawRect(kContent.makeOffset(5, 5), DlPaint(DlColor::kGreen()));
+  builder.Restore();
+  auto display_list = builder.Build();
+
+  auto result = DisplayListOptimizer::Optimize(display_list);
+  EXPECT_EQ(result.folded_layers, 0u);
+  EXPECT_EQ(result.display_list, display_list);
+}
+
+TEST(DisplayListOptimizer, OptionsDisableRewrites) {
+  DisplayListBuilder builder(true);
+  builder.DrawRect(kContent, DlPaint(DlColor::kRed()));
+  DlPaint layer_paint = DlPaint().setOpacity(0.5f);
+  builder.SaveLayer(&kBackground, &layer_paint);
+  builder.DrawRect(kBackground, DlPaint(DlColor::kBlue()));
+  builder.Restore();
+  builder.DrawRect(kBackground, DlPaint(DlColor::kBlue()));
+  auto display_list = builder.Build();
+
+  DisplayListOptimizer::Options options = {
+      .cull_occluded_ops = false,
+      .fold_opacity_layers = false,
+  };
+  auto result = DisplayListOptimizer::Optimize(display_list, options);
+  EXPECT_EQ(result.display_list, display_list);
+
+  result = DisplayListOptimizer::Optimize(display_list);
+  EXPECT_EQ(result.culled_ops, 2u);
+  EXPECT_EQ(result.folded_layers, 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
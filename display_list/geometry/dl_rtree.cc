@@ -5,10 +5,27 @@
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/display_list/geometry/dl_region.h"
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
 #include "flutter/fml/logging.h"
 
+// GCC and Clang vector extensions let the compiler emit the SIMD
+// instructions for the target (SSE, AVX, NEON) for the child tests.
+#if defined(__clang__) || defined(__GNUC__)
+#define DL_RTREE_VECTOR_LANES 1
+#endif
+
 namespace flutter {
 
+namespace {
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+}  // namespace
+
 DlRTree::DlRTree(const SkRect rects[],
                  int N,
                  const int ids[],
@@ -34,28 +51,30 @@ DlRTree::DlRTree(const SkRect rects[],
   }
   leaf_count_ = leaf_count;
 
-  // Count the total number of nodes (leaf and internal) up front
-  // so we can resize the vector just once.
-  uint32_t total_node_count = leaf_count;
+  // Count the number of internal nodes up front so we can resize the
+  // vector just once.
+  uint32_t branch_count = 0;
   uint32_t gen_count = leaf_count;
   while (gen_count > 1) {
     uint32_t family_count = (gen_count + kMaxChildren - 1u) / kMaxChildren;
-    total_node_count += family_count;
+    branch_count += family_count;
     gen_count = family_count;
   }
 
-  nodes_.resize(total_node_count);
+  leaf_bounds_.resize(leaf_count);
+  leaf_ids_.resize(leaf_count);
+  branches_.resize(branch_count);
 
-  // Now place only the tracked rectangles into the nodes array
-  // in the first leaf_count_ entries.
+  // Now place only the tracked rectangles into the leaf arrays.
   int leaf_index = 0;
   int id = invalid_id;
   for (int i = 0; i < N; i++) {
     if (!rects[i].isEmpty()) {
       if (ids == nullptr || p(id = ids[i])) {
-        Node& node = nodes_[leaf_index++];
-        node.bounds = rects[i];
-        node.id = id;
+        leaf_bounds_[leaf_index] = rects[i];
+        leaf_ids_[leaf_index] = id;
+        bounds_.join(rects[i]);
+        leaf_index++;
       }
     }
   }
@@ -81,18 +100,21 @@ DlRTree::DlRTree(const SkRect rects[],
 
   // Continually process the previous level (generation) of nodes,
   // combining them into a new generation of parent groups each grouping
-  // at most |kMaxChildren| children and joining their bounds into its
-  // parent bounds.
+  // at most |kMaxChildren| children and copying their bounds into the
+  // child lanes of the parent. The first generation groups the leaf
+  // nodes, each subsequent generation groups the branches of the one
+  // before it.
   // Each generation will end up reduced by a factor of up to kMaxChildren
   // until there is just one node left, which is the root node of
   // the R-Tree.
   uint32_t gen_start = 0;
+  uint32_t gen_end = leaf_count;
+  uint32_t parent_index = 0;
+  bool leaf_children = true;
   gen_count = leaf_count;
   while (gen_count > 1) {
-    uint32_t gen_end = gen_start + gen_count;
-
     uint32_t family_count = (gen_count + kMaxChildren - 1u) / kMaxChildren;
-    FML_DCHECK(gen_end + family_count <= total_node_count);
+    FML_DCHECK(parent_index + family_count <= branch_count);
 
     // D here is similar to the variable in a Bresenham line algorithm where
     // we want to slowly move |family_count| steps along the minor axis as
@@ -114,29 +136,89 @@ DlRTree::DlRTree(const SkRect rects[],
     // don't care about the distribution of the extra children.
     int D = 0;
 
+    const uint32_t family_end = parent_index + family_count;
     uint32_t sibling_index = gen_start;
-    uint32_t parent_index = gen_end;
-    Node* parent = nullptr;
+    Branch* parent = nullptr;
     while (sibling_index < gen_end) {
       if ((D += family_count) > 0) {
         D -= gen_count;
-        FML_DCHECK(parent_index < gen_end + family_count);
-        parent = &nodes_[parent_index++];
-        parent->bounds.setEmpty();
-        parent->child.index = sibling_index;
-        parent->child.count = 0;
+        FML_DCHECK(parent_index < family_end);
+        parent = &branches_[parent_index++];
+        std::fill(std::begin(parent->left), std::end(parent->left), kInfinity);
+        std::fill(std::begin(parent->top), std::end(parent->top), kInfinity);
+        std::fill(std::begin(parent->right), std::end(parent->right),
+                  -kInfinity);
+        std::fill(std::begin(parent->bottom), std::end(parent->bottom),
+                  -kInfinity);
+        parent->child_index = sibling_index;
+        parent->child_count = 0;
       }
       FML_DCHECK(parent != nullptr);
-      parent->bounds.join(nodes_[sibling_index++].bounds);
-      parent->child.count++;
+      FML_DCHECK(parent->child_count < kMaxChildren);
+      SkRect child_bounds = leaf_children ? leaf_bounds_[sibling_index]
+                                          : BranchBounds(sibling_index);
+      uint32_t lane = parent->child_count++;
+      parent->left[lane] = child_bounds.fLeft;
+      parent->top[lane] = child_bounds.fTop;
+      parent->right[lane] = child_bounds.fRight;
+      parent->bottom[lane] = child_bounds.fBottom;
+      sibling_index++;
     }
     FML_DCHECK(D == 0);
     FML_DCHECK(sibling_index == gen_end);
-    FML_DCHECK(parent_index == gen_end + family_count);
-    gen_start = gen_end;
+    FML_DCHECK(parent_index == family_end);
+    if (leaf_children) {
+      leaf_parent_count_ = family_count;
+      leaf_children = false;
+    }
+    gen_start = family_end - family_count;
+    gen_end = family_end;
     gen_count = family_count;
   }
-  FML_DCHECK(gen_start + gen_count == total_node_count);
+  FML_DCHECK(parent_index == branch_count);
+}
+
+SkRect DlRTree::BranchBounds(uint32_t branch_index) const {
+  const Branch& branch = branches_[branch_index];
+  SkRect bounds = SkRect::MakeEmpty();
+  for (uint32_t i = 0; i < branch.child_count; i++) {
+    bounds.join(SkRect::MakeLTRB(branch.left[i], branch.top[i],
+                                 branch.right[i], branch.bottom[i]));
+  }
+  return bounds;
+}
+
+uint32_t DlRTree::IntersectChildren(const Branch& branch,
+                                    const SkRect& query) {
+  // A child intersects the query if each of its edges is on the far side
+  // of the opposite edge of the query, which matches SkRect::intersects
+  // for the non-empty rects stored in the tree.
+#ifdef DL_RTREE_VECTOR_LANES
+  typedef float Lanes __attribute__((vector_size(sizeof(float) *
+                                                  kMaxChildren)));
+  Lanes left, top, right, bottom;
+  std::memcpy(&left, branch.left, sizeof(Lanes));
+  std::memcpy(&top, branch.top, sizeof(Lanes));
+  std::memcpy(&right, branch.right, sizeof(Lanes));
+  std::memcpy(&bottom, branch.bottom, sizeof(Lanes));
+  auto hits = (left < query.fRight) & (query.fLeft < right) &
+              (top < query.fBottom) & (query.fTop < bottom);
+  uint32_t mask = 0u;
+  for (int i = 0; i < kMaxChildren; i++) {
+    mask |= static_cast<uint32_t>(hits[i] & 1) << i;
+  }
+  return mask;
+#else
+  uint32_t mask = 0u;
+  for (int i = 0; i < kMaxChildren; i++) {
+    bool hit = branch.left[i] < query.fRight &&
+               query.fLeft < branch.right[i] &&
+               branch.top[i] < query.fBottom &&
+               query.fTop < branch.bottom[i];
+    mask |= static_cast<uint32_t>(hit) << i;
+  }
+  return mask;
+#endif  // DL_RTREE_VECTOR_LANES
 }
 
 void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
@@ -144,18 +226,46 @@ void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
   if (query.isEmpty()) {
     return;
   }
-  if (nodes_.size() <= 0) {
-    FML_DCHECK(leaf_count_ == 0);
+  if (leaf_count_ <= 0) {
+    FML_DCHECK(branches_.empty());
+    return;
+  }
+  if (!bounds_.intersects(query)) {
+    return;
+  }
+  if (branches_.empty()) {
+    FML_DCHECK(leaf_count_ == 1);
+    // The root node is the only node and it is a leaf node
+    results->push_back(0);
     return;
   }
-  const Node& root = nodes_.back();
-  if (root.bounds.intersects(query)) {
-    if (nodes_.size() == 1) {
-      FML_DCHECK(leaf_count_ == 1);
-      // The root node is the only node and it is a leaf node
-      results->push_back(0);
+
+  // Traverse the tree depth first with an explicit stack. Children are
+  // pushed in reverse order so that the hits are reported in the same
+  // order as the leaf nodes.
+  uint32_t stack[kMaxStackDepth];
+  int stack_size = 0;
+  stack[stack_size++] = branches_.size() - 1;
+  while (stack_size > 0) {
+    uint32_t branch_index = stack[--stack_size];
+    const Branch& branch = branches_[branch_index];
+    uint32_t hits = IntersectChildren(branch, query);
+    if (hits == 0u) {
+      continue;
+    }
+    if (branch_index < leaf_parent_count_) {
+      for (uint32_t i = 0; i < branch.child_count; i++) {
+        if (hits & (1u << i)) {
+          results->push_back(branch.child_index + i);
+        }
+      }
     } else {
-      search(root, query, results);
+      for (uint32_t i = branch.child_count; i-- > 0;) {
+        if (hits & (1u << i)) {
+          FML_DCHECK(stack_size < kMaxStackDepth);
+          stack[stack_size++] = branch.child_index + i;
+        }
+      }
     }
   }
 }
@@ -183,42 +293,16 @@ std::list<SkRect> DlRTree::searchAndConsolidateRects(const SkRect& query,
   return final_results;
 }
 
-void DlRTree::search(const Node& parent,
-                     const SkRect& query,
-                     std::vector<int>* results) const {
-  // Caller protects against empty query
-  int start = parent.child.index;
-  int end = start + parent.child.count;
-  for (int i = start; i < end; i++) {
-    const Node& node = nodes_[i];
-    if (node.bounds.intersects(query)) {
-      if (i < leaf_count_) {
-        results->push_back(i);
-      } else {
-        search(node, query, results);
-      }
-    }
-  }
-}
-
 const DlRegion& DlRTree::region() const {
   if (!region_) {
     std::vector<SkIRect> rects;
     rects.resize(leaf_count_);
     for (int i = 0; i < leaf_count_; i++) {
-      nodes_[i].bounds.roundOut(&rects[i]);
+      leaf_bounds_[i].roundOut(&rects[i]);
     }
     region_.emplace(rects);
   }
   return *region_;
 }
 
-const SkRect& DlRTree::bounds() const {
-  if (!nodes_.empty()) {
-    return nodes_.back().bounds;
-  } else {
-    return kEmpty;
-  }
-}
-
 }  // namespace flutter
@@ -28,19 +28,27 @@ namespace flutter {
 ///   @see |searchAndConsolidateRects|
 class DlRTree : public SkRefCnt {
  private:
-  static constexpr int kMaxChildren = 11;
-
-  // Leaf nodes at start of vector have an ID,
-  // Internal nodes after that have child index and count.
-  struct Node {
-    SkRect bounds;
-    union {
-      struct {
-        uint32_t index;
-        uint32_t count;
-      } child;
-      int id;
-    };
+  // The number of children grouped under each internal node. The child
+  // bounds of an internal node are stored as 4 arrays of this many floats
+  // so that they can all be tested against a query with a single vector
+  // comparison per edge.
+  static constexpr int kMaxChildren = 8;
+
+  // The maximum number of pending nodes during a search. Each level of
+  // the tree can leave at most kMaxChildren - 1 siblings on the stack and
+  // a tree of 2^31 leaves is at most 11 levels deep.
+  static constexpr int kMaxStackDepth = 11 * (kMaxChildren - 1) + 1;
+
+  // Internal nodes store the bounds of their children in a structure of
+  // arrays layout. Unused lanes hold an inverted (+inf, -inf) rect which
+  // never intersects a query.
+  struct Branch {
+    float left[kMaxChildren];
+    float top[kMaxChildren];
+    float right[kMaxChildren];
+    float bottom[kMaxChildren];
+    uint32_t child_index;
+    uint32_t child_count;
   };
 
  public:
@@ -84,25 +92,26 @@ class DlRTree : public SkRefCnt {
   /// invalid_id if the index is not a valid leaf node index.
   int id(int result_index) const {
     return (result_index >= 0 && result_index < leaf_count_)
-               ? nodes_[result_index].id
+               ? leaf_ids_[result_index]
                : invalid_id_;
   }
 
   /// Returns maximum and minimum axis values of rectangles in this R-Tree.
   /// If R-Tree is empty returns an empty SkRect.
-  const SkRect& bounds() const;
+  const SkRect& bounds() const { return bounds_; }
 
   /// Return the rectangle bounds for the indicated result of a query
   /// or an empty rect if the index is not a valid leaf node index.
   const SkRect& bounds(int result_index) const {
     return (result_index >= 0 && result_index < leaf_count_)
-               ? nodes_[result_index].bounds
+               ? leaf_bounds_[result_index]
                : kEmpty;
   }
 
   /// Returns the bytes used by the object and all of its node data.
   size_t bytes_used() const {
-    return sizeof(DlRTree) + sizeof(Node) * nodes_.size();
+    return sizeof(DlRTree) + sizeof(SkRect) * leaf_bounds_.size() +
+           sizeof(int) * leaf_ids_.size() + sizeof(Branch) * branches_.size();
   }
 
   /// Returns the number of leaf nodes corresponding to non-empty
@@ -112,7 +121,7 @@ class DlRTree : public SkRefCnt {
 
   /// Return the total number of nodes used in the R-Tree, both leaf
   /// and internal consolidation nodes.
-  int node_count() const { return nodes_.size(); }
+  int node_count() const { return leaf_count_ + branches_.size(); }
 
   /// Finds the rects in the tree that intersect with the query rect.
   ///
@@ -139,11 +148,22 @@ class DlRTree : public SkRefCnt {
  private:
   static constexpr SkRect kEmpty = SkRect::MakeEmpty();
 
-  void search(const Node& parent,
-              const SkRect& query,
-              std::vector<int>* results) const;
-
-  std::vector<Node> nodes_;
+  // Returns the union of the child bounds of the indicated branch.
+  SkRect BranchBounds(uint32_t branch_index) const;
+
+  // Returns a bit mask of the children of |branch| whose bounds intersect
+  // the (non-empty) query, with bit i corresponding to child i.
+  static uint32_t IntersectChildren(const Branch& branch, const SkRect& query);
+
+  // Leaf nodes, indexed by the result indices returned from |search|.
+  std::vector<SkRect> leaf_bounds_;
+  std::vector<int> leaf_ids_;
+  // Internal nodes, one generation after another, so that the root node
+  // is the last entry. The first |leaf_parent_count_| entries are the
+  // parents of the leaf nodes, all others are parents of other branches.
+  std::vector<Branch> branches_;
+  uint32_t leaf_parent_count_ = 0;
+  SkRect bounds_ = SkRect::MakeEmpty();
   int leaf_count_ = 0;
   int invalid_id_;
   mutable std::optional<DlRegion> region_;
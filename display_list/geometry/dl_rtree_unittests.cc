@@ -301,6 +301,56 @@ TEST(DisplayListRTree, OverlappingRects) {
   EXPECT_EQ(list.front(), SkRect::MakeLTRB(0, 0, 70, 70));
 }
 
+TEST(DisplayListRTree, SearchMatchesLinearScan) {
+  // Overlapping rects of varying size scattered over a large area so that
+  // the tree is several levels deep and queries hit partially filled
+  // branches. The results must match a linear scan, in the same order.
+  const int N = 5000;
+  std::vector<SkRect> rects(N);
+  std::vector<int> ids(N);
+  for (int i = 0; i < N; i++) {
+    SkScalar x = (i * 37) % 1000;
+    SkScalar y = (i * 91) % 1000;
+    rects[i] = SkRect::MakeXYWH(x, y, (i % 7) * 5, (i % 11) * 3);
+    ids[i] = i;
+  }
+  DlRTree tree(rects.data(), N, ids.data(), [](int id) { return id % 3 != 0; });
+  std::vector<int> results;
+  for (int q = 0; q < 100; q++) {
+    auto query = SkRect::MakeXYWH((q * 53) % 1000, (q * 29) % 1000,  //
+                                  (q % 10) * 20 + 1, (q % 13) * 15 + 1);
+    std::vector<int> expected_ids;
+    for (int i = 0; i < N; i++) {
+      if (!rects[i].isEmpty() && ids[i] % 3 != 0 &&
+          rects[i].intersects(query)) {
+        expected_ids.push_back(ids[i]);
+      }
+    }
+    results.clear();
+    tree.search(query, &results);
+    ASSERT_EQ(results.size(), expected_ids.size()) << "query " << q;
+    for (size_t i = 0; i < results.size(); i++) {
+      EXPECT_EQ(tree.id(results[i]), expected_ids[i]) << "query " << q;
+      EXPECT_TRUE(tree.bounds(results[i]).intersects(query)) << "query " << q;
+    }
+  }
+}
+
+TEST(DisplayListRTree, BoundsOfAllLeaves) {
+  SkRect rects[] = {
+      SkRect::MakeLTRB(10, 20, 30, 40),
+      SkRect::MakeEmpty(),
+      SkRect::MakeLTRB(-5, 25, 0, 60),
+  };
+  DlRTree tree(rects, 3);
+  EXPECT_EQ(tree.leaf_count(), 2);
+  EXPECT_EQ(tree.bounds(), SkRect::MakeLTRB(-5, 20, 30, 60));
+
+  DlRTree empty_tree(rects + 1, 1);
+  EXPECT_EQ(empty_tree.leaf_count(), 0);
+  EXPECT_EQ(empty_tree.bounds(), SkRect::MakeEmpty());
+}
+
 TEST(DisplayListRTree, Region) {
   SkRect rect[9];
   for (int i = 0; i < 9; i++) {
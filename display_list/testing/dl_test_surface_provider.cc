@@ -19,6 +19,9 @@
 #ifdef ENABLE_METAL_BENCHMARKS
 #include "flutter/display_list/testing/dl_test_surface_metal.h"
 #endif
+#ifdef ENABLE_VULKAN_BENCHMARKS
+#include "flutter/display_list/testing/dl_test_surface_vulkan.h"
+#endif
 
 namespace flutter {
 namespace testing {
@@ -31,6 +34,8 @@ std::string DlSurfaceProvider::BackendName(BackendType type) {
       return "OpenGL";
     case kSoftwareBackend:
       return "Software";
+    case kVulkanBackend:
+      return "Vulkan";
   }
 }
 
@@ -48,6 +53,10 @@ std::unique_ptr<DlSurfaceProvider> DlSurfaceProvider::Create(
 #ifdef ENABLE_METAL_BENCHMARKS
     case kMetalBackend:
       return std::make_unique<DlMetalSurfaceProvider>();
+#endif
+#ifdef ENABLE_VULKAN_BENCHMARKS
+    case kVulkanBackend:
+      return std::make_unique<DlVulkanSurfaceProvider>();
 #endif
     default:
       return nullptr;
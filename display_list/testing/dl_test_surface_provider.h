@@ -52,7 +52,12 @@ class DlSurfaceInstanceBase : public DlSurfaceInstance {
 class DlSurfaceProvider {
  public:
   typedef enum { kN32PremulPixelFormat, k565PixelFormat } PixelFormat;
-  typedef enum { kSoftwareBackend, kOpenGlBackend, kMetalBackend } BackendType;
+  typedef enum {
+    kSoftwareBackend,
+    kOpenGlBackend,
+    kMetalBackend,
+    kVulkanBackend,
+  } BackendType;
 
   static SkImageInfo MakeInfo(PixelFormat format, int w, int h) {
     switch (format) {
@@ -0,0 +1,45 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/testing/dl_test_surface_vulkan.h"
+
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
+
+namespace flutter {
+namespace testing {
+
+using PixelFormat = DlSurfaceProvider::PixelFormat;
+
+bool DlVulkanSurfaceProvider::InitializeSurface(size_t width,
+                                                size_t height,
+                                                PixelFormat format) {
+  context_ = fml::MakeRefCounted<TestVulkanContext>();
+  if (!context_->GetGrDirectContext()) {
+    return false;
+  }
+
+  primary_ = MakeOffscreenSurface(width, height, format);
+  return primary_ != nullptr;
+}
+
+std::shared_ptr<DlSurfaceInstance>
+DlVulkanSurfaceProvider::MakeOffscreenSurface(size_t width,
+                                              size_t height,
+                                              PixelFormat format) const {
+  auto offscreen_surface = SkSurfaces::RenderTarget(
+      context_->GetGrDirectContext().get(), skgpu::Budgeted::kNo,
+      MakeInfo(format, width, height), 1, kTopLeft_GrSurfaceOrigin, nullptr,
+      false);
+  if (!offscreen_surface) {
+    return nullptr;
+  }
+
+  offscreen_surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+  return std::make_shared<DlSurfaceInstanceBase>(offscreen_surface);
+}
+
+}  // namespace testing
+}  // namespace flutter
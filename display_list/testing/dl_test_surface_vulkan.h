@@ -0,0 +1,46 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_TESTING_DL_TEST_SURFACE_VULKAN_H_
+#define FLUTTER_DISPLAY_LIST_TESTING_DL_TEST_SURFACE_VULKAN_H_
+
+#include "flutter/display_list/testing/dl_test_surface_provider.h"
+
+#include "flutter/testing/test_vulkan_context.h"
+
+namespace flutter {
+namespace testing {
+
+// Renders with Skia's Vulkan backend on the SwiftShader ICD, or the system
+// Vulkan loader if SwiftShader is not available.
+class DlVulkanSurfaceProvider : public DlSurfaceProvider {
+ public:
+  DlVulkanSurfaceProvider() : DlSurfaceProvider() {}
+  virtual ~DlVulkanSurfaceProvider() = default;
+
+  bool InitializeSurface(size_t width,
+                         size_t height,
+                         PixelFormat format) override;
+  std::shared_ptr<DlSurfaceInstance> GetPrimarySurface() const override {
+    return primary_;
+  }
+  std::shared_ptr<DlSurfaceInstance> MakeOffscreenSurface(
+      size_t width,
+      size_t height,
+      PixelFormat format) const override;
+  const std::string backend_name() const override { return "Vulkan"; }
+  BackendType backend_type() const override { return kVulkanBackend; }
+  bool supports(PixelFormat format) const override {
+    return format == kN32PremulPixelFormat;
+  }
+
+ private:
+  std::shared_ptr<DlSurfaceInstance> primary_;
+  fml::RefPtr<TestVulkanContext> context_;
+};
+
+}  // namespace testing
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_TESTING_DL_TEST_SURFACE_VULKAN_H_
@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/utils/dl_storage_slab.h"
+
+#include <cstdlib>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+DlStorageSlab::DlStorageSlab(size_t max_cached_bytes)
+    : max_cached_bytes_(max_cached_bytes) {}
+
+DlStorageSlab::~DlStorageSlab() {
+  Purge();
+}
+
+size_t DlStorageSlab::ClassIndexForSize(size_t size) {
+  size_t index = 0;
+  while (index < kClassCount && ClassSize(index) < size) {
+    index++;
+  }
+  return index;
+}
+
+uint8_t* DlStorageSlab::Allocate(size_t size, size_t* capacity) {
+  FML_DCHECK(capacity != nullptr);
+  size_t index = ClassIndexForSize(size);
+  if (index >= kClassCount) {
+    // Oversized blocks bypass the free lists entirely.
+    auto block = static_cast<uint8_t*>(std::malloc(size));
+    FML_CHECK(block);
+    *capacity = size;
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.allocations++;
+    return block;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.allocations++;
+    auto& free_list = free_lists_[index];
+    if (!free_list.empty()) {
+      uint8_t* block = free_list.back();
+      free_list.pop_back();
+      stats_.reused++;
+      stats_.cached_bytes -= ClassSize(index);
+      *capacity = ClassSize(index);
+      return block;
+    }
+  }
+  auto block = static_cast<uint8_t*>(std::malloc(ClassSize(index)));
+  FML_CHECK(block);
+  *capacity = ClassSize(index);
+  return block;
+}
+
+void DlStorageSlab::Free(uint8_t* block, size_t capacity) {
+  if (block == nullptr) {
+    return;
+  }
+  size_t index = ClassIndexForSize(capacity);
+  if (index < kClassCount) {
+    FML_DCHECK(ClassSize(index) == capacity);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stats_.cached_bytes + capacity <= max_cached_bytes_) {
+      free_lists_[index].push_back(block);
+      stats_.cached_bytes += capacity;
+      return;
+    }
+  }
+  std::free(block);
+}
+
+void DlStorageSlab::Purge() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& free_list : free_lists_) {
+    for (uint8_t* block : free_list) {
+      std::free(block);
+    }
+    free_list.clear();
+  }
+  stats_.cached_bytes = 0u;
+}
+
+DlStorageSlab::Stats DlStorageSlab::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+}  // namespace flutter
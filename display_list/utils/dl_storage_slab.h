@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_UTILS_DL_STORAGE_SLAB_H_
+#define FLUTTER_DISPLAY_LIST_UTILS_DL_STORAGE_SLAB_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+// A cache of op storage blocks shared between DisplayListBuilder objects
+// and the DisplayList objects they produce.
+//
+// Blocks are handed out in power-of-two size classes from |kMinBlockSize|
+// to |kMaxBlockSize|. When a DisplayList is disposed its block is returned
+// to the free list for its size class, up to |max_cached_bytes| in total,
+// so that the builders recording the next frame can pick it back up
+// without going through malloc, realloc and the page faults of fresh
+// memory. Requests larger than |kMaxBlockSize| are passed through to
+// malloc and are never cached.
+//
+// DisplayList objects are often released on a different thread than the
+// one that recorded them, so all methods are thread-safe.
+class DlStorageSlab {
+ public:
+  static constexpr size_t kMinBlockSize = 4096;
+  static constexpr size_t kMaxBlockSize = 4 * 1024 * 1024;
+  static constexpr size_t kDefaultMaxCachedBytes = 16 * 1024 * 1024;
+
+  struct Stats {
+    // Total number of blocks handed out by |Allocate|.
+    size_t allocations = 0u;
+    // The subset of |allocations| that were satisfied from a free list.
+    size_t reused = 0u;
+    // The number of bytes currently held in the free lists.
+    size_t cached_bytes = 0u;
+  };
+
+  explicit DlStorageSlab(size_t max_cached_bytes = kDefaultMaxCachedBytes);
+
+  ~DlStorageSlab();
+
+  // Returns a block of at least |size| bytes and stores the actual usable
+  // size of the block in |capacity|. The contents of the block are
+  // undefined.
+  uint8_t* Allocate(size_t size, size_t* capacity);
+
+  // Returns a block obtained from |Allocate| to the slab. The |capacity|
+  // must be the value reported when the block was allocated.
+  void Free(uint8_t* block, size_t capacity);
+
+  // Releases all cached blocks back to the system allocator.
+  void Purge();
+
+  Stats GetStats() const;
+
+ private:
+  static constexpr size_t kClassCount = 11;
+  static_assert((kMinBlockSize << (kClassCount - 1)) == kMaxBlockSize);
+
+  static size_t ClassIndexForSize(size_t size);
+  static size_t ClassSize(size_t index) { return kMinBlockSize << index; }
+
+  const size_t max_cached_bytes_;
+
+  mutable std::mutex mutex_;
+  std::array<std::vector<uint8_t*>, kClassCount> free_lists_;
+  Stats stats_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlStorageSlab);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_UTILS_DL_STORAGE_SLAB_H_
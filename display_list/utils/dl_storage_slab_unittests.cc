@@ -0,0 +1,106 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/utils/dl_storage_slab.h"
+#include "flutter/display_list/dl_builder.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(DisplayListStorageSlab, AllocateRoundsUpToSizeClass) {
+  DlStorageSlab slab;
+  size_t capacity = 0u;
+
+  uint8_t* block = slab.Allocate(10, &capacity);
+  ASSERT_NE(block, nullptr);
+  EXPECT_EQ(capacity, DlStorageSlab::kMinBlockSize);
+  slab.Free(block, capacity);
+
+  block = slab.Allocate(DlStorageSlab::kMinBlockSize + 1, &capacity);
+  ASSERT_NE(block, nullptr);
+  EXPECT_EQ(capacity, DlStorageSlab::kMinBlockSize * 2);
+  slab.Free(block, capacity);
+}
+
+TEST(DisplayListStorageSlab, FreedBlocksAreReused) {
+  DlStorageSlab slab;
+  size_t capacity = 0u;
+
+  uint8_t* first = slab.Allocate(5000, &capacity);
+  slab.Free(first, capacity);
+  EXPECT_EQ(slab.GetStats().cached_bytes, capacity);
+
+  uint8_t* second = slab.Allocate(6000, &capacity);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(slab.GetStats().allocations, 2u);
+  EXPECT_EQ(slab.GetStats().reused, 1u);
+  EXPECT_EQ(slab.GetStats().cached_bytes, 0u);
+  slab.Free(second, capacity);
+}
+
+TEST(DisplayListStorageSlab, OversizedBlocksAreNotCached) {
+  DlStorageSlab slab;
+  size_t capacity = 0u;
+
+  uint8_t* block = slab.Allocate(DlStorageSlab::kMaxBlockSize + 1, &capacity);
+  ASSERT_NE(block, nullptr);
+  EXPECT_EQ(capacity, DlStorageSlab::kMaxBlockSize + 1);
+  slab.Free(block, capacity);
+  EXPECT_EQ(slab.GetStats().cached_bytes, 0u);
+}
+
+TEST(DisplayListStorageSlab, CacheIsBounded) {
+  DlStorageSlab slab(DlStorageSlab::kMinBlockSize);
+  size_t capacity_a = 0u;
+  size_t capacity_b = 0u;
+
+  uint8_t* a = slab.Allocate(1, &capacity_a);
+  uint8_t* b = slab.Allocate(1, &capacity_b);
+  slab.Free(a, capacity_a);
+  slab.Free(b, capacity_b);
+  EXPECT_EQ(slab.GetStats().cached_bytes, DlStorageSlab::kMinBlockSize);
+
+  slab.Purge();
+  EXPECT_EQ(slab.GetStats().cached_bytes, 0u);
+}
+
+TEST(DisplayListStorageSlab, DisplayListReturnsStorageToSlab) {
+  auto slab = std::make_shared<DlStorageSlab>();
+  DisplayListBuilder builder;
+  builder.SetStorageSlab(slab);
+  builder.DrawRect(SkRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+  auto display_list = builder.Build();
+  EXPECT_EQ(display_list->GetStorage().slab(), slab);
+  EXPECT_EQ(slab->GetStats().allocations, 1u);
+  EXPECT_EQ(slab->GetStats().cached_bytes, 0u);
+
+  display_list.reset();
+  EXPECT_EQ(slab->GetStats().cached_bytes, DlStorageSlab::kMinBlockSize);
+
+  // The builder keeps using the slab after Build and picks the freed
+  // block back up.
+  builder.DrawRect(SkRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+  display_list = builder.Build();
+  EXPECT_EQ(slab->GetStats().allocations, 2u);
+  EXPECT_EQ(slab->GetStats().reused, 1u);
+}
+
+TEST(DisplayListStorageSlab, SlabBackedListsCompareEqual) {
+  auto slab = std::make_shared<DlStorageSlab>();
+  DisplayListBuilder slab_builder;
+  slab_builder.SetStorageSlab(slab);
+  DisplayListBuilder malloc_builder;
+  for (DisplayListBuilder* builder : {&slab_builder, &malloc_builder}) {
+    builder->Translate(5, 5);
+    builder->DrawCircle(SkPoint::Make(10, 10), 5, DlPaint(DlColor::kBlue()));
+    builder->DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+  }
+  auto slab_list = slab_builder.Build();
+  auto malloc_list = malloc_builder.Build();
+  EXPECT_TRUE(slab_list->Equals(malloc_list));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -184,18 +184,29 @@ void DiffContext::MarkSubtreeDirty(const SkRect& previous_paint_region) {
   state_.dirty = true;
 }
 
-void DiffContext::AddLayerBounds(const SkRect& rect) {
+bool DiffContext::MapLayerRect(const SkRect& rect, SkRect* device_rect) {
   // During painting we cull based on non-overriden transform and then
   // override the transform right before paint. Do the same thing here to get
   // identical paint rect.
-  auto transformed_rect = ApplyFilterBoundsAdjustment(MapRect(rect));
-  if (transformed_rect.intersects(state_.matrix_clip.device_cull_rect())) {
-    if (state_.integral_transform) {
-      DisplayListMatrixClipState temp_state = state_.matrix_clip;
-      MakeTransformIntegral(temp_state);
-      temp_state.mapRect(rect, &transformed_rect);
-      transformed_rect = ApplyFilterBoundsAdjustment(transformed_rect);
-    }
+  SkRect transformed_rect;
+  state_.matrix_clip.mapRect(rect, &transformed_rect);
+  transformed_rect = ApplyFilterBoundsAdjustment(transformed_rect);
+  if (!transformed_rect.intersects(state_.matrix_clip.device_cull_rect())) {
+    return false;
+  }
+  if (state_.integral_transform) {
+    DisplayListMatrixClipState temp_state = state_.matrix_clip;
+    MakeTransformIntegral(temp_state);
+    temp_state.mapRect(rect, &transformed_rect);
+    transformed_rect = ApplyFilterBoundsAdjustment(transformed_rect);
+  }
+  *device_rect = transformed_rect;
+  return true;
+}
+
+void DiffContext::AddLayerBounds(const SkRect& rect) {
+  SkRect transformed_rect;
+  if (MapLayerRect(rect, &transformed_rect)) {
     rects_->push_back(transformed_rect);
     if (IsSubtreeDirty()) {
       AddDamage(transformed_rect);
@@ -203,6 +214,13 @@ void DiffContext::AddLayerBounds(const SkRect& rect) {
   }
 }
 
+void DiffContext::AddLayerDamage(const SkRect& rect) {
+  SkRect transformed_rect;
+  if (!rect.isEmpty() && MapLayerRect(rect, &transformed_rect)) {
+    AddDamage(transformed_rect);
+  }
+}
+
 void DiffContext::MarkSubtreeHasTextureLayer() {
   // Set the has_texture flag on current state and all parent states. That
   // way we'll know that we can't skip diff for retained layers because
@@ -276,7 +294,8 @@ void DiffContext::Statistics::LogStatistics() {
                     deep_compare_pictures_, "SameInstancePictures",
                     same_instance_pictures_,
                     "DifferentInstanceButEqualPictures",
-                    different_instance_but_equal_pictures_);
+                    different_instance_but_equal_pictures_,
+                    "OpDiffedPictures", op_diffed_pictures_);
 #endif  // !FLUTTER_RELEASE
 }
 
@@ -115,6 +115,12 @@ class DiffContext {
   // coordinates.
   void AddLayerBounds(const SkRect& rect);
 
+  // Add the part of the layer that changed since the previous frame to
+  // damage without marking the subtree dirty; rect is in "local" (layer)
+  // coordinates. Used by layers that compute their own damage in
+  // Layer::DiffChanged.
+  void AddLayerDamage(const SkRect& rect);
+
   // Add entire paint region of retained layer for current subtree. This can
   // only be used in subtrees that are not dirty, otherwise ancestor transforms
   // or clips may result in different paint region.
@@ -189,6 +195,10 @@ class DiffContext {
       ++different_instance_but_equal_pictures_;
     };
 
+    // Picture replaced by different picture for which only the changed
+    // operations were added to damage
+    void AddOpDiffedPicture() { ++op_diffed_pictures_; }
+
     // Logs the statistics to trace counter
     void LogStatistics();
 
@@ -198,6 +208,7 @@ class DiffContext {
     int same_instance_pictures_ = 0;
     int deep_compare_pictures_ = 0;
     int different_instance_but_equal_pictures_ = 0;
+    int op_diffed_pictures_ = 0;
   };
 
   Statistics& statistics() { return statistics_; }
@@ -255,6 +266,10 @@ class DiffContext {
 
   void AddDamage(const SkRect& rect);
 
+  // Maps rect from local coordinates to the device rect the layer paints
+  // to; returns false if it falls outside of the current cull rect.
+  bool MapLayerRect(const SkRect& rect, SkRect* device_rect);
+
   void AlignRect(SkIRect& rect,
                  int horizontal_alignment,
                  int vertical_clip_alignment) const;
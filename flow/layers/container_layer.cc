@@ -64,8 +64,23 @@ void ContainerLayer::DiffChildren(DiffContext* context,
     --old_children_bottom;
   }
 
+  // If the same number of layers changed on both sides, pair them up by
+  // position so that layers that can compute precise damage against their
+  // changed counterpart can do so.
+  const int changed_offset = old_children_top - new_children_top;
+  const bool pair_changed_layers =
+      old_children_bottom - old_children_top ==
+      new_children_bottom - new_children_top;
+  auto can_diff_changed = [&](int i) {
+    return pair_changed_layers &&
+           layers_[i]->CanDiffChanged(prev_layers[i + changed_offset].get());
+  };
+
   // old layers that don't match
   for (int i = old_children_top; i <= old_children_bottom; ++i) {
+    if (can_diff_changed(i - changed_offset)) {
+      continue;
+    }
     auto layer = prev_layers[i];
     context->AddDamage(context->GetOldLayerPaintRegion(layer.get()));
   }
@@ -94,6 +109,8 @@ void ContainerLayer::DiffChildren(DiffContext* context,
       } else {
         layer->Diff(context, prev_layer.get());
       }
+    } else if (can_diff_changed(i)) {
+      layers_[i]->DiffChanged(context, prev_layers[i + changed_offset].get());
     } else {
       DiffContext::AutoSubtreeRestore subtree(context);
       context->MarkSubtreeDirty();
@@ -148,7 +165,7 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     // opt-in to applying state attributes during its |Preroll|
     context->renderable_state_flags = 0;
 
-    layer->Preroll(context);
+    layer->PrerollIfNeeded(context);
 
     all_renderable_state_flags &= context->renderable_state_flags;
     if (safe_intersection_test(child_paint_bounds, layer->paint_bounds())) {
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_optimizer.h"
 #include "flutter/flow/layer_snapshot_store.h"
 #include "flutter/flow/layers/cacheable_layer.h"
 #include "flutter/flow/layers/offscreen_surface.h"
@@ -59,6 +60,36 @@ void DisplayListLayer::Diff(DiffContext* context, const Layer* old_layer) {
   context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
 }
 
+bool DisplayListLayer::CanDiffChanged(const Layer* old_layer) const {
+  auto prev = old_layer->as_display_list_layer();
+  return prev != nullptr && prev->offset_ == offset_ &&
+         display_list_->has_rtree() && prev->display_list_->has_rtree() &&
+         display_list_->bytes(false) <= kMaxBytesToDiffOps &&
+         prev->display_list_->bytes(false) <= kMaxBytesToDiffOps;
+}
+
+void DisplayListLayer::DiffChanged(DiffContext* context,
+                                   const Layer* old_layer) {
+  FML_DCHECK(!context->IsSubtreeDirty());
+  auto prev = old_layer->as_display_list_layer();
+  FML_DCHECK(prev && prev->offset_ == offset_);
+
+  DiffContext::AutoSubtreeRestore subtree(context);
+  context->PushTransform(SkMatrix::Translate(offset_.x(), offset_.y()));
+  if (context->has_raster_cache()) {
+    context->WillPaintWithIntegralTransform();
+  }
+  SkRect damage;
+  if (display_list_->ComputeOpDamage(*prev->display_list_, &damage)) {
+    context->statistics().AddOpDiffedPicture();
+    context->AddLayerDamage(damage);
+  } else {
+    context->MarkSubtreeDirty(context->GetOldLayerPaintRegion(old_layer));
+  }
+  context->AddLayerBounds(display_list()->bounds());
+  context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
+}
+
 bool DisplayListLayer::Compare(DiffContext::Statistics& statistics,
                                const DisplayListLayer* l1,
                                const DisplayListLayer* l2) {
@@ -105,6 +136,25 @@ void DisplayListLayer::Preroll(PrerollContext* context) {
     context->renderable_state_flags = LayerStateStack::kCallerCanApplyOpacity;
   }
   set_paint_bounds(bounds_);
+  MaybeOptimize(context);
+}
+
+void DisplayListLayer::MaybeOptimize(PrerollContext* context) {
+  if (!context->optimize_retained_display_lists ||
+      preroll_count_ >= kOptimizeAfterPrerolls) {
+    return;
+  }
+  if (++preroll_count_ < kOptimizeAfterPrerolls) {
+    // The layer must keep counting its Prerolls until it is optimized.
+    context->preroll_is_reusable = false;
+    return;
+  }
+  // The same layer instance has been retained for several frames so its
+  // picture is likely to keep being rendered and will amortize the cost.
+  auto result = DisplayListOptimizer::Optimize(display_list_);
+  if (result.display_list != display_list_) {
+    optimized_display_list_ = std::move(result.display_list);
+  }
 }
 
 void DisplayListLayer::Paint(PaintContext& context) const {
@@ -150,7 +200,7 @@ void DisplayListLayer::Paint(PaintContext& context) const {
         DlAutoCanvasRestore save(canvas, true);
         canvas->Clear(DlColor::kTransparent());
         canvas->SetTransform(ctm);
-        canvas->DrawDisplayList(display_list_, opacity);
+        canvas->DrawDisplayList(painted_display_list(), opacity);
       }
       canvas->Flush();
     }
@@ -166,7 +216,7 @@ void DisplayListLayer::Paint(PaintContext& context) const {
   }
 #endif  //  !SLIMPELLER
 
-  context.canvas->DrawDisplayList(display_list_, opacity);
+  context.canvas->DrawDisplayList(painted_display_list(), opacity);
 }
 
 }  // namespace flutter
@@ -19,6 +19,14 @@ class DisplayListLayer : public Layer {
  public:
   static constexpr size_t kMaxBytesToCompare = 10000;
 
+  // Pictures larger than this are treated as entirely damaged when they
+  // change rather than being diffed op by op.
+  static constexpr size_t kMaxBytesToDiffOps = 1000000;
+
+  // The number of frames a layer must be prerolled in before its picture is
+  // considered retained and worth running through the DisplayListOptimizer.
+  static constexpr int kOptimizeAfterPrerolls = 3;
+
   DisplayListLayer(const SkPoint& offset,
                    sk_sp<DisplayList> display_list,
                    bool is_complex,
@@ -26,10 +34,21 @@ class DisplayListLayer : public Layer {
 
   DisplayList* display_list() const { return display_list_.get(); }
 
+  // The DisplayList that is rendered when the layer is painted directly,
+  // which is either the optimized DisplayList, if one has been produced,
+  // or the original one.
+  const sk_sp<DisplayList>& painted_display_list() const {
+    return optimized_display_list_ ? optimized_display_list_ : display_list_;
+  }
+
   bool IsReplacing(DiffContext* context, const Layer* layer) const override;
 
   void Diff(DiffContext* context, const Layer* old_layer) override;
 
+  bool CanDiffChanged(const Layer* old_layer) const override;
+
+  void DiffChanged(DiffContext* context, const Layer* old_layer) override;
+
   const DisplayListLayer* as_display_list_layer() const override {
     return this;
   }
@@ -58,6 +77,13 @@ class DisplayListLayer : public Layer {
 
   sk_sp<DisplayList> display_list_;
 
+  // Only used for painting, diffing and raster caching are keyed on the
+  // original |display_list_|.
+  sk_sp<DisplayList> optimized_display_list_;
+  int preroll_count_ = 0;
+
+  void MaybeOptimize(PrerollContext* context);
+
   static bool Compare(DiffContext::Statistics& statistics,
                       const DisplayListLayer* l1,
                       const DisplayListLayer* l2);
@@ -294,6 +294,42 @@ TEST_F(DisplayListLayerTest, CachedIncompatibleDisplayListOpacityInheritance) {
   EXPECT_TRUE(DisplayListsEQ_Verbose(expected.Build(), this->display_list()));
 }
 
+TEST_F(DisplayListLayerTest, RetainedDisplayListIsOptimized) {
+  const SkRect content_bounds = SkRect::MakeLTRB(10, 10, 20, 20);
+  const SkRect background_bounds = SkRect::MakeLTRB(0, 0, 50, 50);
+  DisplayListBuilder builder(true);
+  builder.DrawRect(content_bounds, DlPaint(DlColor::kRed()));
+  builder.DrawRect(background_bounds, DlPaint(DlColor::kBlue()));
+  auto display_list = builder.Build();
+  const SkPoint layer_offset = SkPoint::Make(1.5f, -0.5f);
+  auto layer = std::make_shared<DisplayListLayer>(layer_offset, display_list,
+                                                  false, false);
+
+  preroll_context()->optimize_retained_display_lists = true;
+  for (int i = 1; i < DisplayListLayer::kOptimizeAfterPrerolls; i++) {
+    layer->Preroll(preroll_context());
+    EXPECT_EQ(layer->painted_display_list(), display_list);
+  }
+  layer->Preroll(preroll_context());
+  EXPECT_NE(layer->painted_display_list(), display_list);
+  // The original picture is still used to identify the layer.
+  EXPECT_EQ(layer->display_list(), display_list.get());
+
+  DisplayListBuilder expected_picture(true);
+  expected_picture.DrawRect(background_bounds, DlPaint(DlColor::kBlue()));
+  EXPECT_TRUE(DisplayListsEQ_Verbose(layer->painted_display_list(),
+                                     expected_picture.Build()));
+
+  layer->Paint(display_list_paint_context());
+  DisplayListBuilder expected_builder;
+  expected_builder.Save();
+  expected_builder.Translate(layer_offset.fX, layer_offset.fY);
+  expected_builder.DrawDisplayList(layer->painted_display_list());
+  expected_builder.Restore();
+  EXPECT_TRUE(
+      DisplayListsEQ_Verbose(this->display_list(), expected_builder.Build()));
+}
+
 TEST_F(DisplayListLayerTest, RasterCachePreservesRTree) {
   const SkRect picture1_bounds = SkRect::MakeXYWH(10, 10, 10, 10);
   const SkRect picture2_bounds = SkRect::MakeXYWH(15, 15, 10, 10);
@@ -439,6 +475,70 @@ TEST_F(DisplayListLayerDiffTest, DisplayListCompare) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(20, 20, 70, 70));
 }
 
+static sk_sp<DisplayList> CreateTextFieldDisplayList(DlColor cursor_color) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 200, 100),
+                   DlPaint(DlColor::kWhite()));
+  builder.DrawRect(SkRect::MakeLTRB(10, 10, 190, 20),
+                   DlPaint(DlColor::kBlack()));
+  builder.DrawRect(SkRect::MakeLTRB(100, 30, 102, 50),
+                   DlPaint(cursor_color));
+  builder.DrawRect(SkRect::MakeLTRB(10, 60, 190, 70),
+                   DlPaint(DlColor::kBlack()));
+  return builder.Build();
+}
+
+TEST_F(DisplayListLayerDiffTest, ChangedOpsDamageOnlyTheirBounds) {
+  MockLayerTree tree1;
+  tree1.root()->Add(
+      CreateDisplayListLayer(CreateTextFieldDisplayList(DlColor::kBlue()),
+                             SkPoint::Make(10, 10)));
+  auto damage = DiffLayerTree(tree1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 210, 110));
+
+  MockLayerTree tree2;
+  tree2.root()->Add(
+      CreateDisplayListLayer(CreateTextFieldDisplayList(DlColor::kWhite()),
+                             SkPoint::Make(10, 10)));
+  damage = DiffLayerTree(tree2, tree1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(110, 40, 112, 60));
+}
+
+TEST_F(DisplayListLayerDiffTest, ChangedStateOpDamagesFollowingOps) {
+  DisplayListBuilder builder1(/*prepare_rtree=*/true);
+  builder1.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+  builder1.DrawRect(SkRect::MakeLTRB(20, 20, 30, 30), DlPaint());
+  builder1.DrawRect(SkRect::MakeLTRB(40, 40, 50, 50), DlPaint());
+  MockLayerTree tree1;
+  tree1.root()->Add(CreateDisplayListLayer(builder1.Build()));
+  DiffLayerTree(tree1, MockLayerTree());
+
+  DisplayListBuilder builder2(/*prepare_rtree=*/true);
+  builder2.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+  builder2.Translate(1, 1);
+  builder2.DrawRect(SkRect::MakeLTRB(20, 20, 30, 30), DlPaint());
+  builder2.DrawRect(SkRect::MakeLTRB(40, 40, 50, 50), DlPaint());
+  MockLayerTree tree2;
+  tree2.root()->Add(CreateDisplayListLayer(builder2.Build()));
+  auto damage = DiffLayerTree(tree2, tree1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(20, 20, 51, 51));
+}
+
+TEST_F(DisplayListLayerDiffTest, ChangedPictureWithoutRTreeIsFullyDamaged) {
+  MockLayerTree tree1;
+  tree1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(10, 10, 60, 60), DlColor::kGreen())));
+  DiffLayerTree(tree1, MockLayerTree());
+
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(SkRect::MakeLTRB(10, 10, 60, 60),
+                   DlPaint(DlColor::kRed()));
+  MockLayerTree tree2;
+  tree2.root()->Add(CreateDisplayListLayer(builder.Build()));
+  auto damage = DiffLayerTree(tree2, tree1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 60, 60));
+}
+
 TEST_F(DisplayListLayerTest, LayerTreeSnapshotsWhenEnabled) {
   const SkPoint layer_offset = SkPoint::Make(1.5f, -0.5f);
   const SkRect picture_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
@@ -74,9 +74,14 @@ void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
                                               const SkMatrix& matrix) {
   cache_state_ = CacheState::kNone;
   DisplayListComplexityCalculator* complexity_calculator =
-      context->gr_context ? DisplayListComplexityCalculator::GetForBackend(
-                                context->gr_context->backend())
-                          : DisplayListComplexityCalculator::GetForSoftware();
+      context->raster_cache ? context->raster_cache->complexity_calculator()
+                            : nullptr;
+  if (!complexity_calculator) {
+    complexity_calculator =
+        context->gr_context ? DisplayListComplexityCalculator::GetForBackend(
+                                  context->gr_context->backend())
+                            : DisplayListComplexityCalculator::GetForSoftware();
+  }
 
   if (!IsDisplayListWorthRasterizing(display_list(), will_change_, is_complex_,
                                      complexity_calculator)) {
@@ -110,8 +115,12 @@ void DisplayListRasterCacheItem::PrerollFinalize(PrerollContext* context,
   bool visible = !context->state_stack.content_culled(bounds);
   RasterCache::CacheInfo cache_info =
       raster_cache->MarkSeen(key_id_, matrix, visible);
+  // An entry rasterized at another scale within the scale band of the
+  // raster cache can be drawn right away, without waiting for the access
+  // threshold of this scale.
   if (!visible ||
-      cache_info.accesses_since_visible <= raster_cache->access_threshold()) {
+      (cache_info.accesses_since_visible <= raster_cache->access_threshold() &&
+       !cache_info.has_image)) {
     cache_state_ = kNone;
   } else {
     if (cache_info.has_image) {
@@ -168,12 +177,18 @@ bool DisplayListRasterCacheItem::TryToPrepareRasterCache(
       .flow_type          = flow_type,
       // clang-format on
   };
+  auto render_function = [display_list = display_list_](DlCanvas* canvas) {
+    canvas->DrawDisplayList(display_list);
+  };
+  if (context.raster_cache->background_population_enabled() &&
+      display_list_->isUIThreadSafe()) {
+    // Display lists that only reference thread safe images can be rendered
+    // off of the raster thread, keeping the rasterization out of this frame.
+    return context.raster_cache->UpdateCacheEntryInBackground(
+        id.value(), r_context, render_function, display_list_->rtree());
+  }
   return context.raster_cache->UpdateCacheEntry(
-      id.value(), r_context,
-      [display_list = display_list_](DlCanvas* canvas) {
-        canvas->DrawDisplayList(display_list);
-      },
-      display_list_->rtree());
+      id.value(), r_context, render_function, display_list_->rtree());
 }
 }  // namespace flutter
 
@@ -24,6 +24,66 @@ uint64_t Layer::NextUniqueID() {
   return id;
 }
 
+void Layer::PrerollIfNeeded(PrerollContext* context) {
+  if (!context->enable_incremental_preroll) {
+    Preroll(context);
+    return;
+  }
+
+  SkM44 transform = context->state_stack.transform_4x4();
+  SkRect device_cull_rect = context->state_stack.device_cull_rect();
+#if !SLIMPELLER
+  bool has_raster_cache = context->raster_cache != nullptr;
+#else   //  !SLIMPELLER
+  bool has_raster_cache = false;
+#endif  //  !SLIMPELLER
+  bool surface_needed_readback = context->surface_needs_readback;
+
+  const PrerollSnapshot* snapshot = preroll_snapshot_.get();
+  if (snapshot && snapshot->transform == transform &&
+      snapshot->device_cull_rect == device_cull_rect &&
+      snapshot->has_raster_cache == has_raster_cache &&
+      snapshot->surface_needed_readback == surface_needed_readback) {
+    context->surface_needs_readback = snapshot->surface_needs_readback;
+    context->renderable_state_flags = snapshot->renderable_state_flags;
+    context->skipped_preroll_layer_count += snapshot->layer_count;
+    return;
+  }
+  preroll_snapshot_.reset();
+
+  bool parent_is_reusable = context->preroll_is_reusable;
+  size_t layers_before =
+      context->prerolled_layer_count + context->skipped_preroll_layer_count;
+  size_t raster_cached_entries_before =
+      context->raster_cached_entries ? context->raster_cached_entries->size()
+                                     : 0;
+  context->preroll_is_reusable = true;
+  context->prerolled_layer_count++;
+
+  Preroll(context);
+
+  size_t raster_cached_entries_after =
+      context->raster_cached_entries ? context->raster_cached_entries->size()
+                                     : 0;
+  bool is_reusable =
+      context->preroll_is_reusable && !context->has_platform_view &&
+      !context->has_texture_layer &&
+      raster_cached_entries_after == raster_cached_entries_before;
+  if (is_reusable) {
+    preroll_snapshot_ = std::make_unique<PrerollSnapshot>(PrerollSnapshot{
+        .transform = transform,
+        .device_cull_rect = device_cull_rect,
+        .has_raster_cache = has_raster_cache,
+        .surface_needed_readback = surface_needed_readback,
+        .surface_needs_readback = context->surface_needs_readback,
+        .renderable_state_flags = context->renderable_state_flags,
+        .layer_count = context->prerolled_layer_count +
+                       context->skipped_preroll_layer_count - layers_before,
+    });
+  }
+  context->preroll_is_reusable = parent_is_reusable && is_reusable;
+}
+
 Layer::AutoPrerollSaveLayerState::AutoPrerollSaveLayerState(
     PrerollContext* preroll_context,
     bool save_layer_is_active,
@@ -44,6 +44,7 @@ class MockLayer;
 class ContainerLayer;
 class DisplayListLayer;
 class PerformanceOverlayLayer;
+class PlatformViewLayer;
 class TextureLayer;
 class RasterCacheItem;
 
@@ -83,6 +84,24 @@ struct PrerollContext {
   int renderable_state_flags = 0;
 
   std::vector<RasterCacheItem*>* raster_cached_entries;
+
+  // Whether DisplayListLayers may replace the DisplayList of a picture that
+  // has been retained for several frames with an optimized equivalent.
+  bool optimize_retained_display_lists = false;
+
+  // Whether layers retained from an earlier frame may reuse the results of
+  // their last Preroll, see |Layer::PrerollIfNeeded|.
+  bool enable_incremental_preroll = false;
+
+  // Cleared by layers whose Preroll has effects that must be repeated every
+  // frame, which prevents the enclosing subtrees from skipping their Preroll
+  // in later frames.
+  bool preroll_is_reusable = true;
+
+  // The number of layers prerolled by |Layer::PrerollIfNeeded| and the
+  // number of layers in the subtrees whose Preroll it skipped.
+  size_t prerolled_layer_count = 0;
+  size_t skipped_preroll_layer_count = 0;
 };
 
 struct PaintContext {
@@ -157,6 +176,17 @@ class Layer {
   // Performs diff with given layer
   virtual void Diff(DiffContext* context, const Layer* old_layer) {}
 
+  // Used when this layer does not replace the old layer but takes its
+  // position in the parent. If this method returns true, DiffChanged is
+  // called instead of adding the paint region of the old layer to damage
+  // and diffing this layer in a dirty subtree.
+  virtual bool CanDiffChanged(const Layer* old_layer) const { return false; }
+
+  // Performs diff with a changed old layer for which CanDiffChanged returned
+  // true. The layer is responsible for adding the damage caused by the
+  // change to the diff context; the current subtree is not dirty.
+  virtual void DiffChanged(DiffContext* context, const Layer* old_layer) {}
+
   // Used when diffing retained layer; In case the layer is identical, it
   // doesn't need to be diffed, but the paint region needs to be stored in diff
   // context so that it can be used in next frame
@@ -168,6 +198,17 @@ class Layer {
 
   virtual void Preroll(PrerollContext* context) = 0;
 
+  // Calls |Preroll| unless |PrerollContext::enable_incremental_preroll| is
+  // set and this layer was prerolled before under the same transform, cull
+  // rect and raster cache. Layers are immutable once a scene has been built,
+  // so such a layer is a subtree retained from an earlier frame and the
+  // results of its last Preroll are restored to the context instead.
+  //
+  // The results of a Preroll are only kept when the subtree contains no
+  // platform views or texture layers, did not register any raster cache
+  // entries and did not clear |PrerollContext::preroll_is_reusable|.
+  void PrerollIfNeeded(PrerollContext* context);
+
   // Used during Preroll by layers that employ a saveLayer to manage the
   // PrerollContext settings with values affected by the saveLayer mechanism.
   // This object must be created before calling Preroll on the children to
@@ -260,16 +301,32 @@ class Layer {
     return nullptr;
   }
   virtual const TextureLayer* as_texture_layer() const { return nullptr; }
+  virtual const PlatformViewLayer* as_platform_view_layer() const {
+    return nullptr;
+  }
   virtual const PerformanceOverlayLayer* as_performance_overlay_layer() const {
     return nullptr;
   }
   virtual const testing::MockLayer* as_mock_layer() const { return nullptr; }
 
  private:
+  // The inputs and outputs of the last Preroll of a layer whose Preroll can
+  // be skipped, see |PrerollIfNeeded|.
+  struct PrerollSnapshot {
+    SkM44 transform;
+    SkRect device_cull_rect;
+    bool has_raster_cache;
+    bool surface_needed_readback;
+    bool surface_needs_readback;
+    int renderable_state_flags;
+    size_t layer_count;
+  };
+
   SkRect paint_bounds_;
   uint64_t unique_id_;
   uint64_t original_layer_id_;
   bool subtree_has_platform_view_ = false;
+  std::unique_ptr<PrerollSnapshot> preroll_snapshot_;
 
   static uint64_t NextUniqueID();
 
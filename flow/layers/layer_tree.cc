@@ -57,9 +57,21 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       .ui_time = frame.context().ui_time(),
       .texture_registry = frame.context().texture_registry(),
       .raster_cached_entries = &raster_cache_items_,
+      .optimize_retained_display_lists = enable_display_list_optimization_,
+      .enable_incremental_preroll = enable_incremental_preroll_,
   };
 
-  root_layer_->Preroll(&context);
+  root_layer_->PrerollIfNeeded(&context);
+
+  prerolled_layer_count_ = context.prerolled_layer_count;
+  skipped_preroll_layer_count_ = context.skipped_preroll_layer_count;
+  if (enable_incremental_preroll_) {
+    FML_TRACE_COUNTER("flutter", "LayerTree Preroll",
+                      reinterpret_cast<int64_t>(this),          //
+                      "prerolled", prerolled_layer_count_,      //
+                      "skipped", skipped_preroll_layer_count_  //
+    );
+  }
 
   return context.surface_needs_readback;
 }
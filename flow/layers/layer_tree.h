@@ -70,10 +70,37 @@ class LayerTree {
     return enable_leaf_layer_tracing_;
   }
 
+  /// When `Preroll` is called, if display list optimization is enabled, the
+  /// pictures of display list layers that are retained across frames are
+  /// rewritten with the `DisplayListOptimizer` before they are painted.
+  void enable_display_list_optimization(bool enable) {
+    enable_display_list_optimization_ = enable;
+  }
+
+  /// When `Preroll` is called, if incremental preroll is enabled, subtrees
+  /// retained from an earlier frame skip their Preroll when their transform
+  /// and cull rect are unchanged. See `Layer::PrerollIfNeeded`.
+  void enable_incremental_preroll(bool enable) {
+    enable_incremental_preroll_ = enable;
+  }
+
+  /// The number of layers whose Preroll ran during the last `Preroll`.
+  size_t prerolled_layer_count() const { return prerolled_layer_count_; }
+
+  /// The number of layers whose Preroll was skipped during the last
+  /// `Preroll` because they were part of an unchanged retained subtree.
+  size_t skipped_preroll_layer_count() const {
+    return skipped_preroll_layer_count_;
+  }
+
  private:
   std::shared_ptr<Layer> root_layer_;
   SkISize frame_size_ = SkISize::MakeEmpty();  // Physical pixels.
   bool enable_leaf_layer_tracing_ = false;
+  bool enable_display_list_optimization_ = false;
+  bool enable_incremental_preroll_ = false;
+  size_t prerolled_layer_count_ = 0;
+  size_t skipped_preroll_layer_count_ = 0;
 
   PaintRegionMap paint_region_map_;
 
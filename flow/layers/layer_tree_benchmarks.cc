@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/transform_layer.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr int kLeavesPerLevel = 8;
+
+sk_sp<DisplayList> MakeLeafPicture(int index) {
+  DisplayListBuilder builder;
+  DlPaint paint(index % 2 ? DlColor::kBlue() : DlColor::kGreen());
+  builder.DrawRect(SkRect::MakeWH(10, 10), paint);
+  return builder.Build();
+}
+
+// Builds a chain of |depth| transform layers, each of which also holds
+// |kLeavesPerLevel| pictures, like the deeply nested and mostly static
+// widget trees of a typical application.
+std::shared_ptr<Layer> MakeStaticSubtree(int depth) {
+  auto root = std::make_shared<TransformLayer>(SkM44());
+  ContainerLayer* parent = root.get();
+  for (int level = 0; level < depth; level++) {
+    for (int i = 0; i < kLeavesPerLevel; i++) {
+      parent->Add(std::make_shared<DisplayListLayer>(
+          SkPoint::Make(i * 12, 0), MakeLeafPicture(i), false, false));
+    }
+    auto child = std::make_shared<TransformLayer>(SkM44::Translate(0, 12));
+    parent->Add(child);
+    parent = child.get();
+  }
+  return root;
+}
+
+// Prerolls a frame that retains a static subtree of the given depth from the
+// previous frame and adds a single new picture, e.g. a spinner.
+void BM_PrerollRetainedSubtree(benchmark::State& state,
+                               bool incremental_preroll) {
+  CompositorContext compositor_context;
+  auto frame = compositor_context.AcquireFrame(
+      nullptr, nullptr, nullptr, SkMatrix::I(), false, true, nullptr, nullptr);
+  std::shared_ptr<Layer> retained =
+      MakeStaticSubtree(static_cast<int>(state.range(0)));
+  sk_sp<DisplayList> spinner = MakeLeafPicture(0);
+
+  size_t prerolled = 0;
+  size_t skipped = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(retained);
+    root->Add(std::make_shared<DisplayListLayer>(SkPoint::Make(0, 0), spinner,
+                                                 false, true));
+    LayerTree layer_tree(root, SkISize::Make(1000, 1000));
+    layer_tree.enable_incremental_preroll(incremental_preroll);
+    state.ResumeTiming();
+
+    layer_tree.Preroll(*frame);
+
+    prerolled = layer_tree.prerolled_layer_count();
+    skipped = layer_tree.skipped_preroll_layer_count();
+  }
+  state.counters["prerolled_layers"] = prerolled;
+  state.counters["skipped_layers"] = skipped;
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_PrerollRetainedSubtree, Full, false)
+    ->RangeMultiplier(4)
+    ->Range(4, 256);
+
+BENCHMARK_CAPTURE(BM_PrerollRetainedSubtree, Incremental, true)
+    ->RangeMultiplier(4)
+    ->Range(4, 256);
+
+}  // namespace flutter
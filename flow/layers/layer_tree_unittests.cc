@@ -7,6 +7,7 @@
 
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
@@ -265,5 +266,118 @@ TEST_F(LayerTreeTest, PaintContextInitialization) {
   expect_defaults(context);
 }
 
+static std::shared_ptr<ContainerLayer> MakeRetainedSubtree() {
+  auto subtree = std::make_shared<ContainerLayer>();
+  subtree->Add(MockLayer::MakeOpacityCompatible(
+      SkPath().addRect(SkRect::MakeLTRB(5, 5, 10, 10))));
+  subtree->Add(MockLayer::MakeOpacityCompatible(
+      SkPath().addRect(SkRect::MakeLTRB(15, 15, 20, 20))));
+  return subtree;
+}
+
+TEST_F(LayerTreeTest, IncrementalPrerollSkipsRetainedSubtree) {
+  auto retained = MakeRetainedSubtree();
+
+  auto root_1 = std::make_shared<ContainerLayer>();
+  root_1->Add(retained);
+  auto layer_tree_1 = BuildLayerTree(root_1);
+  layer_tree_1->enable_incremental_preroll(true);
+  layer_tree_1->Preroll(frame());
+  EXPECT_EQ(layer_tree_1->prerolled_layer_count(), 4u);
+  EXPECT_EQ(layer_tree_1->skipped_preroll_layer_count(), 0u);
+
+  auto root_2 = std::make_shared<ContainerLayer>();
+  root_2->Add(retained);
+  root_2->Add(std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(25, 25, 30, 30))));
+  auto layer_tree_2 = BuildLayerTree(root_2);
+  layer_tree_2->enable_incremental_preroll(true);
+  layer_tree_2->Preroll(frame());
+  EXPECT_EQ(layer_tree_2->prerolled_layer_count(), 2u);
+  EXPECT_EQ(layer_tree_2->skipped_preroll_layer_count(), 3u);
+
+  // The results of the skipped Preroll are still reflected in the parent.
+  EXPECT_EQ(root_2->paint_bounds(), SkRect::MakeLTRB(5, 5, 30, 30));
+  EXPECT_EQ(retained->paint_bounds(), SkRect::MakeLTRB(5, 5, 20, 20));
+}
+
+TEST_F(LayerTreeTest, IncrementalPrerollRestoresRenderableStateFlags) {
+  auto retained = MakeRetainedSubtree();
+  for (int i = 0; i < 2; i++) {
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(retained);
+    auto layer_tree = BuildLayerTree(root);
+    layer_tree->enable_incremental_preroll(true);
+    layer_tree->Preroll(frame());
+    EXPECT_EQ(layer_tree->skipped_preroll_layer_count(), i == 0 ? 0u : 3u);
+    EXPECT_EQ(root->children_renderable_state_flags(),
+              LayerStateStack::kCallerCanApplyOpacity);
+  }
+}
+
+TEST_F(LayerTreeTest, IncrementalPrerollRestoresSurfaceReadback) {
+  auto retained = std::make_shared<ContainerLayer>();
+  auto reader = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(5, 5, 10, 10)));
+  reader->set_fake_reads_surface(true);
+  retained->Add(reader);
+  for (int i = 0; i < 2; i++) {
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(retained);
+    auto layer_tree = BuildLayerTree(root);
+    layer_tree->enable_incremental_preroll(true);
+    EXPECT_TRUE(layer_tree->Preroll(frame()));
+    EXPECT_EQ(layer_tree->skipped_preroll_layer_count(), i == 0 ? 0u : 2u);
+  }
+}
+
+TEST_F(LayerTreeTest, IncrementalPrerollRevisitsSubtreeUnderNewTransform) {
+  auto retained = MakeRetainedSubtree();
+
+  auto root_1 = std::make_shared<ContainerLayer>();
+  root_1->Add(retained);
+  auto layer_tree_1 = BuildLayerTree(root_1);
+  layer_tree_1->enable_incremental_preroll(true);
+  layer_tree_1->Preroll(frame());
+
+  auto root_2 = std::make_shared<TransformLayer>(SkM44::Translate(5, 5));
+  root_2->Add(retained);
+  auto layer_tree_2 = BuildLayerTree(root_2);
+  layer_tree_2->enable_incremental_preroll(true);
+  layer_tree_2->Preroll(frame());
+  EXPECT_EQ(layer_tree_2->prerolled_layer_count(), 4u);
+  EXPECT_EQ(layer_tree_2->skipped_preroll_layer_count(), 0u);
+}
+
+TEST_F(LayerTreeTest, IncrementalPrerollRevisitsSubtreeWithPlatformView) {
+  auto retained = MakeRetainedSubtree();
+  auto platform_view = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(25, 25, 30, 30)));
+  platform_view->set_fake_has_platform_view(true);
+  retained->Add(platform_view);
+
+  for (int i = 0; i < 2; i++) {
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(retained);
+    auto layer_tree = BuildLayerTree(root);
+    layer_tree->enable_incremental_preroll(true);
+    layer_tree->Preroll(frame());
+    // The mock layers without platform views are still skipped.
+    EXPECT_EQ(layer_tree->prerolled_layer_count(), i == 0 ? 5u : 3u);
+    EXPECT_EQ(layer_tree->skipped_preroll_layer_count(), i == 0 ? 0u : 2u);
+  }
+}
+
+TEST_F(LayerTreeTest, IncrementalPrerollIsDisabledByDefault) {
+  auto retained = MakeRetainedSubtree();
+  for (int i = 0; i < 2; i++) {
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(retained);
+    auto layer_tree = BuildLayerTree(root);
+    layer_tree->Preroll(frame());
+    EXPECT_EQ(layer_tree->skipped_preroll_layer_count(), 0u);
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
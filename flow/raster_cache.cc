@@ -6,6 +6,8 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <atomic>
+#include <cmath>
 #include <cstddef>
 #include <vector>
 
@@ -22,10 +24,70 @@
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/ganesh/SkImageGanesh.h"
 #include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
 
 namespace flutter {
 
+struct RasterCache::BackgroundRasterization {
+  // Set by the background task once |image| has been written.
+  std::atomic<bool> done = false;
+  sk_sp<SkImage> image;
+};
+
+namespace {
+
+// Renders |draw_function| with the |matrix| into an image covering the
+// rounded out device bounds of |logical_rect|. The image is a GPU render
+// target, with mipmaps if |mipmapped| is true, if there is a |gr_context|,
+// and is in raster memory otherwise.
+sk_sp<SkImage> RasterizeImage(
+    GrDirectContext* gr_context,
+    const sk_sp<SkColorSpace>& dst_color_space,
+    const SkMatrix& matrix,
+    const SkRect& logical_rect,
+    const std::function<void(DlCanvas*)>& draw_function,
+    const std::function<void(DlCanvas*, const SkRect& rect)>& draw_checkerboard,
+    bool checkerboard,
+    bool mipmapped) {
+  auto integral_matrix = RasterCacheUtil::GetIntegralTransCTM(matrix);
+  SkRect dest_rect =
+      RasterCacheUtil::GetRoundedOutDeviceBounds(logical_rect, integral_matrix);
+
+  const SkImageInfo image_info = SkImageInfo::MakeN32Premul(
+      dest_rect.width(), dest_rect.height(), dst_color_space);
+
+  sk_sp<SkSurface> surface =
+      gr_context ? SkSurfaces::RenderTarget(
+                       gr_context, skgpu::Budgeted::kYes, image_info, 0,
+                       kTopLeft_GrSurfaceOrigin, nullptr, mipmapped)
+                 : SkSurfaces::Raster(image_info);
+
+  if (!surface) {
+    return nullptr;
+  }
+
+  DlSkCanvasAdapter canvas(surface->getCanvas());
+  canvas.Clear(DlColor::kTransparent());
+
+  canvas.Translate(-dest_rect.left(), -dest_rect.top());
+  canvas.Transform(integral_matrix);
+  draw_function(&canvas);
+
+  if (checkerboard) {
+    draw_checkerboard(&canvas, logical_rect);
+  }
+
+  return surface->makeImageSnapshot();
+}
+
+bool IsPositiveScaleTranslate(const SkMatrix& matrix) {
+  return matrix.isScaleTranslate() && matrix.getScaleX() > 0 &&
+         matrix.getScaleY() > 0;
+}
+
+}  // namespace
+
 RasterCacheResult::RasterCacheResult(sk_sp<DlImage> image,
                                      const SkRect& logical_rect,
                                      const char* type,
@@ -70,6 +132,32 @@ void RasterCacheResult::draw(DlCanvas& canvas,
   }
 }
 
+void RasterCacheResult::draw_scaled(DlCanvas& canvas,
+                                    const DlPaint* paint,
+                                    const SkMatrix& raster_matrix) const {
+  DlAutoCanvasRestore auto_restore(&canvas, true);
+
+  // The image covers the rounded out device bounds of the logical rect
+  // under the integral version of the |raster_matrix| it was rasterized
+  // with. Map those bounds back to logical space, including the snapped
+  // translation, to find the area that the image covers at the current
+  // transform.
+  SkMatrix integral_raster_matrix =
+      RasterCacheUtil::GetIntegralTransCTM(raster_matrix);
+  SkMatrix inverse_raster_matrix;
+  if (!integral_raster_matrix.invert(&inverse_raster_matrix)) {
+    return;
+  }
+  SkRect raster_bounds = RasterCacheUtil::GetRoundedOutDeviceBounds(
+      logical_rect_, integral_raster_matrix);
+  SkRect image_rect = inverse_raster_matrix.mapRect(raster_bounds);
+  SkRect bounds = canvas.GetTransform().mapRect(image_rect);
+
+  canvas.TransformReset();
+  flow_.Step();
+  canvas.DrawImageRect(image_, bounds, DlImageSampling::kMipmapLinear, paint);
+}
+
 RasterCache::RasterCache(size_t access_threshold,
                          size_t display_list_cache_limit_per_frame)
     : access_threshold_(access_threshold),
@@ -82,35 +170,15 @@ std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
     const std::function<void(DlCanvas*)>& draw_function,
     const std::function<void(DlCanvas*, const SkRect& rect)>& draw_checkerboard)
     const {
-  auto matrix = RasterCacheUtil::GetIntegralTransCTM(context.matrix);
-  SkRect dest_rect =
-      RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
-
-  const SkImageInfo image_info = SkImageInfo::MakeN32Premul(
-      dest_rect.width(), dest_rect.height(), context.dst_color_space);
-
-  sk_sp<SkSurface> surface =
-      context.gr_context
-          ? SkSurfaces::RenderTarget(context.gr_context, skgpu::Budgeted::kYes,
-                                     image_info)
-          : SkSurfaces::Raster(image_info);
-
-  if (!surface) {
+  sk_sp<SkImage> sk_image = RasterizeImage(
+      context.gr_context, context.dst_color_space, context.matrix,
+      context.logical_rect, draw_function, draw_checkerboard,
+      checkerboard_images_, scale_band_ > 1.0f);
+  if (!sk_image) {
     return nullptr;
   }
 
-  DlSkCanvasAdapter canvas(surface->getCanvas());
-  canvas.Clear(DlColor::kTransparent());
-
-  canvas.Translate(-dest_rect.left(), -dest_rect.top());
-  canvas.Transform(matrix);
-  draw_function(&canvas);
-
-  if (checkerboard_images_) {
-    draw_checkerboard(&canvas, context.logical_rect);
-  }
-
-  auto image = DlImage::Make(surface->makeImageSnapshot());
+  auto image = DlImage::Make(std::move(sk_image));
   return std::make_unique<RasterCacheResult>(
       image, context.logical_rect, context.flow_type, std::move(rtree));
 }
@@ -122,6 +190,11 @@ bool RasterCache::UpdateCacheEntry(
     sk_sp<const DlRTree> rtree) const {
   RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
   Entry& entry = cache_[key];
+  if (!entry.image && !IsSettled(entry) &&
+      FindScaledEntry(id, raster_cache_context.matrix, nullptr) != nullptr) {
+    // Another entry is drawn scaled instead while the scale is changing.
+    return true;
+  }
   if (!entry.image) {
     void (*func)(DlCanvas*, const SkRect& rect) = DrawCheckerboard;
     entry.image = Rasterize(raster_cache_context, std::move(rtree),
@@ -141,6 +214,86 @@ bool RasterCache::UpdateCacheEntry(
   return entry.image != nullptr;
 }
 
+bool RasterCache::UpdateCacheEntryInBackground(
+    const RasterCacheKeyID& id,
+    const Context& raster_cache_context,
+    const std::function<void(DlCanvas*)>& render_function,
+    sk_sp<const DlRTree> rtree) const {
+  FML_DCHECK(background_population_enabled());
+  RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
+  Entry& entry = cache_[key];
+  if (entry.image) {
+    return true;
+  }
+
+  if (entry.background_rasterization) {
+    if (!entry.background_rasterization->done.load(std::memory_order_acquire)) {
+      return false;
+    }
+    sk_sp<SkImage> image = std::move(entry.background_rasterization->image);
+    entry.background_rasterization.reset();
+    if (!image) {
+      // The rasterization failed. The entry is queued again on a later frame.
+      return false;
+    }
+    if (raster_cache_context.gr_context) {
+      TRACE_EVENT0("flutter", "RasterCache::UploadBackgroundImage");
+      sk_sp<SkImage> texture = SkImages::TextureFromImage(
+          raster_cache_context.gr_context, image,
+          scale_band_ > 1.0f ? skgpu::Mipmapped::kYes : skgpu::Mipmapped::kNo);
+      if (texture) {
+        image = std::move(texture);
+      }
+    }
+    entry.image = std::make_unique<RasterCacheResult>(
+        DlImage::Make(std::move(image)), raster_cache_context.logical_rect,
+        raster_cache_context.flow_type, std::move(rtree));
+    return true;
+  }
+
+  if (!IsSettled(entry) &&
+      FindScaledEntry(id, raster_cache_context.matrix, nullptr) != nullptr) {
+    // Another entry is drawn scaled instead while the scale is changing.
+    return true;
+  }
+
+  auto matrix =
+      RasterCacheUtil::GetIntegralTransCTM(raster_cache_context.matrix);
+  SkRect dest_rect = RasterCacheUtil::GetRoundedOutDeviceBounds(
+      raster_cache_context.logical_rect, matrix);
+  size_t pixels = static_cast<size_t>(dest_rect.width()) *
+                  static_cast<size_t>(dest_rect.height());
+  if (background_pixels_queued_this_frame_ > 0 &&
+      background_pixels_queued_this_frame_ + pixels >
+          background_pixels_per_frame_) {
+    // Over budget for this frame, try again on the next one.
+    return false;
+  }
+  background_pixels_queued_this_frame_ += pixels;
+
+  auto rasterization = std::make_shared<BackgroundRasterization>();
+  entry.background_rasterization = rasterization;
+  background_task_runner_->PostTask(
+      [rasterization,                                          //
+       render_function,                                        //
+       dst_color_space = raster_cache_context.dst_color_space,  //
+       matrix = raster_cache_context.matrix,                   //
+       logical_rect = raster_cache_context.logical_rect,       //
+       checkerboard = checkerboard_images_,                    //
+       mipmapped = scale_band_ > 1.0f                          //
+  ]() {
+        TRACE_EVENT0("flutter", "RasterCache::RasterizeInBackground");
+        void (*draw_checkerboard)(DlCanvas*, const SkRect& rect) =
+            DrawCheckerboard;
+        rasterization->image =
+            RasterizeImage(nullptr, dst_color_space, matrix, logical_rect,
+                           render_function, draw_checkerboard, checkerboard,
+                           mipmapped);
+        rasterization->done.store(true, std::memory_order_release);
+      });
+  return false;
+}
+
 RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
                                              const SkMatrix& matrix,
                                              bool visible) const {
@@ -151,7 +304,60 @@ RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
   if (visible || entry.accesses_since_visible > 0) {
     entry.accesses_since_visible++;
   }
-  return {entry.accesses_since_visible, entry.image != nullptr};
+  bool has_image = entry.image != nullptr;
+  if (!has_image) {
+    Entry* scaled_entry = FindScaledEntry(id, matrix, nullptr);
+    if (scaled_entry) {
+      // Keep the entry that stands in for this one from being evicted.
+      scaled_entry->encountered_this_frame = true;
+      has_image = true;
+    }
+  }
+  return {entry.accesses_since_visible, has_image};
+}
+
+bool RasterCache::IsSettled(const Entry& entry) const {
+  return entry.accesses_since_visible >= kSettledFrameCount;
+}
+
+RasterCache::Entry* RasterCache::FindScaledEntry(
+    const RasterCacheKeyID& id,
+    const SkMatrix& matrix,
+    SkMatrix* raster_matrix) const {
+  if (scale_band_ <= 1.0f || cache_.empty() ||
+      !IsPositiveScaleTranslate(matrix)) {
+    return nullptr;
+  }
+  // Entries are hashed by their id alone, so all of the entries for the id
+  // are in the same bucket.
+  RasterCacheKey key = RasterCacheKey(id, matrix);
+  size_t bucket = cache_.bucket(key);
+  Entry* best_entry = nullptr;
+  float best_distance = 0.0f;
+  for (auto it = cache_.begin(bucket); it != cache_.end(bucket); ++it) {
+    const SkMatrix& entry_matrix = it->first.matrix();
+    if (it->first.id() != id || !it->second.image ||
+        !IsPositiveScaleTranslate(entry_matrix)) {
+      continue;
+    }
+    // Only entries rasterized at a larger scale are drawn scaled. Scaling
+    // up would blur the content.
+    float ratio_x = entry_matrix.getScaleX() / matrix.getScaleX();
+    float ratio_y = entry_matrix.getScaleY() / matrix.getScaleY();
+    if (ratio_x > scale_band_ || ratio_x < 1.0f ||  //
+        ratio_y > scale_band_ || ratio_y < 1.0f) {
+      continue;
+    }
+    float distance = std::abs(std::log(ratio_x)) + std::abs(std::log(ratio_y));
+    if (!best_entry || distance < best_distance) {
+      best_entry = &it->second;
+      best_distance = distance;
+      if (raster_matrix) {
+        *raster_matrix = entry_matrix;
+      }
+    }
+  }
+  return best_entry;
 }
 
 int RasterCache::GetAccessCount(const RasterCacheKeyID& id,
@@ -177,23 +383,34 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
                        DlCanvas& canvas,
                        const DlPaint* paint,
                        bool preserve_rtree) const {
-  auto it = cache_.find(RasterCacheKey(id, canvas.GetTransform()));
-  if (it == cache_.end()) {
-    return false;
+  RasterCacheKey key = RasterCacheKey(id, canvas.GetTransform());
+  RasterCacheMetrics& metrics = GetMetricsForKind(key.kind());
+  auto it = cache_.find(key);
+  if (it != cache_.end() && it->second.image) {
+    it->second.image->draw(canvas, paint, preserve_rtree);
+    metrics.exact_hit_count++;
+    return true;
   }
 
-  Entry& entry = it->second;
-
-  if (entry.image) {
-    entry.image->draw(canvas, paint, preserve_rtree);
-    return true;
+  // A scaled draw of the image would not preserve the RTree.
+  if (!preserve_rtree) {
+    SkMatrix raster_matrix;
+    Entry* scaled_entry =
+        FindScaledEntry(id, canvas.GetTransform(), &raster_matrix);
+    if (scaled_entry) {
+      scaled_entry->image->draw_scaled(canvas, paint, raster_matrix);
+      metrics.scaled_hit_count++;
+      return true;
+    }
   }
 
+  metrics.miss_count++;
   return false;
 }
 
 void RasterCache::BeginFrame() {
   display_list_cached_this_frame_ = 0;
+  background_pixels_queued_this_frame_ = 0;
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
@@ -206,6 +423,8 @@ void RasterCache::UpdateMetrics() {
       RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
       metrics.in_use_count++;
       metrics.in_use_bytes += entry.image->image_bytes();
+    } else if (entry.background_rasterization) {
+      GetMetricsForKind(it->first.kind()).pending_count++;
     }
     entry.encountered_this_frame = false;
   }
@@ -301,7 +520,8 @@ size_t RasterCache::EstimatePictureCacheByteSize() const {
   return picture_cache_bytes;
 }
 
-RasterCacheMetrics& RasterCache::GetMetricsForKind(RasterCacheKeyKind kind) {
+RasterCacheMetrics& RasterCache::GetMetricsForKind(
+    RasterCacheKeyKind kind) const {
   switch (kind) {
     case RasterCacheKeyKind::kDisplayListMetrics:
       return picture_metrics_;
@@ -15,6 +15,7 @@
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkRect.h"
@@ -24,6 +25,8 @@ class SkColorSpace;
 
 namespace flutter {
 
+class DisplayListComplexityCalculator;
+
 enum class RasterCacheLayerStrategy { kLayer, kLayerChildren };
 
 class RasterCacheResult {
@@ -39,6 +42,14 @@ class RasterCacheResult {
                     const DlPaint* paint,
                     bool preserve_rtree) const;
 
+  // Draws the image scaled to the device bounds of the logical rect under
+  // the current transform of the |canvas|, which may differ in scale from
+  // the |raster_matrix| that the image was rasterized with. Both matrices
+  // must be scale and translate only.
+  virtual void draw_scaled(DlCanvas& canvas,
+                           const DlPaint* paint,
+                           const SkMatrix& raster_matrix) const;
+
   virtual SkISize image_dimensions() const {
     return image_ ? image_->dimensions() : SkISize::Make(0, 0);
   };
@@ -80,6 +91,40 @@ struct RasterCacheMetrics {
    */
   size_t in_use_bytes = 0;
 
+  /**
+   * The number of cache entries waiting for their image to be rasterized
+   * on the background task runner during this frame.
+   */
+  size_t pending_count = 0;
+
+  /**
+   * The number of draws in this frame from an entry rasterized with the
+   * same transform as the draw.
+   */
+  size_t exact_hit_count = 0;
+
+  /**
+   * The number of draws in this frame from an entry rasterized at a
+   * different scale within the scale band (see |RasterCache::SetScaleBand|).
+   */
+  size_t scaled_hit_count = 0;
+
+  /**
+   * The number of attempts in this frame to draw an entry that had no
+   * usable image.
+   */
+  size_t miss_count = 0;
+
+  /**
+   * The fraction of draw attempts in this frame that were drawn from the
+   * cache, or 0 if there were no attempts.
+   */
+  double hit_rate() const {
+    size_t hits = exact_hit_count + scaled_hit_count;
+    size_t attempts = hits + miss_count;
+    return attempts == 0 ? 0.0 : static_cast<double>(hits) / attempts;
+  }
+
   /**
    * The total cache entries that had images during this frame.
    */
@@ -108,7 +153,10 @@ struct RasterCacheMetrics {
  *   - RasterCache::EvictUnusedCacheEntries
  *       Evict cached images that are no longer used.
  *   - LayerTree::TryToPrepareRasterCache
- *       Create cache image for each cache entry if it does not exist.
+ *       Create cache image for each cache entry if it does not exist. If
+ *       background population is enabled, display list entries are instead
+ *       queued for rasterization on the background task runner and receive
+ *       their image on the first frame after that rasterization finishes.
  *   - LayerTree::Paint - for each layer in the tree:
  *       If layers or display lists are cached as cached images, the method
  *       `RasterCache::Draw` will be used to draw those cache images.
@@ -246,25 +294,130 @@ class RasterCache {
                         const std::function<void(DlCanvas*)>& render_function,
                         sk_sp<const DlRTree> rtree = nullptr) const;
 
+  /**
+   * @brief Like |UpdateCacheEntry|, but renders the entry on the background
+   * task runner instead of inline.
+   *
+   * The first call for an entry without an image queues the rasterization,
+   * subject to the per-frame pixel budget, and returns false so that the
+   * caller keeps drawing the content directly. A later call, on a frame
+   * after the rasterization has finished, moves the result into the entry
+   * (uploading it to |gr_context| if there is one) and returns true.
+   *
+   * The |render_function| is called on a background thread with a software
+   * canvas, so it must only reference content that is safe to render off
+   * of the raster thread, e.g. a DisplayList for which
+   * |DisplayList::isUIThreadSafe| is true.
+   *
+   * Requires |background_population_enabled|.
+   */
+  bool UpdateCacheEntryInBackground(
+      const RasterCacheKeyID& id,
+      const Context& raster_cache_context,
+      const std::function<void(DlCanvas*)>& render_function,
+      sk_sp<const DlRTree> rtree = nullptr) const;
+
+  /**
+   * @brief Enables rasterizing display list cache entries on |task_runner|
+   * rather than in the frame in which they are first cached (see
+   * |UpdateCacheEntryInBackground|). At most |pixels_per_frame| device
+   * pixels of entries are queued per frame. A null |task_runner| disables
+   * background population.
+   */
+  void EnableBackgroundPopulation(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner,
+      size_t pixels_per_frame =
+          RasterCacheUtil::kDefaultBackgroundPopulationPixelsPerFrame) {
+    background_task_runner_ = std::move(task_runner);
+    background_pixels_per_frame_ = pixels_per_frame;
+  }
+
+  bool background_population_enabled() const {
+    return background_task_runner_ != nullptr;
+  }
+
+  /**
+   * @brief Allows an entry rasterized with one scale to be drawn, and to
+   * stand in for rasterizing a new entry, at a smaller scale when the ratio
+   * between the two scales is within [1, |scale_band|] on both axes. This
+   * avoids re-rasterizing pictures at every intermediate scale of a
+   * pinch-zoom or scale animation. Once the same scale has been used for
+   * |kSettledFrameCount| frames, an entry is rasterized at that exact
+   * scale so that the content is crisp when the animation ends. Only
+   * transforms that are scale and translate are matched this way.
+   *
+   * A |scale_band| of 1, the default, requires the scales to match
+   * exactly. Entries are rasterized with mipmaps when the band is wider so
+   * that down-scaled draws stay crisp.
+   */
+  void SetScaleBand(float scale_band) {
+    FML_DCHECK(scale_band >= 1.0f);
+    scale_band_ = scale_band;
+  }
+
+  float scale_band() const { return scale_band_; }
+
+  /**
+   * @brief Overrides the calculator used to decide whether a display list
+   * is complex enough to be worth caching, e.g. with a calculator for a
+   * cost model (see DisplayListModelComplexityCalculator). If
+   * null, which is the default, the calculator for the backend of the
+   * frame is used.
+   */
+  void SetComplexityCalculator(DisplayListComplexityCalculator* calculator) {
+    complexity_calculator_ = calculator;
+  }
+
+  DisplayListComplexityCalculator* complexity_calculator() const {
+    return complexity_calculator_;
+  }
+
  private:
+  // The state shared between an entry and the background task rasterizing
+  // its image, see |UpdateCacheEntryInBackground|.
+  struct BackgroundRasterization;
+
   struct Entry {
     bool encountered_this_frame = false;
     bool visible_this_frame = false;
     size_t accesses_since_visible = 0;
     std::unique_ptr<RasterCacheResult> image;
+    std::shared_ptr<BackgroundRasterization> background_rasterization;
   };
 
+  // The number of consecutive frames a transform must be used before an
+  // entry is rasterized for it even though a scaled entry could stand in.
+  static constexpr size_t kSettledFrameCount = 2;
+
+  // Whether the transform of the |entry| has been used long enough that it
+  // should get its own image, see |SetScaleBand|.
+  bool IsSettled(const Entry& entry) const;
+
   void UpdateMetrics();
 
-  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind);
+  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind) const;
+
+  // Returns the entry with an image for the |id| that was rasterized with
+  // the smallest scale that is at least that of |matrix| and within the
+  // scale band, or nullptr if there is none. The matrix of the entry is
+  // stored in |raster_matrix| if it is not null.
+  Entry* FindScaledEntry(const RasterCacheKeyID& id,
+                         const SkMatrix& matrix,
+                         SkMatrix* raster_matrix) const;
 
   const size_t access_threshold_;
   const size_t display_list_cache_limit_per_frame_;
   mutable size_t display_list_cached_this_frame_ = 0;
-  RasterCacheMetrics layer_metrics_;
-  RasterCacheMetrics picture_metrics_;
+  mutable RasterCacheMetrics layer_metrics_;
+  mutable RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
   bool checkerboard_images_ = false;
+  DisplayListComplexityCalculator* complexity_calculator_ = nullptr;
+  std::shared_ptr<fml::BasicTaskRunner> background_task_runner_;
+  size_t background_pixels_per_frame_ =
+      RasterCacheUtil::kDefaultBackgroundPopulationPixelsPerFrame;
+  mutable size_t background_pixels_queued_this_frame_ = 0;
+  float scale_band_ = 1.0f;
 
   void TraceStatsToTimeline() const;
 
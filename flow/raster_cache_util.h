@@ -19,6 +19,13 @@ struct RasterCacheUtil {
   // the work across multiple frames.
   static constexpr int kDefaultPictureAndDisplayListCacheLimitPerFrame = 3;
 
+  // The number of device pixels of display list cache entries that may be
+  // queued for rasterization on the background task runner per frame, when
+  // background population is enabled. A single entry larger than the budget
+  // is still queued on a frame that has not queued anything else.
+  static constexpr size_t kDefaultBackgroundPopulationPixelsPerFrame =
+      2 * 1024 * 1024;
+
   // The ImageFilterLayer might cache the filtered output of this layer
   // if the layer remains stable (if it is not animating for instance).
   // If the ImageFilterLayer is not the same between rendered frames,
@@ -33,6 +33,10 @@ class MockRasterCacheResult : public RasterCacheResult {
             const DlPaint* paint = nullptr,
             bool preserve_rtree = false) const override {};
 
+  void draw_scaled(DlCanvas& canvas,
+                   const DlPaint* paint,
+                   const SkMatrix& raster_matrix) const override {};
+
   SkISize image_dimensions() const override {
     return SkSize::Make(device_rect_.width(), device_rect_.height()).toCeil();
   };
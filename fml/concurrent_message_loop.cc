@@ -11,13 +11,31 @@
 
 namespace fml {
 
+namespace {
+
+// The number of times an idle worker looks for tasks to run or steal before
+// it goes to sleep. Tasks are often posted in bursts, and waking a sleeping
+// worker is much more expensive than looking again.
+constexpr size_t kIdleSpinCount = 64;
+
+// The loop and worker index of the current thread if it is a worker.
+thread_local ConcurrentMessageLoop* tls_loop = nullptr;
+thread_local size_t tls_worker_index = 0;
+
+}  // namespace
+
 ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+  for (size_t i = 0; i < worker_count_; ++i) {
+    worker_tasks_.push_back(
+        std::make_unique<WorkStealingDeque<fml::closure>>());
+  }
+
   for (size_t i = 0; i < worker_count_; ++i) {
     workers_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
           std::string{"io.worker." + std::to_string(i + 1)}));
-      WorkerMain();
+      WorkerMain(i);
     });
   }
 
@@ -32,6 +50,14 @@ ConcurrentMessageLoop::~ConcurrentMessageLoop() {
     FML_DCHECK(worker.joinable());
     worker.join();
   }
+
+  // Tasks that were not run before the workers shut down are dropped, the
+  // workers have exited so the deques can be popped from this thread.
+  for (auto& worker_tasks : worker_tasks_) {
+    while (fml::closure* task = worker_tasks->Pop()) {
+      delete task;
+    }
+  }
 }
 
 size_t ConcurrentMessageLoop::GetWorkerCount() const {
@@ -47,6 +73,14 @@ void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
     return;
   }
 
+  // Tasks posted by a task running on a worker go to the deque of that
+  // worker without taking any locks.
+  if (tls_loop == this && !shutdown_.load(std::memory_order_relaxed)) {
+    worker_tasks_[tls_worker_index]->Push(new fml::closure(task));
+    WakeSleepingWorker();
+    return;
+  }
+
   std::unique_lock lock(tasks_mutex_);
 
   // Don't just drop tasks on the floor in case of shutdown.
@@ -60,56 +94,116 @@ void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
   }
 
   tasks_.push(task);
+  tasks_count_.store(tasks_.size(), std::memory_order_relaxed);
 
   // Unlock the mutex before notifying the condition variable because that mutex
   // has to be acquired on the other thread anyway. Waiting in this scope till
   // it is acquired there is a pessimization.
   lock.unlock();
 
-  tasks_condition_.notify_one();
+  if (sleeping_worker_count_.load() > 0) {
+    tasks_condition_.notify_one();
+  }
 }
 
-void ConcurrentMessageLoop::WorkerMain() {
-  while (true) {
-    std::unique_lock lock(tasks_mutex_);
-    tasks_condition_.wait(lock, [&]() {
-      return !tasks_.empty() || shutdown_ || HasThreadTasksLocked();
-    });
+void ConcurrentMessageLoop::WorkerMain(size_t worker_index) {
+  tls_loop = this;
+  tls_worker_index = worker_index;
 
-    // Shutdown cannot be read with the task mutex unlocked.
-    bool shutdown_now = shutdown_;
-    fml::closure task;
-    std::vector<fml::closure> thread_tasks;
+  size_t idle_spins = 0;
+  while (!shutdown_) {
+    if (thread_tasks_count_.load(std::memory_order_relaxed) > 0) {
+      RunThreadTasks();
+    }
 
-    if (!tasks_.empty()) {
-      task = tasks_.front();
-      tasks_.pop();
+    if (std::unique_ptr<fml::closure> task = TakeTask(worker_index)) {
+      idle_spins = 0;
+      ExecuteTask(*task);
+      continue;
     }
 
-    if (HasThreadTasksLocked()) {
-      thread_tasks = GetThreadTasksLocked();
-      FML_DCHECK(!HasThreadTasksLocked());
+    if (idle_spins < kIdleSpinCount) {
+      idle_spins++;
+      std::this_thread::yield();
+      continue;
     }
 
-    // Don't hold onto the mutex while tasks are being executed as they could
-    // themselves try to post more tasks to the message loop.
-    lock.unlock();
+    idle_spins = 0;
+    Sleep();
+  }
+
+  // Tasks posted to all workers are still run on shutdown.
+  RunThreadTasks();
 
-    TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
-    // Execute the primary task we woke up for.
-    if (task) {
-      ExecuteTask(task);
+  tls_loop = nullptr;
+}
+
+std::unique_ptr<fml::closure> ConcurrentMessageLoop::TakeTask(
+    size_t worker_index) {
+  // Prefer the most recent task posted by this worker.
+  if (fml::closure* task = worker_tasks_[worker_index]->Pop()) {
+    return std::unique_ptr<fml::closure>(task);
+  }
+
+  if (tasks_count_.load(std::memory_order_relaxed) > 0) {
+    std::scoped_lock lock(tasks_mutex_);
+    if (!tasks_.empty()) {
+      auto task = std::make_unique<fml::closure>(std::move(tasks_.front()));
+      tasks_.pop();
+      tasks_count_.store(tasks_.size(), std::memory_order_relaxed);
+      return task;
     }
+  }
 
-    // Execute any thread tasks.
-    for (const auto& thread_task : thread_tasks) {
-      ExecuteTask(thread_task);
+  // Steal the oldest task of another worker, starting with the next worker
+  // so that thieves spread out over the victims.
+  for (size_t i = 1; i < worker_count_; i++) {
+    size_t victim = (worker_index + i) % worker_count_;
+    if (fml::closure* task = worker_tasks_[victim]->Steal()) {
+      return std::unique_ptr<fml::closure>(task);
     }
+  }
+  return nullptr;
+}
 
-    if (shutdown_now) {
-      break;
+void ConcurrentMessageLoop::RunThreadTasks() {
+  std::vector<fml::closure> thread_tasks;
+  {
+    std::scoped_lock lock(tasks_mutex_);
+    if (!HasThreadTasksLocked()) {
+      return;
     }
+    thread_tasks = GetThreadTasksLocked();
+    FML_DCHECK(!HasThreadTasksLocked());
+  }
+
+  TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
+  for (const auto& thread_task : thread_tasks) {
+    ExecuteTask(thread_task);
+  }
+}
+
+void ConcurrentMessageLoop::Sleep() {
+  std::unique_lock lock(tasks_mutex_);
+  // Announce the intent to sleep before the final check for tasks. A worker
+  // that pushes a task to its deque checks for sleeping workers after the
+  // push, so either this check sees the task or that worker sees this one.
+  sleeping_worker_count_.fetch_add(1);
+  if (!shutdown_ && !HasTasksLocked()) {
+    tasks_condition_.wait(lock);
   }
+  sleeping_worker_count_.fetch_sub(1);
+}
+
+void ConcurrentMessageLoop::WakeSleepingWorker() {
+  if (sleeping_worker_count_.load() == 0) {
+    return;
+  }
+  // A worker that is going to sleep holds the mutex until it is waiting on
+  // the condition variable, so acquiring it ensures the notification isn't
+  // missed.
+  { std::scoped_lock lock(tasks_mutex_); }
+  tasks_condition_.notify_one();
 }
 
 void ConcurrentMessageLoop::ExecuteTask(const fml::closure& task) {
@@ -131,9 +225,20 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
   for (const auto& worker_thread_id : worker_thread_ids_) {
     thread_tasks_[worker_thread_id].emplace_back(task);
   }
+  thread_tasks_count_.store(thread_tasks_.size(), std::memory_order_relaxed);
   tasks_condition_.notify_all();
 }
 
+bool ConcurrentMessageLoop::HasTasksLocked() const {
+  if (!tasks_.empty() || HasThreadTasksLocked()) {
+    return true;
+  }
+  return std::any_of(worker_tasks_.begin(), worker_tasks_.end(),
+                     [](const auto& worker_tasks) {
+                       return !worker_tasks->IsEmpty();
+                     });
+}
+
 bool ConcurrentMessageLoop::HasThreadTasksLocked() const {
   return thread_tasks_.count(std::this_thread::get_id()) > 0;
 }
@@ -144,6 +249,7 @@ std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasksLocked() {
   std::vector<fml::closure> pending_tasks;
   std::swap(pending_tasks, found->second);
   thread_tasks_.erase(found);
+  thread_tasks_count_.store(thread_tasks_.size(), std::memory_order_relaxed);
   return pending_tasks;
 }
 
@@ -170,13 +276,7 @@ void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
 }
 
 bool ConcurrentMessageLoop::RunsTasksOnCurrentThread() {
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    if (worker_thread_id == std::this_thread::get_id()) {
-      return true;
-    }
-  }
-  return false;
+  return tls_loop == this;
 }
 
 }  // namespace fml
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <map>
 #include <queue>
@@ -13,11 +14,19 @@
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/work_stealing_deque.h"
 
 namespace fml {
 
 class ConcurrentTaskRunner;
 
+/// A pool of worker threads that run the tasks posted to it.
+///
+/// Tasks posted from outside the pool go to a shared queue. Tasks posted by
+/// a task that is running on a worker go to a deque owned by that worker,
+/// which runs the most recently posted of them first while they are likely
+/// to still be in its caches. Workers that run out of tasks steal the oldest
+/// tasks of the other workers, and spin for a while before going to sleep.
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
@@ -45,17 +54,36 @@ class ConcurrentMessageLoop
 
   size_t worker_count_ = 0;
   std::vector<std::thread> workers_;
+  // The tasks posted by tasks running on each worker.
+  std::vector<std::unique_ptr<WorkStealingDeque<fml::closure>>> worker_tasks_;
   std::mutex tasks_mutex_;
   std::condition_variable tasks_condition_;
   std::queue<fml::closure> tasks_;
+  // The size of |tasks_|, readable without |tasks_mutex_|.
+  std::atomic_size_t tasks_count_ = 0;
   std::vector<std::thread::id> worker_thread_ids_;
   std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
+  // The size of |thread_tasks_|, readable without |tasks_mutex_|.
+  std::atomic_size_t thread_tasks_count_ = 0;
+  // The number of workers that are, or are about to be, waiting on
+  // |tasks_condition_|.
+  std::atomic_size_t sleeping_worker_count_ = 0;
+  std::atomic_bool shutdown_ = false;
 
-  void WorkerMain();
+  void WorkerMain(size_t worker_index);
 
   void PostTask(const fml::closure& task);
 
+  std::unique_ptr<fml::closure> TakeTask(size_t worker_index);
+
+  void RunThreadTasks();
+
+  void Sleep();
+
+  void WakeSleepingWorker();
+
+  bool HasTasksLocked() const;
+
   bool HasThreadTasksLocked() const;
 
   std::vector<fml::closure> GetThreadTasksLocked();
@@ -0,0 +1,164 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/concurrent_message_loop.h"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+// The design ConcurrentMessageLoop used before it had per-worker deques, a
+// single queue guarded by a mutex with a condition variable, as a baseline.
+class SharedQueueLoop {
+ public:
+  explicit SharedQueueLoop(size_t worker_count) {
+    for (size_t i = 0; i < worker_count; i++) {
+      workers_.emplace_back([this]() { WorkerMain(); });
+    }
+  }
+
+  ~SharedQueueLoop() {
+    {
+      std::scoped_lock lock(mutex_);
+      shutdown_ = true;
+    }
+    condition_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  void PostTask(const fml::closure& task) {
+    {
+      std::scoped_lock lock(mutex_);
+      tasks_.push(task);
+    }
+    condition_.notify_one();
+  }
+
+ private:
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::queue<fml::closure> tasks_;
+  bool shutdown_ = false;
+
+  void WorkerMain() {
+    while (true) {
+      std::unique_lock lock(mutex_);
+      condition_.wait(lock, [&]() { return !tasks_.empty() || shutdown_; });
+      if (tasks_.empty()) {
+        return;
+      }
+      fml::closure task = std::move(tasks_.front());
+      tasks_.pop();
+      lock.unlock();
+      task();
+    }
+  }
+};
+
+class WorkStealingLoop {
+ public:
+  explicit WorkStealingLoop(size_t worker_count)
+      : loop_(ConcurrentMessageLoop::Create(worker_count)),
+        task_runner_(loop_->GetTaskRunner()) {}
+
+  void PostTask(const fml::closure& task) { task_runner_->PostTask(task); }
+
+ private:
+  std::shared_ptr<ConcurrentMessageLoop> loop_;
+  std::shared_ptr<ConcurrentTaskRunner> task_runner_;
+};
+
+// A small amount of work for each task, so that the benchmarks measure the
+// scheduling of tasks rather than the tasks themselves.
+void SpinFor(size_t iterations) {
+  for (size_t i = 0; i < iterations; i++) {
+    benchmark::DoNotOptimize(i);
+  }
+}
+
+constexpr size_t kWorkerCount = 4;
+constexpr size_t kTaskWork = 100;
+
+}  // namespace
+
+// Posts a burst of independent tasks from a thread outside the loop, e.g.
+// image decodes posted from the UI thread.
+template <typename Loop>
+static void BM_FanOut(benchmark::State& state) {  // NOLINT
+  Loop loop(kWorkerCount);
+  const size_t task_count = state.range(0);
+  for (auto _ : state) {
+    CountDownLatch latch(task_count);
+    for (size_t i = 0; i < task_count; i++) {
+      loop.PostTask([&latch]() {
+        SpinFor(kTaskWork);
+        latch.CountDown();
+      });
+    }
+    latch.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * task_count);
+}
+
+// Posts a single task that recursively splits into two tasks until the given
+// depth, with the leaves doing the work, e.g. work split across tiles.
+template <typename Loop>
+static void BM_ForkJoin(benchmark::State& state) {  // NOLINT
+  const size_t depth = state.range(0);
+  const size_t leaf_count = size_t{1} << depth;
+  // Declared before the loop so that the tasks that are still returning when
+  // the last leaf is done are joined before it is destroyed.
+  std::function<void(size_t)> fork;
+  Loop loop(kWorkerCount);
+  CountDownLatch* latch = nullptr;
+  fork = [&](size_t level) {
+    if (level == depth) {
+      SpinFor(kTaskWork);
+      latch->CountDown();
+      return;
+    }
+    loop.PostTask([&fork, level]() { fork(level + 1); });
+    loop.PostTask([&fork, level]() { fork(level + 1); });
+  };
+  for (auto _ : state) {
+    CountDownLatch leaves_done(leaf_count);
+    latch = &leaves_done;
+    loop.PostTask([&fork]() { fork(0); });
+    leaves_done.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * leaf_count);
+}
+
+BENCHMARK_TEMPLATE(BM_FanOut, SharedQueueLoop)
+    ->RangeMultiplier(8)
+    ->Range(8, 4096)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_FanOut, WorkStealingLoop)
+    ->RangeMultiplier(8)
+    ->Range(8, 4096)
+    ->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_ForkJoin, SharedQueueLoop)
+    ->DenseRange(4, 12, 4)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ForkJoin, WorkStealingLoop)
+    ->DenseRange(4, 12, 4)
+    ->UseRealTime();
+
+}  // namespace benchmarking
+}  // namespace fml
@@ -34,6 +34,34 @@ class TaskSourceGradeHolder {
 static thread_local std::unique_ptr<TaskSourceGradeHolder>
     tls_task_source_grade;
 
+// Locks a TaskQueue along with every TaskQueue it has subsumed. The queues
+// are always locked in the order of their ids so that concurrent group locks
+// of overlapping groups can't deadlock. The topology lock must be held for
+// the lifetime of this object so that the group doesn't change.
+class MessageLoopTaskQueues::QueueGroupLock {
+ public:
+  QueueGroupLock(const MessageLoopTaskQueues& queues, TaskQueueId owner) {
+    const auto& owner_entry = queues.queue_entries_.at(owner);
+    if (owner_entry->owner_of.empty()) {
+      locks_.emplace_back(owner_entry->mutex);
+      return;
+    }
+    std::vector<TaskQueueId> queue_ids(owner_entry->owner_of.begin(),
+                                       owner_entry->owner_of.end());
+    queue_ids.push_back(owner);
+    std::sort(queue_ids.begin(), queue_ids.end());
+    locks_.reserve(queue_ids.size());
+    for (TaskQueueId queue_id : queue_ids) {
+      locks_.emplace_back(queues.queue_entries_.at(queue_id)->mutex);
+    }
+  }
+
+ private:
+  std::vector<std::unique_lock<std::mutex>> locks_;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(QueueGroupLock);
+};
+
 TaskQueueEntry::TaskQueueEntry(TaskQueueId created_for_arg)
     : subsumed_by(kUnmerged), created_for(created_for_arg) {
   wakeable = NULL;
@@ -47,14 +75,15 @@ MessageLoopTaskQueues* MessageLoopTaskQueues::GetInstance() {
 }
 
 TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock topology_lock(*topology_mutex_);
   TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_);
   ++task_queue_id_counter_;
   queue_entries_[loop_id] = std::make_unique<TaskQueueEntry>(loop_id);
   return loop_id;
 }
 
-MessageLoopTaskQueues::MessageLoopTaskQueues() : order_(0) {
+MessageLoopTaskQueues::MessageLoopTaskQueues()
+    : topology_mutex_(fml::SharedMutex::Create()), order_(0) {
   tls_task_source_grade.reset(
       new TaskSourceGradeHolder{TaskSourceGrade::kUnspecified});
 }
@@ -62,7 +91,7 @@ MessageLoopTaskQueues::MessageLoopTaskQueues() : order_(0) {
 MessageLoopTaskQueues::~MessageLoopTaskQueues() = default;
 
 void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock topology_lock(*topology_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
@@ -74,7 +103,8 @@ void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
 }
 
 void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock topology_lock(*topology_mutex_);
+  QueueGroupLock group_lock(*this, queue_id);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
@@ -93,15 +123,16 @@ void MessageLoopTaskQueues::RegisterTask(
     const fml::closure& task,
     fml::TimePoint target_time,
     fml::TaskSourceGrade task_source_grade) {
-  std::lock_guard guard(queue_mutex_);
-  size_t order = order_++;
+  fml::SharedLock topology_lock(*topology_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
-  queue_entry->task_source->RegisterTask(
-      {order, task, target_time, task_source_grade});
   TaskQueueId loop_to_wake = queue_id;
   if (queue_entry->subsumed_by != kUnmerged) {
     loop_to_wake = queue_entry->subsumed_by;
   }
+  QueueGroupLock group_lock(*this, loop_to_wake);
+  size_t order = order_++;
+  queue_entry->task_source->RegisterTask(
+      {order, task, target_time, task_source_grade});
 
   // This can happen when the secondary tasks are paused.
   if (HasPendingTasksUnlocked(loop_to_wake)) {
@@ -110,13 +141,15 @@ void MessageLoopTaskQueues::RegisterTask(
 }
 
 bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock topology_lock(*topology_mutex_);
+  QueueGroupLock group_lock(*this, queue_id);
   return HasPendingTasksUnlocked(queue_id);
 }
 
 fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
                                                      fml::TimePoint from_time) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock topology_lock(*topology_mutex_);
+  QueueGroupLock group_lock(*this, queue_id);
   if (!HasPendingTasksUnlocked(queue_id)) {
     return nullptr;
   }
@@ -147,7 +180,8 @@ void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
 }
 
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock topology_lock(*topology_mutex_);
+  QueueGroupLock group_lock(*this, queue_id);
   const auto& queue_entry = queue_entries_.at(queue_id);
   if (queue_entry->subsumed_by != kUnmerged) {
     return 0;
@@ -167,20 +201,25 @@ size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
 void MessageLoopTaskQueues::AddTaskObserver(TaskQueueId queue_id,
                                             intptr_t key,
                                             const fml::closure& callback) {
-  std::lock_guard guard(queue_mutex_);
   FML_DCHECK(callback != nullptr) << "Observer callback must be non-null.";
-  queue_entries_.at(queue_id)->task_observers[key] = callback;
+  fml::SharedLock topology_lock(*topology_mutex_);
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  std::scoped_lock entry_lock(queue_entry->mutex);
+  queue_entry->task_observers[key] = callback;
 }
 
 void MessageLoopTaskQueues::RemoveTaskObserver(TaskQueueId queue_id,
                                                intptr_t key) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_observers.erase(key);
+  fml::SharedLock topology_lock(*topology_mutex_);
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  std::scoped_lock entry_lock(queue_entry->mutex);
+  queue_entry->task_observers.erase(key);
 }
 
 std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
     TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock topology_lock(*topology_mutex_);
+  QueueGroupLock group_lock(*this, queue_id);
   std::vector<fml::closure> observers;
 
   if (queue_entries_.at(queue_id)->subsumed_by != kUnmerged) {
@@ -203,17 +242,18 @@ std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
 
 void MessageLoopTaskQueues::SetWakeable(TaskQueueId queue_id,
                                         fml::Wakeable* wakeable) {
-  std::lock_guard guard(queue_mutex_);
-  FML_CHECK(!queue_entries_.at(queue_id)->wakeable)
-      << "Wakeable can only be set once.";
-  queue_entries_.at(queue_id)->wakeable = wakeable;
+  fml::SharedLock topology_lock(*topology_mutex_);
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  std::scoped_lock entry_lock(queue_entry->mutex);
+  FML_CHECK(!queue_entry->wakeable) << "Wakeable can only be set once.";
+  queue_entry->wakeable = wakeable;
 }
 
 bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   if (owner == subsumed) {
     return true;
   }
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock topology_lock(*topology_mutex_);
   auto& owner_entry = queue_entries_.at(owner);
   auto& subsumed_entry = queue_entries_.at(subsumed);
   auto& subsumed_set = owner_entry->owner_of;
@@ -261,7 +301,7 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
 }
 
 bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock topology_lock(*topology_mutex_);
   const auto& owner_entry = queue_entries_.at(owner);
   if (owner_entry->owner_of.empty()) {
     FML_LOG(WARNING)
@@ -305,7 +345,7 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
 
 bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
                                  TaskQueueId subsumed) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock topology_lock(*topology_mutex_);
   if (owner == kUnmerged || subsumed == kUnmerged) {
     return false;
   }
@@ -315,17 +355,20 @@ bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
 
 std::set<TaskQueueId> MessageLoopTaskQueues::GetSubsumedTaskQueueId(
     TaskQueueId owner) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock topology_lock(*topology_mutex_);
   return queue_entries_.at(owner)->owner_of;
 }
 
 void MessageLoopTaskQueues::PauseSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_source->PauseSecondary();
+  fml::SharedLock topology_lock(*topology_mutex_);
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  std::scoped_lock entry_lock(queue_entry->mutex);
+  queue_entry->task_source->PauseSecondary();
 }
 
 void MessageLoopTaskQueues::ResumeSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock topology_lock(*topology_mutex_);
+  QueueGroupLock group_lock(*this, queue_id);
   queue_entries_.at(queue_id)->task_source->ResumeSecondary();
   // Schedule a wake as needed.
   if (HasPendingTasksUnlocked(queue_id)) {
@@ -32,6 +32,12 @@ static const TaskQueueId kUnmerged = TaskQueueId(TaskQueueId::kUnmerged);
 class TaskQueueEntry {
  public:
   using TaskObservers = std::map<intptr_t, fml::closure>;
+
+  /// Guards \p wakeable, \p task_observers and \p task_source. The merge
+  /// state in \p owner_of and \p subsumed_by is instead guarded by the
+  /// topology lock of \p fml::MessageLoopTaskQueues.
+  std::mutex mutex;
+
   Wakeable* wakeable;
   TaskObservers task_observers;
   std::unique_ptr<TaskSource> task_source;
@@ -61,6 +67,13 @@ enum class FlushType {
 /// fml::MessageLoops.
 ///
 /// This also wakes up the loop at the required times.
+///
+/// Each TaskQueue has its own lock, so task runners of different TaskQueues,
+/// e.g. those of different engines in the same process, don't contend with
+/// each other. Operations that create, dispose, merge or unmerge TaskQueues
+/// take a process-wide topology lock exclusively, every other operation
+/// takes it shared and then locks only the queues it touches.
+///
 /// \see fml::MessageLoop
 /// \see fml::Wakeable
 class MessageLoopTaskQueues {
@@ -138,7 +151,7 @@ class MessageLoopTaskQueues {
   void ResumeSecondarySource(TaskQueueId queue_id);
 
  private:
-  class MergedQueuesRunner;
+  class QueueGroupLock;
 
   MessageLoopTaskQueues();
 
@@ -152,7 +165,12 @@ class MessageLoopTaskQueues {
 
   fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
 
-  mutable std::mutex queue_mutex_;
+  // The |*Unlocked| methods above must be called either with
+  // |topology_mutex_| held exclusively, or with it held shared along with the
+  // |QueueGroupLock| of the queue.
+
+  // Guards |queue_entries_| and the merge state of the entries.
+  std::unique_ptr<fml::SharedMutex> topology_mutex_;
   std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   size_t task_queue_id_counter_ = 0;
@@ -66,5 +66,100 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
 
 BENCHMARK(BM_RegisterAndGetTasks);
 
+// The number of task queues of each engine, i.e. platform, UI, raster and IO.
+static constexpr int kQueuesPerEngine = 4;
+
+// Runs one thread per task queue of |state.range(0)| engines. Each thread
+// posts tasks to its own queue and to the next queue of its engine, like the
+// UI and raster threads of an engine post to each other, and then drains its
+// own queue. If |state.range(1)| is non-zero the first two queues of each
+// engine are merged, like the platform and raster queues of an engine with
+// platform views.
+static void BM_RegisterAndGetTasksMultipleEngines(
+    benchmark::State& state) {  // NOLINT
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  const int num_engines = state.range(0);
+  const bool merge_queues = state.range(1) != 0;
+  const int num_task_queues = num_engines * kQueuesPerEngine;
+  const int num_tasks_per_queue = 100;
+
+  while (state.KeepRunning()) {
+    std::vector<TaskQueueId> queue_ids;
+    queue_ids.reserve(num_task_queues);
+    for (int i = 0; i < num_task_queues; i++) {
+      queue_ids.push_back(task_queues->CreateTaskQueue());
+    }
+    if (merge_queues) {
+      for (int engine = 0; engine < num_engines; engine++) {
+        int first = engine * kQueuesPerEngine;
+        task_queues->Merge(queue_ids[first], queue_ids[first + 1]);
+      }
+    }
+
+    const fml::TimePoint past = fml::TimePoint::Now();
+    CountDownLatch tasks_registered(num_task_queues);
+    std::vector<std::thread> threads;
+    threads.reserve(num_task_queues);
+    for (int i = 0; i < num_task_queues; i++) {
+      int engine_first = i - i % kQueuesPerEngine;
+      TaskQueueId own_queue = queue_ids[i];
+      TaskQueueId peer_queue =
+          queue_ids[engine_first + (i + 1) % kQueuesPerEngine];
+      threads.emplace_back([&, own_queue, peer_queue]() {
+        for (int j = 0; j < num_tasks_per_queue; j++) {
+          task_queues->RegisterTask(own_queue, [] {}, past);
+          task_queues->RegisterTask(peer_queue, [] {}, past);
+        }
+        tasks_registered.CountDown();
+        tasks_registered.Wait();
+        const auto now = fml::TimePoint::Now();
+        while (task_queues->GetNextTaskToRun(own_queue, now)) {
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    if (merge_queues) {
+      for (int engine = 0; engine < num_engines; engine++) {
+        int first = engine * kQueuesPerEngine;
+        task_queues->Unmerge(queue_ids[first], queue_ids[first + 1]);
+      }
+    }
+    for (TaskQueueId queue_id : queue_ids) {
+      task_queues->Dispose(queue_id);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_task_queues *
+                          num_tasks_per_queue * 2);
+}
+
+BENCHMARK(BM_RegisterAndGetTasksMultipleEngines)
+    ->ArgNames({"engines", "merged"})
+    ->ArgsProduct({{1, 2, 4, 8}, {0, 1}})
+    ->UseRealTime();
+
+// Posts tasks to the queue of the calling thread and polls it, with each of
+// the benchmark threads having a queue of its own, e.g. the threads of many
+// engines in one process.
+static void BM_RegisterAndGetTasksPerThreadQueue(
+    benchmark::State& state) {  // NOLINT
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  TaskQueueId queue_id = task_queues->CreateTaskQueue();
+  const fml::TimePoint past = fml::TimePoint::Now();
+  for (auto _ : state) {
+    task_queues->RegisterTask(queue_id, [] {}, past);
+    benchmark::DoNotOptimize(task_queues->HasPendingTasks(queue_id));
+    benchmark::DoNotOptimize(
+        task_queues->GetNextTaskToRun(queue_id, fml::TimePoint::Now()));
+  }
+  task_queues->Dispose(queue_id);
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_RegisterAndGetTasksPerThreadQueue)->ThreadRange(1, 16);
+
 }  // namespace benchmarking
 }  // namespace fml
@@ -7,6 +7,7 @@
 #include "flutter/fml/message_loop_task_queues.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <thread>
 #include <utility>
@@ -404,6 +405,60 @@ TEST(MessageLoopTaskQueue, ConcurrentQueueAndTaskCreatingCounts) {
   ASSERT_EQ(pending_tasks, kThreadCount * kThreadTaskCount);
 }
 
+TEST(MessageLoopTaskQueue, ConcurrentRegisterAndRunOnMergedQueues) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+
+  // The subsumed queues are created first so that they have lower ids than
+  // their owner.
+  constexpr size_t kThreadTaskCount = 500;
+  std::vector<TaskQueueId> task_queue_ids;
+  task_queue_ids.emplace_back(task_queues->CreateTaskQueue());
+  task_queue_ids.emplace_back(task_queues->CreateTaskQueue());
+  auto owner = task_queues->CreateTaskQueue();
+  task_queue_ids.emplace_back(owner);
+  ASSERT_TRUE(task_queues->Merge(owner, task_queue_ids[0]));
+  ASSERT_TRUE(task_queues->Merge(owner, task_queue_ids[1]));
+
+  std::atomic_size_t tasks_run = 0;
+  fml::CountDownLatch tasks_posted_latch(task_queue_ids.size());
+  std::vector<std::thread> threads;
+  for (const auto& queue_id : task_queue_ids) {
+    threads.emplace_back([&, queue_id]() {
+      for (size_t i = 0; i < kThreadTaskCount; i++) {
+        task_queues->RegisterTask(
+            queue_id, [&tasks_run]() { tasks_run++; }, ChronoTicksSinceEpoch());
+      }
+      tasks_posted_latch.CountDown();
+    });
+  }
+
+  // Run the tasks of the merged queues while they are being posted.
+  std::thread runner([&]() {
+    for (;;) {
+      auto invocation =
+          task_queues->GetNextTaskToRun(owner, ChronoTicksSinceEpoch());
+      if (invocation) {
+        invocation();
+      } else if (tasks_run == task_queue_ids.size() * kThreadTaskCount) {
+        break;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  tasks_posted_latch.Wait();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  runner.join();
+
+  ASSERT_EQ(tasks_run, task_queue_ids.size() * kThreadTaskCount);
+  ASSERT_FALSE(task_queues->HasPendingTasks(owner));
+  ASSERT_TRUE(task_queues->Unmerge(owner, task_queue_ids[0]));
+  ASSERT_TRUE(task_queues->Unmerge(owner, task_queue_ids[1]));
+}
+
 TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
   auto platform_queue = task_queue->CreateTaskQueue();
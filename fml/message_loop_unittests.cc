@@ -212,3 +212,45 @@ TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   latch.Wait();
   ASSERT_GE(thread_ids.size(), 1u);
 }
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTasksPostedByWorkers) {
+  // Each task posts two more until there are kLeafCount leaves, as in a
+  // fork-join computation.
+  constexpr size_t kDepth = 10;
+  constexpr size_t kLeafCount = 1 << kDepth;
+  fml::CountDownLatch latch(kLeafCount);
+  // Declared before the loop so that it outlives the workers.
+  std::function<void(size_t)> fork;
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto task_runner = loop->GetTaskRunner();
+  fork = [&](size_t depth) {
+    EXPECT_TRUE(loop->RunsTasksOnCurrentThread());
+    if (depth == kDepth) {
+      latch.CountDown();
+      return;
+    }
+    for (size_t i = 0; i < 2; i++) {
+      task_runner->PostTask([&fork, depth]() { fork(depth + 1); });
+    }
+  };
+  task_runner->PostTask([&]() { fork(0); });
+  latch.Wait();
+  ASSERT_FALSE(loop->RunsTasksOnCurrentThread());
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTasksPostedToAllWorkers) {
+  const size_t kWorkerCount = 4;
+  auto loop = fml::ConcurrentMessageLoop::Create(kWorkerCount);
+  fml::CountDownLatch latch(kWorkerCount);
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  loop->PostTaskToAllWorkers([&]() {
+    {
+      std::scoped_lock lock(thread_ids_mutex);
+      thread_ids.insert(std::this_thread::get_id());
+    }
+    latch.CountDown();
+  });
+  latch.Wait();
+  ASSERT_EQ(thread_ids.size(), kWorkerCount);
+}
@@ -11,6 +11,7 @@
 #include "flutter/fml/ascii_trie.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_recorder.h"
 
 namespace fml {
 namespace tracing {
@@ -27,7 +28,8 @@ AsciiTrie gAllowlist;
 std::atomic<TimelineEventHandler> gTimelineEventHandler;
 std::atomic<TimelineMicrosSource> gTimelineMicrosSource = DefaultMicrosSource;
 
-inline void FlutterTimelineEvent(const char* label,
+inline void FlutterTimelineEvent(const char* category_group,
+                                 const char* label,
                                  int64_t timestamp0,
                                  int64_t timestamp1_or_async_id,
                                  intptr_t flow_id_count,
@@ -42,6 +44,11 @@ inline void FlutterTimelineEvent(const char* label,
     handler(label, timestamp0, timestamp1_or_async_id, flow_id_count, flow_ids,
             type, argument_count, argument_names, argument_values);
   }
+  if (TraceRecorderIsRecording()) {
+    TraceRecorderRecordEvent(category_group, label, timestamp0,
+                             timestamp1_or_async_id, type, argument_count,
+                             argument_names, argument_values);
+  }
 }
 }  // namespace
 
@@ -90,6 +97,7 @@ void TraceTimelineEvent(TraceArg category_group,
   }
 
   FlutterTimelineEvent(
+      category_group,                              // category_group
       name,                                        // label
       timestamp_micros,                            // timestamp0
       identifier,                                  // timestamp1_or_async_id
@@ -126,7 +134,8 @@ void TraceEvent0(TraceArg category_group,
                  TraceArg name,
                  size_t flow_id_count,
                  const uint64_t* flow_ids) {
-  FlutterTimelineEvent(name,                            // label
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
@@ -146,7 +155,8 @@ void TraceEvent1(TraceArg category_group,
                  TraceArg arg1_val) {
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
-  FlutterTimelineEvent(name,                            // label
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
@@ -168,7 +178,8 @@ void TraceEvent2(TraceArg category_group,
                  TraceArg arg2_val) {
   const char* arg_names[] = {arg1_name, arg2_name};
   const char* arg_values[] = {arg1_val, arg2_val};
-  FlutterTimelineEvent(name,                            // label
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
@@ -181,7 +192,8 @@ void TraceEvent2(TraceArg category_group,
 }
 
 void TraceEventEnd(TraceArg name) {
-  FlutterTimelineEvent(name,                            // label
+  FlutterTimelineEvent(nullptr,                         // category_group
+                       name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,                        // timestamp1_or_async_id
                        0,                        // flow_id_count
@@ -198,7 +210,8 @@ void TraceEventAsyncBegin0(TraceArg category_group,
                            TraceIDArg id,
                            size_t flow_id_count,
                            const uint64_t* flow_ids) {
-  FlutterTimelineEvent(name,                            // label
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,             // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
@@ -213,7 +226,8 @@ void TraceEventAsyncBegin0(TraceArg category_group,
 void TraceEventAsyncEnd0(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id) {
-  FlutterTimelineEvent(name,                            // label
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,                             // timestamp1_or_async_id
                        0,                              // flow_id_count
@@ -234,7 +248,8 @@ void TraceEventAsyncBegin1(TraceArg category_group,
                            TraceArg arg1_val) {
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
-  FlutterTimelineEvent(name,                            // label
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,             // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
@@ -253,7 +268,8 @@ void TraceEventAsyncEnd1(TraceArg category_group,
                          TraceArg arg1_val) {
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
-  FlutterTimelineEvent(name,                            // label
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,                             // timestamp1_or_async_id
                        0,                              // flow_id_count
@@ -269,7 +285,8 @@ void TraceEventInstant0(TraceArg category_group,
                         TraceArg name,
                         size_t flow_id_count,
                         const uint64_t* flow_ids) {
-  FlutterTimelineEvent(name,                            // label
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
@@ -289,7 +306,8 @@ void TraceEventInstant1(TraceArg category_group,
                         TraceArg arg1_val) {
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
-  FlutterTimelineEvent(name,                            // label
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
@@ -311,7 +329,8 @@ void TraceEventInstant2(TraceArg category_group,
                         TraceArg arg2_val) {
   const char* arg_names[] = {arg1_name, arg2_name};
   const char* arg_values[] = {arg1_val, arg2_val};
-  FlutterTimelineEvent(name,                            // label
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
@@ -326,7 +345,8 @@ void TraceEventInstant2(TraceArg category_group,
 void TraceEventFlowBegin0(TraceArg category_group,
                           TraceArg name,
                           TraceIDArg id) {
-  FlutterTimelineEvent(name,                            // label
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,       // timestamp1_or_async_id
                        0,        // flow_id_count
@@ -341,7 +361,8 @@ void TraceEventFlowBegin0(TraceArg category_group,
 void TraceEventFlowStep0(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id) {
-  FlutterTimelineEvent(name,                            // label
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,                             // timestamp1_or_async_id
                        0,                              // flow_id_count
@@ -354,7 +375,8 @@ void TraceEventFlowStep0(TraceArg category_group,
 }
 
 void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
-  FlutterTimelineEvent(name,                            // label
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,                            // timestamp1_or_async_id
                        0,                             // flow_id_count
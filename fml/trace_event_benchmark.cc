@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_event.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/trace_recorder.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+constexpr char kCategory[] = "benchmark";
+
+enum class Recording {
+  kOff,
+  kOn,
+  // Recording, but only a category the benchmarked events do not belong to.
+  kFiltered,
+};
+
+void StartRecording(benchmark::State& state, Recording recording) {
+#if !FLUTTER_TIMELINE_ENABLED
+  state.SkipWithError("Trace events are disabled in this build.");
+#endif  // !FLUTTER_TIMELINE_ENABLED
+  switch (recording) {
+    case Recording::kOff:
+      break;
+    case Recording::kOn:
+      // With multiple threads, the first one starts the session for all.
+      if (!tracing::TraceRecorderIsRecording()) {
+        tracing::TraceRecorderStart({kCategory});
+      }
+      break;
+    case Recording::kFiltered:
+      tracing::TraceRecorderStart({"other"});
+      break;
+  }
+}
+
+// All threads are done with their iterations when any of them returns from
+// the benchmark loop.
+void StopRecording(benchmark::State& state) {
+  tracing::TraceRecorderStop();
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+static void BM_TraceEvent0(benchmark::State& state,  // NOLINT
+                           Recording recording) {
+  StartRecording(state, recording);
+  for (auto _ : state) {
+    TRACE_EVENT0(kCategory, "BM_TraceEvent0");
+  }
+  StopRecording(state);
+}
+
+static void BM_TraceEvent1(benchmark::State& state,  // NOLINT
+                           Recording recording) {
+  StartRecording(state, recording);
+  for (auto _ : state) {
+    TRACE_EVENT1(kCategory, "BM_TraceEvent1", "argument", "value");
+  }
+  StopRecording(state);
+}
+
+static void BM_TraceCounter(benchmark::State& state,  // NOLINT
+                            Recording recording) {
+  StartRecording(state, recording);
+  int64_t value = 0;
+  for (auto _ : state) {
+    FML_TRACE_COUNTER(kCategory, "BM_TraceCounter", 0, "value", value++);
+  }
+  StopRecording(state);
+}
+
+BENCHMARK_CAPTURE(BM_TraceEvent0, NotRecording, Recording::kOff);
+BENCHMARK_CAPTURE(BM_TraceEvent0, Recording, Recording::kOn);
+BENCHMARK_CAPTURE(BM_TraceEvent0, Filtered, Recording::kFiltered);
+BENCHMARK_CAPTURE(BM_TraceEvent0, RecordingMultipleThreads, Recording::kOn)
+    ->ThreadRange(1, 8);
+BENCHMARK_CAPTURE(BM_TraceEvent1, NotRecording, Recording::kOff);
+BENCHMARK_CAPTURE(BM_TraceEvent1, Recording, Recording::kOn);
+BENCHMARK_CAPTURE(BM_TraceCounter, NotRecording, Recording::kOff);
+BENCHMARK_CAPTURE(BM_TraceCounter, Recording, Recording::kOn);
+
+}  // namespace benchmarking
+}  // namespace fml
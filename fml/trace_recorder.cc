@@ -0,0 +1,455 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_recorder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/process.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+namespace tracing {
+
+namespace {
+
+constexpr size_t kMaxNameLength = 48;
+constexpr size_t kMaxArgumentsLength = 96;
+
+// The number of unused chunks kept for reuse rather than freed.
+constexpr size_t kMaxFreeChunkCount = 8;
+
+struct Event {
+  int64_t timestamp0;
+  int64_t timestamp1_or_async_id;
+  const char* category_group;
+  Dart_Timeline_Event_Type type;
+  uint32_t argument_count;
+  char name[kMaxNameLength];
+  // The argument names and values as consecutive NUL terminated strings.
+  char arguments[kMaxArgumentsLength];
+};
+
+// The events recorded by one thread. Only that thread adds events, and the
+// events below |committed_count| are never modified while the chunk is in
+// |session|, so they can be read by other threads without locks. The other
+// fields are guarded by the recorder mutex.
+struct Chunk {
+  uint64_t session = 0;
+  uint32_t thread_id = 0;
+  std::atomic<size_t> committed_count = 0;
+  Event events[kTraceRecorderChunkEventCount];
+};
+
+class ThreadBuffer;
+
+struct Recorder {
+  std::mutex mutex;
+  std::atomic_bool recording = false;
+  std::atomic<uint64_t> session = 0;
+
+  // Guarded by |mutex|.
+  // The category prefixes of the session, or empty to record every category.
+  std::shared_ptr<const std::vector<std::string>> categories =
+      std::make_shared<std::vector<std::string>>();
+  size_t max_retired_chunk_count = 1;
+  std::deque<std::unique_ptr<Chunk>> retired_chunks;
+  std::vector<std::unique_ptr<Chunk>> free_chunks;
+  std::set<ThreadBuffer*> thread_buffers;
+  uint32_t next_thread_id = 1;
+
+  std::unique_ptr<Chunk> TakeFreeChunkLocked() {
+    if (free_chunks.empty()) {
+      return std::make_unique<Chunk>();
+    }
+    std::unique_ptr<Chunk> chunk = std::move(free_chunks.back());
+    free_chunks.pop_back();
+    return chunk;
+  }
+
+  void FreeChunkLocked(std::unique_ptr<Chunk> chunk) {
+    if (free_chunks.size() < kMaxFreeChunkCount) {
+      free_chunks.push_back(std::move(chunk));
+    }
+  }
+
+  void RetireChunkLocked(std::unique_ptr<Chunk> chunk) {
+    if (chunk->session != session.load(std::memory_order_relaxed)) {
+      FreeChunkLocked(std::move(chunk));
+      return;
+    }
+    retired_chunks.push_back(std::move(chunk));
+    while (retired_chunks.size() > max_retired_chunk_count) {
+      FreeChunkLocked(std::move(retired_chunks.front()));
+      retired_chunks.pop_front();
+    }
+  }
+};
+
+// Never destroyed so that threads may record events during shutdown.
+Recorder& GetRecorder() {
+  static Recorder* recorder = new Recorder();
+  return *recorder;
+}
+
+// Copies as much of |source| as fits into |destination| along with a NUL
+// terminator and returns the number of bytes written, or 0 if there is no
+// room for any of it.
+size_t CopyTruncated(char* destination, size_t capacity, const char* source) {
+  if (capacity == 0) {
+    return 0;
+  }
+  size_t length = source ? std::min(std::strlen(source), capacity - 1) : 0;
+  std::memcpy(destination, source, length);
+  destination[length] = '\0';
+  return length + 1;
+}
+
+class ThreadBuffer {
+ public:
+  ThreadBuffer() {
+    Recorder& recorder = GetRecorder();
+    std::scoped_lock lock(recorder.mutex);
+    thread_id_ = recorder.next_thread_id++;
+    recorder.thread_buffers.insert(this);
+  }
+
+  ~ThreadBuffer() {
+    Recorder& recorder = GetRecorder();
+    std::scoped_lock lock(recorder.mutex);
+    recorder.thread_buffers.erase(this);
+    if (chunk_) {
+      recorder.RetireChunkLocked(std::move(chunk_));
+    }
+  }
+
+  void Record(const char* category_group,
+              const char* label,
+              int64_t timestamp0,
+              int64_t timestamp1_or_async_id,
+              Dart_Timeline_Event_Type type,
+              intptr_t argument_count,
+              const char** argument_names,
+              const char** argument_values) {
+    if (GetRecorder().session.load(std::memory_order_acquire) != session_) {
+      BeginSession();
+    }
+
+    // End events have no category, they are recorded if the begin event of
+    // the same scope was.
+    bool record = false;
+    if (type == Dart_Timeline_Event_End) {
+      if (open_scopes_.empty()) {
+        return;
+      }
+      record = open_scopes_.back();
+      open_scopes_.pop_back();
+    } else {
+      record = !category_group || IsCategoryEnabled(category_group);
+      if (type == Dart_Timeline_Event_Begin) {
+        open_scopes_.push_back(record);
+      }
+    }
+    if (!record) {
+      return;
+    }
+
+    if (!chunk_ || chunk_->committed_count.load(std::memory_order_relaxed) ==
+                       kTraceRecorderChunkEventCount) {
+      NewChunk();
+    }
+    size_t index = chunk_->committed_count.load(std::memory_order_relaxed);
+    Event& event = chunk_->events[index];
+    event.timestamp0 = timestamp0 >= 0
+                           ? timestamp0
+                           : TimePoint::Now().ToEpochDelta().ToMicroseconds();
+    event.timestamp1_or_async_id = timestamp1_or_async_id;
+    event.category_group = category_group;
+    event.type = type;
+    CopyTruncated(event.name, kMaxNameLength, label);
+    event.argument_count = 0;
+    size_t offset = 0;
+    for (intptr_t i = 0; i < argument_count; i++) {
+      size_t name_size = CopyTruncated(event.arguments + offset,
+                                       kMaxArgumentsLength - offset,
+                                       argument_names[i]);
+      size_t value_size = CopyTruncated(
+          event.arguments + offset + name_size,
+          kMaxArgumentsLength - offset - name_size, argument_values[i]);
+      if (name_size == 0 || value_size == 0) {
+        break;
+      }
+      offset += name_size + value_size;
+      event.argument_count++;
+    }
+    chunk_->committed_count.store(index + 1, std::memory_order_release);
+  }
+
+  // Read by the exporter with the recorder mutex held. Only modified by the
+  // owning thread with the recorder mutex held.
+  const Chunk* chunk() const { return chunk_.get(); }
+
+ private:
+  uint32_t thread_id_ = 0;
+  uint64_t session_ = 0;
+  std::shared_ptr<const std::vector<std::string>> categories_;
+  std::unique_ptr<Chunk> chunk_;
+  // Whether the begin event of each open scope was recorded.
+  std::vector<bool> open_scopes_;
+
+  bool IsCategoryEnabled(const char* category_group) const {
+    if (categories_->empty()) {
+      return true;
+    }
+    for (const std::string& category : *categories_) {
+      if (std::strncmp(category_group, category.c_str(), category.size()) ==
+          0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void BeginSession() {
+    Recorder& recorder = GetRecorder();
+    std::scoped_lock lock(recorder.mutex);
+    session_ = recorder.session.load(std::memory_order_relaxed);
+    categories_ = recorder.categories;
+    open_scopes_.clear();
+    if (chunk_) {
+      chunk_->session = session_;
+      chunk_->committed_count.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  void NewChunk() {
+    Recorder& recorder = GetRecorder();
+    std::scoped_lock lock(recorder.mutex);
+    if (chunk_) {
+      recorder.RetireChunkLocked(std::move(chunk_));
+    }
+    chunk_ = recorder.TakeFreeChunkLocked();
+    chunk_->session = session_;
+    chunk_->thread_id = thread_id_;
+    chunk_->committed_count.store(0, std::memory_order_relaxed);
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadBuffer);
+};
+
+ThreadBuffer& GetThreadBuffer() {
+  static thread_local ThreadBuffer buffer;
+  return buffer;
+}
+
+void WriteJSONString(std::ostringstream& stream, const char* string) {
+  stream << '"';
+  for (const char* c = string; *c; c++) {
+    switch (*c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(*c) < 0x20) {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x",
+                        static_cast<unsigned char>(*c));
+          stream << escaped;
+        } else {
+          stream << *c;
+        }
+        break;
+    }
+  }
+  stream << '"';
+}
+
+// Counter values must be numbers in the Chrome JSON trace format.
+void WriteJSONCounterValue(std::ostringstream& stream, const char* value) {
+  char* end = nullptr;
+  double number = std::strtod(value, &end);
+  if (end != value && *end == '\0') {
+    stream << number;
+  } else {
+    WriteJSONString(stream, value);
+  }
+}
+
+const char* ChromePhase(Dart_Timeline_Event_Type type) {
+  switch (type) {
+    case Dart_Timeline_Event_Begin:
+      return "B";
+    case Dart_Timeline_Event_End:
+      return "E";
+    case Dart_Timeline_Event_Instant:
+      return "i";
+    case Dart_Timeline_Event_Duration:
+      return "X";
+    case Dart_Timeline_Event_Async_Begin:
+      return "b";
+    case Dart_Timeline_Event_Async_End:
+      return "e";
+    case Dart_Timeline_Event_Async_Instant:
+      return "n";
+    case Dart_Timeline_Event_Counter:
+      return "C";
+    case Dart_Timeline_Event_Flow_Begin:
+      return "s";
+    case Dart_Timeline_Event_Flow_Step:
+      return "t";
+    case Dart_Timeline_Event_Flow_End:
+      return "f";
+  }
+  return "i";
+}
+
+void WriteChromeJSONEvent(std::ostringstream& stream,
+                          const Event& event,
+                          int process_id,
+                          uint32_t thread_id) {
+  stream << "{\"name\":";
+  WriteJSONString(stream, event.name);
+  stream << ",\"cat\":";
+  WriteJSONString(stream, event.category_group ? event.category_group : "");
+  stream << ",\"ph\":\"" << ChromePhase(event.type) << "\",\"ts\":"
+         << event.timestamp0 << ",\"pid\":" << process_id
+         << ",\"tid\":" << thread_id;
+  switch (event.type) {
+    case Dart_Timeline_Event_Begin:
+    case Dart_Timeline_Event_End:
+      break;
+    case Dart_Timeline_Event_Instant:
+      stream << ",\"s\":\"t\"";
+      break;
+    case Dart_Timeline_Event_Duration:
+      stream << ",\"dur\":"
+             << event.timestamp1_or_async_id - event.timestamp0;
+      break;
+    case Dart_Timeline_Event_Flow_End:
+      stream << ",\"bp\":\"e\"";
+      [[fallthrough]];
+    default:
+      stream << ",\"id\":" << event.timestamp1_or_async_id;
+      break;
+  }
+  if (event.argument_count > 0) {
+    stream << ",\"args\":{";
+    const char* argument = event.arguments;
+    for (uint32_t i = 0; i < event.argument_count; i++) {
+      const char* value = argument + std::strlen(argument) + 1;
+      if (i > 0) {
+        stream << ',';
+      }
+      WriteJSONString(stream, argument);
+      stream << ':';
+      if (event.type == Dart_Timeline_Event_Counter) {
+        WriteJSONCounterValue(stream, value);
+      } else {
+        WriteJSONString(stream, value);
+      }
+      argument = value + std::strlen(value) + 1;
+    }
+    stream << '}';
+  }
+  stream << '}';
+}
+
+}  // namespace
+
+void TraceRecorderStart(const std::vector<std::string>& categories,
+                        size_t max_event_count) {
+  Recorder& recorder = GetRecorder();
+  std::scoped_lock lock(recorder.mutex);
+  recorder.categories = std::make_shared<std::vector<std::string>>(categories);
+  recorder.max_retired_chunk_count = std::max<size_t>(
+      1, (max_event_count + kTraceRecorderChunkEventCount - 1) /
+             kTraceRecorderChunkEventCount);
+  while (!recorder.retired_chunks.empty()) {
+    recorder.FreeChunkLocked(std::move(recorder.retired_chunks.front()));
+    recorder.retired_chunks.pop_front();
+  }
+  recorder.session.fetch_add(1, std::memory_order_release);
+  recorder.recording = true;
+}
+
+void TraceRecorderStop() {
+  GetRecorder().recording = false;
+}
+
+bool TraceRecorderIsRecording() {
+  return GetRecorder().recording.load(std::memory_order_relaxed);
+}
+
+std::string TraceRecorderExportChromeJSON() {
+  Recorder& recorder = GetRecorder();
+  const int process_id = GetCurrentProcId();
+  std::ostringstream stream;
+  stream << "{\"traceEvents\":[";
+  bool first = true;
+  {
+    std::scoped_lock lock(recorder.mutex);
+    const uint64_t session = recorder.session.load(std::memory_order_relaxed);
+    auto write_chunk = [&](const Chunk* chunk) {
+      if (!chunk || chunk->session != session) {
+        return;
+      }
+      size_t count = chunk->committed_count.load(std::memory_order_acquire);
+      for (size_t i = 0; i < count; i++) {
+        if (!first) {
+          stream << ',';
+        }
+        first = false;
+        WriteChromeJSONEvent(stream, chunk->events[i], process_id,
+                             chunk->thread_id);
+      }
+    };
+    for (const auto& chunk : recorder.retired_chunks) {
+      write_chunk(chunk.get());
+    }
+    for (const ThreadBuffer* buffer : recorder.thread_buffers) {
+      write_chunk(buffer->chunk());
+    }
+  }
+  stream << "],\"displayTimeUnit\":\"ms\"}";
+  return stream.str();
+}
+
+bool TraceRecorderWriteChromeJSON(const fml::UniqueFD& base_directory,
+                                  const char* file_name) {
+  std::string json = TraceRecorderExportChromeJSON();
+  std::vector<uint8_t> data(json.begin(), json.end());
+  return WriteAtomically(base_directory, file_name,
+                         DataMapping(std::move(data)));
+}
+
+void TraceRecorderRecordEvent(const char* category_group,
+                              const char* label,
+                              int64_t timestamp0,
+                              int64_t timestamp1_or_async_id,
+                              Dart_Timeline_Event_Type type,
+                              intptr_t argument_count,
+                              const char** argument_names,
+                              const char** argument_values) {
+  GetThreadBuffer().Record(category_group, label, timestamp0,
+                           timestamp1_or_async_id, type, argument_count,
+                           argument_names, argument_values);
+}
+
+}  // namespace tracing
+}  // namespace fml
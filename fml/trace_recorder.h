@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_RECORDER_H_
+#define FLUTTER_FML_TRACE_RECORDER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/unique_fd.h"
+#include "third_party/dart/runtime/include/dart_tools_api.h"
+
+// A recorder of the events of the trace event macros in
+// flutter/fml/trace_event.h that works independently of the Dart VM
+// timeline, for use in processes without a VM (benchmarks, playgrounds,
+// tests) and in sampled tracing sessions of production builds.
+//
+// Each thread records events to buffers of its own without taking locks,
+// except once per |kTraceRecorderChunkEventCount| events. The recorder keeps
+// a bounded number of the most recent events, which can be exported in the
+// Chrome JSON trace format, which is also read by the Perfetto UI.
+//
+// The recorder is only available in builds with FLUTTER_TIMELINE_ENABLED. For
+// release builds, that requires the enable_trace_recorder_in_release GN arg.
+
+namespace fml {
+namespace tracing {
+
+/// The number of events recorded to a buffer before the thread hands it to
+/// the recorder and starts another one.
+constexpr size_t kTraceRecorderChunkEventCount = 256;
+
+/// The default number of events that are kept by the recorder.
+constexpr size_t kTraceRecorderDefaultMaxEventCount = 32768;
+
+/// Starts a recording session, discarding the events of the previous one.
+///
+/// Only events of a category prefixed by one of |categories| are recorded,
+/// or events of every category if it is empty. At least the most recent
+/// |max_event_count| events are kept.
+void TraceRecorderStart(
+    const std::vector<std::string>& categories = {},
+    size_t max_event_count = kTraceRecorderDefaultMaxEventCount);
+
+/// Stops recording. The events of the session are kept until the next one
+/// starts.
+void TraceRecorderStop();
+
+bool TraceRecorderIsRecording();
+
+/// Returns the events of the current or last session in the Chrome JSON
+/// trace format. May be called while recording.
+std::string TraceRecorderExportChromeJSON();
+
+/// Writes the result of |TraceRecorderExportChromeJSON| to a file.
+bool TraceRecorderWriteChromeJSON(const fml::UniqueFD& base_directory,
+                                  const char* file_name);
+
+/// Records an event with the arguments of a |TimelineEventHandler|. Events
+/// with a negative timestamp are stamped with the current time.
+///
+/// The category, which may be null for end events, must be a string literal.
+/// The name and argument strings are copied, up to a limited length.
+void TraceRecorderRecordEvent(const char* category_group,
+                              const char* label,
+                              int64_t timestamp0,
+                              int64_t timestamp1_or_async_id,
+                              Dart_Timeline_Event_Type type,
+                              intptr_t argument_count,
+                              const char** argument_names,
+                              const char** argument_values);
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_RECORDER_H_
@@ -0,0 +1,186 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_recorder.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/trace_event.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+// Events of other categories may be recorded by threads left over from other
+// tests, so every test only records this category.
+constexpr char kCategory[] = "recorder_test";
+
+static size_t CountOccurrences(const std::string& string,
+                               const std::string& substring) {
+  size_t count = 0;
+  for (size_t i = string.find(substring); i != std::string::npos;
+       i = string.find(substring, i + 1)) {
+    count++;
+  }
+  return count;
+}
+
+static void RecordInstant(const char* category, const char* name) {
+  TraceRecorderRecordEvent(category, name, -1, 0, Dart_Timeline_Event_Instant,
+                           0, nullptr, nullptr);
+}
+
+TEST(TraceRecorderTest, RecordsInstantEvents) {
+  TraceRecorderStart({kCategory});
+  RecordInstant(kCategory, "Instant");
+  TraceRecorderStop();
+
+  std::string json = TraceRecorderExportChromeJSON();
+  EXPECT_EQ(json.find("{\"traceEvents\":["), 0u);
+  EXPECT_NE(json.find("{\"name\":\"Instant\",\"cat\":\"recorder_test\","
+                      "\"ph\":\"i\""),
+            std::string::npos)
+      << json;
+}
+
+TEST(TraceRecorderTest, FiltersEventsByCategoryPrefix) {
+  TraceRecorderStart({"recorder_test.allowed"});
+  RecordInstant("recorder_test.allowed.detail", "Allowed");
+  RecordInstant("recorder_test.other", "Filtered");
+  TraceRecorderStop();
+
+  std::string json = TraceRecorderExportChromeJSON();
+  EXPECT_NE(json.find("\"name\":\"Allowed\""), std::string::npos);
+  EXPECT_EQ(json.find("\"name\":\"Filtered\""), std::string::npos);
+}
+
+TEST(TraceRecorderTest, RecordsEndEventsOfRecordedScopesOnly) {
+  TraceRecorderStart({kCategory});
+  TraceRecorderRecordEvent(kCategory, "Outer", -1, 0, Dart_Timeline_Event_Begin,
+                           0, nullptr, nullptr);
+  TraceRecorderRecordEvent("other", "Inner", -1, 0, Dart_Timeline_Event_Begin,
+                           0, nullptr, nullptr);
+  TraceRecorderRecordEvent(nullptr, "Inner", -1, 0, Dart_Timeline_Event_End, 0,
+                           nullptr, nullptr);
+  TraceRecorderRecordEvent(nullptr, "Outer", -1, 0, Dart_Timeline_Event_End, 0,
+                           nullptr, nullptr);
+  TraceRecorderStop();
+
+  std::string json = TraceRecorderExportChromeJSON();
+  EXPECT_EQ(CountOccurrences(json, "\"name\":\"Outer\""), 2u);
+  EXPECT_EQ(CountOccurrences(json, "\"name\":\"Inner\""), 0u);
+  EXPECT_NE(json.find("\"name\":\"Outer\",\"cat\":\"\",\"ph\":\"E\""),
+            std::string::npos)
+      << json;
+}
+
+TEST(TraceRecorderTest, ExportsArgumentsAndCounters) {
+  TraceRecorderStart({kCategory});
+  const char* names[] = {"quote", "count"};
+  const char* values[] = {"\"quoted\"", "42"};
+  TraceRecorderRecordEvent(kCategory, "Args", -1, 0,
+                           Dart_Timeline_Event_Instant, 2, names, values);
+  TraceRecorderRecordEvent(kCategory, "Counter", -1, 7,
+                           Dart_Timeline_Event_Counter, 2, names, values);
+  TraceRecorderStop();
+
+  std::string json = TraceRecorderExportChromeJSON();
+  EXPECT_NE(json.find("\"args\":{\"quote\":\"\\\"quoted\\\"\","
+                      "\"count\":\"42\"}"),
+            std::string::npos)
+      << json;
+  EXPECT_NE(json.find("\"ph\":\"C\""), std::string::npos);
+  EXPECT_NE(json.find("\"id\":7,\"args\":{\"quote\":\"\\\"quoted\\\"\","
+                      "\"count\":42}"),
+            std::string::npos)
+      << json;
+}
+
+TEST(TraceRecorderTest, KeepsTheMostRecentEvents) {
+  TraceRecorderStart({kCategory}, kTraceRecorderChunkEventCount);
+  for (size_t i = 0; i < kTraceRecorderChunkEventCount * 4; i++) {
+    RecordInstant(kCategory, i == 0 ? "First" : "Event");
+  }
+  RecordInstant(kCategory, "Last");
+  TraceRecorderStop();
+
+  std::string json = TraceRecorderExportChromeJSON();
+  EXPECT_EQ(json.find("\"name\":\"First\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"Last\""), std::string::npos);
+  size_t count = CountOccurrences(json, "\"ph\":\"i\"");
+  EXPECT_GE(count, kTraceRecorderChunkEventCount);
+  EXPECT_LE(count, kTraceRecorderChunkEventCount * 2);
+}
+
+TEST(TraceRecorderTest, StartingASessionDiscardsThePreviousOne) {
+  TraceRecorderStart({kCategory});
+  RecordInstant(kCategory, "Previous");
+  TraceRecorderStop();
+  TraceRecorderStart({kCategory});
+  RecordInstant(kCategory, "Current");
+  TraceRecorderStop();
+
+  std::string json = TraceRecorderExportChromeJSON();
+  EXPECT_EQ(json.find("\"name\":\"Previous\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"Current\""), std::string::npos);
+}
+
+TEST(TraceRecorderTest, RecordsEventsOfAllThreads) {
+  constexpr size_t kThreadCount = 4;
+  constexpr size_t kEventCount = 1000;
+  TraceRecorderStart({kCategory});
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadCount; i++) {
+    threads.emplace_back([]() {
+      for (size_t j = 0; j < kEventCount; j++) {
+        RecordInstant(kCategory, "Threaded");
+      }
+    });
+  }
+  // Exporting while recording must be safe.
+  EXPECT_FALSE(TraceRecorderExportChromeJSON().empty());
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  TraceRecorderStop();
+
+  std::string json = TraceRecorderExportChromeJSON();
+  EXPECT_EQ(CountOccurrences(json, "\"name\":\"Threaded\""),
+            kThreadCount * kEventCount);
+}
+
+#if FLUTTER_TIMELINE_ENABLED && !defined(OS_FUCHSIA)
+TEST(TraceRecorderTest, RecordsTraceEventMacros) {
+  TRACE_EVENT0(kCategory, "NotRecording");
+
+  TraceRecorderStart({kCategory});
+  EXPECT_TRUE(TraceRecorderIsRecording());
+  {
+    TRACE_EVENT1(kCategory, "Scope", "arg", "value");
+    TRACE_EVENT_INSTANT0(kCategory, "Instant");
+  }
+  TraceRecorderStop();
+  EXPECT_FALSE(TraceRecorderIsRecording());
+  TRACE_EVENT_INSTANT0(kCategory, "Stopped");
+
+  std::string json = TraceRecorderExportChromeJSON();
+  EXPECT_NE(json.find("\"name\":\"Scope\",\"cat\":\"recorder_test\","
+                      "\"ph\":\"B\""),
+            std::string::npos)
+      << json;
+  EXPECT_NE(json.find("\"name\":\"Scope\",\"cat\":\"\",\"ph\":\"E\""),
+            std::string::npos)
+      << json;
+  EXPECT_NE(json.find("\"name\":\"Instant\""), std::string::npos);
+  EXPECT_EQ(json.find("\"name\":\"NotRecording\""), std::string::npos);
+  EXPECT_EQ(json.find("\"name\":\"Stopped\""), std::string::npos);
+}
+#endif  // FLUTTER_TIMELINE_ENABLED && !defined(OS_FUCHSIA)
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,156 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_WORK_STEALING_DEQUE_H_
+#define FLUTTER_FML_WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+/// A Chase-Lev work-stealing deque of pointers to items.
+///
+/// One thread, the owner, pushes items to and pops items from the bottom of
+/// the deque without taking locks. Any other thread may steal items from the
+/// top of the deque, competing with the owner and with the other thieves for
+/// the last item by compare-and-swap. The deque grows as needed and does not
+/// own the items it holds.
+///
+/// \see "Correct and Efficient Work-Stealing for Weak Memory Models",
+///      Lê et al., PPoPP 2013.
+template <typename T>
+class WorkStealingDeque {
+ public:
+  explicit WorkStealingDeque(size_t initial_capacity = 64) {
+    FML_DCHECK(initial_capacity > 0 &&
+               (initial_capacity & (initial_capacity - 1)) == 0)
+        << "The capacity must be a power of two.";
+    buffers_.push_back(std::make_unique<Buffer>(initial_capacity));
+    buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+  }
+
+  ~WorkStealingDeque() = default;
+
+  /// Adds an item to the bottom of the deque. Must only be called by the
+  /// owner.
+  void Push(T* item) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    if (bottom - top >= static_cast<int64_t>(buffer->Capacity())) {
+      buffer = Grow(buffer, top, bottom);
+    }
+    buffer->Put(bottom, item);
+    // Sequentially consistent so that a thread that announces that it is
+    // about to sleep and then checks the deque either sees this item or is
+    // seen by the caller.
+    bottom_.store(bottom + 1, std::memory_order_seq_cst);
+  }
+
+  /// Removes the item at the bottom of the deque, i.e. the item pushed most
+  /// recently. Returns nullptr if the deque is empty. Must only be called by
+  /// the owner.
+  T* Pop() {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_seq_cst);
+    if (top > bottom) {
+      // Empty.
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    T* item = buffer->Get(bottom);
+    if (top == bottom) {
+      // The last item, which a thief may be taking at the same time.
+      if (!top_.compare_exchange_strong(top, top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        item = nullptr;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  /// Removes the item at the top of the deque, i.e. the oldest item. Returns
+  /// nullptr if the deque is empty or if another thread took the item first.
+  /// May be called from any thread.
+  T* Steal() {
+    int64_t top = top_.load(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+    if (top >= bottom) {
+      return nullptr;
+    }
+    Buffer* buffer = buffer_.load(std::memory_order_acquire);
+    T* item = buffer->Get(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return item;
+  }
+
+  /// Whether the deque appeared empty at some point during the call. May be
+  /// called from any thread.
+  bool IsEmpty() const {
+    int64_t top = top_.load(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+    return top >= bottom;
+  }
+
+ private:
+  class Buffer {
+   public:
+    explicit Buffer(size_t capacity)
+        : mask_(capacity - 1), items_(new std::atomic<T*>[capacity]) {}
+
+    size_t Capacity() const { return mask_ + 1; }
+
+    T* Get(int64_t index) const {
+      return items_[index & mask_].load(std::memory_order_relaxed);
+    }
+
+    void Put(int64_t index, T* item) {
+      items_[index & mask_].store(item, std::memory_order_relaxed);
+    }
+
+   private:
+    const int64_t mask_;
+    std::unique_ptr<std::atomic<T*>[]> items_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(Buffer);
+  };
+
+  std::atomic<int64_t> top_ = 0;
+  std::atomic<int64_t> bottom_ = 0;
+  std::atomic<Buffer*> buffer_;
+  // All of the buffers the deque has used. Thieves may still be reading an
+  // old buffer after the owner has replaced it, so buffers are only released
+  // with the deque. As each buffer is twice the size of the last, this at
+  // most doubles the memory used.
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+
+  Buffer* Grow(Buffer* buffer, int64_t top, int64_t bottom) {
+    buffers_.push_back(std::make_unique<Buffer>(buffer->Capacity() * 2));
+    Buffer* grown = buffers_.back().get();
+    for (int64_t i = top; i < bottom; i++) {
+      grown->Put(i, buffer->Get(i));
+    }
+    buffer_.store(grown, std::memory_order_release);
+    return grown;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(WorkStealingDeque);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_WORK_STEALING_DEQUE_H_
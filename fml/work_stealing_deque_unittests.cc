@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/work_stealing_deque.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(WorkStealingDequeTest, StartsEmpty) {
+  WorkStealingDeque<int> deque;
+  EXPECT_TRUE(deque.IsEmpty());
+  EXPECT_EQ(deque.Pop(), nullptr);
+  EXPECT_EQ(deque.Steal(), nullptr);
+}
+
+TEST(WorkStealingDequeTest, PopsNewestAndStealsOldest) {
+  WorkStealingDeque<int> deque;
+  int items[3] = {0, 1, 2};
+  for (int& item : items) {
+    deque.Push(&item);
+  }
+  EXPECT_FALSE(deque.IsEmpty());
+  EXPECT_EQ(deque.Pop(), &items[2]);
+  EXPECT_EQ(deque.Steal(), &items[0]);
+  EXPECT_EQ(deque.Pop(), &items[1]);
+  EXPECT_TRUE(deque.IsEmpty());
+  EXPECT_EQ(deque.Pop(), nullptr);
+}
+
+TEST(WorkStealingDequeTest, GrowsPastInitialCapacity) {
+  WorkStealingDeque<int> deque(2);
+  std::vector<int> items(100);
+  for (int& item : items) {
+    deque.Push(&item);
+  }
+  EXPECT_EQ(deque.Steal(), &items[0]);
+  for (size_t i = items.size() - 1; i > 0; i--) {
+    EXPECT_EQ(deque.Pop(), &items[i]);
+  }
+  EXPECT_TRUE(deque.IsEmpty());
+}
+
+TEST(WorkStealingDequeTest, EachItemIsTakenOnceWhileStealing) {
+  constexpr size_t kItemCount = 100000;
+  constexpr size_t kThiefCount = 4;
+  WorkStealingDeque<size_t> deque(4);
+  std::vector<size_t> items(kItemCount);
+  std::vector<std::atomic_size_t> taken_counts(kItemCount);
+  std::atomic_bool done = false;
+
+  auto take = [&](size_t* item) {
+    taken_counts[item - items.data()]++;
+  };
+
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < kThiefCount; i++) {
+    thieves.emplace_back([&]() {
+      while (!done) {
+        if (size_t* item = deque.Steal()) {
+          take(item);
+        }
+      }
+    });
+  }
+
+  // The owner pops every other item it pushes, so it competes with the
+  // thieves for the last item in the deque.
+  for (size_t i = 0; i < kItemCount; i++) {
+    deque.Push(&items[i]);
+    if (i % 2 == 1) {
+      if (size_t* item = deque.Pop()) {
+        take(item);
+      }
+    }
+  }
+  while (size_t* item = deque.Pop()) {
+    take(item);
+  }
+  done = true;
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+
+  for (size_t i = 0; i < kItemCount; i++) {
+    ASSERT_EQ(taken_counts[i], 1u) << "Item " << i;
+  }
+}
+
+}  // namespace testing
+}  // namespace fml
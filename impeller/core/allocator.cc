@@ -4,6 +4,8 @@
 
 #include "impeller/core/allocator.h"
 
+#include <vector>
+
 #include "impeller/base/validation.h"
 #include "impeller/core/device_buffer.h"
 #include "impeller/core/formats.h"
@@ -66,6 +68,37 @@ std::shared_ptr<Texture> Allocator::CreateTexture(
   return OnCreateTexture(desc);
 }
 
+Allocator::MemoryPressureCallbackID Allocator::AddMemoryPressureCallback(
+    MemoryPressureCallback callback) {
+  Lock lock(memory_pressure_mutex_);
+  auto id = next_memory_pressure_callback_id_++;
+  memory_pressure_callbacks_[id] = std::move(callback);
+  return id;
+}
+
+void Allocator::RemoveMemoryPressureCallback(MemoryPressureCallbackID id) {
+  Lock lock(memory_pressure_mutex_);
+  memory_pressure_callbacks_.erase(id);
+}
+
+void Allocator::NotifyMemoryPressure() const {
+  // Callbacks are invoked without holding the lock so that they may register
+  // or unregister callbacks themselves.
+  std::vector<MemoryPressureCallback> callbacks;
+  {
+    Lock lock(memory_pressure_mutex_);
+    callbacks.reserve(memory_pressure_callbacks_.size());
+    for (const auto& [id, callback] : memory_pressure_callbacks_) {
+      callbacks.push_back(callback);
+    }
+  }
+  for (const auto& callback : callbacks) {
+    if (callback) {
+      callback();
+    }
+  }
+}
+
 uint16_t Allocator::MinimumBytesPerRow(PixelFormat format) const {
   return BytesPerPixelForPixelFormat(format);
 }
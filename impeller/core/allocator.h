@@ -5,7 +5,12 @@
 #ifndef FLUTTER_IMPELLER_CORE_ALLOCATOR_H_
 #define FLUTTER_IMPELLER_CORE_ALLOCATOR_H_
 
+#include <cstdint>
+#include <functional>
+#include <map>
+
 #include "flutter/fml/mapping.h"
+#include "impeller/base/thread.h"
 #include "impeller/core/device_buffer_descriptor.h"
 #include "impeller/core/texture.h"
 #include "impeller/core/texture_descriptor.h"
@@ -53,9 +58,37 @@ class Allocator {
   // Visible for testing.
   virtual size_t DebugGetHeapUsage() const { return 0; }
 
+  using MemoryPressureCallback = std::function<void()>;
+
+  using MemoryPressureCallbackID = uint64_t;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Register a callback to invoke when the allocator nears its
+  ///             device memory budget, so that caches of device memory can
+  ///             release what they can spare.
+  ///
+  ///             The callback may be invoked on any thread that allocates
+  ///             from this allocator. Callers that aren't thread safe should
+  ///             only take note of the pressure and evict at a point of their
+  ///             choosing.
+  ///
+  /// @return     The identifier to unregister the callback with.
+  ///
+  MemoryPressureCallbackID AddMemoryPressureCallback(
+      MemoryPressureCallback callback);
+
+  void RemoveMemoryPressureCallback(MemoryPressureCallbackID id);
+
  protected:
   Allocator();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Invoke the registered memory pressure callbacks. Backends
+  ///             that track a memory budget call this when they near it or
+  ///             fail an allocation.
+  ///
+  void NotifyMemoryPressure() const;
+
   virtual std::shared_ptr<DeviceBuffer> OnCreateBuffer(
       const DeviceBufferDescriptor& desc) = 0;
 
@@ -63,6 +96,12 @@ class Allocator {
       const TextureDescriptor& desc) = 0;
 
  private:
+  mutable Mutex memory_pressure_mutex_;
+  MemoryPressureCallbackID next_memory_pressure_callback_id_
+      IPLR_GUARDED_BY(memory_pressure_mutex_) = 0u;
+  std::map<MemoryPressureCallbackID, MemoryPressureCallback>
+      memory_pressure_callbacks_ IPLR_GUARDED_BY(memory_pressure_mutex_);
+
   Allocator(const Allocator&) = delete;
 
   Allocator& operator=(const Allocator&) = delete;
@@ -79,5 +79,25 @@ TEST(AllocatorTest, TextureDescriptorCompatibility) {
   }
 }
 
+TEST(AllocatorTest, InvokesRegisteredMemoryPressureCallbacks) {
+  MockAllocator allocator;
+  size_t first_count = 0u;
+  size_t second_count = 0u;
+  auto first_id =
+      allocator.AddMemoryPressureCallback([&]() { first_count++; });
+  auto second_id =
+      allocator.AddMemoryPressureCallback([&]() { second_count++; });
+  EXPECT_NE(first_id, second_id);
+
+  allocator.NotifyMemoryPressure();
+  EXPECT_EQ(first_count, 1u);
+  EXPECT_EQ(second_count, 1u);
+
+  allocator.RemoveMemoryPressureCallback(first_id);
+  allocator.NotifyMemoryPressure();
+  EXPECT_EQ(first_count, 1u);
+  EXPECT_EQ(second_count, 2u);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -3,12 +3,26 @@
 // found in the LICENSE file.
 
 #include "impeller/entity/render_target_cache.h"
+
+#include <algorithm>
+
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
 
 RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator)
-    : RenderTargetAllocator(std::move(allocator)) {}
+    : RenderTargetAllocator(allocator), allocator_(std::move(allocator)) {
+  if (allocator_) {
+    memory_pressure_callback_id_ = allocator_->AddMemoryPressureCallback(
+        [memory_pressure = memory_pressure_]() { *memory_pressure = true; });
+  }
+}
+
+RenderTargetCache::~RenderTargetCache() {
+  if (allocator_) {
+    allocator_->RemoveMemoryPressureCallback(memory_pressure_callback_id_);
+  }
+}
 
 void RenderTargetCache::Start() {
   for (auto& td : render_target_data_) {
@@ -17,6 +31,11 @@ void RenderTargetCache::Start() {
 }
 
 void RenderTargetCache::End() {
+  // Discarding the textures this frame didn't use is all that memory pressure
+  // calls for, and that happens at the end of every frame. The working set of
+  // the frame is kept, since the next frame will most likely need it again.
+  memory_pressure_->store(false);
+
   std::vector<RenderTargetData> retain;
 
   for (const auto& td : render_target_data_) {
@@ -27,6 +46,18 @@ void RenderTargetCache::End() {
   render_target_data_.swap(retain);
 }
 
+void RenderTargetCache::EvictUnusedUnderMemoryPressure() {
+  if (!memory_pressure_->load()) {
+    return;
+  }
+  render_target_data_.erase(
+      std::remove_if(render_target_data_.begin(), render_target_data_.end(),
+                     [](const RenderTargetData& render_target_data) {
+                       return !render_target_data.used_this_frame;
+                     }),
+      render_target_data_.end());
+}
+
 RenderTarget RenderTargetCache::CreateOffscreen(
     const Context& context,
     ISize size,
@@ -62,6 +93,7 @@ RenderTarget RenderTargetCache::CreateOffscreen(
           stencil_attachment_config, color0.texture, depth_tex);
     }
   }
+  EvictUnusedUnderMemoryPressure();
   RenderTarget created_target = RenderTargetAllocator::CreateOffscreen(
       context, size, mip_count, label, color_attachment_config,
       stencil_attachment_config);
@@ -113,6 +145,7 @@ RenderTarget RenderTargetCache::CreateOffscreenMSAA(
           depth_tex);
     }
   }
+  EvictUnusedUnderMemoryPressure();
   RenderTarget created_target = RenderTargetAllocator::CreateOffscreenMSAA(
       context, size, mip_count, label, color_attachment_config,
       stencil_attachment_config);
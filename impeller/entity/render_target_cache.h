@@ -5,6 +5,9 @@
 #ifndef FLUTTER_IMPELLER_ENTITY_RENDER_TARGET_CACHE_H_
 #define FLUTTER_IMPELLER_ENTITY_RENDER_TARGET_CACHE_H_
 
+#include <atomic>
+#include <memory>
+
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
@@ -12,12 +15,15 @@ namespace impeller {
 /// @brief An implementation of the [RenderTargetAllocator] that caches all
 ///        allocated texture data for one frame.
 ///
-///        Any textures unused after a frame are immediately discarded.
+///        Any textures unused after a frame are immediately discarded. When the
+///        allocator reports memory pressure, the textures not used by the
+///        current frame so far are also discarded before allocating new ones,
+///        rather than at the end of the frame.
 class RenderTargetCache : public RenderTargetAllocator {
  public:
   explicit RenderTargetCache(std::shared_ptr<Allocator> allocator);
 
-  ~RenderTargetCache() = default;
+  ~RenderTargetCache();
 
   // |RenderTargetAllocator|
   void Start() override;
@@ -62,7 +68,19 @@ class RenderTargetCache : public RenderTargetAllocator {
     RenderTarget render_target;
   };
 
+  //----------------------------------------------------------------------------
+  /// @brief      Discard the cached textures that have not been used this
+  ///             frame if the allocator reported memory pressure.
+  ///
+  void EvictUnusedUnderMemoryPressure();
+
+  std::shared_ptr<Allocator> allocator_;
   std::vector<RenderTargetData> render_target_data_;
+  // Set by the memory pressure callback of the allocator, which may be
+  // invoked on any thread. Cleared at the end of the frame.
+  std::shared_ptr<std::atomic_bool> memory_pressure_ =
+      std::make_shared<std::atomic_bool>(false);
+  Allocator::MemoryPressureCallbackID memory_pressure_callback_id_ = 0u;
 
   RenderTargetCache(const RenderTargetCache&) = delete;
 
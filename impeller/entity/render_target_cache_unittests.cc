@@ -25,6 +25,8 @@ class TestAllocator : public Allocator {
 
   ~TestAllocator() = default;
 
+  using Allocator::NotifyMemoryPressure;
+
   ISize GetMaxTextureSizeSupported() const override {
     return ISize(1024, 1024);
   };
@@ -87,6 +89,36 @@ TEST_P(RenderTargetCacheTest, DoesNotPersistFailedAllocations) {
   EXPECT_EQ(render_target_cache.CachedTextureCount(), 0u);
 }
 
+TEST_P(RenderTargetCacheTest, EvictsUnusedTexturesUnderMemoryPressure) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache = RenderTargetCache(allocator);
+
+  render_target_cache.Start();
+  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  render_target_cache.CreateOffscreen(*GetContext(), {200, 200}, 1);
+  render_target_cache.End();
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+
+  render_target_cache.Start();
+  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  allocator->NotifyMemoryPressure();
+  // The 200x200 texture wasn't used this frame so far. It is discarded
+  // before a new texture is allocated instead of at the end of the frame.
+  render_target_cache.CreateOffscreen(*GetContext(), {300, 300}, 1);
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+  render_target_cache.End();
+  // The working set of the frame stays cached.
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+
+  // The pressure is handled by the end of the frame.
+  render_target_cache.Start();
+  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  render_target_cache.CreateOffscreen(*GetContext(), {400, 400}, 1);
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 3u);
+  render_target_cache.End();
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+}
+
 TEST_P(RenderTargetCacheTest, CachedTextureGetsNewAttachmentConfig) {
   auto render_target_cache =
       RenderTargetCache(GetContext()->GetResourceAllocator());
@@ -14,6 +14,7 @@
 #include "third_party/glfw/include/GLFW/glfw3.h"
 
 #include "flutter/fml/build_config.h"
+#include "impeller/entity/gles/entity_gles3_shaders_gles.h"
 #include "impeller/entity/gles/entity_shaders_gles.h"
 #include "impeller/entity/gles/framebuffer_blend_shaders_gles.h"
 #include "impeller/entity/gles/modern_shaders_gles.h"
@@ -124,6 +125,15 @@ ShaderLibraryMappingsForPlayground() {
   };
 }
 
+static std::vector<std::shared_ptr<fml::Mapping>>
+GLES3ShaderLibraryMappingsForPlayground() {
+  return {
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_entity_gles3_shaders_gles_data,
+          impeller_entity_gles3_shaders_gles_length),
+  };
+}
+
 // |PlaygroundImpl|
 std::shared_ptr<Context> PlaygroundImplGLES::GetContext() const {
   auto resolver = use_angle_ ? [](const char* name) -> void* {
@@ -145,7 +155,8 @@ std::shared_ptr<Context> PlaygroundImplGLES::GetContext() const {
   }
 
   auto context = ContextGLES::Create(
-      std::move(gl), ShaderLibraryMappingsForPlayground(), true);
+      std::move(gl), ShaderLibraryMappingsForPlayground(), true,
+      GLES3ShaderLibraryMappingsForPlayground());
   if (!context) {
     FML_LOG(ERROR) << "Could not create context.";
     return nullptr;
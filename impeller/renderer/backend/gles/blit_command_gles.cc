@@ -100,9 +100,10 @@ bool BlitCopyTextureToTextureCommandGLES::Encode(
     draw_fbo = draw.value();
   }
 
-  gl.Disable(GL_SCISSOR_TEST);
-  gl.Disable(GL_DEPTH_TEST);
-  gl.Disable(GL_STENCIL_TEST);
+  auto& state = reactor.GetStateTracker();
+  state.SetEnabled(GL_SCISSOR_TEST, false);
+  state.SetEnabled(GL_DEPTH_TEST, false);
+  state.SetEnabled(GL_STENCIL_TEST, false);
 
   gl.BlitFramebuffer(source_region.GetX(),       // srcX0
                      source_region.GetY(),       // srcY0
@@ -261,7 +262,7 @@ bool BlitCopyBufferToTextureCommandGLES::Encode(
     return false;
   }
   const auto& gl = reactor.GetProcTable();
-  gl.BindTexture(texture_type, gl_handle.value());
+  reactor.GetStateTracker().BindTexture(texture_type, gl_handle.value());
   const GLvoid* tex_data =
       data.buffer_view.buffer->OnGetContents() + data.buffer_view.range.offset;
 
@@ -91,6 +91,12 @@ bool BufferBindingsGLES::ReadUniformsBindings(const ProcTableGLES& gl,
   if (!gl.IsProgram(program)) {
     return false;
   }
+  const bool supports_uniform_buffers =
+      gl.GetCapabilities()->SupportsUniformBuffers();
+  if (supports_uniform_buffers && !ReadUniformBlockBindings(gl, program)) {
+    return false;
+  }
+
   GLint max_name_size = 0;
   gl.GetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_size);
 
@@ -127,6 +133,18 @@ bool BufferBindingsGLES::ReadUniformsBindings(const ProcTableGLES& gl,
       }
     }
 
+    // Members of uniform blocks don't have locations. They are specified by
+    // binding a buffer to the block instead.
+    if (supports_uniform_buffers) {
+      const GLuint index = i;
+      GLint block_index = -1;
+      gl.GetActiveUniformsiv(program, 1, &index, GL_UNIFORM_BLOCK_INDEX,
+                             &block_index);
+      if (block_index != -1) {
+        continue;
+      }
+    }
+
     auto location = gl.GetUniformLocation(program, name.data());
     if (location == -1) {
       VALIDATION_LOG << "Could not query the location of an active uniform.";
@@ -142,10 +160,44 @@ bool BufferBindingsGLES::ReadUniformsBindings(const ProcTableGLES& gl,
   return true;
 }
 
+bool BufferBindingsGLES::ReadUniformBlockBindings(const ProcTableGLES& gl,
+                                                  GLuint program) {
+  GLint block_count = 0;
+  gl.GetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &block_count);
+
+  GLint max_name_size = 0;
+  gl.GetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH,
+                  &max_name_size);
+
+  for (GLint i = 0; i < block_count; i++) {
+    std::vector<GLchar> name;
+    name.resize(max_name_size);
+    GLsizei written_count = 0u;
+    gl.GetActiveUniformBlockName(program,         // program
+                                 i,               // index
+                                 max_name_size,   // buffer_size
+                                 &written_count,  // length
+                                 name.data()      // name
+    );
+    if (written_count <= 0) {
+      VALIDATION_LOG << "Uniform block name could not be read for active "
+                        "uniform block.";
+      return false;
+    }
+    // Give each block its own binding point so buffers can be bound without
+    // touching the program again.
+    gl.UniformBlockBinding(program, i, i);
+    uniform_block_bindings_[NormalizeUniformKey(std::string{
+        name.data(), static_cast<size_t>(written_count)})] = i;
+  }
+  return true;
+}
+
 bool BufferBindingsGLES::BindVertexAttributes(const ProcTableGLES& gl,
+                                              StateTrackerGLES& state,
                                               size_t vertex_offset) const {
   for (const auto& array : vertex_attrib_arrays_) {
-    gl.EnableVertexAttribArray(array.index);
+    state.SetVertexAttribArrayEnabled(array.index, true);
     gl.VertexAttribPointer(array.index,       // index
                            array.size,        // size (must be 1, 2, 3, or 4)
                            array.type,        // type
@@ -160,6 +212,7 @@ bool BufferBindingsGLES::BindVertexAttributes(const ProcTableGLES& gl,
 }
 
 bool BufferBindingsGLES::BindUniformData(const ProcTableGLES& gl,
+                                         StateTrackerGLES& state,
                                          Allocator& transients_allocator,
                                          const Bindings& vertex_bindings,
                                          const Bindings& fragment_bindings) {
@@ -175,12 +228,12 @@ bool BufferBindingsGLES::BindUniformData(const ProcTableGLES& gl,
   }
 
   std::optional<size_t> next_unit_index =
-      BindTextures(gl, vertex_bindings, ShaderStage::kVertex);
+      BindTextures(gl, state, vertex_bindings, ShaderStage::kVertex);
   if (!next_unit_index.has_value()) {
     return false;
   }
 
-  if (!BindTextures(gl, fragment_bindings, ShaderStage::kFragment,
+  if (!BindTextures(gl, state, fragment_bindings, ShaderStage::kFragment,
                     *next_unit_index)
            .has_value()) {
     return false;
@@ -189,9 +242,10 @@ bool BufferBindingsGLES::BindUniformData(const ProcTableGLES& gl,
   return true;
 }
 
-bool BufferBindingsGLES::UnbindVertexAttributes(const ProcTableGLES& gl) const {
+bool BufferBindingsGLES::UnbindVertexAttributes(
+    StateTrackerGLES& state) const {
   for (const auto& array : vertex_attrib_arrays_) {
-    gl.DisableVertexAttribArray(array.index);
+    state.SetVertexAttribArrayEnabled(array.index, false);
   }
   return true;
 }
@@ -245,6 +299,49 @@ const std::vector<GLint>& BufferBindingsGLES::ComputeUniformLocations(
   return locations;
 }
 
+std::optional<GLuint> BufferBindingsGLES::ComputeUniformBlockBinding(
+    const ShaderMetadata* metadata) {
+  auto binding = block_binding_map_.find(metadata->name);
+  if (binding != block_binding_map_.end()) {
+    return binding->second;
+  }
+  auto& computed_binding = block_binding_map_[metadata->name] = std::nullopt;
+  auto block =
+      uniform_block_bindings_.find(CreateUniformMemberKey(metadata->name));
+  if (block != uniform_block_bindings_.end()) {
+    computed_binding = block->second;
+  }
+  return computed_binding;
+}
+
+bool BufferBindingsGLES::BindUniformBlock(const ProcTableGLES& gl,
+                                          GLuint binding,
+                                          const DeviceBufferGLES& device_buffer,
+                                          const Range& range) const {
+  const auto alignment = gl.GetCapabilities()->uniform_buffer_offset_alignment;
+  if (range.offset % alignment != 0) {
+    VALIDATION_LOG << "Uniform buffer offset " << range.offset
+                   << " is not a multiple of the required alignment "
+                   << alignment << ".";
+    return false;
+  }
+  if (!device_buffer.BindAndUploadDataIfNecessary(
+          DeviceBufferGLES::BindingType::kUniformBuffer)) {
+    return false;
+  }
+  auto handle = device_buffer.GetHandle();
+  if (!handle.has_value()) {
+    return false;
+  }
+  gl.BindBufferRange(GL_UNIFORM_BUFFER,  // target
+                     binding,            // index
+                     handle.value(),     // buffer
+                     range.offset,       // offset
+                     range.length        // size
+  );
+  return true;
+}
+
 bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
                                            Allocator& transients_allocator,
                                            const BufferResource& buffer) {
@@ -255,6 +352,15 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
     return false;
   }
   const auto& device_buffer_gles = DeviceBufferGLES::Cast(*device_buffer);
+
+  // If the program declares the buffer as a uniform block, the whole buffer
+  // is bound in one call instead of specifying each member.
+  if (auto binding = ComputeUniformBlockBinding(metadata);
+      binding.has_value()) {
+    return BindUniformBlock(gl, binding.value(), device_buffer_gles,
+                            buffer.resource.range);
+  }
+
   const uint8_t* buffer_ptr =
       device_buffer_gles.GetBufferData() + buffer.resource.range.offset;
 
@@ -361,6 +467,7 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
 
 std::optional<size_t> BufferBindingsGLES::BindTextures(
     const ProcTableGLES& gl,
+    StateTrackerGLES& state,
     const Bindings& bindings,
     ShaderStage stage,
     size_t unit_start_index) {
@@ -385,7 +492,7 @@ std::optional<size_t> BufferBindingsGLES::BindTextures(
                         "this shader stage.";
       return std::nullopt;
     }
-    gl.ActiveTexture(GL_TEXTURE0 + active_index);
+    state.ActiveTexture(GL_TEXTURE0 + active_index);
 
     //--------------------------------------------------------------------------
     /// Bind the texture.
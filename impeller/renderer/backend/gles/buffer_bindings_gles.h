@@ -5,12 +5,15 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_BUFFER_BINDINGS_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_BUFFER_BINDINGS_GLES_H_
 
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
 #include "impeller/core/shader_types.h"
+#include "impeller/renderer/backend/gles/device_buffer_gles.h"
 #include "impeller/renderer/backend/gles/gles.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
 #include "impeller/renderer/command.h"
 
 namespace impeller {
@@ -33,14 +36,16 @@ class BufferBindingsGLES {
   bool ReadUniformsBindings(const ProcTableGLES& gl, GLuint program);
 
   bool BindVertexAttributes(const ProcTableGLES& gl,
+                            StateTrackerGLES& state,
                             size_t vertex_offset) const;
 
   bool BindUniformData(const ProcTableGLES& gl,
+                       StateTrackerGLES& state,
                        Allocator& transients_allocator,
                        const Bindings& vertex_bindings,
                        const Bindings& fragment_bindings);
 
-  bool UnbindVertexAttributes(const ProcTableGLES& gl) const;
+  bool UnbindVertexAttributes(StateTrackerGLES& state) const;
 
  private:
   //----------------------------------------------------------------------------
@@ -58,19 +63,39 @@ class BufferBindingsGLES {
 
   std::unordered_map<std::string, GLint> uniform_locations_;
 
+  // The binding points assigned to the active uniform blocks of the program,
+  // keyed by the normalized block name. Only populated if the context
+  // supports uniform buffers and the program declares uniform blocks.
+  std::unordered_map<std::string, GLuint> uniform_block_bindings_;
+
   using BindingMap = std::unordered_map<std::string, std::vector<GLint>>;
   BindingMap binding_map_ = {};
 
+  using BlockBindingMap =
+      std::unordered_map<std::string, std::optional<GLuint>>;
+  BlockBindingMap block_binding_map_ = {};
+
+  bool ReadUniformBlockBindings(const ProcTableGLES& gl, GLuint program);
+
   const std::vector<GLint>& ComputeUniformLocations(
       const ShaderMetadata* metadata);
 
+  std::optional<GLuint> ComputeUniformBlockBinding(
+      const ShaderMetadata* metadata);
+
   GLint ComputeTextureLocation(const ShaderMetadata* metadata);
 
   bool BindUniformBuffer(const ProcTableGLES& gl,
                          Allocator& transients_allocator,
                          const BufferResource& buffer);
 
+  bool BindUniformBlock(const ProcTableGLES& gl,
+                        GLuint binding,
+                        const DeviceBufferGLES& device_buffer,
+                        const Range& range) const;
+
   std::optional<size_t> BindTextures(const ProcTableGLES& gl,
+                                     StateTrackerGLES& state,
                                      const Bindings& bindings,
                                      ShaderStage stage,
                                      size_t unit_start_index = 0);
@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/gles/capabilities_gles.h"
 
+#include "impeller/base/version.h"
 #include "impeller/core/formats.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
 
@@ -22,6 +23,10 @@ static const constexpr char* kNvidiaTextureBorderClampExt =
 static const constexpr char* kMultisampledRenderToTextureExt =
     "GL_EXT_multisampled_render_to_texture";
 
+// https://registry.khronos.org/OpenGL/extensions/KHR/KHR_parallel_shader_compile.txt
+static const constexpr char* kParallelShaderCompileExt =
+    "GL_KHR_parallel_shader_compile";
+
 CapabilitiesGLES::CapabilitiesGLES(const ProcTableGLES& gl) {
   {
     GLint value = 0;
@@ -126,6 +131,26 @@ CapabilitiesGLES::CapabilitiesGLES(const ProcTableGLES& gl) {
   }
 
   is_angle_ = desc->IsANGLE();
+
+  supports_parallel_shader_compile_ =
+      desc->HasExtension(kParallelShaderCompileExt);
+
+  const auto uniform_buffers_version =
+      desc->IsES() ? Version(3, 0, 0) : Version(3, 1, 0);
+  supports_uniform_buffers_ =
+      desc->GetGlVersion().IsAtLeast(uniform_buffers_version) &&
+      gl.BindBufferRange.IsAvailable() &&
+      gl.GetActiveUniformBlockName.IsAvailable() &&
+      gl.GetActiveUniformsiv.IsAvailable() &&
+      gl.UniformBlockBinding.IsAvailable();
+
+  if (supports_uniform_buffers_) {
+    GLint value = 0;
+    gl.GetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &value);
+    if (value > 0) {
+      uniform_buffer_offset_alignment = value;
+    }
+  }
 }
 
 size_t CapabilitiesGLES::GetMaxTextureUnits(ShaderStage stage) const {
@@ -197,6 +222,14 @@ bool CapabilitiesGLES::IsANGLE() const {
   return is_angle_;
 }
 
+bool CapabilitiesGLES::SupportsUniformBuffers() const {
+  return supports_uniform_buffers_;
+}
+
+bool CapabilitiesGLES::SupportsParallelShaderCompile() const {
+  return supports_parallel_shader_compile_;
+}
+
 PixelFormat CapabilitiesGLES::GetDefaultGlyphAtlasFormat() const {
   return default_glyph_atlas_format_;
 }
@@ -73,10 +73,25 @@ class CapabilitiesGLES final
   // May be 0.
   size_t num_shader_binary_formats = 0;
 
+  // Must be at most 256. Only valid if uniform buffers are supported.
+  size_t uniform_buffer_offset_alignment = 256;
+
   size_t GetMaxTextureUnits(ShaderStage stage) const;
 
   bool IsANGLE() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether uniform blocks may be bound from buffer objects. This
+  ///             requires OpenGL ES 3.0 or desktop OpenGL 3.1.
+  ///
+  bool SupportsUniformBuffers() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the driver compiles and links shaders off the calling
+  ///             thread and link completion can be polled without blocking.
+  ///
+  bool SupportsParallelShaderCompile() const;
+
   // |Capabilities|
   bool SupportsOffscreenMSAA() const override;
 
@@ -125,6 +140,8 @@ class CapabilitiesGLES final
   bool supports_offscreen_msaa_ = false;
   bool supports_implicit_msaa_ = false;
   bool is_angle_ = false;
+  bool supports_uniform_buffers_ = false;
+  bool supports_parallel_shader_compile_ = false;
   PixelFormat default_glyph_atlas_format_ = PixelFormat::kUnknown;
 };
 
@@ -16,15 +16,18 @@ namespace impeller {
 std::shared_ptr<ContextGLES> ContextGLES::Create(
     std::unique_ptr<ProcTableGLES> gl,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
-    bool enable_gpu_tracing) {
+    bool enable_gpu_tracing,
+    const std::vector<std::shared_ptr<fml::Mapping>>& gles3_shader_libraries) {
   return std::shared_ptr<ContextGLES>(
-      new ContextGLES(std::move(gl), shader_libraries, enable_gpu_tracing));
+      new ContextGLES(std::move(gl), shader_libraries, enable_gpu_tracing,
+                      gles3_shader_libraries));
 }
 
 ContextGLES::ContextGLES(
     std::unique_ptr<ProcTableGLES> gl,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_mappings,
-    bool enable_gpu_tracing) {
+    bool enable_gpu_tracing,
+    const std::vector<std::shared_ptr<fml::Mapping>>& gles3_shader_libraries) {
   reactor_ = std::make_shared<ReactorGLES>(std::move(gl));
   if (!reactor_->IsValid()) {
     VALIDATION_LOG << "Could not create valid reactor.";
@@ -33,8 +36,16 @@ ContextGLES::ContextGLES(
 
   // Create the shader library.
   {
-    auto library = std::shared_ptr<ShaderLibraryGLES>(
-        new ShaderLibraryGLES(shader_libraries_mappings));
+    auto mappings = shader_libraries_mappings;
+    // Desktop GL contexts can't generally compile GLSL ES 3.00 shaders.
+    const auto& gl = reactor_->GetProcTable();
+    if (gl.GetDescription()->IsES() &&
+        gl.GetCapabilities()->SupportsUniformBuffers()) {
+      mappings.insert(mappings.end(), gles3_shader_libraries.begin(),
+                      gles3_shader_libraries.end());
+    }
+    auto library =
+        std::shared_ptr<ShaderLibraryGLES>(new ShaderLibraryGLES(mappings));
     if (!library->IsValid()) {
       VALIDATION_LOG << "Could not create valid shader library.";
       return;
@@ -103,6 +114,12 @@ bool ContextGLES::IsValid() const {
 
 void ContextGLES::Shutdown() {}
 
+void ContextGLES::FinishPendingPipelines() const {
+  if (pipeline_library_) {
+    pipeline_library_->FinishPendingPipelines();
+  }
+}
+
 // |Context|
 std::string ContextGLES::DescribeGpuModel() const {
   return reactor_->GetProcTable().GetDescription()->GetString();
@@ -23,10 +23,27 @@ class ContextGLES final : public Context,
                           public BackendCast<ContextGLES, Context>,
                           public std::enable_shared_from_this<ContextGLES> {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      Create a context from the given proc table and shader
+  ///             libraries.
+  ///
+  /// @param[in]  gl                      The proc table.
+  /// @param[in]  shader_libraries        The shader libraries targeting
+  ///                                     OpenGL ES 2.0.
+  /// @param[in]  enable_gpu_tracing      Whether to trace GPU timings.
+  /// @param[in]  gles3_shader_libraries  Variants of shaders in the other
+  ///                                     libraries targeting OpenGL ES 3.0.
+  ///                                     They replace the shaders of the same
+  ///                                     name on OpenGL ES 3.0 contexts, where
+  ///                                     their uniform blocks can be bound
+  ///                                     from a buffer in a single call.
+  ///
   static std::shared_ptr<ContextGLES> Create(
       std::unique_ptr<ProcTableGLES> gl,
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
-      bool enable_gpu_tracing);
+      bool enable_gpu_tracing,
+      const std::vector<std::shared_ptr<fml::Mapping>>&
+          gles3_shader_libraries = {});
 
   // |Context|
   ~ContextGLES() override;
@@ -43,6 +60,13 @@ class ContextGLES final : public Context,
 
   std::shared_ptr<GPUTracerGLES> GetGPUTracer() const { return gpu_tracer_; }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Finish the pipeline links that are still pending, so that
+  ///             pipelines that are never waited on release their shaders.
+  ///             Called once a frame has been presented.
+  ///
+  void FinishPendingPipelines() const;
+
  private:
   ReactorGLES::Ref reactor_;
   std::shared_ptr<ShaderLibraryGLES> shader_library_;
@@ -61,7 +85,9 @@ class ContextGLES final : public Context,
   ContextGLES(
       std::unique_ptr<ProcTableGLES> gl,
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
-      bool enable_gpu_tracing);
+      bool enable_gpu_tracing,
+      const std::vector<std::shared_ptr<fml::Mapping>>&
+          gles3_shader_libraries);
 
   // |Context|
   std::string DescribeGpuModel() const override;
@@ -67,6 +67,8 @@ static GLenum ToTarget(DeviceBufferGLES::BindingType type) {
       return GL_ARRAY_BUFFER;
     case DeviceBufferGLES::BindingType::kElementArrayBuffer:
       return GL_ELEMENT_ARRAY_BUFFER;
+    case DeviceBufferGLES::BindingType::kUniformBuffer:
+      return GL_UNIFORM_BUFFER;
   }
   FML_UNREACHABLE();
 }
@@ -84,7 +86,7 @@ bool DeviceBufferGLES::BindAndUploadDataIfNecessary(BindingType type) const {
   const auto target_type = ToTarget(type);
   const auto& gl = reactor_->GetProcTable();
 
-  gl.BindBuffer(target_type, buffer.value());
+  reactor_->GetStateTracker().BindBuffer(target_type, buffer.value());
 
   if (upload_generation_ != generation_) {
     TRACE_EVENT1("impeller", "BufferData", "Bytes",
@@ -97,6 +99,13 @@ bool DeviceBufferGLES::BindAndUploadDataIfNecessary(BindingType type) const {
   return true;
 }
 
+std::optional<GLuint> DeviceBufferGLES::GetHandle() const {
+  if (!reactor_) {
+    return std::nullopt;
+  }
+  return reactor_->GetGLHandle(handle_);
+}
+
 // |DeviceBuffer|
 bool DeviceBufferGLES::SetLabel(const std::string& label) {
   reactor_->SetDebugLabel(handle_, label);
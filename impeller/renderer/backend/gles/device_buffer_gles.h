@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 
 #include "impeller/base/allocation.h"
 #include "impeller/base/backend_cast.h"
@@ -34,10 +35,17 @@ class DeviceBufferGLES final
   enum class BindingType {
     kArrayBuffer,
     kElementArrayBuffer,
+    kUniformBuffer,
   };
 
   [[nodiscard]] bool BindAndUploadDataIfNecessary(BindingType type) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The name of the buffer object, if it has been created on the
+  ///             reactor.
+  ///
+  std::optional<GLuint> GetHandle() const;
+
   void Flush(std::optional<Range> range = std::nullopt) const override;
 
  private:
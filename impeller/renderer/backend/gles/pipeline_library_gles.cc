@@ -4,10 +4,13 @@
 
 #include "impeller/renderer/backend/gles/pipeline_library_gles.h"
 
+#include <future>
 #include <sstream>
 #include <string>
 
 #include "flutter/fml/container.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "fml/closure.h"
 #include "impeller/base/promise.h"
@@ -17,7 +20,19 @@
 namespace impeller {
 
 PipelineLibraryGLES::PipelineLibraryGLES(ReactorGLES::Ref reactor)
-    : reactor_(std::move(reactor)) {}
+    : reactor_(std::move(reactor)) {
+  if (!reactor_) {
+    return;
+  }
+  // Let the driver decide how many threads to compile shaders on.
+  auto result = reactor_->AddOperation([](const ReactorGLES& reactor) {
+    const auto& gl = reactor.GetProcTable();
+    if (gl.MaxShaderCompilerThreadsKHR.IsAvailable()) {
+      gl.MaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    }
+  });
+  FML_CHECK(result);
+}
 
 static std::string GetShaderInfoLog(const ProcTableGLES& gl, GLuint shader) {
   GLint log_length = 0;
@@ -74,27 +89,47 @@ static void LogShaderCompilationFailure(const ProcTableGLES& gl,
   VALIDATION_LOG << stream.str();
 }
 
-static bool LinkProgram(
-    const ReactorGLES& reactor,
-    const std::shared_ptr<PipelineGLES>& pipeline,
-    const std::shared_ptr<const ShaderFunction>& vert_function,
-    const std::shared_ptr<const ShaderFunction>& frag_function) {
+//------------------------------------------------------------------------------
+/// @brief      A pipeline whose program has been compiled and linked but whose
+///             status has not been checked yet.
+///
+///             Only accessed from within reactor operations once it has been
+///             created.
+///
+struct PendingPipelineGLES {
+  std::promise<std::shared_ptr<Pipeline<PipelineDescriptor>>> promise;
+  std::shared_ptr<PipelineGLES> pipeline;
+  std::shared_ptr<const ShaderFunction> vert_function;
+  std::shared_ptr<const ShaderFunction> frag_function;
+  GLuint program = GL_NONE;
+  GLuint vert_shader = GL_NONE;
+  GLuint frag_shader = GL_NONE;
+  fml::TimePoint start_time;
+  bool is_finished = false;
+};
+
+static bool BeginLinkProgram(const ReactorGLES& reactor,
+                             PendingPipelineGLES& pending) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
-  const auto& descriptor = pipeline->GetDescriptor();
+  const auto& descriptor = pending.pipeline->GetDescriptor();
 
   auto vert_mapping =
-      ShaderFunctionGLES::Cast(*vert_function).GetSourceMapping();
+      ShaderFunctionGLES::Cast(*pending.vert_function).GetSourceMapping();
   auto frag_mapping =
-      ShaderFunctionGLES::Cast(*frag_function).GetSourceMapping();
+      ShaderFunctionGLES::Cast(*pending.frag_function).GetSourceMapping();
 
   const auto& gl = reactor.GetProcTable();
 
+  pending.start_time = fml::TimePoint::Now();
+
   auto vert_shader = gl.CreateShader(GL_VERTEX_SHADER);
   auto frag_shader = gl.CreateShader(GL_FRAGMENT_SHADER);
 
   if (vert_shader == 0 || frag_shader == 0) {
     VALIDATION_LOG << "Could not create shader handles.";
+    gl.DeleteShader(vert_shader);
+    gl.DeleteShader(frag_shader);
     return false;
   }
 
@@ -104,11 +139,6 @@ static bool LinkProgram(
       DebugResourceType::kShader, frag_shader,
       SPrintF("%s Fragment Shader", descriptor.GetLabel().c_str()));
 
-  fml::ScopedCleanupClosure delete_vert_shader(
-      [&gl, vert_shader]() { gl.DeleteShader(vert_shader); });
-  fml::ScopedCleanupClosure delete_frag_shader(
-      [&gl, frag_shader]() { gl.DeleteShader(frag_shader); });
-
   gl.ShaderSourceMapping(vert_shader, *vert_mapping,
                          descriptor.GetSpecializationConstants());
   gl.ShaderSourceMapping(frag_shader, *frag_mapping,
@@ -117,61 +147,156 @@ static bool LinkProgram(
   gl.CompileShader(vert_shader);
   gl.CompileShader(frag_shader);
 
+  gl.AttachShader(pending.program, vert_shader);
+  gl.AttachShader(pending.program, frag_shader);
+
+  for (const auto& stage_input :
+       descriptor.GetVertexDescriptor()->GetStageInputs()) {
+    gl.BindAttribLocation(pending.program,                            //
+                          static_cast<GLuint>(stage_input.location),  //
+                          stage_input.name                            //
+    );
+  }
+
+  // Linking a program with shaders that failed to compile fails as well. The
+  // compile status of the shaders is checked along with the link status so
+  // that neither blocks here.
+  gl.LinkProgram(pending.program);
+
+  pending.vert_shader = vert_shader;
+  pending.frag_shader = frag_shader;
+  return true;
+}
+
+static bool FinishLinkProgram(const ProcTableGLES& gl,
+                              const PendingPipelineGLES& pending) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+
+  const auto& descriptor = pending.pipeline->GetDescriptor();
+
+  fml::ScopedCleanupClosure delete_shaders([&gl, &pending]() {
+    gl.DetachShader(pending.program, pending.vert_shader);
+    gl.DetachShader(pending.program, pending.frag_shader);
+    gl.DeleteShader(pending.vert_shader);
+    gl.DeleteShader(pending.frag_shader);
+  });
+
   GLint vert_status = GL_FALSE;
   GLint frag_status = GL_FALSE;
 
-  gl.GetShaderiv(vert_shader, GL_COMPILE_STATUS, &vert_status);
-  gl.GetShaderiv(frag_shader, GL_COMPILE_STATUS, &frag_status);
+  gl.GetShaderiv(pending.vert_shader, GL_COMPILE_STATUS, &vert_status);
+  gl.GetShaderiv(pending.frag_shader, GL_COMPILE_STATUS, &frag_status);
 
   if (vert_status != GL_TRUE) {
-    LogShaderCompilationFailure(gl, vert_shader, descriptor.GetLabel(),
-                                *vert_mapping, ShaderStage::kVertex);
+    LogShaderCompilationFailure(
+        gl, pending.vert_shader, descriptor.GetLabel(),
+        *ShaderFunctionGLES::Cast(*pending.vert_function).GetSourceMapping(),
+        ShaderStage::kVertex);
     return false;
   }
 
   if (frag_status != GL_TRUE) {
-    LogShaderCompilationFailure(gl, frag_shader, descriptor.GetLabel(),
-                                *frag_mapping, ShaderStage::kFragment);
+    LogShaderCompilationFailure(
+        gl, pending.frag_shader, descriptor.GetLabel(),
+        *ShaderFunctionGLES::Cast(*pending.frag_function).GetSourceMapping(),
+        ShaderStage::kFragment);
     return false;
   }
 
-  auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
-  if (!program.has_value()) {
-    VALIDATION_LOG << "Could not get program handle from reactor.";
+  GLint link_status = GL_FALSE;
+  gl.GetProgramiv(pending.program, GL_LINK_STATUS, &link_status);
+
+  if (link_status != GL_TRUE) {
+    VALIDATION_LOG << "Could not link shader program: "
+                   << gl.GetProgramInfoLogString(pending.program);
     return false;
   }
+  return true;
+}
 
-  gl.AttachShader(*program, vert_shader);
-  gl.AttachShader(*program, frag_shader);
-
-  fml::ScopedCleanupClosure detach_vert_shader(
-      [&gl, program = *program, vert_shader]() {
-        gl.DetachShader(program, vert_shader);
-      });
-  fml::ScopedCleanupClosure detach_frag_shader(
-      [&gl, program = *program, frag_shader]() {
-        gl.DetachShader(program, frag_shader);
-      });
-
-  for (const auto& stage_input :
-       descriptor.GetVertexDescriptor()->GetStageInputs()) {
-    gl.BindAttribLocation(*program,                                   //
-                          static_cast<GLuint>(stage_input.location),  //
-                          stage_input.name                            //
-    );
+//------------------------------------------------------------------------------
+/// @brief      Check the results of a pending link and fulfill the promise of
+///             the pipeline. This blocks till the driver is done with the link
+///             if it isn't already.
+///
+static void FinishPipeline(const ReactorGLES& reactor,
+                           PendingPipelineGLES& pending) {
+  if (pending.is_finished) {
+    return;
   }
+  pending.is_finished = true;
 
-  gl.LinkProgram(*program);
+  const auto& gl = reactor.GetProcTable();
+  if (!FinishLinkProgram(gl, pending)) {
+    pending.promise.set_value(nullptr);
+    VALIDATION_LOG << "Could not link pipeline program.";
+    return;
+  }
+  if (!pending.pipeline->BuildVertexDescriptor(gl, pending.program)) {
+    pending.promise.set_value(nullptr);
+    VALIDATION_LOG << "Could not build pipeline vertex descriptors.";
+    return;
+  }
+  if (!pending.pipeline->IsValid()) {
+    pending.promise.set_value(nullptr);
+    VALIDATION_LOG << "Pipeline validation checks failed.";
+    return;
+  }
+  FML_DLOG(INFO) << "Compiled and linked '"
+                 << pending.pipeline->GetDescriptor().GetLabel() << "' in "
+                 << (fml::TimePoint::Now() - pending.start_time)
+                        .ToMillisecondsF()
+                 << "ms.";
+  pending.promise.set_value(std::move(pending.pipeline));
+}
 
-  GLint link_status = GL_FALSE;
-  gl.GetProgramiv(*program, GL_LINK_STATUS, &link_status);
+void PipelineLibraryGLES::FinishPendingPipelines(const ReactorGLES& reactor,
+                                                 bool wait) {
+  const auto& gl = reactor.GetProcTable();
+  const auto can_poll = gl.GetCapabilities()->SupportsParallelShaderCompile();
+  if (!wait && !can_poll) {
+    // There is no telling whether a link is done without blocking on it.
+    return;
+  }
+  Lock lock(pending_pipelines_mutex_);
+  std::vector<std::shared_ptr<PendingPipelineGLES>> still_pending;
+  for (auto& pending : pending_pipelines_) {
+    if (!pending->is_finished) {
+      GLint completion_status = GL_TRUE;
+      if (!wait) {
+        gl.GetProgramiv(pending->program, GL_COMPLETION_STATUS_KHR,
+                        &completion_status);
+      }
+      if (completion_status == GL_TRUE) {
+        FinishPipeline(reactor, *pending);
+      }
+    }
+    if (!pending->is_finished) {
+      still_pending.emplace_back(std::move(pending));
+    }
+  }
+  pending_pipelines_ = std::move(still_pending);
+}
 
-  if (link_status != GL_TRUE) {
-    VALIDATION_LOG << "Could not link shader program: "
-                   << gl.GetProgramInfoLogString(*program);
-    return false;
+void PipelineLibraryGLES::FinishPendingPipelines() {
+  if (!reactor_) {
+    return;
   }
-  return true;
+  {
+    Lock lock(pending_pipelines_mutex_);
+    if (pending_pipelines_.empty()) {
+      return;
+    }
+  }
+  auto weak_this = weak_from_this();
+  [[maybe_unused]] auto result =
+      reactor_->AddOperation([weak_this](const ReactorGLES& reactor) {
+        auto strong_this =
+            std::static_pointer_cast<PipelineLibraryGLES>(weak_this.lock());
+        if (strong_this) {
+          strong_this->FinishPendingPipelines(reactor, /*wait=*/true);
+        }
+      });
 }
 
 // |PipelineLibrary|
@@ -204,56 +329,62 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryGLES::GetPipeline(
         RealizedFuture<std::shared_ptr<Pipeline<PipelineDescriptor>>>(nullptr)};
   }
 
-  auto promise = std::make_shared<
-      std::promise<std::shared_ptr<Pipeline<PipelineDescriptor>>>>();
-  auto pipeline_future =
-      PipelineFuture<PipelineDescriptor>{descriptor, promise->get_future()};
-  pipelines_[descriptor] = pipeline_future;
+  auto pending = std::make_shared<PendingPipelineGLES>();
+  pending->vert_function = std::move(vert_function);
+  pending->frag_function = std::move(frag_function);
+  auto link_future = pending->promise.get_future();
   auto weak_this = weak_from_this();
 
   auto result = reactor_->AddOperation(
-      [promise, weak_this, reactor_ptr = reactor_, descriptor, vert_function,
-       frag_function](const ReactorGLES& reactor) {
-        auto strong_this = weak_this.lock();
+      [pending, weak_this, reactor_ptr = reactor_,
+       descriptor](const ReactorGLES& reactor) {
+        auto strong_this =
+            std::static_pointer_cast<PipelineLibraryGLES>(weak_this.lock());
         if (!strong_this) {
-          promise->set_value(nullptr);
+          pending->is_finished = true;
+          pending->promise.set_value(nullptr);
           VALIDATION_LOG << "Library was collected before a pending pipeline "
                             "creation could finish.";
           return;
         }
-        auto pipeline = std::shared_ptr<PipelineGLES>(
+        strong_this->FinishPendingPipelines(reactor, /*wait=*/false);
+        pending->pipeline = std::shared_ptr<PipelineGLES>(
             new PipelineGLES(reactor_ptr, strong_this, descriptor));
-        auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
+        auto program =
+            reactor.GetGLHandle(pending->pipeline->GetProgramHandle());
         if (!program.has_value()) {
-          promise->set_value(nullptr);
+          pending->is_finished = true;
+          pending->promise.set_value(nullptr);
           VALIDATION_LOG << "Could not obtain program handle.";
           return;
         }
-        const auto link_result = LinkProgram(reactor,        //
-                                             pipeline,       //
-                                             vert_function,  //
-                                             frag_function   //
-        );
-        if (!link_result) {
-          promise->set_value(nullptr);
+        pending->program = program.value();
+        if (!BeginLinkProgram(reactor, *pending)) {
+          pending->is_finished = true;
+          pending->promise.set_value(nullptr);
           VALIDATION_LOG << "Could not link pipeline program.";
           return;
         }
-        if (!pipeline->BuildVertexDescriptor(reactor.GetProcTable(),
-                                             program.value())) {
-          promise->set_value(nullptr);
-          VALIDATION_LOG << "Could not build pipeline vertex descriptors.";
-          return;
-        }
-        if (!pipeline->IsValid()) {
-          promise->set_value(nullptr);
-          VALIDATION_LOG << "Pipeline validation checks failed.";
-          return;
-        }
-        promise->set_value(std::move(pipeline));
+        Lock lock(strong_this->pending_pipelines_mutex_);
+        strong_this->pending_pipelines_.emplace_back(pending);
       });
   FML_CHECK(result);
 
+  // Checking the status of the link blocks till the driver is done with it.
+  // Defer that till the pipeline is actually needed.
+  auto finish_pipeline = [pending, reactor = reactor_,
+                          link_future = std::move(link_future)]() mutable {
+    auto result =
+        reactor->AddOperation([pending](const ReactorGLES& reactor) {
+          FinishPipeline(reactor, *pending);
+        });
+    FML_CHECK(result);
+    return link_future.get();
+  };
+  auto pipeline_future = PipelineFuture<PipelineDescriptor>{
+      descriptor,
+      std::async(std::launch::deferred, std::move(finish_pipeline)).share()};
+  pipelines_[descriptor] = pipeline_future;
   return pipeline_future;
 }
 
@@ -278,6 +409,23 @@ void PipelineLibraryGLES::RemovePipelinesWithEntryPoint(
 }
 
 // |PipelineLibrary|
-PipelineLibraryGLES::~PipelineLibraryGLES() = default;
+PipelineLibraryGLES::~PipelineLibraryGLES() {
+  std::vector<std::shared_ptr<PendingPipelineGLES>> pending_pipelines;
+  {
+    Lock lock(pending_pipelines_mutex_);
+    pending_pipelines = std::move(pending_pipelines_);
+  }
+  if (!reactor_ || pending_pipelines.empty()) {
+    return;
+  }
+  // Release the shaders of the pipelines that were never waited on.
+  [[maybe_unused]] auto result = reactor_->AddOperation(
+      [pending_pipelines =
+           std::move(pending_pipelines)](const ReactorGLES& reactor) {
+        for (const auto& pending : pending_pipelines) {
+          FinishPipeline(reactor, *pending);
+        }
+      });
+}
 
 }  // namespace impeller
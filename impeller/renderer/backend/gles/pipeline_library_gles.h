@@ -5,13 +5,36 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PIPELINE_LIBRARY_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PIPELINE_LIBRARY_GLES_H_
 
+#include <memory>
+#include <vector>
+
+#include "impeller/base/thread.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 #include "impeller/renderer/pipeline_library.h"
 
 namespace impeller {
 
 class ContextGLES;
-
+struct PendingPipelineGLES;
+
+//------------------------------------------------------------------------------
+/// @brief      Creates pipelines by compiling and linking programs in reactor
+///             operations.
+///
+///             Programs are compiled and linked as soon as a pipeline is
+///             requested, but their status is only checked once the pipeline
+///             is waited on or the frame is presented, whichever comes first.
+///             Drivers are free to compile in the background till then, so a
+///             batch of pipelines is linked concurrently. When
+///             `GL_KHR_parallel_shader_compile` is available, pending links
+///             are also polled without blocking whenever more pipelines are
+///             requested, so pipelines become available as soon as the driver
+///             is done with them.
+///
+///             Finishing a link releases the shaders of the program. Links
+///             still pending when the library is collected are finished in a
+///             final reactor operation.
+///
 class PipelineLibraryGLES final : public PipelineLibrary {
  public:
   // |PipelineLibrary|
@@ -22,9 +45,29 @@ class PipelineLibraryGLES final : public PipelineLibrary {
 
   ReactorGLES::Ref reactor_;
   PipelineMap pipelines_;
+  Mutex pending_pipelines_mutex_;
+  std::vector<std::shared_ptr<PendingPipelineGLES>> pending_pipelines_
+      IPLR_GUARDED_BY(pending_pipelines_mutex_);
 
   explicit PipelineLibraryGLES(ReactorGLES::Ref reactor);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Finish the pending links in a reactor operation, blocking on
+  ///             the ones the driver isn't done with yet. Called by the
+  ///             context at frame boundaries.
+  ///
+  void FinishPendingPipelines();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Finish the pending links.
+  ///
+  /// @param[in]  wait  Whether to block on links the driver isn't done with.
+  ///                   If not, only links that
+  ///                   `GL_KHR_parallel_shader_compile` reports as complete are
+  ///                   finished, and none without the extension.
+  ///
+  void FinishPendingPipelines(const ReactorGLES& reactor, bool wait);
+
   // |PipelineLibrary|
   bool IsValid() const override;
 
@@ -137,6 +137,10 @@ ProcTableGLES::ProcTableGLES(  // NOLINT(google-readability-function-size)
     DiscardFramebufferEXT.Reset();
   }
 
+  if (!description_->HasExtension("GL_KHR_parallel_shader_compile")) {
+    MaxShaderCompilerThreadsKHR.Reset();
+  }
+
   capabilities_ = std::make_shared<CapabilitiesGLES>(*this);
 
   is_valid_ = true;
@@ -199,7 +199,12 @@ void(glDepthRange)(GLdouble n, GLdouble f);
   PROC(ClearDepth);                               \
   PROC(DepthRange);
 
-#define FOR_EACH_IMPELLER_GLES3_PROC(PROC) PROC(BlitFramebuffer);
+#define FOR_EACH_IMPELLER_GLES3_PROC(PROC) \
+  PROC(BindBufferRange);                   \
+  PROC(BlitFramebuffer);                   \
+  PROC(GetActiveUniformBlockName);         \
+  PROC(GetActiveUniformsiv);               \
+  PROC(UniformBlockBinding);
 
 #define FOR_EACH_IMPELLER_EXT_PROC(PROC)    \
   PROC(DebugMessageControlKHR);             \
@@ -214,7 +219,8 @@ void(glDepthRange)(GLdouble n, GLdouble f);
   PROC(GetQueryObjectui64vEXT);             \
   PROC(BeginQueryEXT);                      \
   PROC(EndQueryEXT);                        \
-  PROC(GetQueryObjectuivEXT);
+  PROC(GetQueryObjectuivEXT);               \
+  PROC(MaxShaderCompilerThreadsKHR);
 
 enum class DebugResourceType {
   kTexture,
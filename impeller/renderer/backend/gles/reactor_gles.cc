@@ -19,6 +19,7 @@ ReactorGLES::ReactorGLES(std::unique_ptr<ProcTableGLES> gl)
     return;
   }
   can_set_debug_labels_ = proc_table_->GetDescription()->HasDebugExtension();
+  state_tracker_ = std::make_unique<StateTrackerGLES>(*proc_table_);
   is_valid_ = true;
 }
 
@@ -50,6 +51,16 @@ const ProcTableGLES& ReactorGLES::GetProcTable() const {
   return *proc_table_;
 }
 
+StateTrackerGLES& ReactorGLES::GetStateTracker() const {
+  FML_DCHECK(IsValid());
+  FML_DCHECK(IsReactingOnCurrentThread());
+  return *state_tracker_;
+}
+
+bool ReactorGLES::IsReactingOnCurrentThread() const {
+  return reacting_thread_.load() == std::this_thread::get_id();
+}
+
 std::optional<GLuint> ReactorGLES::GetGLHandle(const HandleGLES& handle) const {
   ReaderLock handles_lock(handles_mutex_);
   if (auto found = handles_.find(handle); found != handles_.end()) {
@@ -252,10 +263,20 @@ bool ReactorGLES::FlushOps() {
     Lock ops_lock(ops_mutex_);
     std::swap(ops_, ops);
   }
+  reacting_thread_.store(std::this_thread::get_id());
   for (const auto& op : ops) {
     TRACE_EVENT0("impeller", "ReactorGLES::Operation");
+    // The operation may run on a different worker, and so a different
+    // context, than the last one. And the context may have been used outside
+    // of the reactor or by operations that don't go through the tracker.
+    state_tracker_->Invalidate();
     op(*this);
+    // The context may be used outside of the reactor, e.g. to bind external
+    // textures, before the next operation.
+    state_tracker_->Invalidate();
   }
+  reacting_thread_.store(std::thread::id());
+  state_tracker_->TraceAndResetCounts();
   return true;
 }
 
@@ -5,13 +5,16 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_REACTOR_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_REACTOR_GLES_H_
 
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/gles/handle_gles.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
 
 namespace impeller {
 
@@ -138,6 +141,25 @@ class ReactorGLES {
   ///
   const ProcTableGLES& GetProcTable() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the tracker of the state of the OpenGL context that
+  ///             reactions run on. Calls that set state shadowed by the tracker
+  ///             should go through it so that redundant calls are skipped.
+  ///
+  ///             This may only be used within a reaction. That is, within a
+  ///             `ReactorGLES::Operation`. The shadowed state is invalidated
+  ///             before each operation.
+  ///
+  /// @return     The state tracker.
+  ///
+  StateTrackerGLES& GetStateTracker() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether a reaction is being performed on the calling thread.
+  ///             The state tracker may only be used if this is true.
+  ///
+  bool IsReactingOnCurrentThread() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Returns the OpenGL handle for a reactor handle if one is
   ///             available. This is typically only safe to call within a
@@ -232,6 +254,10 @@ class ReactorGLES {
   };
 
   std::unique_ptr<ProcTableGLES> proc_table_;
+  // Only used within reactions, which are serialized by
+  // `ops_execution_mutex_`.
+  std::unique_ptr<StateTrackerGLES> state_tracker_;
+  std::atomic<std::thread::id> reacting_thread_;
 
   Mutex ops_execution_mutex_;
   mutable Mutex ops_mutex_;
@@ -16,6 +16,7 @@
 #include "impeller/renderer/backend/gles/formats_gles.h"
 #include "impeller/renderer/backend/gles/gpu_tracer_gles.h"
 #include "impeller/renderer/backend/gles/pipeline_gles.h"
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
 #include "impeller/renderer/backend/gles/texture_gles.h"
 
 namespace impeller {
@@ -40,22 +41,22 @@ void RenderPassGLES::OnSetLabel(std::string label) {
   label_ = std::move(label);
 }
 
-void ConfigureBlending(const ProcTableGLES& gl,
+void ConfigureBlending(StateTrackerGLES& state,
                        const ColorAttachmentDescriptor* color) {
   if (color->blending_enabled) {
-    gl.Enable(GL_BLEND);
-    gl.BlendFuncSeparate(
+    state.SetEnabled(GL_BLEND, true);
+    state.BlendFuncSeparate(
         ToBlendFactor(color->src_color_blend_factor),  // src color
         ToBlendFactor(color->dst_color_blend_factor),  // dst color
         ToBlendFactor(color->src_alpha_blend_factor),  // src alpha
         ToBlendFactor(color->dst_alpha_blend_factor)   // dst alpha
     );
-    gl.BlendEquationSeparate(
+    state.BlendEquationSeparate(
         ToBlendOperation(color->color_blend_op),  // mode color
         ToBlendOperation(color->alpha_blend_op)   // mode alpha
     );
   } else {
-    gl.Disable(GL_BLEND);
+    state.SetEnabled(GL_BLEND, false);
   }
 
   {
@@ -64,7 +65,7 @@ void ConfigureBlending(const ProcTableGLES& gl,
       return (mask & check) ? GL_TRUE : GL_FALSE;
     };
 
-    gl.ColorMask(
+    state.ColorMask(
         is_set(color->write_mask, ColorWriteMaskBits::kRed),    // red
         is_set(color->write_mask, ColorWriteMaskBits::kGreen),  // green
         is_set(color->write_mask, ColorWriteMaskBits::kBlue),   // blue
@@ -74,44 +75,45 @@ void ConfigureBlending(const ProcTableGLES& gl,
 }
 
 void ConfigureStencil(GLenum face,
-                      const ProcTableGLES& gl,
+                      StateTrackerGLES& state,
                       const StencilAttachmentDescriptor& stencil,
                       uint32_t stencil_reference) {
-  gl.StencilOpSeparate(
+  state.StencilOpSeparate(
       face,                                    // face
       ToStencilOp(stencil.stencil_failure),    // stencil fail
       ToStencilOp(stencil.depth_failure),      // depth fail
       ToStencilOp(stencil.depth_stencil_pass)  // depth stencil pass
   );
-  gl.StencilFuncSeparate(face,                                        // face
-                         ToCompareFunction(stencil.stencil_compare),  // func
-                         stencil_reference,                           // ref
-                         stencil.read_mask                            // mask
+  state.StencilFuncSeparate(
+      face,                                        // face
+      ToCompareFunction(stencil.stencil_compare),  // func
+      stencil_reference,                           // ref
+      stencil.read_mask                            // mask
   );
-  gl.StencilMaskSeparate(face, stencil.write_mask);
+  state.StencilMaskSeparate(face, stencil.write_mask);
 }
 
-void ConfigureStencil(const ProcTableGLES& gl,
+void ConfigureStencil(StateTrackerGLES& state,
                       const PipelineDescriptor& pipeline,
                       uint32_t stencil_reference) {
   if (!pipeline.HasStencilAttachmentDescriptors()) {
-    gl.Disable(GL_STENCIL_TEST);
+    state.SetEnabled(GL_STENCIL_TEST, false);
     return;
   }
 
-  gl.Enable(GL_STENCIL_TEST);
+  state.SetEnabled(GL_STENCIL_TEST, true);
   const auto& front = pipeline.GetFrontStencilAttachmentDescriptor();
   const auto& back = pipeline.GetBackStencilAttachmentDescriptor();
 
   if (front.has_value() && back.has_value() && front == back) {
-    ConfigureStencil(GL_FRONT_AND_BACK, gl, *front, stencil_reference);
+    ConfigureStencil(GL_FRONT_AND_BACK, state, *front, stencil_reference);
     return;
   }
   if (front.has_value()) {
-    ConfigureStencil(GL_FRONT, gl, *front, stencil_reference);
+    ConfigureStencil(GL_FRONT, state, *front, stencil_reference);
   }
   if (back.has_value()) {
-    ConfigureStencil(GL_BACK, gl, *back, stencil_reference);
+    ConfigureStencil(GL_BACK, state, *back, stencil_reference);
   }
 }
 
@@ -150,6 +152,7 @@ struct RenderPassData {
   TRACE_EVENT0("impeller", "RenderPassGLES::EncodeCommandsInReactor");
 
   const auto& gl = reactor.GetProcTable();
+  auto& state = reactor.GetStateTracker();
 #ifdef IMPELLER_DEBUG
   tracer->MarkFrameStart(gl);
 #endif  // IMPELLER_DEBUG
@@ -236,18 +239,29 @@ struct RenderPassData {
     clear_bits |= GL_STENCIL_BUFFER_BIT;
   }
 
-  gl.Disable(GL_SCISSOR_TEST);
-  gl.Disable(GL_DEPTH_TEST);
-  gl.Disable(GL_STENCIL_TEST);
-  gl.Disable(GL_CULL_FACE);
-  gl.Disable(GL_BLEND);
-  gl.ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-  gl.DepthMask(GL_TRUE);
-  gl.StencilMaskSeparate(GL_FRONT, 0xFFFFFFFF);
-  gl.StencilMaskSeparate(GL_BACK, 0xFFFFFFFF);
+  state.SetEnabled(GL_SCISSOR_TEST, false);
+  state.SetEnabled(GL_DEPTH_TEST, false);
+  state.SetEnabled(GL_STENCIL_TEST, false);
+  state.SetEnabled(GL_CULL_FACE, false);
+  state.SetEnabled(GL_BLEND, false);
+  state.ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  state.DepthMask(GL_TRUE);
+  state.StencilMaskSeparate(GL_FRONT, 0xFFFFFFFF);
+  state.StencilMaskSeparate(GL_BACK, 0xFFFFFFFF);
 
   gl.Clear(clear_bits);
 
+  // The vertex attributes and program stay bound across commands with the
+  // same pipeline and are only unbound when the pipeline changes and at the
+  // end of the pass.
+  const PipelineGLES* bound_pipeline = nullptr;
+  fml::ScopedCleanupClosure unbind_pipeline([&state, &bound_pipeline]() {
+    if (bound_pipeline) {
+      bound_pipeline->GetBufferBindings()->UnbindVertexAttributes(state);
+      [[maybe_unused]] auto unbound = bound_pipeline->UnbindProgram();
+    }
+  });
+
   for (const auto& command : commands) {
     if (command.instance_count != 1u) {
       VALIDATION_LOG << "GLES backend does not support instanced rendering.";
@@ -282,12 +296,13 @@ struct RenderPassData {
     //--------------------------------------------------------------------------
     /// Configure blending.
     ///
-    ConfigureBlending(gl, color_attachment);
+    ConfigureBlending(state, color_attachment);
 
     //--------------------------------------------------------------------------
     /// Setup stencil.
     ///
-    ConfigureStencil(gl, pipeline.GetDescriptor(), command.stencil_reference);
+    ConfigureStencil(state, pipeline.GetDescriptor(),
+                     command.stencil_reference);
 
     //--------------------------------------------------------------------------
     /// Configure depth.
@@ -295,11 +310,11 @@ struct RenderPassData {
     if (auto depth =
             pipeline.GetDescriptor().GetDepthStencilAttachmentDescriptor();
         depth.has_value()) {
-      gl.Enable(GL_DEPTH_TEST);
-      gl.DepthFunc(ToCompareFunction(depth->depth_compare));
-      gl.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
+      state.SetEnabled(GL_DEPTH_TEST, true);
+      state.DepthFunc(ToCompareFunction(depth->depth_compare));
+      state.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
     } else {
-      gl.Disable(GL_DEPTH_TEST);
+      state.SetEnabled(GL_DEPTH_TEST, false);
     }
 
     // Both the viewport and scissor are specified in framebuffer coordinates.
@@ -311,18 +326,15 @@ struct RenderPassData {
     /// Setup the viewport.
     ///
     const auto& viewport = command.viewport.value_or(pass_data.viewport);
-    gl.Viewport(viewport.rect.GetX(),  // x
-                target_size.height - viewport.rect.GetY() -
-                    viewport.rect.GetHeight(),  // y
-                viewport.rect.GetWidth(),       // width
-                viewport.rect.GetHeight()       // height
+    state.Viewport(viewport.rect.GetX(),  // x
+                   target_size.height - viewport.rect.GetY() -
+                       viewport.rect.GetHeight(),  // y
+                   viewport.rect.GetWidth(),       // width
+                   viewport.rect.GetHeight()       // height
     );
     if (pass_data.depth_attachment) {
-      if (gl.DepthRangef.IsAvailable()) {
-        gl.DepthRangef(viewport.depth_range.z_near, viewport.depth_range.z_far);
-      } else {
-        gl.DepthRange(viewport.depth_range.z_near, viewport.depth_range.z_far);
-      }
+      state.DepthRange(viewport.depth_range.z_near,
+                       viewport.depth_range.z_far);
     }
 
     //--------------------------------------------------------------------------
@@ -330,15 +342,15 @@ struct RenderPassData {
     ///
     if (command.scissor.has_value()) {
       const auto& scissor = command.scissor.value();
-      gl.Enable(GL_SCISSOR_TEST);
-      gl.Scissor(
+      state.SetEnabled(GL_SCISSOR_TEST, true);
+      state.Scissor(
           scissor.GetX(),                                             // x
           target_size.height - scissor.GetY() - scissor.GetHeight(),  // y
           scissor.GetWidth(),                                         // width
           scissor.GetHeight()                                         // height
       );
     } else {
-      gl.Disable(GL_SCISSOR_TEST);
+      state.SetEnabled(GL_SCISSOR_TEST, false);
     }
 
     //--------------------------------------------------------------------------
@@ -346,15 +358,15 @@ struct RenderPassData {
     ///
     switch (pipeline.GetDescriptor().GetCullMode()) {
       case CullMode::kNone:
-        gl.Disable(GL_CULL_FACE);
+        state.SetEnabled(GL_CULL_FACE, false);
         break;
       case CullMode::kFrontFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_FRONT);
+        state.SetEnabled(GL_CULL_FACE, true);
+        state.CullFace(GL_FRONT);
         break;
       case CullMode::kBackFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_BACK);
+        state.SetEnabled(GL_CULL_FACE, true);
+        state.CullFace(GL_BACK);
         break;
     }
     //--------------------------------------------------------------------------
@@ -362,10 +374,10 @@ struct RenderPassData {
     ///
     switch (pipeline.GetDescriptor().GetWindingOrder()) {
       case WindingOrder::kClockwise:
-        gl.FrontFace(GL_CW);
+        state.FrontFace(GL_CW);
         break;
       case WindingOrder::kCounterClockwise:
-        gl.FrontFace(GL_CCW);
+        state.FrontFace(GL_CCW);
         break;
     }
 
@@ -397,8 +409,15 @@ struct RenderPassData {
     }
 
     //--------------------------------------------------------------------------
-    /// Bind the pipeline program.
+    /// Bind the pipeline program. Vertex attribs of the previous pipeline that
+    /// this one doesn't use are disabled.
     ///
+    if (bound_pipeline != &pipeline) {
+      if (bound_pipeline) {
+        bound_pipeline->GetBufferBindings()->UnbindVertexAttributes(state);
+      }
+      bound_pipeline = &pipeline;
+    }
     if (!pipeline.BindProgram()) {
       return false;
     }
@@ -407,7 +426,7 @@ struct RenderPassData {
     /// Bind vertex attribs.
     ///
     if (!vertex_desc_gles->BindVertexAttributes(
-            gl, vertex_buffer_view.range.offset)) {
+            gl, state, vertex_buffer_view.range.offset)) {
       return false;
     }
 
@@ -415,6 +434,7 @@ struct RenderPassData {
     /// Bind uniform data.
     ///
     if (!vertex_desc_gles->BindUniformData(gl,                        //
+                                           state,                     //
                                            *transients_allocator,     //
                                            command.vertex_bindings,   //
                                            command.fragment_bindings  //
@@ -456,20 +476,6 @@ struct RenderPassData {
                           index_buffer_view.range.offset))  // indices
       );
     }
-
-    //--------------------------------------------------------------------------
-    /// Unbind vertex attribs.
-    ///
-    if (!vertex_desc_gles->UnbindVertexAttributes(gl)) {
-      return false;
-    }
-
-    //--------------------------------------------------------------------------
-    /// Unbind the program pipeline.
-    ///
-    if (!pipeline.UnbindProgram()) {
-      return false;
-    }
   }
 
   if (gl.DiscardFramebufferEXT.IsAvailable()) {
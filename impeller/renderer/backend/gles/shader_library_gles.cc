@@ -67,6 +67,8 @@ ShaderLibraryGLES::ShaderLibraryGLES(
 
     return true;
   };
+  // Shaders in later libraries replace the ones of the same name in earlier
+  // libraries.
   for (auto library : shader_libraries) {
     auto blob_library = ShaderArchive{std::move(library)};
     if (!blob_library.IsValid()) {
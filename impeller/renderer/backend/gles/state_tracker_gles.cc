@@ -0,0 +1,277 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
+
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+StateTrackerGLES::StateTrackerGLES(const ProcTableGLES& gl) : gl_(gl) {}
+
+StateTrackerGLES::~StateTrackerGLES() = default;
+
+void StateTrackerGLES::Invalidate() {
+  capabilities_.fill(std::nullopt);
+  program_ = std::nullopt;
+  array_buffer_ = std::nullopt;
+  element_array_buffer_ = std::nullopt;
+  active_texture_ = std::nullopt;
+  texture_bindings_.fill({});
+  vertex_attrib_arrays_.fill(std::nullopt);
+  blend_func_ = std::nullopt;
+  blend_equation_ = std::nullopt;
+  color_mask_ = std::nullopt;
+  depth_func_ = std::nullopt;
+  depth_mask_ = std::nullopt;
+  depth_range_ = std::nullopt;
+  front_stencil_ = {};
+  back_stencil_ = {};
+  cull_face_ = std::nullopt;
+  front_face_ = std::nullopt;
+  viewport_ = std::nullopt;
+  scissor_ = std::nullopt;
+}
+
+void StateTrackerGLES::SetEnabled(GLenum capability, bool enabled) {
+  auto setter = [&]() {
+    if (enabled) {
+      gl_.Enable(capability);
+    } else {
+      gl_.Disable(capability);
+    }
+  };
+  std::optional<Capability> tracked;
+  switch (capability) {
+    case GL_BLEND:
+      tracked = Capability::kBlend;
+      break;
+    case GL_CULL_FACE:
+      tracked = Capability::kCullFace;
+      break;
+    case GL_DEPTH_TEST:
+      tracked = Capability::kDepthTest;
+      break;
+    case GL_SCISSOR_TEST:
+      tracked = Capability::kScissorTest;
+      break;
+    case GL_STENCIL_TEST:
+      tracked = Capability::kStencilTest;
+      break;
+  }
+  if (!tracked.has_value()) {
+    issued_call_count_++;
+    setter();
+    return;
+  }
+  Update(capabilities_[static_cast<size_t>(tracked.value())], enabled, setter);
+}
+
+void StateTrackerGLES::UseProgram(GLuint program) {
+  Update(program_, program, [&]() { gl_.UseProgram(program); });
+}
+
+void StateTrackerGLES::BindBuffer(GLenum target, GLuint buffer) {
+  auto setter = [&]() { gl_.BindBuffer(target, buffer); };
+  switch (target) {
+    case GL_ARRAY_BUFFER:
+      Update(array_buffer_, buffer, setter);
+      return;
+    case GL_ELEMENT_ARRAY_BUFFER:
+      Update(element_array_buffer_, buffer, setter);
+      return;
+  }
+  issued_call_count_++;
+  setter();
+}
+
+void StateTrackerGLES::ActiveTexture(GLenum unit) {
+  Update(active_texture_, unit, [&]() { gl_.ActiveTexture(unit); });
+}
+
+void StateTrackerGLES::BindTexture(GLenum target, GLuint texture) {
+  auto setter = [&]() { gl_.BindTexture(target, texture); };
+  std::optional<TextureTarget> tracked;
+  switch (target) {
+    case GL_TEXTURE_2D:
+      tracked = TextureTarget::kTexture2D;
+      break;
+    case GL_TEXTURE_CUBE_MAP:
+      tracked = TextureTarget::kTextureCubeMap;
+      break;
+    case GL_TEXTURE_EXTERNAL_OES:
+      tracked = TextureTarget::kTextureExternal;
+      break;
+  }
+  // Bindings are per texture unit, so they can only be shadowed once the
+  // active unit is known.
+  const size_t unit = active_texture_.has_value()
+                          ? active_texture_.value() - GL_TEXTURE0
+                          : kMaxTextureUnits;
+  if (!tracked.has_value() || unit >= kMaxTextureUnits) {
+    issued_call_count_++;
+    setter();
+    return;
+  }
+  Update(texture_bindings_[unit][static_cast<size_t>(tracked.value())],
+         texture, setter);
+}
+
+void StateTrackerGLES::SetVertexAttribArrayEnabled(GLuint index,
+                                                   bool enabled) {
+  auto setter = [&]() {
+    if (enabled) {
+      gl_.EnableVertexAttribArray(index);
+    } else {
+      gl_.DisableVertexAttribArray(index);
+    }
+  };
+  if (index >= kMaxVertexAttribs) {
+    issued_call_count_++;
+    setter();
+    return;
+  }
+  Update(vertex_attrib_arrays_[index], enabled, setter);
+}
+
+void StateTrackerGLES::BlendFuncSeparate(GLenum src_rgb,
+                                         GLenum dst_rgb,
+                                         GLenum src_alpha,
+                                         GLenum dst_alpha) {
+  Update(blend_func_, std::make_tuple(src_rgb, dst_rgb, src_alpha, dst_alpha),
+         [&]() {
+           gl_.BlendFuncSeparate(src_rgb, dst_rgb, src_alpha, dst_alpha);
+         });
+}
+
+void StateTrackerGLES::BlendEquationSeparate(GLenum mode_rgb,
+                                             GLenum mode_alpha) {
+  Update(blend_equation_, std::make_tuple(mode_rgb, mode_alpha),
+         [&]() { gl_.BlendEquationSeparate(mode_rgb, mode_alpha); });
+}
+
+void StateTrackerGLES::ColorMask(GLboolean red,
+                                 GLboolean green,
+                                 GLboolean blue,
+                                 GLboolean alpha) {
+  Update(color_mask_, std::make_tuple(red, green, blue, alpha),
+         [&]() { gl_.ColorMask(red, green, blue, alpha); });
+}
+
+void StateTrackerGLES::DepthFunc(GLenum func) {
+  Update(depth_func_, func, [&]() { gl_.DepthFunc(func); });
+}
+
+void StateTrackerGLES::DepthMask(GLboolean flag) {
+  Update(depth_mask_, flag, [&]() { gl_.DepthMask(flag); });
+}
+
+void StateTrackerGLES::DepthRange(GLfloat near_value, GLfloat far_value) {
+  Update(depth_range_, std::make_tuple(near_value, far_value), [&]() {
+    if (gl_.DepthRangef.IsAvailable()) {
+      gl_.DepthRangef(near_value, far_value);
+    } else {
+      gl_.DepthRange(near_value, far_value);
+    }
+  });
+}
+
+template <class T, class Setter>
+void StateTrackerGLES::UpdateStencil(GLenum face,
+                                     std::optional<T> StencilState::*member,
+                                     const T& value,
+                                     const Setter& setter) {
+  switch (face) {
+    case GL_FRONT:
+      Update(front_stencil_.*member, value, setter);
+      return;
+    case GL_BACK:
+      Update(back_stencil_.*member, value, setter);
+      return;
+    case GL_FRONT_AND_BACK: {
+      // One call sets both faces, so it can only be skipped if neither
+      // changes.
+      auto& front = front_stencil_.*member;
+      auto& back = back_stencil_.*member;
+      if (front == value && back == value) {
+        elided_call_count_++;
+        return;
+      }
+      front = value;
+      back = value;
+      issued_call_count_++;
+      setter();
+      return;
+    }
+  }
+  issued_call_count_++;
+  setter();
+}
+
+void StateTrackerGLES::StencilOpSeparate(GLenum face,
+                                         GLenum stencil_fail,
+                                         GLenum depth_fail,
+                                         GLenum depth_pass) {
+  UpdateStencil(face, &StencilState::op,
+                std::make_tuple(stencil_fail, depth_fail, depth_pass), [&]() {
+                  gl_.StencilOpSeparate(face, stencil_fail, depth_fail,
+                                        depth_pass);
+                });
+}
+
+void StateTrackerGLES::StencilFuncSeparate(GLenum face,
+                                           GLenum func,
+                                           GLint ref,
+                                           GLuint mask) {
+  UpdateStencil(face, &StencilState::func, std::make_tuple(func, ref, mask),
+                [&]() { gl_.StencilFuncSeparate(face, func, ref, mask); });
+}
+
+void StateTrackerGLES::StencilMaskSeparate(GLenum face, GLuint mask) {
+  UpdateStencil(face, &StencilState::write_mask, mask,
+                [&]() { gl_.StencilMaskSeparate(face, mask); });
+}
+
+void StateTrackerGLES::CullFace(GLenum mode) {
+  Update(cull_face_, mode, [&]() { gl_.CullFace(mode); });
+}
+
+void StateTrackerGLES::FrontFace(GLenum mode) {
+  Update(front_face_, mode, [&]() { gl_.FrontFace(mode); });
+}
+
+void StateTrackerGLES::Viewport(GLint x,
+                                GLint y,
+                                GLsizei width,
+                                GLsizei height) {
+  Update(viewport_, std::make_tuple(x, y, width, height),
+         [&]() { gl_.Viewport(x, y, width, height); });
+}
+
+void StateTrackerGLES::Scissor(GLint x,
+                               GLint y,
+                               GLsizei width,
+                               GLsizei height) {
+  Update(scissor_, std::make_tuple(x, y, width, height),
+         [&]() { gl_.Scissor(x, y, width, height); });
+}
+
+size_t StateTrackerGLES::GetIssuedCallCount() const {
+  return issued_call_count_;
+}
+
+size_t StateTrackerGLES::GetElidedCallCount() const {
+  return elided_call_count_;
+}
+
+void StateTrackerGLES::TraceAndResetCounts() {
+  FML_TRACE_COUNTER("impeller", "GLStateCalls",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "Issued", issued_call_count_,     //
+                    "Elided", elided_call_count_);
+  issued_call_count_ = 0u;
+  elided_call_count_ = 0u;
+}
+
+}  // namespace impeller
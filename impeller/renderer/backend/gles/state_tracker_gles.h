@@ -0,0 +1,212 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_TRACKER_GLES_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_TRACKER_GLES_H_
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+
+#include "impeller/renderer/backend/gles/gles.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Shadows the fixed function state, program and buffer and
+///             texture bindings of the OpenGL context a reaction runs on, and
+///             skips calls that would not change them.
+///
+///             Render passes set up all of this state for each command, and
+///             most of these calls are redundant. On drivers where each call is
+///             expensive (ANGLE and most mobile drivers), these calls would
+///             otherwise dominate the cost of encoding.
+///
+///             Shadowed state starts out unknown, so the first call for each
+///             piece of state is always made. The reactor invalidates the
+///             shadowed state before each operation, since operations may run
+///             on any worker and the context of a worker may be used by others
+///             in between. Within an operation, all changes to shadowed state
+///             must go through the tracker.
+///
+///             The tracker is owned by the reactor and may only be used from
+///             within a reaction.
+///
+class StateTrackerGLES {
+ public:
+  static constexpr size_t kMaxTextureUnits = 32u;
+
+  static constexpr size_t kMaxVertexAttribs = 16u;
+
+  explicit StateTrackerGLES(const ProcTableGLES& gl);
+
+  ~StateTrackerGLES();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forget all shadowed state so that the next call for each
+  ///             piece of state is made.
+  ///
+  void Invalidate();
+
+  void SetEnabled(GLenum capability, bool enabled);
+
+  void UseProgram(GLuint program);
+
+  void BindBuffer(GLenum target, GLuint buffer);
+
+  void ActiveTexture(GLenum unit);
+
+  void BindTexture(GLenum target, GLuint texture);
+
+  void SetVertexAttribArrayEnabled(GLuint index, bool enabled);
+
+  void BlendFuncSeparate(GLenum src_rgb,
+                         GLenum dst_rgb,
+                         GLenum src_alpha,
+                         GLenum dst_alpha);
+
+  void BlendEquationSeparate(GLenum mode_rgb, GLenum mode_alpha);
+
+  void ColorMask(GLboolean red,
+                 GLboolean green,
+                 GLboolean blue,
+                 GLboolean alpha);
+
+  void DepthFunc(GLenum func);
+
+  void DepthMask(GLboolean flag);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Set the depth range, with `glDepthRangef` on OpenGL ES and
+  ///             `glDepthRange` on desktop OpenGL.
+  ///
+  void DepthRange(GLfloat near_value, GLfloat far_value);
+
+  void StencilOpSeparate(GLenum face,
+                         GLenum stencil_fail,
+                         GLenum depth_fail,
+                         GLenum depth_pass);
+
+  void StencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask);
+
+  void StencilMaskSeparate(GLenum face, GLuint mask);
+
+  void CullFace(GLenum mode);
+
+  void FrontFace(GLenum mode);
+
+  void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void Scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of calls made through the tracker since the counts
+  ///             were last reset.
+  ///
+  size_t GetIssuedCallCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of calls skipped by the tracker since the counts
+  ///             were last reset.
+  ///
+  size_t GetElidedCallCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Emit the call counts to the timeline and reset them.
+  ///
+  void TraceAndResetCounts();
+
+ private:
+  struct StencilState {
+    std::optional<std::tuple<GLenum, GLenum, GLenum>> op;
+    std::optional<std::tuple<GLenum, GLint, GLuint>> func;
+    std::optional<GLuint> write_mask;
+  };
+
+  // The capabilities set by render passes. Others aren't shadowed.
+  enum class Capability {
+    kBlend,
+    kCullFace,
+    kDepthTest,
+    kScissorTest,
+    kStencilTest,
+    kLast,
+  };
+
+  // The texture targets Impeller binds. Others aren't shadowed.
+  enum class TextureTarget {
+    kTexture2D,
+    kTextureCubeMap,
+    kTextureExternal,
+    kLast,
+  };
+
+  using TextureBindings =
+      std::array<std::optional<GLuint>,
+                 static_cast<size_t>(TextureTarget::kLast)>;
+
+  const ProcTableGLES& gl_;
+  size_t issued_call_count_ = 0u;
+  size_t elided_call_count_ = 0u;
+
+  std::array<std::optional<bool>, static_cast<size_t>(Capability::kLast)>
+      capabilities_;
+  std::optional<GLuint> program_;
+  std::optional<GLuint> array_buffer_;
+  std::optional<GLuint> element_array_buffer_;
+  std::optional<GLenum> active_texture_;
+  std::array<TextureBindings, kMaxTextureUnits> texture_bindings_;
+  std::array<std::optional<bool>, kMaxVertexAttribs> vertex_attrib_arrays_;
+  std::optional<std::tuple<GLenum, GLenum, GLenum, GLenum>> blend_func_;
+  std::optional<std::tuple<GLenum, GLenum>> blend_equation_;
+  std::optional<std::tuple<GLboolean, GLboolean, GLboolean, GLboolean>>
+      color_mask_;
+  std::optional<GLenum> depth_func_;
+  std::optional<GLboolean> depth_mask_;
+  std::optional<std::tuple<GLfloat, GLfloat>> depth_range_;
+  StencilState front_stencil_;
+  StencilState back_stencil_;
+  std::optional<GLenum> cull_face_;
+  std::optional<GLenum> front_face_;
+  std::optional<std::tuple<GLint, GLint, GLsizei, GLsizei>> viewport_;
+  std::optional<std::tuple<GLint, GLint, GLsizei, GLsizei>> scissor_;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Update the shadowed value and invoke the setter if it
+  ///             changed.
+  ///
+  /// @return     If the setter was invoked.
+  ///
+  template <class T, class Setter>
+  bool Update(std::optional<T>& shadow, const T& value, const Setter& setter) {
+    if (shadow.has_value() && shadow.value() == value) {
+      elided_call_count_++;
+      return false;
+    }
+    shadow = value;
+    issued_call_count_++;
+    setter();
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Update the stencil state of one or both faces, which is
+  ///             selected by the member pointer.
+  ///
+  template <class T, class Setter>
+  void UpdateStencil(GLenum face,
+                     std::optional<T> StencilState::*member,
+                     const T& value,
+                     const Setter& setter);
+
+  StateTrackerGLES(const StateTrackerGLES&) = delete;
+
+  StateTrackerGLES& operator=(const StateTrackerGLES&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_TRACKER_GLES_H_
@@ -74,19 +74,27 @@ std::unique_ptr<Surface> SurfaceGLES::WrapFBO(
 #endif  // IMPELLER_DEBUG
 
   return std::unique_ptr<SurfaceGLES>(
-      new SurfaceGLES(std::move(swap_callback), render_target_desc));
+      new SurfaceGLES(context, std::move(swap_callback), render_target_desc));
 }
 
-SurfaceGLES::SurfaceGLES(SwapCallback swap_callback,
+SurfaceGLES::SurfaceGLES(std::weak_ptr<Context> context,
+                         SwapCallback swap_callback,
                          const RenderTarget& target_desc)
-    : Surface(target_desc), swap_callback_(std::move(swap_callback)) {}
+    : Surface(target_desc),
+      context_(std::move(context)),
+      swap_callback_(std::move(swap_callback)) {}
 
 // |Surface|
 SurfaceGLES::~SurfaceGLES() = default;
 
 // |Surface|
 bool SurfaceGLES::Present() const {
-  return swap_callback_ ? swap_callback_() : false;
+  const bool presented = swap_callback_ ? swap_callback_() : false;
+  // Pipelines requested during the frame have had the whole frame to link.
+  if (auto context = context_.lock()) {
+    ContextGLES::Cast(*context).FinishPendingPipelines();
+  }
+  return presented;
 }
 
 }  // namespace impeller
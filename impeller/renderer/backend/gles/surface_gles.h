@@ -29,9 +29,12 @@ class SurfaceGLES final : public Surface {
   ~SurfaceGLES() override;
 
  private:
+  std::weak_ptr<Context> context_;
   SwapCallback swap_callback_;
 
-  SurfaceGLES(SwapCallback swap_callback, const RenderTarget& target_desc);
+  SurfaceGLES(std::weak_ptr<Context> context,
+              SwapCallback swap_callback,
+              const RenderTarget& target_desc);
 
   // |Surface|
   bool Present() const override;
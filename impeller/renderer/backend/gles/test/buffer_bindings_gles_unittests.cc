@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/base/allocation.h"
+#include "impeller/core/allocator.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/renderer/backend/gles/buffer_bindings_gles.h"
+#include "impeller/renderer/backend/gles/device_buffer_gles.h"
+#include "impeller/renderer/backend/gles/reactor_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+class TestWorker : public ReactorGLES::Worker {
+ public:
+  // |ReactorGLES::Worker|
+  bool CanReactorReactOnCurrentThreadNow(
+      const ReactorGLES& reactor) const override {
+    return true;
+  }
+};
+
+class TestAllocator : public Allocator {
+ public:
+  ISize GetMaxTextureSizeSupported() const override {
+    return ISize(1024, 1024);
+  };
+
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    return nullptr;
+  };
+
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    return nullptr;
+  };
+};
+
+size_t CountCalls(const std::vector<std::string>& calls,
+                  const std::string& name) {
+  return std::count(calls.begin(), calls.end(), name);
+}
+
+}  // namespace
+
+TEST(BufferBindingsGLESTest, BindsUniformBlocksWithSingleCall) {
+  auto mock_gles = MockGLES::Init();
+  mock_gles->SetActiveUniformBlocks({"FragInfo"});
+  auto reactor = std::make_shared<ReactorGLES>(
+      std::make_unique<ProcTableGLES>(kMockResolverGLES));
+  auto worker = std::make_shared<TestWorker>();
+  reactor->AddWorker(worker);
+  ASSERT_TRUE(
+      reactor->GetProcTable().GetCapabilities()->SupportsUniformBuffers());
+
+  auto backing_store = std::make_shared<Allocation>();
+  ASSERT_TRUE(backing_store->Truncate(256u));
+  auto device_buffer = std::make_shared<DeviceBufferGLES>(
+      DeviceBufferDescriptor{
+          .storage_mode = StorageMode::kHostVisible,
+          .size = 256u,
+      },
+      reactor, backing_store);
+
+  ShaderMetadata metadata = {
+      "FragInfo",  // name
+      {
+          ShaderStructMemberMetadata{
+              ShaderType::kFloat,  // type
+              "mvp",               // name
+              0u,                  // offset
+              sizeof(Matrix),      // size
+              sizeof(Matrix),      // byte_length
+              std::nullopt,        // array_elements
+          },
+          ShaderStructMemberMetadata{
+              ShaderType::kFloat,  // type
+              "color",             // name
+              sizeof(Matrix),      // offset
+              sizeof(Vector4),     // size
+              sizeof(Vector4),     // byte_length
+              std::nullopt,        // array_elements
+          },
+      },
+  };
+  Bindings fragment_bindings;
+  fragment_bindings.buffers.push_back(BufferAndUniformSlot{
+      .slot = ShaderUniformSlot{.name = "FragInfo"},
+      .view = BufferResource(
+          &metadata,
+          BufferView{device_buffer,
+                     Range{0u, sizeof(Matrix) + sizeof(Vector4)}}),
+  });
+
+  TestAllocator allocator;
+  std::vector<std::string> calls;
+  EXPECT_TRUE(reactor->AddOperation([&](const ReactorGLES& reactor_gles) {
+    const auto& gl = reactor_gles.GetProcTable();
+    BufferBindingsGLES bindings;
+    ASSERT_TRUE(bindings.ReadUniformsBindings(gl, 1u));
+    EXPECT_EQ(
+        CountCalls(mock_gles->GetCapturedCalls(), "glUniformBlockBinding"),
+        1u);
+
+    EXPECT_TRUE(bindings.BindUniformData(gl, reactor_gles.GetStateTracker(),
+                                         allocator, Bindings{},
+                                         fragment_bindings));
+    calls = mock_gles->GetCapturedCalls();
+  }));
+
+  // The whole block is bound from the buffer instead of specifying each
+  // member of the struct.
+  EXPECT_EQ(CountCalls(calls, "glBindBufferRange"), 1u);
+  EXPECT_EQ(CountCalls(calls, "glUniformMatrix4fv"), 0u);
+  EXPECT_EQ(CountCalls(calls, "glUniform4fv"), 0u);
+}
+
+}  // namespace testing
+}  // namespace impeller
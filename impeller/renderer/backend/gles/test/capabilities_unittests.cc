@@ -63,5 +63,39 @@ TEST(CapabilitiesGLES, SupportsFramebufferFetch) {
   EXPECT_TRUE(capabilities->SupportsFramebufferFetch());
 }
 
+TEST(CapabilitiesGLES, SupportsParallelShaderCompile) {
+  auto const extensions = std::vector<const unsigned char*>{
+      reinterpret_cast<const unsigned char*>("GL_KHR_debug"),  //
+      reinterpret_cast<const unsigned char*>(
+          "GL_KHR_parallel_shader_compile"),  //
+  };
+  auto mock_gles = MockGLES::Init(extensions);
+  auto capabilities = mock_gles->GetProcTable().GetCapabilities();
+  EXPECT_TRUE(capabilities->SupportsParallelShaderCompile());
+  EXPECT_TRUE(
+      mock_gles->GetProcTable().MaxShaderCompilerThreadsKHR.IsAvailable());
+}
+
+TEST(CapabilitiesGLES, DoesNotSupportParallelShaderCompileByDefault) {
+  auto mock_gles = MockGLES::Init();
+  auto capabilities = mock_gles->GetProcTable().GetCapabilities();
+  EXPECT_FALSE(capabilities->SupportsParallelShaderCompile());
+  EXPECT_FALSE(
+      mock_gles->GetProcTable().MaxShaderCompilerThreadsKHR.IsAvailable());
+}
+
+TEST(CapabilitiesGLES, SupportsUniformBuffersOnGLES3) {
+  auto mock_gles = MockGLES::Init(std::nullopt, "OpenGL ES 3.0");
+  auto capabilities = mock_gles->GetProcTable().GetCapabilities();
+  EXPECT_TRUE(capabilities->SupportsUniformBuffers());
+  EXPECT_EQ(capabilities->uniform_buffer_offset_alignment, 64u);
+}
+
+TEST(CapabilitiesGLES, DoesNotSupportUniformBuffersOnGLES2) {
+  auto mock_gles = MockGLES::Init(std::nullopt, "OpenGL ES 2.0");
+  auto capabilities = mock_gles->GetProcTable().GetCapabilities();
+  EXPECT_FALSE(capabilities->SupportsUniformBuffers());
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/gles/context_gles.h"
+#include "impeller/renderer/backend/gles/shader_function_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+#include "impeller/shader_archive/shader_archive_writer.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+std::shared_ptr<fml::Mapping> CreateMappingFromString(std::string p_string) {
+  auto string = std::make_shared<std::string>(std::move(p_string));
+  return std::make_shared<fml::NonOwnedMapping>(
+      reinterpret_cast<const uint8_t*>(string->data()), string->size(),
+      [string](auto, auto) {});
+}
+
+std::shared_ptr<fml::Mapping> CreateShaderArchive(const std::string& source) {
+  ShaderArchiveWriter writer;
+  FML_CHECK(writer.AddShader(ArchiveShaderType::kFragment, "test",
+                             CreateMappingFromString(source)));
+  return writer.CreateMapping();
+}
+
+std::string GetFragmentSource(const ContextGLES& context) {
+  auto function = context.GetShaderLibrary()->GetFunction(
+      "test_fragment_main", ShaderStage::kFragment);
+  if (!function) {
+    return "";
+  }
+  const auto& mapping = ShaderFunctionGLES::Cast(*function).GetSourceMapping();
+  return std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                     mapping->GetSize());
+}
+
+}  // namespace
+
+TEST(ContextGLESTest, PrefersGLES3ShadersOnGLES3Contexts) {
+  auto mock_gles = MockGLES::Init(std::nullopt, "OpenGL ES 3.0");
+  auto context = ContextGLES::Create(
+      std::make_unique<ProcTableGLES>(kMockResolverGLES),
+      {CreateShaderArchive("#version 100")}, /*enable_gpu_tracing=*/false,
+      {CreateShaderArchive("#version 300 es")});
+  ASSERT_TRUE(context && context->IsValid());
+
+  EXPECT_EQ(GetFragmentSource(*context), "#version 300 es");
+}
+
+TEST(ContextGLESTest, IgnoresGLES3ShadersOnGLES2Contexts) {
+  auto mock_gles = MockGLES::Init(std::nullopt, "OpenGL ES 2.0");
+  auto context = ContextGLES::Create(
+      std::make_unique<ProcTableGLES>(kMockResolverGLES),
+      {CreateShaderArchive("#version 100")}, /*enable_gpu_tracing=*/false,
+      {CreateShaderArchive("#version 300 es")});
+  ASSERT_TRUE(context && context->IsValid());
+
+  EXPECT_EQ(GetFragmentSource(*context), "#version 100");
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 #include "GLES3/gl3.h"
@@ -32,6 +34,14 @@ void RecordGLCall(const char* name) {
   }
 }
 
+// Has friend visibility into MockGLES to read the mocked program state.
+std::vector<std::string> GetActiveUniformBlocks() {
+  if (auto mock_gles = g_mock_gles.lock()) {
+    return mock_gles->active_uniform_blocks_;
+  }
+  return {};
+}
+
 template <typename T, typename U>
 struct CheckSameSignature : std::false_type {};
 
@@ -83,6 +93,9 @@ void mockGetIntegerv(GLenum name, int* value) {
     case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
       *value = 8;
       break;
+    case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:
+      *value = 64;
+      break;
     default:
       *value = 0;
       break;
@@ -163,6 +176,192 @@ void mockDeleteQueriesEXT(GLsizei size, const GLuint* queries) {
 static_assert(CheckSameSignature<decltype(mockDeleteQueriesEXT),  //
                                  decltype(glDeleteQueriesEXT)>::value);
 
+void mockEnable(GLenum cap) {
+  RecordGLCall("glEnable");
+}
+
+static_assert(CheckSameSignature<decltype(mockEnable),  //
+                                 decltype(glEnable)>::value);
+
+void mockDisable(GLenum cap) {
+  RecordGLCall("glDisable");
+}
+
+static_assert(CheckSameSignature<decltype(mockDisable),  //
+                                 decltype(glDisable)>::value);
+
+void mockUseProgram(GLuint program) {
+  RecordGLCall("glUseProgram");
+}
+
+static_assert(CheckSameSignature<decltype(mockUseProgram),  //
+                                 decltype(glUseProgram)>::value);
+
+void mockActiveTexture(GLenum texture) {
+  RecordGLCall("glActiveTexture");
+}
+
+static_assert(CheckSameSignature<decltype(mockActiveTexture),  //
+                                 decltype(glActiveTexture)>::value);
+
+void mockBindTexture(GLenum target, GLuint texture) {
+  RecordGLCall("glBindTexture");
+}
+
+static_assert(CheckSameSignature<decltype(mockBindTexture),  //
+                                 decltype(glBindTexture)>::value);
+
+void mockStencilMaskSeparate(GLenum face, GLuint mask) {
+  RecordGLCall("glStencilMaskSeparate");
+}
+
+static_assert(CheckSameSignature<decltype(mockStencilMaskSeparate),  //
+                                 decltype(glStencilMaskSeparate)>::value);
+
+void mockViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+  RecordGLCall("glViewport");
+}
+
+static_assert(CheckSameSignature<decltype(mockViewport),  //
+                                 decltype(glViewport)>::value);
+
+GLuint mockCreateProgram() {
+  RecordGLCall("glCreateProgram");
+  return 1u;
+}
+
+static_assert(CheckSameSignature<decltype(mockCreateProgram),  //
+                                 decltype(glCreateProgram)>::value);
+
+GLboolean mockIsProgram(GLuint program) {
+  return program != 0u ? GL_TRUE : GL_FALSE;
+}
+
+static_assert(CheckSameSignature<decltype(mockIsProgram),  //
+                                 decltype(glIsProgram)>::value);
+
+void mockLinkProgram(GLuint program) {
+  RecordGLCall("glLinkProgram");
+}
+
+static_assert(CheckSameSignature<decltype(mockLinkProgram),  //
+                                 decltype(glLinkProgram)>::value);
+
+void mockGetProgramiv(GLuint program, GLenum pname, GLint* params) {
+  switch (pname) {
+    case GL_LINK_STATUS:
+      RecordGLCall("glGetProgramiv(GL_LINK_STATUS)");
+      *params = GL_TRUE;
+      break;
+    case GL_COMPLETION_STATUS_KHR:
+      RecordGLCall("glGetProgramiv(GL_COMPLETION_STATUS_KHR)");
+      *params = GL_TRUE;
+      break;
+    case GL_ACTIVE_UNIFORM_BLOCKS:
+      *params = GetActiveUniformBlocks().size();
+      break;
+    case GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH: {
+      size_t max_length = 0u;
+      for (const auto& name : GetActiveUniformBlocks()) {
+        max_length = std::max(max_length, name.size() + 1u);
+      }
+      *params = max_length;
+    } break;
+    default:
+      *params = 0;
+      break;
+  }
+}
+
+static_assert(CheckSameSignature<decltype(mockGetProgramiv),  //
+                                 decltype(glGetProgramiv)>::value);
+
+GLuint mockCreateShader(GLenum type) {
+  RecordGLCall("glCreateShader");
+  static GLuint next_shader = 1u;
+  return next_shader++;
+}
+
+static_assert(CheckSameSignature<decltype(mockCreateShader),  //
+                                 decltype(glCreateShader)>::value);
+
+void mockGetShaderiv(GLuint shader, GLenum pname, GLint* params) {
+  switch (pname) {
+    case GL_COMPILE_STATUS:
+      *params = GL_TRUE;
+      break;
+    default:
+      *params = 0;
+      break;
+  }
+}
+
+static_assert(CheckSameSignature<decltype(mockGetShaderiv),  //
+                                 decltype(glGetShaderiv)>::value);
+
+void mockDeleteShader(GLuint shader) {
+  RecordGLCall("glDeleteShader");
+}
+
+static_assert(CheckSameSignature<decltype(mockDeleteShader),  //
+                                 decltype(glDeleteShader)>::value);
+
+void mockGetActiveUniformBlockName(GLuint program,
+                                   GLuint index,
+                                   GLsizei buffer_size,
+                                   GLsizei* length,
+                                   GLchar* name) {
+  const auto names = GetActiveUniformBlocks();
+  if (index >= names.size() || buffer_size <= 0) {
+    *length = 0;
+    return;
+  }
+  const auto& block_name = names[index];
+  *length = std::min<GLsizei>(block_name.size(), buffer_size - 1);
+  std::memcpy(name, block_name.data(), *length);
+  name[*length] = '\0';
+}
+
+static_assert(CheckSameSignature<decltype(mockGetActiveUniformBlockName),  //
+                                 decltype(glGetActiveUniformBlockName)>::value);
+
+void mockUniformBlockBinding(GLuint program,
+                             GLuint block_index,
+                             GLuint block_binding) {
+  RecordGLCall("glUniformBlockBinding");
+}
+
+static_assert(CheckSameSignature<decltype(mockUniformBlockBinding),  //
+                                 decltype(glUniformBlockBinding)>::value);
+
+void mockBindBufferRange(GLenum target,
+                         GLuint index,
+                         GLuint buffer,
+                         GLintptr offset,
+                         GLsizeiptr size) {
+  RecordGLCall("glBindBufferRange");
+}
+
+static_assert(CheckSameSignature<decltype(mockBindBufferRange),  //
+                                 decltype(glBindBufferRange)>::value);
+
+void mockUniform4fv(GLint location, GLsizei count, const GLfloat* value) {
+  RecordGLCall("glUniform4fv");
+}
+
+static_assert(CheckSameSignature<decltype(mockUniform4fv),  //
+                                 decltype(glUniform4fv)>::value);
+
+void mockUniformMatrix4fv(GLint location,
+                          GLsizei count,
+                          GLboolean transpose,
+                          const GLfloat* value) {
+  RecordGLCall("glUniformMatrix4fv");
+}
+
+static_assert(CheckSameSignature<decltype(mockUniformMatrix4fv),  //
+                                 decltype(glUniformMatrix4fv)>::value);
+
 std::shared_ptr<MockGLES> MockGLES::Init(
     const std::optional<std::vector<const unsigned char*>>& extensions,
     const char* version_string,
@@ -202,6 +401,44 @@ const ProcTableGLES::Resolver kMockResolverGLES = [](const char* name) {
     return reinterpret_cast<void*>(mockGetQueryObjectui64vEXT);
   } else if (strcmp(name, "glGetQueryObjectuivEXT") == 0) {
     return reinterpret_cast<void*>(mockGetQueryObjectuivEXT);
+  } else if (strcmp(name, "glEnable") == 0) {
+    return reinterpret_cast<void*>(&mockEnable);
+  } else if (strcmp(name, "glDisable") == 0) {
+    return reinterpret_cast<void*>(&mockDisable);
+  } else if (strcmp(name, "glUseProgram") == 0) {
+    return reinterpret_cast<void*>(&mockUseProgram);
+  } else if (strcmp(name, "glActiveTexture") == 0) {
+    return reinterpret_cast<void*>(&mockActiveTexture);
+  } else if (strcmp(name, "glBindTexture") == 0) {
+    return reinterpret_cast<void*>(&mockBindTexture);
+  } else if (strcmp(name, "glStencilMaskSeparate") == 0) {
+    return reinterpret_cast<void*>(&mockStencilMaskSeparate);
+  } else if (strcmp(name, "glViewport") == 0) {
+    return reinterpret_cast<void*>(&mockViewport);
+  } else if (strcmp(name, "glCreateProgram") == 0) {
+    return reinterpret_cast<void*>(&mockCreateProgram);
+  } else if (strcmp(name, "glIsProgram") == 0) {
+    return reinterpret_cast<void*>(&mockIsProgram);
+  } else if (strcmp(name, "glLinkProgram") == 0) {
+    return reinterpret_cast<void*>(&mockLinkProgram);
+  } else if (strcmp(name, "glGetProgramiv") == 0) {
+    return reinterpret_cast<void*>(&mockGetProgramiv);
+  } else if (strcmp(name, "glCreateShader") == 0) {
+    return reinterpret_cast<void*>(&mockCreateShader);
+  } else if (strcmp(name, "glGetShaderiv") == 0) {
+    return reinterpret_cast<void*>(&mockGetShaderiv);
+  } else if (strcmp(name, "glDeleteShader") == 0) {
+    return reinterpret_cast<void*>(&mockDeleteShader);
+  } else if (strcmp(name, "glGetActiveUniformBlockName") == 0) {
+    return reinterpret_cast<void*>(&mockGetActiveUniformBlockName);
+  } else if (strcmp(name, "glUniformBlockBinding") == 0) {
+    return reinterpret_cast<void*>(&mockUniformBlockBinding);
+  } else if (strcmp(name, "glBindBufferRange") == 0) {
+    return reinterpret_cast<void*>(&mockBindBufferRange);
+  } else if (strcmp(name, "glUniform4fv") == 0) {
+    return reinterpret_cast<void*>(&mockUniform4fv);
+  } else if (strcmp(name, "glUniformMatrix4fv") == 0) {
+    return reinterpret_cast<void*>(&mockUniformMatrix4fv);
   } else {
     return reinterpret_cast<void*>(&doNothing);
   }
@@ -7,6 +7,8 @@
 
 #include <memory>
 #include <optional>
+#include <string>
+#include <vector>
 
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
 
@@ -39,6 +41,12 @@ class MockGLES final {
   /// @brief      Returns a configured |ProcTableGLES| instance.
   const ProcTableGLES& GetProcTable() const { return proc_table_; }
 
+  /// @brief      Sets the names of the active uniform blocks reported for all
+  ///             programs.
+  void SetActiveUniformBlocks(std::vector<std::string> names) {
+    active_uniform_blocks_ = std::move(names);
+  }
+
   /// @brief      Returns a vector of the names of all recorded calls.
   ///
   /// Calls are cleared after this method is called.
@@ -52,6 +60,7 @@ class MockGLES final {
 
  private:
   friend void RecordGLCall(const char* name);
+  friend std::vector<std::string> GetActiveUniformBlocks();
 
   explicit MockGLES(ProcTableGLES::Resolver resolver = kMockResolverGLES);
 
@@ -59,6 +68,7 @@ class MockGLES final {
 
   ProcTableGLES proc_table_;
   std::vector<std::string> captured_calls_;
+  std::vector<std::string> active_uniform_blocks_;
 
   MockGLES(const MockGLES&) = delete;
 
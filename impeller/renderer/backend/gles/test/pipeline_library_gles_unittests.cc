@@ -0,0 +1,164 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/gles/context_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+#include "impeller/renderer/pipeline_descriptor.h"
+#include "impeller/renderer/vertex_descriptor.h"
+#include "impeller/shader_archive/shader_archive_writer.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+class TestWorker : public ReactorGLES::Worker {
+ public:
+  // |ReactorGLES::Worker|
+  bool CanReactorReactOnCurrentThreadNow(
+      const ReactorGLES& reactor) const override {
+    return true;
+  }
+};
+
+size_t CountCalls(const std::vector<std::string>& calls,
+                  const std::string& name) {
+  return std::count(calls.begin(), calls.end(), name);
+}
+
+std::shared_ptr<fml::Mapping> CreateMappingFromString(std::string p_string) {
+  auto string = std::make_shared<std::string>(std::move(p_string));
+  return std::make_shared<fml::NonOwnedMapping>(
+      reinterpret_cast<const uint8_t*>(string->data()), string->size(),
+      [string](auto, auto) {});
+}
+
+std::shared_ptr<ContextGLES> CreateContext() {
+  ShaderArchiveWriter writer;
+  FML_CHECK(writer.AddShader(ArchiveShaderType::kVertex, "test",
+                             CreateMappingFromString("void main() {}")));
+  FML_CHECK(writer.AddShader(ArchiveShaderType::kFragment, "test",
+                             CreateMappingFromString("void main() {}")));
+  return ContextGLES::Create(std::make_unique<ProcTableGLES>(kMockResolverGLES),
+                             {writer.CreateMapping()},
+                             /*enable_gpu_tracing=*/false);
+}
+
+PipelineDescriptor CreatePipelineDescriptor(const ContextGLES& context,
+                                            std::string label) {
+  auto library = context.GetShaderLibrary();
+  PipelineDescriptor descriptor;
+  descriptor.SetLabel(std::move(label));
+  descriptor.AddStageEntrypoint(
+      library->GetFunction("test_vertex_main", ShaderStage::kVertex));
+  descriptor.AddStageEntrypoint(
+      library->GetFunction("test_fragment_main", ShaderStage::kFragment));
+  descriptor.SetVertexDescriptor(std::make_shared<VertexDescriptor>());
+  return descriptor;
+}
+
+}  // namespace
+
+TEST(PipelineLibraryGLESTest, DefersLinkStatusCheckTillPipelineIsWaitedOn) {
+  auto mock_gles = MockGLES::Init();
+  auto context = CreateContext();
+  ASSERT_TRUE(context && context->IsValid());
+  auto worker = std::make_shared<TestWorker>();
+  ASSERT_TRUE(context->AddReactorWorker(worker).has_value());
+  mock_gles->GetCapturedCalls();
+
+  auto future = context->GetPipelineLibrary()->GetPipeline(
+      CreatePipelineDescriptor(*context, "A"));
+
+  auto calls = mock_gles->GetCapturedCalls();
+  EXPECT_EQ(CountCalls(calls, "glLinkProgram"), 1u);
+  EXPECT_EQ(CountCalls(calls, "glGetProgramiv(GL_LINK_STATUS)"), 0u);
+  EXPECT_EQ(CountCalls(calls, "glDeleteShader"), 0u);
+
+  EXPECT_NE(future.Get(), nullptr);
+
+  calls = mock_gles->GetCapturedCalls();
+  EXPECT_EQ(CountCalls(calls, "glGetProgramiv(GL_LINK_STATUS)"), 1u);
+  EXPECT_EQ(CountCalls(calls, "glDeleteShader"), 2u);
+}
+
+TEST(PipelineLibraryGLESTest, PollsPendingLinksWhenMorePipelinesAreRequested) {
+  auto const extensions = std::vector<const unsigned char*>{
+      reinterpret_cast<const unsigned char*>("GL_KHR_debug"),  //
+      reinterpret_cast<const unsigned char*>(
+          "GL_KHR_parallel_shader_compile"),  //
+  };
+  auto mock_gles = MockGLES::Init(extensions);
+  auto context = CreateContext();
+  ASSERT_TRUE(context && context->IsValid());
+  ASSERT_TRUE(context->GetReactor()
+                  ->GetProcTable()
+                  .GetCapabilities()
+                  ->SupportsParallelShaderCompile());
+  auto worker = std::make_shared<TestWorker>();
+  ASSERT_TRUE(context->AddReactorWorker(worker).has_value());
+  mock_gles->GetCapturedCalls();
+
+  auto library = context->GetPipelineLibrary();
+  auto future_a = library->GetPipeline(CreatePipelineDescriptor(*context, "A"));
+  auto calls = mock_gles->GetCapturedCalls();
+  EXPECT_EQ(CountCalls(calls, "glGetProgramiv(GL_COMPLETION_STATUS_KHR)"), 0u);
+  EXPECT_EQ(CountCalls(calls, "glGetProgramiv(GL_LINK_STATUS)"), 0u);
+
+  // The mock reports all links as complete, so requesting another pipeline
+  // finishes the first one.
+  auto future_b = library->GetPipeline(CreatePipelineDescriptor(*context, "B"));
+  calls = mock_gles->GetCapturedCalls();
+  EXPECT_EQ(CountCalls(calls, "glGetProgramiv(GL_COMPLETION_STATUS_KHR)"), 1u);
+  EXPECT_EQ(CountCalls(calls, "glGetProgramiv(GL_LINK_STATUS)"), 1u);
+  EXPECT_EQ(CountCalls(calls, "glDeleteShader"), 2u);
+
+  // Waiting on a finished pipeline does not check its status again.
+  EXPECT_NE(future_a.Get(), nullptr);
+  calls = mock_gles->GetCapturedCalls();
+  EXPECT_EQ(CountCalls(calls, "glGetProgramiv(GL_LINK_STATUS)"), 0u);
+  EXPECT_EQ(CountCalls(calls, "glDeleteShader"), 0u);
+}
+
+TEST(PipelineLibraryGLESTest, ReleasesShadersOfPipelinesNeverWaitedOn) {
+  auto mock_gles = MockGLES::Init();
+  auto context = CreateContext();
+  ASSERT_TRUE(context && context->IsValid());
+  auto worker = std::make_shared<TestWorker>();
+  ASSERT_TRUE(context->AddReactorWorker(worker).has_value());
+  mock_gles->GetCapturedCalls();
+
+  // Without GL_KHR_parallel_shader_compile, requesting more pipelines does
+  // not block on the links that are still pending.
+  auto library = context->GetPipelineLibrary();
+  auto future_a = library->GetPipeline(CreatePipelineDescriptor(*context, "A"));
+  auto future_b = library->GetPipeline(CreatePipelineDescriptor(*context, "B"));
+  auto calls = mock_gles->GetCapturedCalls();
+  EXPECT_EQ(CountCalls(calls, "glLinkProgram"), 2u);
+  EXPECT_EQ(CountCalls(calls, "glGetProgramiv(GL_LINK_STATUS)"), 0u);
+  EXPECT_EQ(CountCalls(calls, "glDeleteShader"), 0u);
+
+  // They are finished at the end of the frame instead.
+  context->FinishPendingPipelines();
+  calls = mock_gles->GetCapturedCalls();
+  EXPECT_EQ(CountCalls(calls, "glGetProgramiv(GL_LINK_STATUS)"), 2u);
+  EXPECT_EQ(CountCalls(calls, "glDeleteShader"), 4u);
+
+  // The links still pending are finished when the library is collected.
+  auto future_c = library->GetPipeline(CreatePipelineDescriptor(*context, "C"));
+  mock_gles->GetCapturedCalls();
+  library.reset();
+  context.reset();
+  calls = mock_gles->GetCapturedCalls();
+  EXPECT_EQ(CountCalls(calls, "glGetProgramiv(GL_LINK_STATUS)"), 1u);
+  EXPECT_EQ(CountCalls(calls, "glDeleteShader"), 2u);
+}
+
+}  // namespace testing
+}  // namespace impeller
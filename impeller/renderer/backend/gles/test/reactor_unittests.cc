@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/gles/reactor_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+#include "impeller/renderer/backend/gles/texture_gles.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+class TestWorker : public ReactorGLES::Worker {
+ public:
+  // |ReactorGLES::Worker|
+  bool CanReactorReactOnCurrentThreadNow(
+      const ReactorGLES& reactor) const override {
+    return true;
+  }
+};
+
+size_t CountCalls(const std::vector<std::string>& calls,
+                  const std::string& name) {
+  return std::count(calls.begin(), calls.end(), name);
+}
+
+}  // namespace
+
+TEST(ReactorGLESTest, KnowsWhetherItIsReactingOnCurrentThread) {
+  auto mock_gles = MockGLES::Init();
+  auto reactor = std::make_shared<ReactorGLES>(
+      std::make_unique<ProcTableGLES>(kMockResolverGLES));
+  auto worker = std::make_shared<TestWorker>();
+  reactor->AddWorker(worker);
+
+  EXPECT_FALSE(reactor->IsReactingOnCurrentThread());
+  bool was_reacting = false;
+  EXPECT_TRUE(reactor->AddOperation([&](const ReactorGLES& reactor_gles) {
+    was_reacting = reactor_gles.IsReactingOnCurrentThread();
+  }));
+  EXPECT_TRUE(was_reacting);
+  EXPECT_FALSE(reactor->IsReactingOnCurrentThread());
+}
+
+TEST(ReactorGLESTest, DoesNotCarryShadowedStateAcrossOperations) {
+  auto mock_gles = MockGLES::Init();
+  auto reactor = std::make_shared<ReactorGLES>(
+      std::make_unique<ProcTableGLES>(kMockResolverGLES));
+  auto worker = std::make_shared<TestWorker>();
+  reactor->AddWorker(worker);
+
+  for (size_t i = 0; i < 2; i++) {
+    EXPECT_TRUE(reactor->AddOperation([](const ReactorGLES& reactor_gles) {
+      reactor_gles.GetStateTracker().UseProgram(1u);
+    }));
+  }
+
+  EXPECT_EQ(CountCalls(mock_gles->GetCapturedCalls(), "glUseProgram"), 2u);
+}
+
+TEST(ReactorGLESTest, TextureBindOutsideOfReactionBypassesStateTracker) {
+  auto mock_gles = MockGLES::Init();
+  auto reactor = std::make_shared<ReactorGLES>(
+      std::make_unique<ProcTableGLES>(kMockResolverGLES));
+  auto worker = std::make_shared<TestWorker>();
+  reactor->AddWorker(worker);
+
+  TextureDescriptor desc;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {10, 10};
+  auto texture = std::make_shared<TextureGLES>(reactor, desc);
+  // Create the GL handle of the texture and bind it within a reaction, which
+  // leaves it bound in the shadowed state.
+  EXPECT_TRUE(reactor->AddOperation([&](const ReactorGLES&) {
+    EXPECT_TRUE(texture->Bind());
+  }));
+  mock_gles->GetCapturedCalls();
+
+  // External textures are bound outside of reactions, e.g. on the raster
+  // thread, and rely on the binding actually being made.
+  EXPECT_TRUE(texture->Bind());
+  EXPECT_TRUE(texture->Bind());
+
+  EXPECT_EQ(CountCalls(mock_gles->GetCapturedCalls(), "glBindTexture"), 2u);
+}
+
+}  // namespace testing
+}  // namespace impeller
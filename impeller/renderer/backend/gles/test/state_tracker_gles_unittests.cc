@@ -0,0 +1,95 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(StateTrackerGLESTest, SkipsCallsThatDoNotChangeState) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  state.SetEnabled(GL_BLEND, true);
+  state.SetEnabled(GL_BLEND, true);
+  state.UseProgram(1u);
+  state.UseProgram(1u);
+  state.Viewport(0, 0, 100, 100);
+  state.Viewport(0, 0, 100, 100);
+  state.SetEnabled(GL_BLEND, false);
+  state.UseProgram(2u);
+  state.Viewport(0, 0, 50, 50);
+
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>({"glEnable", "glUseProgram", "glViewport",
+                                      "glDisable", "glUseProgram",
+                                      "glViewport"}));
+  EXPECT_EQ(state.GetIssuedCallCount(), 6u);
+  EXPECT_EQ(state.GetElidedCallCount(), 3u);
+}
+
+TEST(StateTrackerGLESTest, InvalidateForgetsShadowedState) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  state.UseProgram(1u);
+  state.SetEnabled(GL_SCISSOR_TEST, false);
+  state.Invalidate();
+  state.UseProgram(1u);
+  state.SetEnabled(GL_SCISSOR_TEST, false);
+
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>({"glUseProgram", "glDisable",
+                                      "glUseProgram", "glDisable"}));
+  EXPECT_EQ(state.GetElidedCallCount(), 0u);
+}
+
+TEST(StateTrackerGLESTest, ShadowsTextureBindingsPerUnit) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  state.ActiveTexture(GL_TEXTURE0);
+  state.BindTexture(GL_TEXTURE_2D, 1u);
+  state.ActiveTexture(GL_TEXTURE1);
+  state.BindTexture(GL_TEXTURE_2D, 1u);
+  state.ActiveTexture(GL_TEXTURE0);
+  state.BindTexture(GL_TEXTURE_2D, 1u);
+
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>({"glActiveTexture", "glBindTexture",
+                                      "glActiveTexture", "glBindTexture",
+                                      "glActiveTexture"}));
+}
+
+TEST(StateTrackerGLESTest, DoesNotShadowTextureBindingsOfUnknownUnit) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  state.BindTexture(GL_TEXTURE_2D, 1u);
+  state.BindTexture(GL_TEXTURE_2D, 1u);
+
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>({"glBindTexture", "glBindTexture"}));
+}
+
+TEST(StateTrackerGLESTest, ShadowsStencilStatePerFace) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  state.StencilMaskSeparate(GL_FRONT, 0xFF);
+  // The back face is still unknown.
+  state.StencilMaskSeparate(GL_FRONT_AND_BACK, 0xFF);
+  state.StencilMaskSeparate(GL_BACK, 0xFF);
+  state.StencilMaskSeparate(GL_FRONT_AND_BACK, 0xFF);
+
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>(
+                {"glStencilMaskSeparate", "glStencilMaskSeparate"}));
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -282,7 +282,7 @@ bool TextureGLES::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
       return;
     }
     const auto& gl = reactor.GetProcTable();
-    gl.BindTexture(texture_type, gl_handle.value());
+    reactor.GetStateTracker().BindTexture(texture_type, gl_handle.value());
     const GLvoid* tex_data = nullptr;
     if (data->data) {
       tex_data = data->data->GetMapping();
@@ -343,6 +343,19 @@ static std::optional<GLenum> ToRenderBufferFormat(PixelFormat format) {
   FML_UNREACHABLE();
 }
 
+// Binds through the state tracker within reactions. Outside of them, such as
+// when an external texture is bound on the raster thread, the tracker may
+// neither be used nor trusted to know the current binding.
+static void BindTexture(const ReactorGLES& reactor,
+                        GLenum target,
+                        GLuint texture) {
+  if (reactor.IsReactingOnCurrentThread()) {
+    reactor.GetStateTracker().BindTexture(target, texture);
+  } else {
+    reactor.GetProcTable().BindTexture(target, texture);
+  }
+}
+
 void TextureGLES::InitializeContentsIfNecessary() const {
   if (!IsValid() || slices_initialized_[0]) {
     return;
@@ -374,7 +387,7 @@ void TextureGLES::InitializeContentsIfNecessary() const {
         VALIDATION_LOG << "Invalid format for texture image.";
         return;
       }
-      gl.BindTexture(GL_TEXTURE_2D, handle.value());
+      BindTexture(*reactor_, GL_TEXTURE_2D, handle.value());
       {
         TRACE_EVENT0("impeller", "TexImage2DInitialization");
         gl.TexImage2D(GL_TEXTURE_2D,  // target
@@ -442,7 +455,7 @@ bool TextureGLES::Bind() const {
         VALIDATION_LOG << "Could not bind texture of this type.";
         return false;
       }
-      gl.BindTexture(target.value(), handle.value());
+      BindTexture(*reactor_, target.value(), handle.value());
     } break;
     case Type::kRenderBuffer:
     case Type::kRenderBufferMultisampled:
@@ -52,7 +52,12 @@ static VmaAllocationCreateFlags ToVmaAllocationBufferCreateFlags(
   FML_UNREACHABLE();
 }
 
-static PoolVMA CreateBufferPool(VmaAllocator allocator) {
+// The size of the blocks of the pool of small buffers. Small enough to not
+// waste much memory on devices that only draw a few small buffers per frame.
+static constexpr VkDeviceSize kSmallBufferPoolBlockSize = 4u * 1024u * 1024u;
+
+static PoolVMA CreateBufferPool(VmaAllocator allocator,
+                                VkDeviceSize block_size = 0u) {
   vk::BufferCreateInfo buffer_info;
   buffer_info.usage = vk::BufferUsageFlagBits::eVertexBuffer |
                       vk::BufferUsageFlagBits::eIndexBuffer |
@@ -82,6 +87,7 @@ static PoolVMA CreateBufferPool(VmaAllocator allocator) {
   VmaPoolCreateInfo pool_create_info = {};
   pool_create_info.memoryTypeIndex = memTypeIndex;
   pool_create_info.flags = VMA_POOL_CREATE_IGNORE_BUFFER_IMAGE_GRANULARITY_BIT;
+  pool_create_info.blockSize = block_size;
 
   VmaPool pool = {};
   result = vk::Result{::vmaCreatePool(allocator, &pool_create_info, &pool)};
@@ -143,6 +149,9 @@ AllocatorVK::AllocatorVK(std::weak_ptr<Context> context,
   allocator_info.device = device_holder->GetDevice();
   allocator_info.instance = instance;
   allocator_info.pVulkanFunctions = &proc_table;
+  if (capabilities.HasExtension(OptionalDeviceExtensionVK::kEXTMemoryBudget)) {
+    allocator_info.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+  }
 
   VmaAllocator allocator = {};
   auto result = vk::Result{::vmaCreateAllocator(&allocator_info, &allocator)};
@@ -151,7 +160,10 @@ AllocatorVK::AllocatorVK(std::weak_ptr<Context> context,
     return;
   }
   staging_buffer_pool_.reset(CreateBufferPool(allocator));
-  created_buffer_pool_ &= staging_buffer_pool_.is_valid();
+  small_buffer_pool_.reset(
+      CreateBufferPool(allocator, kSmallBufferPoolBlockSize));
+  created_buffer_pool_ &=
+      staging_buffer_pool_.is_valid() && small_buffer_pool_.is_valid();
   allocator_.reset(allocator);
   supports_memoryless_textures_ =
       capabilities.SupportsDeviceTransientTextures();
@@ -451,6 +463,7 @@ std::shared_ptr<Texture> AllocatorVK::OnCreateTexture(
       supports_memoryless_textures_                    //
   );
   if (!source->IsValid()) {
+    NotifyMemoryPressure();
     return nullptr;
   }
   return std::make_shared<TextureVK>(context_, std::move(source));
@@ -459,6 +472,11 @@ std::shared_ptr<Texture> AllocatorVK::OnCreateTexture(
 // |Allocator|
 std::shared_ptr<DeviceBuffer> AllocatorVK::OnCreateBuffer(
     const DeviceBufferDescriptor& desc) {
+  const bool is_pooled = created_buffer_pool_ &&
+                         desc.storage_mode == StorageMode::kHostVisible &&
+                         !desc.readback;
+  const bool is_small = is_pooled && desc.size <= kSmallBufferMaxSize;
+
   vk::BufferCreateInfo buffer_info;
   buffer_info.usage = vk::BufferUsageFlagBits::eVertexBuffer |
                       vk::BufferUsageFlagBits::eIndexBuffer |
@@ -466,7 +484,7 @@ std::shared_ptr<DeviceBuffer> AllocatorVK::OnCreateBuffer(
                       vk::BufferUsageFlagBits::eStorageBuffer |
                       vk::BufferUsageFlagBits::eTransferSrc |
                       vk::BufferUsageFlagBits::eTransferDst;
-  buffer_info.size = desc.size;
+  buffer_info.size = is_small ? ToSmallBufferSizeClass(desc.size) : desc.size;
   buffer_info.sharingMode = vk::SharingMode::eExclusive;
   auto buffer_info_native =
       static_cast<vk::BufferCreateInfo::NativeType>(buffer_info);
@@ -477,8 +495,9 @@ std::shared_ptr<DeviceBuffer> AllocatorVK::OnCreateBuffer(
       ToVKBufferMemoryPropertyFlags(desc.storage_mode));
   allocation_info.flags =
       ToVmaAllocationBufferCreateFlags(desc.storage_mode, desc.readback);
-  if (created_buffer_pool_ && desc.storage_mode == StorageMode::kHostVisible &&
-      !desc.readback) {
+  if (is_small) {
+    allocation_info.pool = small_buffer_pool_.get().pool;
+  } else if (is_pooled) {
     allocation_info.pool = staging_buffer_pool_.get().pool;
   }
 
@@ -496,6 +515,7 @@ std::shared_ptr<DeviceBuffer> AllocatorVK::OnCreateBuffer(
   if (result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Unable to allocate a device buffer: "
                    << vk::to_string(result);
+    NotifyMemoryPressure();
     return {};
   }
 
@@ -509,13 +529,70 @@ std::shared_ptr<DeviceBuffer> AllocatorVK::OnCreateBuffer(
   );
 }
 
-size_t AllocatorVK::DebugGetHeapUsage() const {
-  auto count = memory_properties_.memoryHeapCount;
-  std::vector<VmaBudget> budgets(count);
+size_t AllocatorVK::ToSmallBufferSizeClass(size_t size) {
+  FML_DCHECK(size <= kSmallBufferMaxSize);
+  size_t size_class = kSmallBufferMinSizeClass;
+  while (size_class < size) {
+    size_class <<= 1u;
+  }
+  return size_class;
+}
+
+std::vector<VmaBudget> AllocatorVK::GetHeapBudgets() const {
+  std::vector<VmaBudget> budgets(memory_properties_.memoryHeapCount);
   vmaGetHeapBudgets(allocator_.get(), budgets.data());
+  return budgets;
+}
+
+bool AllocatorVK::IsNearMemoryBudget() const {
+  if (!IsValid()) {
+    return false;
+  }
+  for (const auto& budget : GetHeapBudgets()) {
+    if (budget.budget > 0u &&
+        budget.usage > budget.budget * kMemoryPressureThreshold) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void AllocatorVK::DidAcquireSurfaceFrame() {
+  if (!IsValid()) {
+    return;
+  }
+  // With VK_EXT_memory_budget, VMA queries the budget from the driver when
+  // the frame index changes.
+  vmaSetCurrentFrameIndex(allocator_.get(), ++frame_index_);
+  if (ShouldNotifyMemoryPressure(IsNearMemoryBudget(), frame_index_,
+                                 pressure_frame_index_)) {
+    TRACE_EVENT0("impeller", "AllocatorVK::MemoryPressure");
+    NotifyMemoryPressure();
+  }
+}
+
+bool AllocatorVK::ShouldNotifyMemoryPressure(
+    bool is_near_budget,
+    uint32_t frame_index,
+    std::optional<uint32_t>& pressure_frame_index) {
+  if (!is_near_budget) {
+    pressure_frame_index.reset();
+    return false;
+  }
+  // Caches trimmed on the previous notification need some frames to settle.
+  // Notifying every frame would keep them from retaining any working set.
+  if (pressure_frame_index.has_value() &&
+      frame_index - pressure_frame_index.value() <
+          kMemoryPressureRenotifyFrameCount) {
+    return false;
+  }
+  pressure_frame_index = frame_index;
+  return true;
+}
+
+size_t AllocatorVK::DebugGetHeapUsage() const {
   size_t total_usage = 0;
-  for (auto i = 0u; i < count; i++) {
-    const VmaBudget& budget = budgets[i];
+  for (const auto& budget : GetHeapBudgets()) {
     total_usage += budget.usage;
   }
   // Convert bytes to MB.
@@ -525,9 +602,14 @@ size_t AllocatorVK::DebugGetHeapUsage() const {
 
 void AllocatorVK::DebugTraceMemoryStatistics() const {
 #ifdef IMPELLER_DEBUG
+  size_t total_budget = 0;
+  for (const auto& budget : GetHeapBudgets()) {
+    total_budget += budget.budget;
+  }
   FML_TRACE_COUNTER("flutter", "AllocatorVK",
                     reinterpret_cast<int64_t>(this),  // Trace Counter ID
-                    "MemoryBudgetUsageMB", DebugGetHeapUsage());
+                    "MemoryBudgetUsageMB", DebugGetHeapUsage(),
+                    "MemoryBudgetMB", total_budget / (1024 * 1024));
 #endif  // IMPELLER_DEBUG
 }
 
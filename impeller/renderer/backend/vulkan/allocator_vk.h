@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_ALLOCATOR_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_ALLOCATOR_VK_H_
 
+#include "impeller/base/backend_cast.h"
 #include "impeller/core/allocator.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
@@ -13,17 +14,81 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace impeller {
 
-class AllocatorVK final : public Allocator {
+class AllocatorVK final : public Allocator,
+                          public BackendCast<AllocatorVK, Allocator> {
  public:
+  //----------------------------------------------------------------------------
+  /// The fraction of the budget of a memory heap above which the memory
+  /// pressure callbacks are invoked.
+  ///
+  static constexpr float kMemoryPressureThreshold = 0.9f;
+
+  //----------------------------------------------------------------------------
+  /// The number of frames after which the memory pressure callbacks are
+  /// invoked again while the allocator stays near its budget.
+  ///
+  static constexpr uint32_t kMemoryPressureRenotifyFrameCount = 60u;
+
+  //----------------------------------------------------------------------------
+  /// Host visible buffers up to this size are rounded up to a power of two
+  /// size class and allocated from a pool of their own. Freed ranges of the
+  /// pool then fit later buffers of the same class exactly, which keeps the
+  /// many small per-frame buffers from fragmenting the larger blocks.
+  ///
+  static constexpr size_t kSmallBufferMaxSize = 64u * 1024u;
+
+  static constexpr size_t kSmallBufferMinSizeClass = 256u;
+
   // |Allocator|
   ~AllocatorVK() override;
 
   // |Allocator|
   size_t DebugGetHeapUsage() const override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the usage of any memory heap exceeds
+  ///             `kMemoryPressureThreshold` of its budget.
+  ///
+  ///             The budget is reported by the driver if `VK_EXT_memory_budget`
+  ///             is available and estimated from the size of the heaps
+  ///             otherwise.
+  ///
+  bool IsNearMemoryBudget() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Refreshes the memory budget and invokes the memory pressure
+  ///             callbacks when the allocator gets near it. Called once per
+  ///             frame.
+  ///
+  void DidAcquireSurfaceFrame();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether to invoke the memory pressure callbacks in the given
+  ///             frame. They are invoked when the allocator crosses the
+  ///             threshold and then every `kMemoryPressureRenotifyFrameCount`
+  ///             frames while it stays near the budget.
+  ///
+  /// @param[in]  is_near_budget         Whether the allocator is near its
+  ///                                    budget in the frame.
+  /// @param[in]  frame_index            The index of the frame.
+  /// @param      pressure_frame_index   The frame the callbacks were last
+  ///                                    invoked in, if the allocator has been
+  ///                                    near its budget since. Updated for the
+  ///                                    given frame.
+  ///
+  static bool ShouldNotifyMemoryPressure(
+      bool is_near_budget,
+      uint32_t frame_index,
+      std::optional<uint32_t>& pressure_frame_index);
+
+  // Visible for testing.
+  static size_t ToSmallBufferSizeClass(size_t size);
+
   /// @brief Select a matching memory type for the given
   ///        [memory_type_bits_requirement], or -1 if none is found.
   ///
@@ -44,6 +109,9 @@ class AllocatorVK final : public Allocator {
 
   UniqueAllocatorVMA allocator_;
   UniquePoolVMA staging_buffer_pool_;
+  UniquePoolVMA small_buffer_pool_;
+  uint32_t frame_index_ = 0u;
+  std::optional<uint32_t> pressure_frame_index_;
   std::weak_ptr<Context> context_;
   std::weak_ptr<DeviceHolderVK> device_holder_;
   ISize max_texture_size_;
@@ -63,6 +131,8 @@ class AllocatorVK final : public Allocator {
   // |Allocator|
   bool IsValid() const;
 
+  std::vector<VmaBudget> GetHeapBudgets() const;
+
   // |Allocator|
   std::shared_ptr<DeviceBuffer> OnCreateBuffer(
       const DeviceBufferDescriptor& desc) override;
@@ -70,6 +70,81 @@ TEST(AllocatorVKTest, MemoryTypeSelectionTwoHeap) {
   EXPECT_EQ(AllocatorVK::FindMemoryTypeIndex(4, properties), -1);
 }
 
+TEST(AllocatorVKTest, ToSmallBufferSizeClass) {
+  EXPECT_EQ(AllocatorVK::ToSmallBufferSizeClass(1u), 256u);
+  EXPECT_EQ(AllocatorVK::ToSmallBufferSizeClass(256u), 256u);
+  EXPECT_EQ(AllocatorVK::ToSmallBufferSizeClass(257u), 512u);
+  EXPECT_EQ(AllocatorVK::ToSmallBufferSizeClass(3000u), 4096u);
+  EXPECT_EQ(
+      AllocatorVK::ToSmallBufferSizeClass(AllocatorVK::kSmallBufferMaxSize),
+      AllocatorVK::kSmallBufferMaxSize);
+}
+
+TEST(AllocatorVKTest, AllocatesSmallHostVisibleBuffers) {
+  auto const context = MockVulkanContextBuilder().Build();
+  auto allocator = context->GetResourceAllocator();
+
+  auto small_buffer = allocator->CreateBuffer(DeviceBufferDescriptor{
+      .storage_mode = StorageMode::kHostVisible,
+      .size = 100,
+  });
+  ASSERT_TRUE(small_buffer);
+  // The size of the buffer is the requested one, not that of its size class.
+  EXPECT_EQ(small_buffer->GetDeviceBufferDescriptor().size, 100u);
+
+  auto large_buffer = allocator->CreateBuffer(DeviceBufferDescriptor{
+      .storage_mode = StorageMode::kHostVisible,
+      .size = AllocatorVK::kSmallBufferMaxSize + 1,
+  });
+  EXPECT_TRUE(large_buffer);
+}
+
+TEST(AllocatorVKTest, DoesNotNotifyMemoryPressureBelowBudget) {
+  auto const context = MockVulkanContextBuilder().Build();
+  auto& allocator = AllocatorVK::Cast(*context->GetResourceAllocator());
+
+  size_t notification_count = 0u;
+  auto id = allocator.AddMemoryPressureCallback(
+      [&notification_count]() { notification_count++; });
+
+  allocator.CreateBuffer(DeviceBufferDescriptor{
+      .storage_mode = StorageMode::kDevicePrivate,
+      .size = 1024,
+  });
+  EXPECT_FALSE(allocator.IsNearMemoryBudget());
+  allocator.DidAcquireSurfaceFrame();
+  EXPECT_EQ(notification_count, 0u);
+
+  allocator.RemoveMemoryPressureCallback(id);
+}
+
+TEST(AllocatorVKTest, NotifiesMemoryPressureWhenCrossingBudget) {
+  std::optional<uint32_t> pressure_frame_index;
+
+  EXPECT_FALSE(
+      AllocatorVK::ShouldNotifyMemoryPressure(false, 1u, pressure_frame_index));
+  EXPECT_TRUE(
+      AllocatorVK::ShouldNotifyMemoryPressure(true, 2u, pressure_frame_index));
+  EXPECT_EQ(pressure_frame_index, 2u);
+
+  // Staying near the budget only notifies again after a while.
+  for (uint32_t i = 3u; i < 2u + AllocatorVK::kMemoryPressureRenotifyFrameCount;
+       i++) {
+    EXPECT_FALSE(
+        AllocatorVK::ShouldNotifyMemoryPressure(true, i, pressure_frame_index));
+  }
+  EXPECT_TRUE(AllocatorVK::ShouldNotifyMemoryPressure(
+      true, 2u + AllocatorVK::kMemoryPressureRenotifyFrameCount,
+      pressure_frame_index));
+
+  // Dropping below the budget and crossing it again notifies right away.
+  EXPECT_FALSE(AllocatorVK::ShouldNotifyMemoryPressure(false, 100u,
+                                                       pressure_frame_index));
+  EXPECT_FALSE(pressure_frame_index.has_value());
+  EXPECT_TRUE(AllocatorVK::ShouldNotifyMemoryPressure(true, 101u,
+                                                      pressure_frame_index));
+}
+
 #ifdef IMPELLER_DEBUG
 
 TEST(AllocatorVKTest, RecreateSwapchainWhenSizeChanges) {
@@ -4,4 +4,135 @@
 
 #include "impeller/renderer/backend/vulkan/barrier_vk.h"
 
-namespace impeller {}  // namespace impeller
+#include "flutter/fml/trace_event.h"
+#include "impeller/renderer/backend/vulkan/formats_vk.h"
+#include "impeller/renderer/backend/vulkan/texture_source_vk.h"
+
+namespace impeller {
+
+BarrierCountersVK::BarrierCountersVK() = default;
+
+BarrierCountersVK::~BarrierCountersVK() = default;
+
+void BarrierCountersVK::RecordPipelineBarrier(size_t image_barrier_count) {
+  pipeline_barriers_.fetch_add(1u, std::memory_order_relaxed);
+  image_barriers_.fetch_add(image_barrier_count, std::memory_order_relaxed);
+}
+
+void BarrierCountersVK::RecordElidedTransitions(size_t count) {
+  elided_transitions_.fetch_add(count, std::memory_order_relaxed);
+}
+
+size_t BarrierCountersVK::GetPipelineBarrierCount() const {
+  return pipeline_barriers_.load(std::memory_order_relaxed);
+}
+
+size_t BarrierCountersVK::GetImageBarrierCount() const {
+  return image_barriers_.load(std::memory_order_relaxed);
+}
+
+size_t BarrierCountersVK::GetElidedTransitionCount() const {
+  return elided_transitions_.load(std::memory_order_relaxed);
+}
+
+void BarrierCountersVK::TraceAndReset() {
+  [[maybe_unused]] const size_t pipeline_barriers =
+      pipeline_barriers_.exchange(0u, std::memory_order_relaxed);
+  [[maybe_unused]] const size_t image_barriers =
+      image_barriers_.exchange(0u, std::memory_order_relaxed);
+  [[maybe_unused]] const size_t elided_transitions =
+      elided_transitions_.exchange(0u, std::memory_order_relaxed);
+  FML_TRACE_COUNTER("impeller", "BarriersPerFrame",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "PipelineBarriers", pipeline_barriers, "ImageBarriers",
+                    image_barriers, "ElidedTransitions", elided_transitions);
+}
+
+BarrierBatchVK::BarrierBatchVK() = default;
+
+BarrierBatchVK::~BarrierBatchVK() = default;
+
+void BarrierBatchVK::AddTransition(const TextureSourceVK& texture,
+                                   const BarrierVK& barrier) {
+  const vk::ImageLayout old_layout =
+      texture.SetLayoutWithoutEncoding(barrier.new_layout);
+  if (old_layout == barrier.new_layout) {
+    elided_transitions_++;
+    return;
+  }
+
+  vk::PipelineStageFlags src_stage = barrier.src_stage;
+  vk::AccessFlags src_access = barrier.src_access;
+  if (old_layout == vk::ImageLayout::eUndefined &&
+      !texture.IsSwapchainImage()) {
+    src_stage = vk::PipelineStageFlagBits::eTopOfPipe;
+    src_access = {};
+  }
+  src_stage_ |= src_stage;
+  dst_stage_ |= barrier.dst_stage;
+
+  const vk::Image image = texture.GetImage();
+  // Barriers in the same call are not ordered with respect to each other. A
+  // texture transitioned twice is transitioned straight to its final layout.
+  for (auto& image_barrier : image_barriers_) {
+    if (image_barrier.image == image) {
+      image_barrier.srcAccessMask |= src_access;
+      image_barrier.dstAccessMask |= barrier.dst_access;
+      image_barrier.newLayout = barrier.new_layout;
+      elided_transitions_++;
+      return;
+    }
+  }
+
+  const TextureDescriptor& desc = texture.GetTextureDescriptor();
+  vk::ImageMemoryBarrier image_barrier;
+  image_barrier.srcAccessMask = src_access;
+  image_barrier.dstAccessMask = barrier.dst_access;
+  image_barrier.oldLayout = old_layout;
+  image_barrier.newLayout = barrier.new_layout;
+  image_barrier.image = image;
+  image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  image_barrier.subresourceRange.aspectMask = ToImageAspectFlags(desc.format);
+  image_barrier.subresourceRange.baseMipLevel = 0u;
+  image_barrier.subresourceRange.levelCount = desc.mip_count;
+  image_barrier.subresourceRange.baseArrayLayer = 0u;
+  image_barrier.subresourceRange.layerCount = ToArrayLayerCount(desc.type);
+  image_barriers_.push_back(image_barrier);
+}
+
+bool BarrierBatchVK::IsEmpty() const {
+  return image_barriers_.empty();
+}
+
+size_t BarrierBatchVK::GetImageBarrierCount() const {
+  return image_barriers_.size();
+}
+
+void BarrierBatchVK::Encode(const vk::CommandBuffer& cmd_buffer,
+                            BarrierCountersVK* counters) {
+  if (counters) {
+    counters->RecordElidedTransitions(elided_transitions_);
+  }
+  elided_transitions_ = 0u;
+  if (image_barriers_.empty()) {
+    return;
+  }
+
+  cmd_buffer.pipelineBarrier(src_stage_,       // src stage
+                             dst_stage_,       // dst stage
+                             {},               // dependency flags
+                             nullptr,          // memory barriers
+                             nullptr,          // buffer barriers
+                             image_barriers_   // image barriers
+  );
+  if (counters) {
+    counters->RecordPipelineBarrier(image_barriers_.size());
+  }
+
+  src_stage_ = {};
+  dst_stage_ = {};
+  image_barriers_.clear();
+}
+
+}  // namespace impeller
@@ -5,10 +5,15 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_BARRIER_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_BARRIER_VK_H_
 
+#include <atomic>
+#include <vector>
+
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 namespace impeller {
 
+class TextureSourceVK;
+
 //------------------------------------------------------------------------------
 /// @brief      Defines an operations and memory access barrier on a resource.
 ///
@@ -49,6 +54,91 @@ struct BarrierVK {
   vk::AccessFlags dst_access = vk::AccessFlagBits::eNone;
 };
 
+//------------------------------------------------------------------------------
+/// @brief      Counts the barriers recorded by |BarrierBatchVK|s, so they can
+///             be reported once per frame.
+///
+class BarrierCountersVK {
+ public:
+  BarrierCountersVK();
+
+  ~BarrierCountersVK();
+
+  void RecordPipelineBarrier(size_t image_barrier_count);
+
+  void RecordElidedTransitions(size_t count);
+
+  size_t GetPipelineBarrierCount() const;
+
+  size_t GetImageBarrierCount() const;
+
+  size_t GetElidedTransitionCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Emits the counts as trace counters and starts counting anew.
+  ///
+  void TraceAndReset();
+
+ private:
+  std::atomic_size_t pipeline_barriers_ = 0u;
+  std::atomic_size_t image_barriers_ = 0u;
+  std::atomic_size_t elided_transitions_ = 0u;
+
+  BarrierCountersVK(const BarrierCountersVK&) = delete;
+
+  BarrierCountersVK& operator=(const BarrierCountersVK&) = delete;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Collects the layout transitions of the textures used by the
+///             next command, so that they are recorded with a single pipeline
+///             barrier whose scopes are the union of the scopes of the
+///             transitions.
+///
+///             Transitions to the layout a texture is already in are elided.
+///             Transitions of images whose contents are undefined don't wait
+///             for any prior work, unless they are swapchain images whose
+///             acquisition is waited for in the color attachment output
+///             stage.
+///
+class BarrierBatchVK {
+ public:
+  BarrierBatchVK();
+
+  ~BarrierBatchVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Transitions the texture to the layout of the barrier. The
+  ///             command buffer of the barrier is ignored, the transition is
+  ///             recorded by |Encode|.
+  ///
+  void AddTransition(const TextureSourceVK& texture, const BarrierVK& barrier);
+
+  bool IsEmpty() const;
+
+  size_t GetImageBarrierCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the transitions added since the last call, if any,
+  ///             and clears the batch.
+  ///
+  /// @param[in]  cmd_buffer  The command buffer to record the barrier into.
+  /// @param      counters    The counters to record the barrier in, if any.
+  ///
+  void Encode(const vk::CommandBuffer& cmd_buffer,
+              BarrierCountersVK* counters = nullptr);
+
+ private:
+  vk::PipelineStageFlags src_stage_;
+  vk::PipelineStageFlags dst_stage_;
+  std::vector<vk::ImageMemoryBarrier> image_barriers_;
+  size_t elided_transitions_ = 0u;
+
+  BarrierBatchVK(const BarrierBatchVK&) = delete;
+
+  BarrierBatchVK& operator=(const BarrierBatchVK&) = delete;
+};
+
 }  // namespace impeller
 
 #endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_BARRIER_VK_H_
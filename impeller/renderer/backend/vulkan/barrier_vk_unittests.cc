@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/vulkan/barrier_vk.h"
+#include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
+#include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "impeller/renderer/backend/vulkan/texture_vk.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+std::shared_ptr<const TextureSourceVK> CreateTextureSource(
+    const ContextVK& context) {
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {100, 100};
+  desc.usage = TextureUsage::kRenderTarget | TextureUsage::kShaderRead;
+  auto texture = context.GetResourceAllocator()->CreateTexture(desc);
+  return texture ? TextureVK::Cast(*texture).GetTextureSource() : nullptr;
+}
+
+BarrierVK MakeBarrier(vk::ImageLayout layout) {
+  BarrierVK barrier;
+  barrier.new_layout = layout;
+  barrier.src_access = vk::AccessFlagBits::eColorAttachmentWrite;
+  barrier.src_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+  barrier.dst_access = vk::AccessFlagBits::eShaderRead;
+  barrier.dst_stage = vk::PipelineStageFlagBits::eFragmentShader;
+  return barrier;
+}
+
+size_t CountPipelineBarriers(const ContextVK& context) {
+  auto functions = GetMockVulkanFunctions(context.GetDevice());
+  return std::count(functions->begin(), functions->end(),
+                    "vkCmdPipelineBarrier");
+}
+
+}  // namespace
+
+TEST(BarrierVKTest, BatchesTransitionsIntoOnePipelineBarrier) {
+  auto const context = MockVulkanContextBuilder().Build();
+  auto source_a = CreateTextureSource(*context);
+  auto source_b = CreateTextureSource(*context);
+  ASSERT_TRUE(source_a && source_b);
+
+  auto buffer = context->CreateCommandBuffer();
+  const auto& encoder = CommandBufferVK::Cast(*buffer).GetEncoder();
+
+  BarrierBatchVK batch;
+  batch.AddTransition(*source_a, MakeBarrier(vk::ImageLayout::eGeneral));
+  batch.AddTransition(*source_b, MakeBarrier(vk::ImageLayout::eGeneral));
+  EXPECT_EQ(batch.GetImageBarrierCount(), 2u);
+  encoder->EncodeBarriers(batch);
+
+  EXPECT_TRUE(batch.IsEmpty());
+  EXPECT_EQ(CountPipelineBarriers(*context), 1u);
+  const auto& counters = context->GetBarrierCounters();
+  EXPECT_EQ(counters->GetPipelineBarrierCount(), 1u);
+  EXPECT_EQ(counters->GetImageBarrierCount(), 2u);
+  EXPECT_EQ(source_a->GetLayout(), vk::ImageLayout::eGeneral);
+  EXPECT_EQ(source_b->GetLayout(), vk::ImageLayout::eGeneral);
+}
+
+TEST(BarrierVKTest, ElidesTransitionsToTheCurrentLayout) {
+  auto const context = MockVulkanContextBuilder().Build();
+  auto source = CreateTextureSource(*context);
+  ASSERT_TRUE(source);
+  source->SetLayoutWithoutEncoding(vk::ImageLayout::eGeneral);
+
+  auto buffer = context->CreateCommandBuffer();
+  const auto& encoder = CommandBufferVK::Cast(*buffer).GetEncoder();
+
+  BarrierBatchVK batch;
+  batch.AddTransition(*source, MakeBarrier(vk::ImageLayout::eGeneral));
+  EXPECT_TRUE(batch.IsEmpty());
+  encoder->EncodeBarriers(batch);
+
+  EXPECT_EQ(CountPipelineBarriers(*context), 0u);
+  const auto& counters = context->GetBarrierCounters();
+  EXPECT_EQ(counters->GetPipelineBarrierCount(), 0u);
+  EXPECT_EQ(counters->GetElidedTransitionCount(), 1u);
+}
+
+TEST(BarrierVKTest, MergesRepeatedTransitionsOfATexture) {
+  auto const context = MockVulkanContextBuilder().Build();
+  auto source = CreateTextureSource(*context);
+  ASSERT_TRUE(source);
+
+  BarrierBatchVK batch;
+  batch.AddTransition(*source,
+                      MakeBarrier(vk::ImageLayout::eTransferDstOptimal));
+  batch.AddTransition(*source,
+                      MakeBarrier(vk::ImageLayout::eShaderReadOnlyOptimal));
+  EXPECT_EQ(batch.GetImageBarrierCount(), 1u);
+  EXPECT_EQ(source->GetLayout(), vk::ImageLayout::eShaderReadOnlyOptimal);
+}
+
+TEST(BarrierVKTest, CountersAreResetWhenTraced) {
+  BarrierCountersVK counters;
+  counters.RecordPipelineBarrier(3u);
+  counters.RecordElidedTransitions(2u);
+  EXPECT_EQ(counters.GetPipelineBarrierCount(), 1u);
+  EXPECT_EQ(counters.GetImageBarrierCount(), 3u);
+  EXPECT_EQ(counters.GetElidedTransitionCount(), 2u);
+
+  counters.TraceAndReset();
+  EXPECT_EQ(counters.GetPipelineBarrierCount(), 0u);
+  EXPECT_EQ(counters.GetImageBarrierCount(), 0u);
+  EXPECT_EQ(counters.GetElidedTransitionCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace impeller
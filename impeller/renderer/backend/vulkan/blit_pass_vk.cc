@@ -107,10 +107,13 @@ bool BlitPassVK::OnCopyTextureToTextureCommand(
   dst_barrier.dst_stage = vk::PipelineStageFlagBits::eFragmentShader |
                           vk::PipelineStageFlagBits::eTransfer;
 
-  if (!src.SetLayout(src_barrier) || !dst.SetLayout(dst_barrier)) {
+  BarrierBatchVK batch;
+  if (!src.SetLayout(src_barrier, batch) ||
+      !dst.SetLayout(dst_barrier, batch)) {
     VALIDATION_LOG << "Could not complete layout transitions.";
     return false;
   }
+  encoder.EncodeBarriers(batch);
 
   vk::ImageCopy image_copy;
 
@@ -149,7 +152,11 @@ bool BlitPassVK::OnCopyTextureToTextureCommand(
   barrier.dst_access = vk::AccessFlagBits::eShaderRead;
   barrier.dst_stage = vk::PipelineStageFlagBits::eFragmentShader;
 
-  return dst.SetLayout(barrier);
+  if (!dst.SetLayout(barrier, batch)) {
+    return false;
+  }
+  encoder.EncodeBarriers(batch);
+  return true;
 }
 
 // |BlitPass|
@@ -195,10 +202,12 @@ bool BlitPassVK::OnCopyTextureToBufferCommand(
   image_copy.setImageExtent(
       vk::Extent3D(source_region.GetWidth(), source_region.GetHeight(), 1));
 
-  if (!src.SetLayout(barrier)) {
+  BarrierBatchVK batch;
+  if (!src.SetLayout(barrier, batch)) {
     VALIDATION_LOG << "Could not encode layout transition.";
     return false;
   }
+  encoder.EncodeBarriers(batch);
 
   cmd_buffer.copyImageToBuffer(src.GetImage(),      //
                                barrier.new_layout,  //
@@ -241,7 +250,12 @@ bool BlitPassVK::ConvertTextureToShaderRead(
     return false;
   }
 
-  return texture_vk.SetLayout(barrier);
+  BarrierBatchVK batch;
+  if (!texture_vk.SetLayout(barrier, batch)) {
+    return false;
+  }
+  encoder.EncodeBarriers(batch);
+  return true;
 }
 
 // |BlitPass|
@@ -259,6 +273,13 @@ bool BlitPassVK::OnCopyBufferToTextureCommand(
   const auto& dst = TextureVK::Cast(*destination);
   const auto& src = DeviceBufferVK::Cast(*source.buffer);
 
+  // Copies that replace the base mip level of a texture that hasn't been used
+  // yet, like decoded images, don't need to wait for the graphics queue.
+  if (destination_region == IRect::MakeSize(dst.GetSize()) &&
+      dst.UploadOnTransferQueue(source, slice)) {
+    return true;
+  }
+
   if (!encoder.Track(source.buffer) || !encoder.Track(destination)) {
     return false;
   }
@@ -289,10 +310,12 @@ bool BlitPassVK::OnCopyBufferToTextureCommand(
   // Note: this barrier should do nothing if we're already in the transfer dst
   // optimal state. This is important for performance of repeated blit pass
   // encoding.
-  if (!dst.SetLayout(dst_barrier)) {
+  BarrierBatchVK batch;
+  if (!dst.SetLayout(dst_barrier, batch)) {
     VALIDATION_LOG << "Could not encode layout transition.";
     return false;
   }
+  encoder.EncodeBarriers(batch);
 
   cmd_buffer.copyBufferToImage(src.GetBuffer(),         //
                                dst.GetImage(),          //
@@ -311,9 +334,10 @@ bool BlitPassVK::OnCopyBufferToTextureCommand(
 
     barrier.new_layout = vk::ImageLayout::eShaderReadOnlyOptimal;
 
-    if (!dst.SetLayout(barrier)) {
+    if (!dst.SetLayout(barrier, batch)) {
       return false;
     }
+    encoder.EncodeBarriers(batch);
   }
 
   return true;
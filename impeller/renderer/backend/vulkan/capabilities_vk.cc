@@ -199,6 +199,12 @@ static const char* GetExtensionName(OptionalDeviceExtensionVK ext) {
       return VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME;
     case OptionalDeviceExtensionVK::kVKKHRPortabilitySubset:
       return "VK_KHR_portability_subset";
+    case OptionalDeviceExtensionVK::kKHRTimelineSemaphore:
+      return VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kKHRPushDescriptor:
+      return VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kEXTMemoryBudget:
+      return VK_EXT_MEMORY_BUDGET_EXTENSION_NAME;
     case OptionalDeviceExtensionVK::kLast:
       return "Unknown";
   }
@@ -409,6 +415,19 @@ CapabilitiesVK::GetEnabledDeviceFeatures(
         supported.uniformAndStorageBuffer16BitAccess;
   }
 
+  // VK_KHR_timeline_semaphore features.
+  if (IsExtensionInList(enabled_extensions.value(),
+                        OptionalDeviceExtensionVK::kKHRTimelineSemaphore)) {
+    auto& required =
+        required_chain.get<vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>();
+    const auto& supported =
+        supported_chain.get<vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>();
+
+    required.timelineSemaphore = supported.timelineSemaphore;
+  } else {
+    required_chain.unlink<vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>();
+  }
+
   return required_chain;
 }
 
@@ -518,6 +537,28 @@ bool CapabilitiesVK::SetPhysicalDevice(const vk::PhysicalDevice& device) {
     });
   }
 
+  // |GetEnabledDeviceFeatures| enables timeline semaphores whenever the
+  // extension is available and the device supports them.
+  supports_timeline_semaphores_ = false;
+  if (HasExtension(OptionalDeviceExtensionVK::kKHRTimelineSemaphore)) {
+    auto features =
+        device.getFeatures2<vk::PhysicalDeviceFeatures2,
+                            vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>();
+    supports_timeline_semaphores_ =
+        features.get<vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>()
+            .timelineSemaphore;
+  }
+
+  max_push_descriptors_ = 0u;
+  if (HasExtension(OptionalDeviceExtensionVK::kKHRPushDescriptor)) {
+    auto properties = device.getProperties2<
+        vk::PhysicalDeviceProperties2,
+        vk::PhysicalDevicePushDescriptorPropertiesKHR>();
+    max_push_descriptors_ =
+        properties.get<vk::PhysicalDevicePushDescriptorPropertiesKHR>()
+            .maxPushDescriptors;
+  }
+
   return true;
 }
 
@@ -572,6 +613,21 @@ bool CapabilitiesVK::SupportsDeviceTransientTextures() const {
   return supports_device_transient_textures_;
 }
 
+bool CapabilitiesVK::SupportsTimelineSemaphores() const {
+  return supports_timeline_semaphores_;
+}
+
+DescriptorUpdatePathVK CapabilitiesVK::GetDescriptorUpdatePath() const {
+  if (max_push_descriptors_ > 0u) {
+    return DescriptorUpdatePathVK::kPushDescriptors;
+  }
+  return DescriptorUpdatePathVK::kCachedDescriptorSets;
+}
+
+uint32_t CapabilitiesVK::GetMaxPushDescriptors() const {
+  return max_push_descriptors_;
+}
+
 // |Capabilities|
 PixelFormat CapabilitiesVK::GetDefaultColorFormat() const {
   return default_color_format_;
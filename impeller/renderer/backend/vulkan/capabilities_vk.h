@@ -131,9 +131,51 @@ enum class OptionalDeviceExtensionVK : uint32_t {
   ///
   kVKKHRPortabilitySubset,
 
+  //----------------------------------------------------------------------------
+  /// To track the completion of submissions with a counter per queue instead
+  /// of a fence per submission. Core in Vulkan 1.2.
+  ///
+  /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_KHR_timeline_semaphore.html
+  ///
+  kKHRTimelineSemaphore,
+
+  //----------------------------------------------------------------------------
+  /// To record the descriptors of a draw directly into the command buffer
+  /// instead of allocating and updating a descriptor set.
+  ///
+  /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_KHR_push_descriptor.html
+  ///
+  kKHRPushDescriptor,
+
+  //----------------------------------------------------------------------------
+  /// To query the device memory budget of each heap, so that caches can be
+  /// trimmed before allocations fail.
+  ///
+  /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_EXT_memory_budget.html
+  ///
+  kEXTMemoryBudget,
+
   kLast,
 };
 
+//------------------------------------------------------------------------------
+/// @brief      How render passes provide the descriptors of each draw.
+///
+enum class DescriptorUpdatePathVK {
+  //----------------------------------------------------------------------------
+  /// Descriptor sets are allocated from the per-frame descriptor pool, and
+  /// reused by later draws of the frame that bind identical resources.
+  ///
+  kCachedDescriptorSets,
+
+  //----------------------------------------------------------------------------
+  /// Descriptors are pushed into the command buffer via
+  /// `VK_KHR_push_descriptor`. Pipelines with more bindings than the device
+  /// can push still use cached descriptor sets.
+  ///
+  kPushDescriptors,
+};
+
 //------------------------------------------------------------------------------
 /// @brief      The Vulkan layers and extensions wrangler.
 ///
@@ -165,7 +207,8 @@ class CapabilitiesVK final : public Capabilities,
   using PhysicalDeviceFeatures =
       vk::StructureChain<vk::PhysicalDeviceFeatures2,
                          vk::PhysicalDeviceSamplerYcbcrConversionFeaturesKHR,
-                         vk::PhysicalDevice16BitStorageFeatures>;
+                         vk::PhysicalDevice16BitStorageFeatures,
+                         vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>;
 
   std::optional<PhysicalDeviceFeatures> GetEnabledDeviceFeatures(
       const vk::PhysicalDevice& physical_device) const;
@@ -207,6 +250,23 @@ class CapabilitiesVK final : public Capabilities,
   // |Capabilities|
   bool SupportsDeviceTransientTextures() const override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the device supports and has enabled timeline
+  ///             semaphores, via `VK_KHR_timeline_semaphore`.
+  ///
+  bool SupportsTimelineSemaphores() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      How render passes provide the descriptors of each draw.
+  ///
+  DescriptorUpdatePathVK GetDescriptorUpdatePath() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The maximum number of descriptors in a push descriptor set
+  ///             layout, or zero if push descriptors are not supported.
+  ///
+  uint32_t GetMaxPushDescriptors() const;
+
   // |Capabilities|
   PixelFormat GetDefaultColorFormat() const override;
 
@@ -231,6 +291,8 @@ class CapabilitiesVK final : public Capabilities,
   PixelFormat default_depth_stencil_format_ = PixelFormat::kUnknown;
   vk::PhysicalDeviceProperties device_properties_;
   bool supports_compute_subgroups_ = false;
+  bool supports_timeline_semaphores_ = false;
+  uint32_t max_push_descriptors_ = 0u;
   bool supports_device_transient_textures_ = false;
   bool is_valid_ = false;
 
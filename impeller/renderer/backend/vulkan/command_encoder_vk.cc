@@ -60,20 +60,22 @@ std::shared_ptr<CommandEncoderVK> CommandEncoderFactoryVK::Create() {
   tracked_objects->GetGPUProbe().RecordCmdBufferStart(
       tracked_objects->GetCommandBuffer());
 
-  return std::make_shared<CommandEncoderVK>(context->GetDeviceHolder(),
-                                            tracked_objects, queue,
-                                            context->GetFenceWaiter());
+  return std::make_shared<CommandEncoderVK>(
+      context->GetDeviceHolder(), tracked_objects, queue,
+      context->GetFenceWaiter(), context->GetBarrierCounters());
 }
 
 CommandEncoderVK::CommandEncoderVK(
     std::weak_ptr<const DeviceHolderVK> device_holder,
     std::shared_ptr<TrackedObjectsVK> tracked_objects,
     const std::shared_ptr<QueueVK>& queue,
-    std::shared_ptr<FenceWaiterVK> fence_waiter)
+    std::shared_ptr<FenceWaiterVK> fence_waiter,
+    std::shared_ptr<BarrierCountersVK> barrier_counters)
     : device_holder_(std::move(device_holder)),
       tracked_objects_(std::move(tracked_objects)),
       queue_(queue),
-      fence_waiter_(std::move(fence_waiter)) {}
+      fence_waiter_(std::move(fence_waiter)),
+      barrier_counters_(std::move(barrier_counters)) {}
 
 CommandEncoderVK::~CommandEncoderVK() = default;
 
@@ -141,6 +143,14 @@ bool CommandEncoderVK::Track(std::shared_ptr<const TextureSourceVK> texture) {
   return true;
 }
 
+bool CommandEncoderVK::Track(std::shared_ptr<TrackedObjectsVK> secondary) {
+  if (!IsValid()) {
+    return false;
+  }
+  tracked_objects_->Track(std::move(secondary));
+  return true;
+}
+
 bool CommandEncoderVK::Track(const std::shared_ptr<const Texture>& texture) {
   if (!IsValid()) {
     return false;
@@ -172,6 +182,33 @@ fml::StatusOr<vk::DescriptorSet> CommandEncoderVK::AllocateDescriptorSets(
                                                                       context);
 }
 
+fml::StatusOr<vk::DescriptorSet> CommandEncoderVK::GetDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    vk::WriteDescriptorSet* writes,
+    size_t write_count,
+    const ContextVK& context) {
+  if (!IsValid()) {
+    return fml::Status(fml::StatusCode::kUnknown, "command encoder invalid");
+  }
+
+  return tracked_objects_->GetDescriptorPool().GetDescriptorSet(
+      layout, writes, write_count, context);
+}
+
+void CommandEncoderVK::RecordPushedDescriptorSet() {
+  if (!IsValid()) {
+    return;
+  }
+  tracked_objects_->GetDescriptorPool().RecordPushedDescriptorSet();
+}
+
+void CommandEncoderVK::EncodeBarriers(BarrierBatchVK& batch) const {
+  if (!tracked_objects_) {
+    return;
+  }
+  batch.Encode(tracked_objects_->GetCommandBuffer(), barrier_counters_.get());
+}
+
 void CommandEncoderVK::PushDebugGroup(std::string_view label) const {
   if (!HasValidationLayers()) {
     return;
@@ -9,6 +9,7 @@
 #include <functional>
 #include <optional>
 
+#include "impeller/renderer/backend/vulkan/barrier_vk.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/command_queue_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
@@ -55,7 +56,8 @@ class CommandEncoderVK {
   CommandEncoderVK(std::weak_ptr<const DeviceHolderVK> device_holder,
                    std::shared_ptr<TrackedObjectsVK> tracked_objects,
                    const std::shared_ptr<QueueVK>& queue,
-                   std::shared_ptr<FenceWaiterVK> fence_waiter);
+                   std::shared_ptr<FenceWaiterVK> fence_waiter,
+                   std::shared_ptr<BarrierCountersVK> barrier_counters = {});
 
   ~CommandEncoderVK();
 
@@ -73,6 +75,9 @@ class CommandEncoderVK {
 
   bool Track(std::shared_ptr<const TextureSourceVK> texture);
 
+  /// @see        |TrackedObjectsVK::Track|.
+  bool Track(std::shared_ptr<TrackedObjectsVK> secondary);
+
   vk::CommandBuffer GetCommandBuffer() const;
 
   void PushDebugGroup(std::string_view label) const;
@@ -87,6 +92,23 @@ class CommandEncoderVK {
       const vk::DescriptorSetLayout& layout,
       const ContextVK& context);
 
+  /// @see        |DescriptorPoolVK::GetDescriptorSet|.
+  fml::StatusOr<vk::DescriptorSet> GetDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      vk::WriteDescriptorSet* writes,
+      size_t write_count,
+      const ContextVK& context);
+
+  /// @see        |DescriptorPoolVK::RecordPushedDescriptorSet|.
+  void RecordPushedDescriptorSet();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the transitions of the batch into the command buffer
+  ///             with a single pipeline barrier, and counts it towards the
+  ///             barriers of the current frame.
+  ///
+  void EncodeBarriers(BarrierBatchVK& batch) const;
+
  private:
   friend class ContextVK;
   friend class CommandQueueVK;
@@ -95,6 +117,7 @@ class CommandEncoderVK {
   std::shared_ptr<TrackedObjectsVK> tracked_objects_;
   std::shared_ptr<QueueVK> queue_;
   const std::shared_ptr<FenceWaiterVK> fence_waiter_;
+  const std::shared_ptr<BarrierCountersVK> barrier_counters_;
   std::shared_ptr<HostBuffer> host_buffer_;
   bool is_valid_ = true;
 
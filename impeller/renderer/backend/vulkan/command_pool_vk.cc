@@ -29,10 +29,12 @@ class BackgroundCommandPoolVK final {
   explicit BackgroundCommandPoolVK(
       vk::UniqueCommandPool&& pool,
       std::vector<vk::UniqueCommandBuffer>&& buffers,
+      std::vector<vk::UniqueCommandBuffer>&& secondary_buffers,
       size_t unused_count,
       std::weak_ptr<CommandPoolRecyclerVK> recycler)
       : pool_(std::move(pool)),
         buffers_(std::move(buffers)),
+        secondary_buffers_(std::move(secondary_buffers)),
         unused_count_(unused_count),
         recycler_(std::move(recycler)) {}
 
@@ -53,6 +55,10 @@ class BackgroundCommandPoolVK final {
       }
     }
 
+    // Secondary command buffers are not reused. Nothing else refers to the
+    // pool anymore, so they can be freed from this thread.
+    secondary_buffers_.clear();
+
     recycler->Reclaim(std::move(pool_), std::move(buffers_));
   }
 
@@ -67,6 +73,7 @@ class BackgroundCommandPoolVK final {
   // wrapper type will attempt to reset the cmd buffer, and doing so may be a
   // thread safety violation as this may happen on the fence waiter thread.
   std::vector<vk::UniqueCommandBuffer> buffers_;
+  std::vector<vk::UniqueCommandBuffer> secondary_buffers_;
   const size_t unused_count_;
   std::weak_ptr<CommandPoolRecyclerVK> recycler_;
 };
@@ -93,7 +100,8 @@ CommandPoolVK::~CommandPoolVK() {
   unused_command_buffers_.clear();
 
   auto reset_pool_when_dropped = BackgroundCommandPoolVK(
-      std::move(pool_), std::move(collected_buffers_), unused_count, recycler);
+      std::move(pool_), std::move(collected_buffers_),
+      std::move(collected_secondary_buffers_), unused_count, recycler);
 
   UniqueResourceVKT<BackgroundCommandPoolVK> pool(
       context->GetResourceManager(), std::move(reset_pool_when_dropped));
@@ -116,11 +124,29 @@ vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer() {
     return buffer;
   }
 
+  return AllocateCommandBuffer(vk::CommandBufferLevel::ePrimary);
+}
+
+vk::UniqueCommandBuffer CommandPoolVK::CreateSecondaryCommandBuffer() {
+  Lock lock(pool_mutex_);
+  if (!pool_) {
+    return {};
+  }
+  return AllocateCommandBuffer(vk::CommandBufferLevel::eSecondary);
+}
+
+vk::UniqueCommandBuffer CommandPoolVK::AllocateCommandBuffer(
+    vk::CommandBufferLevel level) {
+  auto const context = context_.lock();
+  if (!context) {
+    return {};
+  }
+
   auto const device = context->GetDevice();
   vk::CommandBufferAllocateInfo info;
   info.setCommandPool(pool_.get());
   info.setCommandBufferCount(1u);
-  info.setLevel(vk::CommandBufferLevel::ePrimary);
+  info.setLevel(level);
   auto [result, buffers] = device.allocateCommandBuffersUnique(info);
   if (result != vk::Result::eSuccess) {
     return {};
@@ -139,6 +165,16 @@ void CommandPoolVK::CollectCommandBuffer(vk::UniqueCommandBuffer&& buffer) {
   collected_buffers_.push_back(std::move(buffer));
 }
 
+void CommandPoolVK::CollectSecondaryCommandBuffer(
+    vk::UniqueCommandBuffer&& buffer) {
+  Lock lock(pool_mutex_);
+  if (!pool_) {
+    buffer.release();
+    return;
+  }
+  collected_secondary_buffers_.push_back(std::move(buffer));
+}
+
 void CommandPoolVK::Destroy() {
   Lock lock(pool_mutex_);
   pool_.reset();
@@ -151,8 +187,12 @@ void CommandPoolVK::Destroy() {
   for (auto& buffer : unused_command_buffers_) {
     buffer.release();
   }
+  for (auto& buffer : collected_secondary_buffers_) {
+    buffer.release();
+  }
   unused_command_buffers_.clear();
   collected_buffers_.clear();
+  collected_secondary_buffers_.clear();
 }
 
 // Associates a resource with a thread and context.
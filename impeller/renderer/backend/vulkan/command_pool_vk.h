@@ -58,6 +58,22 @@ class CommandPoolVK final {
   /// @see        |GarbageCollectBuffersIfAble|
   void CollectCommandBuffer(vk::UniqueCommandBuffer&& buffer);
 
+  /// @brief      Creates and returns a new secondary |vk::CommandBuffer|.
+  ///
+  ///             Unlike primary command buffers, secondary command buffers are
+  ///             not recycled along with the pool. They are freed right before
+  ///             the pool is reset.
+  ///
+  /// @return     A `{}` default instance if a command buffer could not be
+  ///             created.
+  vk::UniqueCommandBuffer CreateSecondaryCommandBuffer();
+
+  /// @brief      Collects the given secondary |vk::CommandBuffer| to be freed
+  ///             when the pool is recycled.
+  ///
+  /// @param[in]  buffer  The |vk::CommandBuffer| to collect.
+  void CollectSecondaryCommandBuffer(vk::UniqueCommandBuffer&& buffer);
+
   /// @brief      Delete all Vulkan objects in this command pool.
   void Destroy();
 
@@ -74,6 +90,11 @@ class CommandPoolVK final {
   // Used to retain a reference on these until the pool is reset.
   std::vector<vk::UniqueCommandBuffer> collected_buffers_ IPLR_GUARDED_BY(
       pool_mutex_);
+  std::vector<vk::UniqueCommandBuffer> collected_secondary_buffers_
+      IPLR_GUARDED_BY(pool_mutex_);
+
+  vk::UniqueCommandBuffer AllocateCommandBuffer(vk::CommandBufferLevel level)
+      IPLR_REQUIRES(pool_mutex_);
 };
 
 //------------------------------------------------------------------------------
@@ -11,7 +11,9 @@
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
+#include "impeller/renderer/backend/vulkan/timeline_waiter_vk.h"
 #include "impeller/renderer/backend/vulkan/tracked_objects_vk.h"
+#include "impeller/renderer/backend/vulkan/upload_queue_vk.h"
 #include "impeller/renderer/command_buffer.h"
 
 namespace impeller {
@@ -35,10 +37,21 @@ fml::Status CommandQueueVK::Submit(
     }
   });
 
+  auto context = context_.lock();
+  if (!context) {
+    VALIDATION_LOG << "Device lost.";
+    return fml::Status(fml::StatusCode::kCancelled, "Device lost.");
+  }
+
+  // Textures uploaded on the transfer queue may only be used once they are
+  // acquired by the graphics queue. No submission may overtake the one that
+  // records the acquire.
+  Lock submit_lock(submit_mutex_);
+
   std::vector<vk::CommandBuffer> vk_buffers;
   std::vector<std::shared_ptr<TrackedObjectsVK>> tracked_objects;
-  vk_buffers.reserve(buffers.size());
-  tracked_objects.reserve(buffers.size());
+  vk_buffers.reserve(buffers.size() + 1u);
+  tracked_objects.reserve(buffers.size() + 1u);
   for (const std::shared_ptr<CommandBuffer>& buffer : buffers) {
     auto encoder = CommandBufferVK::Cast(*buffer).GetEncoder();
     if (!encoder->EndCommandBuffer()) {
@@ -50,37 +63,105 @@ fml::Status CommandQueueVK::Submit(
     encoder->Reset();
   }
 
-  auto context = context_.lock();
-  if (!context) {
-    VALIDATION_LOG << "Device lost.";
-    return fml::Status(fml::StatusCode::kCancelled, "Device lost.");
+  auto timeline_waiter = context->GetTimelineWaiter();
+  vk::UniqueFence fence;
+  if (!timeline_waiter) {
+    auto [fence_result, unique_fence] =
+        context->GetDevice().createFenceUnique({});
+    if (fence_result != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Failed to create fence: "
+                     << vk::to_string(fence_result);
+      return fml::Status(fml::StatusCode::kCancelled,
+                         "Failed to create fence.");
+    }
+    fence = std::move(unique_fence);
   }
-  auto [fence_result, fence] = context->GetDevice().createFenceUnique({});
-  if (fence_result != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Failed to create fence: " << vk::to_string(fence_result);
-    return fml::Status(fml::StatusCode::kCancelled, "Failed to create fence.");
+
+  // The acquires are taken as late as possible. Should anything fail before
+  // they are submitted, they are handed back to the upload queue so that the
+  // next submission records them instead.
+  const auto& upload_queue = context->GetUploadQueue();
+  std::shared_ptr<UploadQueueVK::PendingAcquires> acquires;
+  if (upload_queue) {
+    acquires = std::make_shared<UploadQueueVK::PendingAcquires>(
+        upload_queue->TakePendingAcquires());
+  }
+  fml::ScopedCleanupClosure return_acquires([&]() {
+    if (acquires) {
+      upload_queue->ReturnPendingAcquires(std::move(*acquires));
+    }
+  });
+
+  std::vector<vk::Semaphore> wait_semaphores;
+  std::vector<vk::PipelineStageFlags> wait_stages;
+  if (acquires && !acquires->barriers.empty()) {
+    auto acquire_buffer = context->CreateCommandBuffer();
+    if (!acquire_buffer) {
+      return fml::Status(fml::StatusCode::kCancelled,
+                         "Failed to create acquire command buffer.");
+    }
+    auto encoder = CommandBufferVK::Cast(*acquire_buffer).GetEncoder();
+    encoder->GetCommandBuffer().pipelineBarrier(
+        vk::PipelineStageFlagBits::eTopOfPipe,    // src stage
+        vk::PipelineStageFlagBits::eAllCommands,  // dst stage
+        {},                                       // dependency flags
+        nullptr,                                  // memory barriers
+        nullptr,                                  // buffer barriers
+        acquires->barriers                        // image barriers
+    );
+    if (!encoder->EndCommandBuffer()) {
+      return fml::Status(fml::StatusCode::kCancelled,
+                         "Failed to end acquire command buffer.");
+    }
+    // The acquires must be executed before any of the other command buffers.
+    tracked_objects.insert(tracked_objects.begin(), encoder->tracked_objects_);
+    vk_buffers.insert(vk_buffers.begin(), encoder->GetCommandBuffer());
+    encoder->Reset();
+    for (const auto& semaphore : acquires->semaphores) {
+      wait_semaphores.push_back(semaphore.get());
+      wait_stages.push_back(vk::PipelineStageFlagBits::eAllCommands);
+    }
   }
 
   vk::SubmitInfo submit_info;
   submit_info.setCommandBuffers(vk_buffers);
+  submit_info.setWaitSemaphores(wait_semaphores);
+  submit_info.setWaitDstStageMask(wait_stages);
+
+  // Submit will proceed, call callback with true when it is done and do not
+  // call when `reset` is collected. The semaphores waited on and the textures
+  // acquired are kept alive till then.
+  auto on_completed = [completion_callback,
+                       tracked_objects = std::move(tracked_objects),
+                       acquires]() mutable {
+    // Ensure tracked objects are destructed before calling any final
+    // callbacks.
+    tracked_objects.clear();
+    acquires.reset();
+    if (completion_callback) {
+      completion_callback(CommandBuffer::Status::kCompleted);
+    }
+  };
+
+  if (timeline_waiter) {
+    auto status = timeline_waiter->Submit(submit_info, on_completed);
+    if (!status.ok()) {
+      return status;
+    }
+    return_acquires.Release();
+    reset.Release();
+    return fml::Status();
+  }
+
   auto status = context->GetGraphicsQueue()->Submit(submit_info, *fence);
   if (status != vk::Result::eSuccess) {
     VALIDATION_LOG << "Failed to submit queue: " << vk::to_string(status);
     return fml::Status(fml::StatusCode::kCancelled, "Failed to submit queue: ");
   }
+  return_acquires.Release();
 
-  // Submit will proceed, call callback with true when it is done and do not
-  // call when `reset` is collected.
-  auto added_fence = context->GetFenceWaiter()->AddFence(
-      std::move(fence), [completion_callback, tracked_objects = std::move(
-                                                  tracked_objects)]() mutable {
-        // Ensure tracked objects are destructed before calling any final
-        // callbacks.
-        tracked_objects.clear();
-        if (completion_callback) {
-          completion_callback(CommandBuffer::Status::kCompleted);
-        }
-      });
+  auto added_fence =
+      context->GetFenceWaiter()->AddFence(std::move(fence), on_completed);
   if (!added_fence) {
     return fml::Status(fml::StatusCode::kCancelled, "Failed to add fence.");
   }
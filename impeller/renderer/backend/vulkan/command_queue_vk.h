@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_COMMAND_QUEUE_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_COMMAND_QUEUE_VK_H_
 
+#include "impeller/base/thread.h"
 #include "impeller/renderer/command_queue.h"
 
 namespace impeller {
@@ -23,6 +24,7 @@ class CommandQueueVK : public CommandQueue {
 
  private:
   std::weak_ptr<ContextVK> context_;
+  Mutex submit_mutex_;
 
   CommandQueueVK(const CommandQueueVK&) = delete;
 
@@ -25,6 +25,7 @@
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/vulkan/allocator_vk.h"
+#include "impeller/renderer/backend/vulkan/barrier_vk.h"
 #include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
@@ -33,8 +34,11 @@
 #include "impeller/renderer/backend/vulkan/debug_report_vk.h"
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
 #include "impeller/renderer/backend/vulkan/gpu_tracer_vk.h"
+#include "impeller/renderer/backend/vulkan/render_pass_cache_vk.h"
 #include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_context_vk.h"
+#include "impeller/renderer/backend/vulkan/timeline_waiter_vk.h"
+#include "impeller/renderer/backend/vulkan/upload_queue_vk.h"
 #include "impeller/renderer/backend/vulkan/yuv_conversion_library_vk.h"
 #include "impeller/renderer/capabilities.h"
 
@@ -277,8 +281,14 @@ void ContextVK::Setup(Settings settings) {
   ///
   auto graphics_queue =
       PickQueue(device_holder->physical_device, vk::QueueFlagBits::eGraphics);
-  auto transfer_queue =
-      PickQueue(device_holder->physical_device, vk::QueueFlagBits::eTransfer);
+  // Prefer a dedicated transfer queue so that texture uploads can overlap
+  // with rendering. See |UploadQueueVK|.
+  auto transfer_queue = UploadQueueVK::PickQueue(
+      device_holder->physical_device.getQueueFamilyProperties());
+  if (!transfer_queue.has_value()) {
+    transfer_queue =
+        PickQueue(device_holder->physical_device, vk::QueueFlagBits::eTransfer);
+  }
   auto compute_queue =
       PickQueue(device_holder->physical_device, vk::QueueFlagBits::eCompute);
 
@@ -430,6 +440,30 @@ void ContextVK::Setup(Settings settings) {
     return;
   }
 
+  //----------------------------------------------------------------------------
+  /// Create the upload queue if there is a dedicated transfer queue.
+  ///
+  std::shared_ptr<UploadQueueVK> upload_queue;
+  const uint32_t graphics_queue_family =
+      queues.graphics_queue->GetIndex().family;
+  if (queues.transfer_queue->GetIndex().family != graphics_queue_family) {
+    upload_queue = UploadQueueVK::Create(device_holder, queues.transfer_queue,
+                                         graphics_queue_family);
+    if (!upload_queue) {
+      VALIDATION_LOG << "Could not create upload queue. Textures will be "
+                        "uploaded on the graphics queue.";
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// Create the timeline waiter if possible, the fence waiter is the fallback.
+  ///
+  std::shared_ptr<TimelineWaiterVK> timeline_waiter;
+  if (caps->SupportsTimelineSemaphores()) {
+    timeline_waiter =
+        TimelineWaiterVK::Create(device_holder, queues.graphics_queue);
+  }
+
   VkPhysicalDeviceProperties physical_device_properties;
   dispatcher.vkGetPhysicalDeviceProperties(device_holder->physical_device,
                                            &physical_device_properties);
@@ -447,9 +481,14 @@ void ContextVK::Setup(Settings settings) {
   pipeline_library_ = std::move(pipeline_library);
   yuv_conversion_library_ = std::shared_ptr<YUVConversionLibraryVK>(
       new YUVConversionLibraryVK(device_holder_));
+  render_pass_cache_ =
+      std::shared_ptr<RenderPassCacheVK>(new RenderPassCacheVK());
+  barrier_counters_ = std::make_shared<BarrierCountersVK>();
   queues_ = std::move(queues);
   device_capabilities_ = std::move(caps);
   fence_waiter_ = std::move(fence_waiter);
+  timeline_waiter_ = std::move(timeline_waiter);
+  upload_queue_ = std::move(upload_queue);
   resource_manager_ = std::move(resource_manager);
   command_pool_recycler_ = std::move(command_pool_recycler);
   descriptor_pool_recycler_ = std::move(descriptor_pool_recycler);
@@ -526,6 +565,7 @@ void ContextVK::Shutdown() {
   //
   // tl;dr: Without it, we get thread::join failures on shutdown.
   fence_waiter_.reset();
+  timeline_waiter_.reset();
   resource_manager_.reset();
 
   raster_message_loop_->Terminate();
@@ -551,6 +591,14 @@ std::shared_ptr<FenceWaiterVK> ContextVK::GetFenceWaiter() const {
   return fence_waiter_;
 }
 
+std::shared_ptr<TimelineWaiterVK> ContextVK::GetTimelineWaiter() const {
+  return timeline_waiter_;
+}
+
+const std::shared_ptr<UploadQueueVK>& ContextVK::GetUploadQueue() const {
+  return upload_queue_;
+}
+
 std::shared_ptr<ResourceManagerVK> ContextVK::GetResourceManager() const {
   return resource_manager_;
 }
@@ -622,6 +670,16 @@ ContextVK::GetYUVConversionLibrary() const {
   return yuv_conversion_library_;
 }
 
+const std::shared_ptr<RenderPassCacheVK>& ContextVK::GetRenderPassCache()
+    const {
+  return render_pass_cache_;
+}
+
+const std::shared_ptr<BarrierCountersVK>& ContextVK::GetBarrierCounters()
+    const {
+  return barrier_counters_;
+}
+
 const std::unique_ptr<DriverInfoVK>& ContextVK::GetDriverInfo() const {
   return driver_info_;
 }
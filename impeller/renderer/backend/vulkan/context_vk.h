@@ -38,6 +38,10 @@ class SurfaceContextVK;
 class GPUTracerVK;
 class DescriptorPoolRecyclerVK;
 class CommandQueueVK;
+class TimelineWaiterVK;
+class RenderPassCacheVK;
+class BarrierCountersVK;
+class UploadQueueVK;
 
 class ContextVK final : public Context,
                         public BackendCast<ContextVK, Context>,
@@ -99,6 +103,10 @@ class ContextVK final : public Context,
   const std::shared_ptr<YUVConversionLibraryVK>& GetYUVConversionLibrary()
       const;
 
+  const std::shared_ptr<RenderPassCacheVK>& GetRenderPassCache() const;
+
+  const std::shared_ptr<BarrierCountersVK>& GetBarrierCounters() const;
+
   // |Context|
   void Shutdown() override;
 
@@ -154,6 +162,20 @@ class ContextVK final : public Context,
 
   std::shared_ptr<FenceWaiterVK> GetFenceWaiter() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The waiter for submissions to the graphics queue, or null if
+  ///             the device does not support timeline semaphores, in which
+  ///             case submissions are tracked by the fence waiter.
+  ///
+  std::shared_ptr<TimelineWaiterVK> GetTimelineWaiter() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The queue used to upload textures on a dedicated transfer
+  ///             queue, or null if the device doesn't have one. In that case
+  ///             textures are uploaded on the graphics queue.
+  ///
+  const std::shared_ptr<UploadQueueVK>& GetUploadQueue() const;
+
   std::shared_ptr<ResourceManagerVK> GetResourceManager() const;
 
   std::shared_ptr<CommandPoolRecyclerVK> GetCommandPoolRecycler() const;
@@ -190,9 +212,13 @@ class ContextVK final : public Context,
   std::shared_ptr<SamplerLibraryVK> sampler_library_;
   std::shared_ptr<PipelineLibraryVK> pipeline_library_;
   std::shared_ptr<YUVConversionLibraryVK> yuv_conversion_library_;
+  std::shared_ptr<RenderPassCacheVK> render_pass_cache_;
+  std::shared_ptr<BarrierCountersVK> barrier_counters_;
   QueuesVK queues_;
   std::shared_ptr<const Capabilities> device_capabilities_;
   std::shared_ptr<FenceWaiterVK> fence_waiter_;
+  std::shared_ptr<TimelineWaiterVK> timeline_waiter_;
+  std::shared_ptr<UploadQueueVK> upload_queue_;
   std::shared_ptr<ResourceManagerVK> resource_manager_;
   std::shared_ptr<CommandPoolRecyclerVK> command_pool_recycler_;
   std::string device_name_;
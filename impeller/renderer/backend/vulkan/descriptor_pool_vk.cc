@@ -6,6 +6,8 @@
 
 #include <optional>
 
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
 #include "vulkan/vulkan_enums.hpp"
@@ -68,6 +70,8 @@ DescriptorPoolVK::DescriptorPoolVK(std::weak_ptr<const ContextVK> context)
     : context_(std::move(context)) {}
 
 DescriptorPoolVK::~DescriptorPoolVK() {
+  TraceDescriptorSetCounts();
+
   if (pools_.empty()) {
     return;
   }
@@ -120,6 +124,123 @@ fml::StatusOr<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSets(
   return set;
 }
 
+fml::StatusOr<vk::DescriptorSet> DescriptorPoolVK::GetDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    vk::WriteDescriptorSet* writes,
+    size_t write_count,
+    const ContextVK& context_vk) {
+  size_t hash = fml::HashCombine(static_cast<VkDescriptorSetLayout>(layout));
+  for (auto i = 0u; i < write_count; i++) {
+    fml::HashCombineSeed(hash,
+                         DescriptorBindingVK::FromWrite(writes[i]).GetHash());
+  }
+
+  auto [begin, end] = cached_sets_.equal_range(hash);
+  for (auto it = begin; it != end; ++it) {
+    const CachedDescriptorSetVK& cached = it->second;
+    if (cached.layout != layout || cached.bindings.size() != write_count) {
+      continue;
+    }
+    bool matches = true;
+    for (auto i = 0u; i < write_count && matches; i++) {
+      matches = cached.bindings[i] == DescriptorBindingVK::FromWrite(writes[i]);
+    }
+    if (matches) {
+      reused_set_count_++;
+      return cached.set;
+    }
+  }
+
+  auto set = AllocateDescriptorSets(layout, context_vk);
+  if (!set.ok()) {
+    return set;
+  }
+  allocated_set_count_++;
+
+  CachedDescriptorSetVK cached;
+  cached.layout = layout;
+  cached.set = set.value();
+  cached.bindings.reserve(write_count);
+  for (auto i = 0u; i < write_count; i++) {
+    writes[i].dstSet = cached.set;
+    cached.bindings.push_back(DescriptorBindingVK::FromWrite(writes[i]));
+  }
+  context_vk.GetDevice().updateDescriptorSets(write_count, writes, 0u, {});
+  cached_sets_.emplace(hash, std::move(cached));
+  return set;
+}
+
+void DescriptorPoolVK::RecordPushedDescriptorSet() {
+  pushed_set_count_++;
+}
+
+size_t DescriptorPoolVK::GetAllocatedDescriptorSetCount() const {
+  return allocated_set_count_;
+}
+
+size_t DescriptorPoolVK::GetReusedDescriptorSetCount() const {
+  return reused_set_count_;
+}
+
+size_t DescriptorPoolVK::GetPushedDescriptorSetCount() const {
+  return pushed_set_count_;
+}
+
+void DescriptorPoolVK::TraceDescriptorSetCounts() const {
+  if (allocated_set_count_ == 0u && reused_set_count_ == 0u &&
+      pushed_set_count_ == 0u) {
+    return;
+  }
+  static constexpr int64_t kImpellerDescriptorSetsTraceID = 1989;
+  FML_TRACE_COUNTER("impeller",                         //
+                    "DescriptorSets",                   //
+                    kImpellerDescriptorSetsTraceID,     //
+                    "Allocated", allocated_set_count_,  //
+                    "Reused", reused_set_count_,        //
+                    "Pushed", pushed_set_count_         //
+  );
+}
+
+DescriptorPoolVK::DescriptorBindingVK
+DescriptorPoolVK::DescriptorBindingVK::FromWrite(
+    const vk::WriteDescriptorSet& write) {
+  FML_DCHECK(write.descriptorCount == 1u);
+  DescriptorBindingVK binding;
+  binding.binding = write.dstBinding;
+  binding.type = write.descriptorType;
+  if (write.pBufferInfo) {
+    binding.buffer = write.pBufferInfo->buffer;
+    binding.offset = write.pBufferInfo->offset;
+    binding.range = write.pBufferInfo->range;
+  }
+  if (write.pImageInfo) {
+    binding.sampler = write.pImageInfo->sampler;
+    binding.image_view = write.pImageInfo->imageView;
+    binding.image_layout = write.pImageInfo->imageLayout;
+  }
+  return binding;
+}
+
+size_t DescriptorPoolVK::DescriptorBindingVK::GetHash() const {
+  return fml::HashCombine(binding,                               //
+                          static_cast<uint32_t>(type),           //
+                          static_cast<VkBuffer>(buffer),         //
+                          static_cast<uint64_t>(offset),         //
+                          static_cast<uint64_t>(range),          //
+                          static_cast<VkSampler>(sampler),       //
+                          static_cast<VkImageView>(image_view),  //
+                          static_cast<uint32_t>(image_layout)    //
+  );
+}
+
+bool DescriptorPoolVK::DescriptorBindingVK::operator==(
+    const DescriptorBindingVK& other) const {
+  return binding == other.binding && type == other.type &&
+         buffer == other.buffer && offset == other.offset &&
+         range == other.range && sampler == other.sampler &&
+         image_view == other.image_view && image_layout == other.image_layout;
+}
+
 fml::Status DescriptorPoolVK::CreateNewPool(const ContextVK& context_vk) {
   auto new_pool = context_vk.GetDescriptorPoolRecycler()->Get();
   if (!new_pool) {
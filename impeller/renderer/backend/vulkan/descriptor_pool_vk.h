@@ -6,6 +6,8 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_DESCRIPTOR_POOL_VK_H_
 
 #include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 #include "fml/status_or.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
@@ -24,6 +26,10 @@ namespace impeller {
 ///
 ///             Encoders create pools as necessary as they have the same
 ///             threading and lifecycle restrictions.
+///
+///             Sets returned by |GetDescriptorSet| are cached for the lifetime
+///             of the pool so that draws binding identical resources share a
+///             single set.
 class DescriptorPoolVK {
  public:
   explicit DescriptorPoolVK(std::weak_ptr<const ContextVK> context);
@@ -34,12 +40,78 @@ class DescriptorPoolVK {
       const vk::DescriptorSetLayout& layout,
       const ContextVK& context_vk);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Gets a descriptor set of the given layout with the given
+  ///             writes applied to it.
+  ///
+  ///             If a previous call used the same layout and writes, the set
+  ///             returned then is returned again without being updated. Sets
+  ///             are never updated after being returned, so they may be bound
+  ///             any number of times while the pool is alive.
+  ///
+  /// @param[in]  layout       The layout of the set.
+  /// @param[in]  writes       The writes, each for a single descriptor. Their
+  ///                          destination set is overwritten.
+  /// @param[in]  write_count  The number of writes.
+  /// @param[in]  context_vk   The context.
+  ///
+  fml::StatusOr<vk::DescriptorSet> GetDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      vk::WriteDescriptorSet* writes,
+      size_t write_count,
+      const ContextVK& context_vk);
+
+  /// @brief      Counts a set of descriptors that was pushed into the command
+  ///             buffer instead of being allocated from this pool.
+  void RecordPushedDescriptorSet();
+
+  /// The number of sets allocated by |GetDescriptorSet|.
+  size_t GetAllocatedDescriptorSetCount() const;
+
+  /// The number of times |GetDescriptorSet| returned a cached set.
+  size_t GetReusedDescriptorSetCount() const;
+
+  /// The number of calls to |RecordPushedDescriptorSet|.
+  size_t GetPushedDescriptorSetCount() const;
+
  private:
+  // A single descriptor written to a set.
+  struct DescriptorBindingVK {
+    uint32_t binding = 0u;
+    vk::DescriptorType type = vk::DescriptorType::eUniformBuffer;
+    vk::Buffer buffer = {};
+    vk::DeviceSize offset = 0u;
+    vk::DeviceSize range = 0u;
+    vk::Sampler sampler = {};
+    vk::ImageView image_view = {};
+    vk::ImageLayout image_layout = vk::ImageLayout::eUndefined;
+
+    static DescriptorBindingVK FromWrite(const vk::WriteDescriptorSet& write);
+
+    size_t GetHash() const;
+
+    bool operator==(const DescriptorBindingVK& other) const;
+  };
+
+  struct CachedDescriptorSetVK {
+    vk::DescriptorSetLayout layout;
+    std::vector<DescriptorBindingVK> bindings;
+    vk::DescriptorSet set;
+  };
+
   std::weak_ptr<const ContextVK> context_;
   std::vector<vk::UniqueDescriptorPool> pools_;
+  // Keyed by the hash of the layout and the bindings. Collisions are resolved
+  // by comparing the bindings.
+  std::unordered_multimap<size_t, CachedDescriptorSetVK> cached_sets_;
+  size_t allocated_set_count_ = 0u;
+  size_t reused_set_count_ = 0u;
+  size_t pushed_set_count_ = 0u;
 
   fml::Status CreateNewPool(const ContextVK& context_vk);
 
+  void TraceDescriptorSetCounts() const;
+
   DescriptorPoolVK(const DescriptorPoolVK&) = delete;
 
   DescriptorPoolVK& operator=(const DescriptorPoolVK&) = delete;
@@ -5,6 +5,7 @@
 #include "flutter/testing/testing.h"  // IWYU pragma: keep.
 #include "fml/closure.h"
 #include "fml/synchronization/waitable_event.h"
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
@@ -123,5 +124,90 @@ TEST(DescriptorPoolRecyclerVKTest, ReclaimDropsDescriptorPoolIfSizeIsExceeded) {
   context->Shutdown();
 }
 
+static vk::WriteDescriptorSet CreateBufferWrite(
+    uint32_t binding,
+    const vk::DescriptorBufferInfo& buffer_info) {
+  vk::WriteDescriptorSet write;
+  write.dstBinding = binding;
+  write.descriptorCount = 1u;
+  write.descriptorType = vk::DescriptorType::eUniformBuffer;
+  write.pBufferInfo = &buffer_info;
+  return write;
+}
+
+TEST(DescriptorPoolVKTest, ReusesDescriptorSetsWithIdenticalWrites) {
+  auto const context = MockVulkanContextBuilder().Build();
+
+  {
+    auto pool = DescriptorPoolVK(context);
+    vk::DescriptorBufferInfo buffer_info;
+    buffer_info.buffer = vk::Buffer(reinterpret_cast<VkBuffer>(0x1234));
+    buffer_info.offset = 0u;
+    buffer_info.range = 64u;
+    vk::DescriptorBufferInfo other_buffer_info = buffer_info;
+    other_buffer_info.offset = 64u;
+
+    std::array<vk::WriteDescriptorSet, 2> writes = {
+        CreateBufferWrite(0u, buffer_info),
+        CreateBufferWrite(1u, buffer_info),
+    };
+    EXPECT_TRUE(
+        pool.GetDescriptorSet({}, writes.data(), writes.size(), *context).ok());
+    EXPECT_TRUE(
+        pool.GetDescriptorSet({}, writes.data(), writes.size(), *context).ok());
+    EXPECT_EQ(pool.GetAllocatedDescriptorSetCount(), 1u);
+    EXPECT_EQ(pool.GetReusedDescriptorSetCount(), 1u);
+
+    // Any difference in the bindings requires another set.
+    writes[1] = CreateBufferWrite(1u, other_buffer_info);
+    EXPECT_TRUE(
+        pool.GetDescriptorSet({}, writes.data(), writes.size(), *context).ok());
+    EXPECT_TRUE(pool.GetDescriptorSet({}, writes.data(), 1u, *context).ok());
+    EXPECT_EQ(pool.GetAllocatedDescriptorSetCount(), 3u);
+    EXPECT_EQ(pool.GetReusedDescriptorSetCount(), 1u);
+  }
+
+  auto const called = GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(
+      std::count(called->begin(), called->end(), "vkAllocateDescriptorSets"),
+      3u);
+  EXPECT_EQ(
+      std::count(called->begin(), called->end(), "vkUpdateDescriptorSets"), 3u);
+
+  context->Shutdown();
+}
+
+TEST(DescriptorPoolVKTest, CountsPushedDescriptorSets) {
+  auto const context = MockVulkanContextBuilder().Build();
+
+  auto pool = DescriptorPoolVK(context);
+  pool.RecordPushedDescriptorSet();
+  EXPECT_EQ(pool.GetPushedDescriptorSetCount(), 1u);
+  EXPECT_EQ(pool.GetAllocatedDescriptorSetCount(), 0u);
+
+  context->Shutdown();
+}
+
+TEST(DescriptorPoolVKTest, PushDescriptorsAreUsedWhenAvailable) {
+  auto const context = MockVulkanContextBuilder().Build();
+  const auto& caps = CapabilitiesVK::Cast(*context->GetCapabilities());
+  EXPECT_EQ(caps.GetDescriptorUpdatePath(),
+            DescriptorUpdatePathVK::kCachedDescriptorSets);
+  EXPECT_EQ(caps.GetMaxPushDescriptors(), 0u);
+
+  auto const push_context =
+      MockVulkanContextBuilder()
+          .SetDeviceExtensions({"VK_KHR_swapchain", "VK_KHR_push_descriptor"})
+          .Build();
+  const auto& push_caps =
+      CapabilitiesVK::Cast(*push_context->GetCapabilities());
+  EXPECT_EQ(push_caps.GetDescriptorUpdatePath(),
+            DescriptorUpdatePathVK::kPushDescriptors);
+  EXPECT_EQ(push_caps.GetMaxPushDescriptors(), 32u);
+
+  context->Shutdown();
+  push_context->Shutdown();
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -169,7 +169,8 @@ namespace {
 fml::StatusOr<vk::UniqueDescriptorSetLayout> MakeDescriptorSetLayout(
     const PipelineDescriptor& desc,
     const std::shared_ptr<DeviceHolderVK>& device_holder,
-    const std::shared_ptr<SamplerVK>& immutable_sampler) {
+    const std::shared_ptr<SamplerVK>& immutable_sampler,
+    bool use_push_descriptors) {
   std::vector<vk::DescriptorSetLayoutBinding> set_bindings;
 
   vk::Sampler vk_immutable_sampler =
@@ -197,6 +198,10 @@ fml::StatusOr<vk::UniqueDescriptorSetLayout> MakeDescriptorSetLayout(
 
   vk::DescriptorSetLayoutCreateInfo desc_set_layout_info;
   desc_set_layout_info.setBindings(set_bindings);
+  if (use_push_descriptors) {
+    desc_set_layout_info.setFlags(
+        vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR);
+  }
 
   auto [descs_result, descs_layout] =
       device_holder->GetDevice().createDescriptorSetLayoutUnique(
@@ -461,8 +466,19 @@ std::unique_ptr<PipelineVK> PipelineVK::Create(
 
   const auto& pso_cache = PipelineLibraryVK::Cast(*library).GetPSOCache();
 
+  // Push descriptor set layouts are limited in size. Pipelines with more
+  // bindings than that fall back to allocated descriptor sets.
+  const CapabilitiesVK* caps = pso_cache->GetCapabilities();
+  const bool use_push_descriptors =
+      caps &&
+      caps->GetDescriptorUpdatePath() ==
+          DescriptorUpdatePathVK::kPushDescriptors &&
+      desc.GetVertexDescriptor()->GetDescriptorSetLayouts().size() <=
+          caps->GetMaxPushDescriptors();
+
   fml::StatusOr<vk::UniqueDescriptorSetLayout> descs_layout =
-      MakeDescriptorSetLayout(desc, device_holder, immutable_sampler);
+      MakeDescriptorSetLayout(desc, device_holder, immutable_sampler,
+                              use_push_descriptors);
   if (!descs_layout.ok()) {
     return nullptr;
   }
@@ -495,7 +511,8 @@ std::unique_ptr<PipelineVK> PipelineVK::Create(
       std::move(render_pass),              //
       std::move(pipeline_layout.value()),  //
       std::move(descs_layout.value()),     //
-      std::move(immutable_sampler)         //
+      std::move(immutable_sampler),        //
+      use_push_descriptors                 //
       ));
   if (!pipeline_vk->IsValid()) {
     VALIDATION_LOG << "Could not create a valid pipeline.";
@@ -511,14 +528,16 @@ PipelineVK::PipelineVK(std::weak_ptr<DeviceHolderVK> device_holder,
                        vk::UniqueRenderPass render_pass,
                        vk::UniquePipelineLayout layout,
                        vk::UniqueDescriptorSetLayout descriptor_set_layout,
-                       std::shared_ptr<SamplerVK> immutable_sampler)
+                       std::shared_ptr<SamplerVK> immutable_sampler,
+                       bool uses_push_descriptors)
     : Pipeline(std::move(library), desc),
       device_holder_(std::move(device_holder)),
       pipeline_(std::move(pipeline)),
       render_pass_(std::move(render_pass)),
       layout_(std::move(layout)),
       descriptor_set_layout_(std::move(descriptor_set_layout)),
-      immutable_sampler_(std::move(immutable_sampler)) {
+      immutable_sampler_(std::move(immutable_sampler)),
+      uses_push_descriptors_(uses_push_descriptors) {
   is_valid_ = pipeline_ && render_pass_ && layout_ && descriptor_set_layout_;
 }
 
@@ -547,6 +566,10 @@ const vk::DescriptorSetLayout& PipelineVK::GetDescriptorSetLayout() const {
   return *descriptor_set_layout_;
 }
 
+bool PipelineVK::UsesPushDescriptors() const {
+  return uses_push_descriptors_;
+}
+
 std::shared_ptr<PipelineVK> PipelineVK::CreateVariantForImmutableSamplers(
     const std::shared_ptr<SamplerVK>& immutable_sampler) const {
   if (!immutable_sampler) {
@@ -44,6 +44,13 @@ class PipelineVK final
 
   const vk::DescriptorSetLayout& GetDescriptorSetLayout() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the descriptor set layout is a push descriptor set
+  ///             layout. The descriptors of draws using this pipeline must be
+  ///             pushed instead of bound as a descriptor set.
+  ///
+  bool UsesPushDescriptors() const;
+
   std::shared_ptr<PipelineVK> CreateVariantForImmutableSamplers(
       const std::shared_ptr<SamplerVK>& immutable_sampler) const;
 
@@ -62,6 +69,7 @@ class PipelineVK final
   vk::UniquePipelineLayout layout_;
   vk::UniqueDescriptorSetLayout descriptor_set_layout_;
   std::shared_ptr<SamplerVK> immutable_sampler_;
+  const bool uses_push_descriptors_;
   mutable Mutex immutable_sampler_variants_mutex_;
   mutable ImmutableSamplerVariants immutable_sampler_variants_ IPLR_GUARDED_BY(
       immutable_sampler_variants_mutex_);
@@ -74,7 +82,8 @@ class PipelineVK final
              vk::UniqueRenderPass render_pass,
              vk::UniquePipelineLayout layout,
              vk::UniqueDescriptorSetLayout descriptor_set_layout,
-             std::shared_ptr<SamplerVK> immutable_sampler);
+             std::shared_ptr<SamplerVK> immutable_sampler,
+             bool uses_push_descriptors);
 
   // |Pipeline|
   bool IsValid() const override;
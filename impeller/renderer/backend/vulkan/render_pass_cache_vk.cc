@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/render_pass_cache_vk.h"
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+
+namespace impeller {
+
+static size_t HashAttachment(size_t seed,
+                             const vk::AttachmentDescription& attachment) {
+  fml::HashCombineSeed(seed, attachment.format, attachment.samples,
+                       attachment.loadOp, attachment.storeOp,
+                       attachment.stencilLoadOp, attachment.stencilStoreOp,
+                       attachment.initialLayout, attachment.finalLayout);
+  return seed;
+}
+
+RenderPassCacheVK::RenderPassCacheVK(size_t max_render_passes,
+                                     size_t max_framebuffers)
+    : max_render_passes_(max_render_passes),
+      max_framebuffers_(max_framebuffers) {}
+
+RenderPassCacheVK::~RenderPassCacheVK() = default;
+
+SharedHandleVK<vk::RenderPass> RenderPassCacheVK::GetRenderPass(
+    const ContextVK& context,
+    const RenderPassBuilderVK& builder,
+    const std::string& debug_label) {
+  size_t hash = 0u;
+  for (const auto& [index, color] : builder.GetColorAttachments()) {
+    hash = HashAttachment(fml::HashCombine(hash, index), color);
+  }
+  for (const auto& [index, resolve] : builder.GetResolves()) {
+    hash = HashAttachment(fml::HashCombine(hash, index), resolve);
+  }
+  if (builder.GetDepthStencil().has_value()) {
+    hash = HashAttachment(hash, builder.GetDepthStencil().value());
+  }
+
+  Lock lock(mutex_);
+  for (auto it = render_passes_.begin(); it != render_passes_.end(); ++it) {
+    if (it->hash == hash && it->colors == builder.GetColorAttachments() &&
+        it->resolves == builder.GetResolves() &&
+        it->depth_stencil == builder.GetDepthStencil()) {
+      render_passes_.splice(render_passes_.begin(), render_passes_, it);
+      return it->render_pass;
+    }
+  }
+
+  TRACE_EVENT0("impeller", "CreateRenderPass");
+  auto pass = builder.Build(context.GetDevice());
+  if (!pass) {
+    VALIDATION_LOG << "Failed to create render pass for framebuffer.";
+    return {};
+  }
+
+  context.SetDebugName(pass.get(), debug_label.c_str());
+
+  RenderPassEntry entry;
+  entry.hash = hash;
+  entry.colors = builder.GetColorAttachments();
+  entry.resolves = builder.GetResolves();
+  entry.depth_stencil = builder.GetDepthStencil();
+  entry.render_pass = MakeSharedVK(std::move(pass));
+  render_passes_.push_front(std::move(entry));
+  if (render_passes_.size() > max_render_passes_) {
+    render_passes_.pop_back();
+  }
+  return render_passes_.front().render_pass;
+}
+
+SharedHandleVK<vk::Framebuffer> RenderPassCacheVK::GetFramebuffer(
+    const ContextVK& context,
+    const SharedHandleVK<vk::RenderPass>& render_pass,
+    const std::vector<std::shared_ptr<const TextureSourceVK>>& attachments,
+    ISize size) {
+  if (!render_pass) {
+    return {};
+  }
+
+  size_t hash = fml::HashCombine(
+      static_cast<VkRenderPass>(render_pass->Get()), size.width, size.height);
+  for (const auto& attachment : attachments) {
+    hash = fml::HashCombine(hash, attachment.get());
+  }
+
+  auto matches = [&](const FramebufferEntry& entry) -> bool {
+    if (entry.hash != hash || entry.render_pass != render_pass ||
+        entry.size != size || entry.attachments.size() != attachments.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < attachments.size(); i++) {
+      if (entry.attachments[i].lock() != attachments[i]) {
+        return false;
+      }
+    }
+    return true;
+  };
+  auto is_stale = [](const FramebufferEntry& entry) -> bool {
+    for (const auto& attachment : entry.attachments) {
+      if (attachment.expired()) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  Lock lock(mutex_);
+  for (auto it = framebuffers_.begin(); it != framebuffers_.end();) {
+    if (matches(*it)) {
+      framebuffers_.splice(framebuffers_.begin(), framebuffers_, it);
+      return it->framebuffer;
+    }
+    // Framebuffers of collected textures can never be returned again.
+    if (is_stale(*it)) {
+      it = framebuffers_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  TRACE_EVENT0("impeller", "CreateFramebuffer");
+  std::vector<vk::ImageView> views;
+  views.reserve(attachments.size());
+  for (const auto& attachment : attachments) {
+    views.push_back(attachment->GetRenderTargetView());
+  }
+
+  vk::FramebufferCreateInfo fb_info;
+  fb_info.renderPass = render_pass->Get();
+  fb_info.width = size.width;
+  fb_info.height = size.height;
+  fb_info.layers = 1u;
+  fb_info.setAttachments(views);
+
+  auto [result, framebuffer] =
+      context.GetDevice().createFramebufferUnique(fb_info);
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create framebuffer: " << vk::to_string(result);
+    return {};
+  }
+
+  FramebufferEntry entry;
+  entry.hash = hash;
+  entry.render_pass = render_pass;
+  entry.size = size;
+  entry.attachments.assign(attachments.begin(), attachments.end());
+  entry.framebuffer = MakeSharedVK(std::move(framebuffer));
+  framebuffers_.push_front(std::move(entry));
+  if (framebuffers_.size() > max_framebuffers_) {
+    framebuffers_.pop_back();
+  }
+  return framebuffers_.front().framebuffer;
+}
+
+size_t RenderPassCacheVK::GetRenderPassCount() const {
+  Lock lock(mutex_);
+  return render_passes_.size();
+}
+
+size_t RenderPassCacheVK::GetFramebufferCount() const {
+  Lock lock(mutex_);
+  return framebuffers_.size();
+}
+
+void RenderPassCacheVK::Clear() {
+  Lock lock(mutex_);
+  render_passes_.clear();
+  framebuffers_.clear();
+}
+
+}  // namespace impeller
@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_RENDER_PASS_CACHE_VK_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_RENDER_PASS_CACHE_VK_H_
+
+#include <list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "impeller/base/thread.h"
+#include "impeller/geometry/size.h"
+#include "impeller/renderer/backend/vulkan/render_pass_builder_vk.h"
+#include "impeller/renderer/backend/vulkan/shared_object_vk.h"
+#include "impeller/renderer/backend/vulkan/texture_source_vk.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+class ContextVK;
+
+//------------------------------------------------------------------------------
+/// @brief      Caches the render passes and framebuffers of the render targets
+///             that were recently rendered to, so that frames with many
+///             offscreen passes don't create and destroy these objects for
+///             each of them.
+///
+///             Render passes are keyed by the descriptions of their
+///             attachments, that is their formats, sample counts, load and
+///             store operations and layouts. Framebuffers are keyed by their
+///             render pass, size and the textures attached to them. Both are
+///             evicted in least recently used order.
+///
+///             There is one cache per context and it may be used on any
+///             thread.
+///
+class RenderPassCacheVK {
+ public:
+  static constexpr size_t kMaxRenderPasses = 32u;
+
+  static constexpr size_t kMaxFramebuffers = 64u;
+
+  ~RenderPassCacheVK();
+
+  RenderPassCacheVK(const RenderPassCacheVK&) = delete;
+
+  RenderPassCacheVK& operator=(const RenderPassCacheVK&) = delete;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get a render pass with the attachments of the builder, which
+  ///             is built if no such render pass is cached.
+  ///
+  ///             The debug label is only given to a newly built render pass.
+  ///             A cached render pass keeps the label it was built with.
+  ///
+  SharedHandleVK<vk::RenderPass> GetRenderPass(
+      const ContextVK& context,
+      const RenderPassBuilderVK& builder,
+      const std::string& debug_label);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get a framebuffer for the render pass with the render target
+  ///             views of the given textures as attachments, which is created
+  ///             if no such framebuffer is cached.
+  ///
+  ///             The attachments must be in the order of the attachments of
+  ///             the render pass.
+  ///
+  SharedHandleVK<vk::Framebuffer> GetFramebuffer(
+      const ContextVK& context,
+      const SharedHandleVK<vk::RenderPass>& render_pass,
+      const std::vector<std::shared_ptr<const TextureSourceVK>>& attachments,
+      ISize size);
+
+  size_t GetRenderPassCount() const;
+
+  size_t GetFramebufferCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops all cached objects. Objects still in use by command
+  ///             buffers remain alive until these are done with them.
+  ///
+  void Clear();
+
+ private:
+  friend class ContextVK;
+
+  struct RenderPassEntry {
+    size_t hash = 0u;
+    std::map<size_t, vk::AttachmentDescription> colors;
+    std::map<size_t, vk::AttachmentDescription> resolves;
+    std::optional<vk::AttachmentDescription> depth_stencil;
+    SharedHandleVK<vk::RenderPass> render_pass;
+  };
+
+  struct FramebufferEntry {
+    size_t hash = 0u;
+    // Keeps the handle of the render pass from being reused by another
+    // render pass while the framebuffer is cached.
+    SharedHandleVK<vk::RenderPass> render_pass;
+    ISize size;
+    // Weak so that the cache doesn't keep textures alive. A framebuffer whose
+    // textures were collected is never returned, since the handles of their
+    // views may have been reused by other textures.
+    std::vector<std::weak_ptr<const TextureSourceVK>> attachments;
+    SharedHandleVK<vk::Framebuffer> framebuffer;
+  };
+
+  const size_t max_render_passes_;
+  const size_t max_framebuffers_;
+  mutable Mutex mutex_;
+  // In most recently used order.
+  std::list<RenderPassEntry> render_passes_ IPLR_GUARDED_BY(mutex_);
+  std::list<FramebufferEntry> framebuffers_ IPLR_GUARDED_BY(mutex_);
+
+  explicit RenderPassCacheVK(size_t max_render_passes = kMaxRenderPasses,
+                             size_t max_framebuffers = kMaxFramebuffers);
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_RENDER_PASS_CACHE_VK_H_
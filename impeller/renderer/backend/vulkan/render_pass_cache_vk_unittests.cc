@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/vulkan/render_pass_builder_vk.h"
+#include "impeller/renderer/backend/vulkan/render_pass_cache_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+namespace testing {
+
+static size_t CountFramebuffersCreated(const ContextVK& context) {
+  auto functions = GetMockVulkanFunctions(context.GetDevice());
+  return std::count(functions->begin(), functions->end(),
+                    "vkCreateFramebuffer");
+}
+
+TEST(RenderPassCacheVKTest, ReusesRenderPassesWithIdenticalAttachments) {
+  auto const context = MockVulkanContextBuilder().Build();
+  const auto& cache = context->GetRenderPassCache();
+
+  RenderPassBuilderVK builder;
+  builder.SetColorAttachment(0, PixelFormat::kR8G8B8A8UNormInt,
+                             SampleCount::kCount1, LoadAction::kClear,
+                             StoreAction::kStore);
+  auto render_pass = cache->GetRenderPass(*context, builder, "");
+  ASSERT_NE(render_pass, nullptr);
+  EXPECT_EQ(cache->GetRenderPass(*context, builder, ""), render_pass);
+  EXPECT_EQ(cache->GetRenderPassCount(), 1u);
+
+  RenderPassBuilderVK other_builder;
+  other_builder.SetColorAttachment(0, PixelFormat::kR8G8B8A8UNormInt,
+                                   SampleCount::kCount1, LoadAction::kLoad,
+                                   StoreAction::kStore);
+  auto other_render_pass = cache->GetRenderPass(*context, other_builder, "");
+  ASSERT_NE(other_render_pass, nullptr);
+  EXPECT_NE(other_render_pass, render_pass);
+  EXPECT_EQ(cache->GetRenderPassCount(), 2u);
+}
+
+TEST(RenderPassCacheVKTest, EvictsLeastRecentlyUsedRenderPasses) {
+  auto const context = MockVulkanContextBuilder().Build();
+  const auto& cache = context->GetRenderPassCache();
+
+  auto get_render_pass = [&](size_t index) {
+    RenderPassBuilderVK builder;
+    builder.SetColorAttachment(index, PixelFormat::kR8G8B8A8UNormInt,
+                               SampleCount::kCount1, LoadAction::kClear,
+                               StoreAction::kStore);
+    return cache->GetRenderPass(*context, builder, "");
+  };
+
+  auto first = get_render_pass(0u);
+  for (size_t i = 1; i <= RenderPassCacheVK::kMaxRenderPasses; i++) {
+    get_render_pass(i);
+  }
+  EXPECT_EQ(cache->GetRenderPassCount(), RenderPassCacheVK::kMaxRenderPasses);
+  EXPECT_NE(get_render_pass(0u), first);
+}
+
+TEST(RenderPassCacheVKTest, ReusesFramebuffersOfRenderTargets) {
+  auto const context = MockVulkanContextBuilder().Build();
+  const auto& cache = context->GetRenderPassCache();
+  RenderTargetAllocator allocator(context->GetResourceAllocator());
+
+  {
+    auto render_target =
+        allocator.CreateOffscreen(*context, {100, 100}, /*mip_count=*/1);
+    for (size_t i = 0; i < 3u; i++) {
+      auto buffer = context->CreateCommandBuffer();
+      auto render_pass = buffer->CreateRenderPass(render_target);
+      ASSERT_TRUE(render_pass && render_pass->IsValid());
+      EXPECT_TRUE(render_pass->EncodeCommands());
+    }
+    EXPECT_EQ(CountFramebuffersCreated(*context), 1u);
+    EXPECT_EQ(cache->GetFramebufferCount(), 1u);
+  }
+
+  // The framebuffer of the collected render target is dropped and a new one
+  // is created for the textures of the new render target.
+  auto render_target =
+      allocator.CreateOffscreen(*context, {100, 100}, /*mip_count=*/1);
+  auto buffer = context->CreateCommandBuffer();
+  auto render_pass = buffer->CreateRenderPass(render_target);
+  ASSERT_TRUE(render_pass && render_pass->IsValid());
+  EXPECT_EQ(CountFramebuffersCreated(*context), 2u);
+  EXPECT_EQ(cache->GetFramebufferCount(), 1u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -4,10 +4,15 @@
 
 #include "impeller/renderer/backend/vulkan/render_pass_vk.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <thread>
 #include <vector>
 
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
 #include "fml/status.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/device_buffer.h"
@@ -16,14 +21,18 @@
 #include "impeller/renderer/backend/vulkan/barrier_vk.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
+#include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_vk.h"
 #include "impeller/renderer/backend/vulkan/render_pass_builder_vk.h"
+#include "impeller/renderer/backend/vulkan/render_pass_cache_vk.h"
 #include "impeller/renderer/backend/vulkan/sampler_vk.h"
 #include "impeller/renderer/backend/vulkan/shared_object_vk.h"
 #include "impeller/renderer/backend/vulkan/texture_vk.h"
+#include "impeller/renderer/backend/vulkan/tracked_objects_vk.h"
+#include "impeller/renderer/command.h"
 #include "vulkan/vulkan_handles.hpp"
 
 namespace impeller {
@@ -90,6 +99,8 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
                       vk::PipelineStageFlagBits::eTransfer;
 
   RenderPassBuilderVK builder;
+  // The attachments are transitioned with a single barrier.
+  BarrierBatchVK batch;
 
   for (const auto& [bind_point, color] : render_target_.GetColorAttachments()) {
     builder.SetColorAttachment(
@@ -99,9 +110,9 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
         color.load_action,                                   //
         color.store_action                                   //
     );
-    TextureVK::Cast(*color.texture).SetLayout(barrier);
+    TextureVK::Cast(*color.texture).SetLayout(barrier, batch);
     if (color.resolve_texture) {
-      TextureVK::Cast(*color.resolve_texture).SetLayout(barrier);
+      TextureVK::Cast(*color.resolve_texture).SetLayout(barrier, batch);
     }
   }
 
@@ -122,20 +133,14 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
     );
   }
 
+  command_buffer->GetEncoder()->EncodeBarriers(batch);
+
   if (recycled_renderpass != nullptr) {
     return recycled_renderpass;
   }
 
-  auto pass = builder.Build(context.GetDevice());
-
-  if (!pass) {
-    VALIDATION_LOG << "Failed to create render pass for framebuffer.";
-    return {};
-  }
-
-  context.SetDebugName(pass.get(), debug_label_.c_str());
-
-  return MakeSharedVK(std::move(pass));
+  return context.GetRenderPassCache()->GetRenderPass(context, builder,
+                                                     debug_label_);
 }
 
 RenderPassVK::RenderPassVK(const std::shared_ptr<const Context>& context,
@@ -167,8 +172,6 @@ RenderPassVK::RenderPassVK(const std::shared_ptr<const Context>& context,
         TextureVK::Cast(*resolve_image_vk_).GetCachedFramebuffer();
   }
 
-  const auto& target_size = render_target_.GetRenderTargetSize();
-
   render_pass_ =
       CreateVKRenderPass(vk_context, recycled_render_pass, command_buffer_);
   if (!render_pass_) {
@@ -178,7 +181,7 @@ RenderPassVK::RenderPassVK(const std::shared_ptr<const Context>& context,
   }
 
   auto framebuffer = (recycled_framebuffer == nullptr)
-                         ? CreateVKFramebuffer(vk_context, *render_pass_)
+                         ? CreateVKFramebuffer(vk_context, render_pass_)
                          : recycled_framebuffer;
   if (!framebuffer) {
     VALIDATION_LOG << "Could not create framebuffer.";
@@ -195,17 +198,35 @@ RenderPassVK::RenderPassVK(const std::shared_ptr<const Context>& context,
     TextureVK::Cast(*resolve_image_vk_).SetCachedRenderPass(render_pass_);
   }
 
+  framebuffer_ = std::move(framebuffer);
+  is_valid_ = true;
+}
+
+RenderPassVK::~RenderPassVK() = default;
+
+void RenderPassVK::BeginRenderPass(vk::SubpassContents contents) const {
+  if (has_begun_render_pass_) {
+    return;
+  }
+  has_begun_render_pass_ = true;
+
+  const auto& target_size = render_target_.GetRenderTargetSize();
   auto clear_values = GetVKClearValues(render_target_);
 
   vk::RenderPassBeginInfo pass_info;
   pass_info.renderPass = *render_pass_;
-  pass_info.framebuffer = *framebuffer;
+  pass_info.framebuffer = *framebuffer_;
   pass_info.renderArea.extent.width = static_cast<uint32_t>(target_size.width);
   pass_info.renderArea.extent.height =
       static_cast<uint32_t>(target_size.height);
   pass_info.setClearValues(clear_values);
 
-  command_buffer_vk_.beginRenderPass(pass_info, vk::SubpassContents::eInline);
+  command_buffer_vk_.beginRenderPass(pass_info, contents);
+
+  // Secondary command buffers set their own dynamic state.
+  if (contents != vk::SubpassContents::eInline) {
+    return;
+  }
 
   // Set the initial viewport.
   const auto vp = Viewport{.rect = Rect::MakeSize(target_size)};
@@ -228,11 +249,11 @@ RenderPassVK::RenderPassVK(const std::shared_ptr<const Context>& context,
   // Set the initial stencil reference.
   command_buffer_vk_.setStencilReference(
       vk::StencilFaceFlagBits::eVkStencilFrontAndBack, 0u);
-
-  is_valid_ = true;
 }
 
-RenderPassVK::~RenderPassVK() = default;
+bool RenderPassVK::RecordsCommandsInParallel() const {
+  return records_commands_in_parallel_;
+}
 
 bool RenderPassVK::IsValid() const {
   return is_valid_;
@@ -247,17 +268,8 @@ void RenderPassVK::OnSetLabel(std::string label) {
 
 SharedHandleVK<vk::Framebuffer> RenderPassVK::CreateVKFramebuffer(
     const ContextVK& context,
-    const vk::RenderPass& pass) const {
-  vk::FramebufferCreateInfo fb_info;
-
-  fb_info.renderPass = pass;
-
-  const auto target_size = render_target_.GetRenderTargetSize();
-  fb_info.width = target_size.width;
-  fb_info.height = target_size.height;
-  fb_info.layers = 1u;
-
-  std::vector<vk::ImageView> attachments;
+    const SharedHandleVK<vk::RenderPass>& pass) const {
+  std::vector<std::shared_ptr<const TextureSourceVK>> attachments;
 
   // This bit must be consistent to ensure compatibility with the pass created
   // earlier. Follow this order: Color attachments, then depth-stencil, then
@@ -266,37 +278,46 @@ SharedHandleVK<vk::Framebuffer> RenderPassVK::CreateVKFramebuffer(
     // The bind point doesn't matter here since that information is present in
     // the render pass.
     attachments.emplace_back(
-        TextureVK::Cast(*color.texture).GetRenderTargetView());
+        TextureVK::Cast(*color.texture).GetTextureSource());
     if (color.resolve_texture) {
       attachments.emplace_back(
-          TextureVK::Cast(*color.resolve_texture).GetRenderTargetView());
+          TextureVK::Cast(*color.resolve_texture).GetTextureSource());
     }
   }
   if (auto depth = render_target_.GetDepthAttachment(); depth.has_value()) {
     attachments.emplace_back(
-        TextureVK::Cast(*depth->texture).GetRenderTargetView());
+        TextureVK::Cast(*depth->texture).GetTextureSource());
   } else if (auto stencil = render_target_.GetStencilAttachment();
              stencil.has_value()) {
     attachments.emplace_back(
-        TextureVK::Cast(*stencil->texture).GetRenderTargetView());
+        TextureVK::Cast(*stencil->texture).GetTextureSource());
   }
 
-  fb_info.setAttachments(attachments);
-
-  auto [result, framebuffer] =
-      context.GetDevice().createFramebufferUnique(fb_info);
+  return context.GetRenderPassCache()->GetFramebuffer(
+      context, pass, attachments, render_target_.GetRenderTargetSize());
+}
 
-  if (result != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Could not create framebuffer: " << vk::to_string(result);
-    return {};
+// |RenderPass|
+void RenderPassVK::ReserveCommands(size_t command_count) {
+  // Only a pass that has nothing recorded or bound yet can switch to
+  // collecting its commands.
+  if (records_commands_in_parallel_ || has_begun_render_pass_ || pipeline_ ||
+      descriptor_write_offset_ > 0u ||
+      command_count < kMinCommandsForParallelRecording ||
+      !ContextVK::Cast(*context_).GetConcurrentWorkerTaskRunner()) {
+    return;
   }
-
-  return MakeSharedVK(std::move(framebuffer));
+  records_commands_in_parallel_ = true;
+  RenderPass::ReserveCommands(command_count);
 }
 
 // |RenderPass|
 void RenderPassVK::SetPipeline(
     const std::shared_ptr<Pipeline<PipelineDescriptor>>& pipeline) {
+  if (records_commands_in_parallel_) {
+    RenderPass::SetPipeline(pipeline);
+    return;
+  }
   pipeline_ = pipeline.get();
   if (!pipeline_) {
     return;
@@ -328,7 +349,12 @@ void RenderPassVK::SetPipeline(
 
 // |RenderPass|
 void RenderPassVK::SetCommandLabel(std::string_view label) {
+  if (records_commands_in_parallel_) {
+    RenderPass::SetCommandLabel(label);
+    return;
+  }
 #ifdef IMPELLER_DEBUG
+  BeginRenderPass(vk::SubpassContents::eInline);
   command_buffer_->GetEncoder()->PushDebugGroup(label);
   has_label_ = true;
 #endif  // IMPELLER_DEBUG
@@ -336,17 +362,31 @@ void RenderPassVK::SetCommandLabel(std::string_view label) {
 
 // |RenderPass|
 void RenderPassVK::SetStencilReference(uint32_t value) {
+  if (records_commands_in_parallel_) {
+    RenderPass::SetStencilReference(value);
+    return;
+  }
+  BeginRenderPass(vk::SubpassContents::eInline);
   command_buffer_vk_.setStencilReference(
       vk::StencilFaceFlagBits::eVkStencilFrontAndBack, value);
 }
 
 // |RenderPass|
 void RenderPassVK::SetBaseVertex(uint64_t value) {
+  if (records_commands_in_parallel_) {
+    RenderPass::SetBaseVertex(value);
+    return;
+  }
   base_vertex_ = value;
 }
 
 // |RenderPass|
 void RenderPassVK::SetViewport(Viewport viewport) {
+  if (records_commands_in_parallel_) {
+    RenderPass::SetViewport(viewport);
+    return;
+  }
+  BeginRenderPass(vk::SubpassContents::eInline);
   vk::Viewport viewport_vk = vk::Viewport()
                                  .setWidth(viewport.rect.GetWidth())
                                  .setHeight(-viewport.rect.GetHeight())
@@ -358,6 +398,11 @@ void RenderPassVK::SetViewport(Viewport viewport) {
 
 // |RenderPass|
 void RenderPassVK::SetScissor(IRect scissor) {
+  if (records_commands_in_parallel_) {
+    RenderPass::SetScissor(scissor);
+    return;
+  }
+  BeginRenderPass(vk::SubpassContents::eInline);
   vk::Rect2D scissor_vk =
       vk::Rect2D()
           .setOffset(vk::Offset2D(scissor.GetX(), scissor.GetY()))
@@ -367,11 +412,19 @@ void RenderPassVK::SetScissor(IRect scissor) {
 
 // |RenderPass|
 void RenderPassVK::SetInstanceCount(size_t count) {
+  if (records_commands_in_parallel_) {
+    RenderPass::SetInstanceCount(count);
+    return;
+  }
   instance_count_ = count;
 }
 
 // |RenderPass|
 bool RenderPassVK::SetVertexBuffer(VertexBuffer buffer) {
+  if (records_commands_in_parallel_) {
+    return RenderPass::SetVertexBuffer(std::move(buffer));
+  }
+  BeginRenderPass(vk::SubpassContents::eInline);
   vertex_count_ = buffer.vertex_count;
   if (buffer.index_type == IndexType::kUnknown || !buffer.vertex_buffer) {
     return false;
@@ -423,10 +476,14 @@ bool RenderPassVK::SetVertexBuffer(VertexBuffer buffer) {
 
 // |RenderPass|
 fml::Status RenderPassVK::Draw() {
+  if (records_commands_in_parallel_) {
+    return RenderPass::Draw();
+  }
   if (!pipeline_) {
     return fml::Status(fml::StatusCode::kCancelled,
                        "No valid pipeline is bound to the RenderPass.");
   }
+  BeginRenderPass(vk::SubpassContents::eInline);
 
   //----------------------------------------------------------------------------
   /// If there are immutable samplers referenced in the render pass, the base
@@ -460,35 +517,42 @@ fml::Status RenderPassVK::Draw() {
   const auto& context_vk = ContextVK::Cast(*context_);
   const auto& pipeline_vk = PipelineVK::Cast(*pipeline_);
 
-  auto descriptor_result =
-      command_buffer_->GetEncoder()->AllocateDescriptorSets(
-          pipeline_vk.GetDescriptorSetLayout(), context_vk);
-  if (!descriptor_result.ok()) {
-    return fml::Status(fml::StatusCode::kAborted,
-                       "Could not allocate descriptor sets.");
-  }
-  const auto descriptor_set = descriptor_result.value();
   const auto pipeline_layout = pipeline_vk.GetPipelineLayout();
   command_buffer_vk_.bindPipeline(vk::PipelineBindPoint::eGraphics,
                                   pipeline_vk.GetPipeline());
 
-  for (auto i = 0u; i < descriptor_write_offset_; i++) {
-    write_workspace_[i].dstSet = descriptor_set;
+  if (pipeline_vk.UsesPushDescriptors()) {
+    command_buffer_vk_.pushDescriptorSetKHR(
+        vk::PipelineBindPoint::eGraphics,  // bind point
+        pipeline_layout,                   // layout
+        0,                                 // set
+        descriptor_write_offset_,          // write count
+        write_workspace_.data()            // writes
+    );
+    command_buffer_->GetEncoder()->RecordPushedDescriptorSet();
+  } else {
+    // Consecutive draws frequently bind identical resources. The encoder hands
+    // out the same set for those instead of allocating and updating another.
+    auto descriptor_result = command_buffer_->GetEncoder()->GetDescriptorSet(
+        pipeline_vk.GetDescriptorSetLayout(), write_workspace_.data(),
+        descriptor_write_offset_, context_vk);
+    if (!descriptor_result.ok()) {
+      return fml::Status(fml::StatusCode::kAborted,
+                         "Could not allocate descriptor sets.");
+    }
+    const auto descriptor_set = descriptor_result.value();
+
+    command_buffer_vk_.bindDescriptorSets(
+        vk::PipelineBindPoint::eGraphics,  // bind point
+        pipeline_layout,                   // layout
+        0,                                 // first set
+        1,                                 // set count
+        &descriptor_set,                   // sets
+        0,                                 // offset count
+        nullptr                            // offsets
+    );
   }
 
-  context_vk.GetDevice().updateDescriptorSets(descriptor_write_offset_,
-                                              write_workspace_.data(), 0u, {});
-
-  command_buffer_vk_.bindDescriptorSets(
-      vk::PipelineBindPoint::eGraphics,  // bind point
-      pipeline_layout,                   // layout
-      0,                                 // first set
-      1,                                 // set count
-      &descriptor_set,                   // sets
-      0,                                 // offset count
-      nullptr                            // offsets
-  );
-
   if (pipeline_uses_input_attachments_) {
     InsertBarrierForInputAttachmentRead(
         command_buffer_vk_, TextureVK::Cast(*color_image_vk_).GetImage());
@@ -535,6 +599,10 @@ bool RenderPassVK::BindResource(ShaderStage stage,
                                 const ShaderUniformSlot& slot,
                                 const ShaderMetadata& metadata,
                                 BufferView view) {
+  if (records_commands_in_parallel_) {
+    return RenderPass::BindResource(stage, type, slot, metadata,
+                                    std::move(view));
+  }
   return BindResource(slot.binding, type, view);
 }
 
@@ -544,6 +612,10 @@ bool RenderPassVK::BindResource(
     const ShaderUniformSlot& slot,
     const std::shared_ptr<const ShaderMetadata>& metadata,
     BufferView view) {
+  if (records_commands_in_parallel_) {
+    return RenderPass::BindResource(stage, type, slot, metadata,
+                                    std::move(view));
+  }
   return BindResource(slot.binding, type, view);
 }
 
@@ -588,6 +660,10 @@ bool RenderPassVK::BindResource(ShaderStage stage,
                                 const ShaderMetadata& metadata,
                                 std::shared_ptr<const Texture> texture,
                                 const std::unique_ptr<const Sampler>& sampler) {
+  if (records_commands_in_parallel_) {
+    return RenderPass::BindResource(stage, type, slot, metadata,
+                                    std::move(texture), sampler);
+  }
   if (bound_buffer_offset_ >= kMaxBindings) {
     return false;
   }
@@ -621,7 +697,407 @@ bool RenderPassVK::BindResource(ShaderStage stage,
   return true;
 }
 
+namespace {
+
+// The descriptors of a single command recorded into a secondary command
+// buffer.
+struct CommandDescriptorsVK {
+  std::array<vk::DescriptorImageInfo, kMaxBindings> image_infos;
+  std::array<vk::DescriptorBufferInfo, kMaxBindings> buffer_infos;
+  std::array<vk::WriteDescriptorSet, kMaxBindings + kMaxBindings> writes;
+  size_t image_count = 0u;
+  size_t buffer_count = 0u;
+  size_t write_count = 0u;
+};
+
+// The state shared by the threads recording the secondary command buffers of
+// a render pass.
+struct ParallelRecordingVK {
+  explicit ParallelRecordingVK(size_t chunk_count)
+      : secondaries(chunk_count), latch(chunk_count) {}
+
+  std::atomic_size_t next_chunk = 0u;
+  std::atomic_bool failed = false;
+  // Each element is only written by the thread that claimed its chunk.
+  std::vector<std::shared_ptr<TrackedObjectsVK>> secondaries;
+  fml::CountDownLatch latch;
+};
+
+}  // namespace
+
+// Commands only record the slots of buffers, the descriptor type comes from
+// the layout of the pipeline.
+static vk::DescriptorType GetBufferDescriptorType(const PipelineVK& pipeline,
+                                                  uint32_t binding) {
+  const auto& layouts =
+      pipeline.GetDescriptor().GetVertexDescriptor()->GetDescriptorSetLayouts();
+  for (const auto& layout : layouts) {
+    if (layout.binding == binding) {
+      return ToVKDescriptorType(layout.descriptor_type);
+    }
+  }
+  return vk::DescriptorType::eUniformBuffer;
+}
+
+static bool AddBufferDescriptor(CommandDescriptorsVK& descriptors,
+                                TrackedObjectsVK& tracked_objects,
+                                const PipelineVK& pipeline,
+                                const BufferAndUniformSlot& binding) {
+  if (descriptors.buffer_count >= kMaxBindings) {
+    return false;
+  }
+  const BufferView& view = binding.view.resource;
+  if (!view.buffer) {
+    return false;
+  }
+  auto buffer = DeviceBufferVK::Cast(*view.buffer).GetBuffer();
+  if (!buffer) {
+    return false;
+  }
+  tracked_objects.Track(view.buffer);
+
+  vk::DescriptorBufferInfo& buffer_info =
+      descriptors.buffer_infos[descriptors.buffer_count++];
+  buffer_info.buffer = buffer;
+  buffer_info.offset = view.range.offset;
+  buffer_info.range = view.range.length;
+
+  vk::WriteDescriptorSet write_set;
+  write_set.dstBinding = binding.slot.binding;
+  write_set.descriptorCount = 1u;
+  write_set.descriptorType =
+      GetBufferDescriptorType(pipeline, binding.slot.binding);
+  write_set.pBufferInfo = &buffer_info;
+  descriptors.writes[descriptors.write_count++] = write_set;
+  return true;
+}
+
+static bool AddImageDescriptor(CommandDescriptorsVK& descriptors,
+                               TrackedObjectsVK& tracked_objects,
+                               const TextureAndSampler& binding) {
+  if (descriptors.image_count >= kMaxBindings) {
+    return false;
+  }
+  const std::shared_ptr<const Texture>& texture = binding.texture.resource;
+  if (!texture || !texture->IsValid() || !binding.sampler) {
+    return false;
+  }
+  const TextureVK& texture_vk = TextureVK::Cast(*texture);
+  tracked_objects.Track(texture_vk.GetTextureSource());
+
+  vk::DescriptorImageInfo& image_info =
+      descriptors.image_infos[descriptors.image_count++];
+  image_info.imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+  image_info.sampler = SamplerVK::Cast(*binding.sampler).GetSampler();
+  image_info.imageView = texture_vk.GetImageView();
+
+  vk::WriteDescriptorSet write_set;
+  write_set.dstBinding = binding.slot.binding;
+  write_set.descriptorCount = 1u;
+  write_set.descriptorType = vk::DescriptorType::eCombinedImageSampler;
+  write_set.pImageInfo = &image_info;
+  descriptors.writes[descriptors.write_count++] = write_set;
+  return true;
+}
+
+// Records a command collected by a pass that records in parallel. This is the
+// equivalent of the immediate mode |RenderPassVK| calls for a draw.
+static bool EncodeCommand(const ContextVK& context_vk,
+                          const Command& command,
+                          TrackedObjectsVK& tracked_objects,
+                          CommandDescriptorsVK& descriptors,
+                          const TextureVK& color_image,
+                          const ISize& target_size) {
+  vk::CommandBuffer cmd = tracked_objects.GetCommandBuffer();
+  descriptors.image_count = 0u;
+  descriptors.buffer_count = 0u;
+  descriptors.write_count = 0u;
+
+  const PipelineVK* pipeline = &PipelineVK::Cast(*command.pipeline);
+  std::shared_ptr<SamplerVK> immutable_sampler;
+  for (const Bindings* bindings :
+       {&command.vertex_bindings, &command.fragment_bindings}) {
+    for (const TextureAndSampler& image : bindings->sampled_images) {
+      if (!AddImageDescriptor(descriptors, tracked_objects, image)) {
+        return false;
+      }
+      if (!immutable_sampler) {
+        immutable_sampler =
+            TextureVK::Cast(*image.texture.resource)
+                .GetImmutableSamplerVariant(SamplerVK::Cast(*image.sampler));
+      }
+    }
+    for (const BufferAndUniformSlot& buffer : bindings->buffers) {
+      if (!AddBufferDescriptor(descriptors, tracked_objects, *pipeline,
+                               buffer)) {
+        return false;
+      }
+    }
+  }
+
+  // See |RenderPassVK::Draw|.
+  std::shared_ptr<PipelineVK> pipeline_variant;
+  if (immutable_sampler) {
+    pipeline_variant =
+        pipeline->CreateVariantForImmutableSamplers(immutable_sampler);
+    if (!pipeline_variant) {
+      return false;
+    }
+    pipeline = pipeline_variant.get();
+  }
+
+  const bool uses_input_attachments =
+      pipeline->GetDescriptor().GetVertexDescriptor()->UsesInputAttacments();
+  if (uses_input_attachments) {
+    if (descriptors.image_count >= kMaxBindings) {
+      return false;
+    }
+    vk::DescriptorImageInfo& image_info =
+        descriptors.image_infos[descriptors.image_count++];
+    image_info.imageLayout = vk::ImageLayout::eGeneral;
+    image_info.sampler = VK_NULL_HANDLE;
+    image_info.imageView = color_image.GetImageView();
+
+    vk::WriteDescriptorSet write_set;
+    write_set.dstBinding = kMagicSubpassInputBinding;
+    write_set.descriptorCount = 1u;
+    write_set.descriptorType = vk::DescriptorType::eInputAttachment;
+    write_set.pImageInfo = &image_info;
+    descriptors.writes[descriptors.write_count++] = write_set;
+  }
+
+  cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline->GetPipeline());
+
+  const Viewport viewport = command.viewport.value_or(
+      Viewport{.rect = Rect::MakeSize(target_size)});
+  vk::Viewport viewport_vk = vk::Viewport()
+                                 .setWidth(viewport.rect.GetWidth())
+                                 .setHeight(-viewport.rect.GetHeight())
+                                 .setY(viewport.rect.GetHeight())
+                                 .setMinDepth(0.0f)
+                                 .setMaxDepth(1.0f);
+  cmd.setViewport(0, 1, &viewport_vk);
+
+  const IRect scissor =
+      command.scissor.value_or(IRect::MakeSize(target_size));
+  vk::Rect2D scissor_vk =
+      vk::Rect2D()
+          .setOffset(vk::Offset2D(scissor.GetX(), scissor.GetY()))
+          .setExtent(vk::Extent2D(scissor.GetWidth(), scissor.GetHeight()));
+  cmd.setScissor(0, 1, &scissor_vk);
+
+  cmd.setStencilReference(vk::StencilFaceFlagBits::eVkStencilFrontAndBack,
+                          command.stencil_reference);
+
+  const VertexBuffer& vertex_buffer = command.vertex_buffer;
+  if (vertex_buffer.index_type == IndexType::kUnknown || !vertex_buffer) {
+    return false;
+  }
+  tracked_objects.Track(vertex_buffer.vertex_buffer.buffer);
+  vk::Buffer vertex_buffer_handle =
+      DeviceBufferVK::Cast(*vertex_buffer.vertex_buffer.buffer).GetBuffer();
+  vk::DeviceSize vertex_buffer_offset =
+      vertex_buffer.vertex_buffer.range.offset;
+  cmd.bindVertexBuffers(0u, 1u, &vertex_buffer_handle, &vertex_buffer_offset);
+
+  const bool has_index_buffer = vertex_buffer.index_type != IndexType::kNone;
+  if (has_index_buffer) {
+    const BufferView& index_buffer_view = vertex_buffer.index_buffer;
+    tracked_objects.Track(index_buffer_view.buffer);
+    cmd.bindIndexBuffer(
+        DeviceBufferVK::Cast(*index_buffer_view.buffer).GetBuffer(),
+        index_buffer_view.range.offset,
+        ToVKIndexType(vertex_buffer.index_type));
+  }
+
+  const auto pipeline_layout = pipeline->GetPipelineLayout();
+  if (pipeline->UsesPushDescriptors()) {
+    cmd.pushDescriptorSetKHR(vk::PipelineBindPoint::eGraphics,  // bind point
+                             pipeline_layout,                   // layout
+                             0,                                 // set
+                             descriptors.write_count,           // write count
+                             descriptors.writes.data()          // writes
+    );
+    tracked_objects.GetDescriptorPool().RecordPushedDescriptorSet();
+  } else {
+    auto descriptor_result =
+        tracked_objects.GetDescriptorPool().GetDescriptorSet(
+            pipeline->GetDescriptorSetLayout(), descriptors.writes.data(),
+            descriptors.write_count, context_vk);
+    if (!descriptor_result.ok()) {
+      return false;
+    }
+    const auto descriptor_set = descriptor_result.value();
+    cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,  // bind point
+                           pipeline_layout,                   // layout
+                           0,                                 // first set
+                           1,                                 // set count
+                           &descriptor_set,                   // sets
+                           0,                                 // offset count
+                           nullptr                            // offsets
+    );
+  }
+
+  if (uses_input_attachments) {
+    InsertBarrierForInputAttachmentRead(cmd, color_image.GetImage());
+  }
+
+  if (has_index_buffer) {
+    cmd.drawIndexed(vertex_buffer.vertex_count,  // index count
+                    command.instance_count,      // instance count
+                    0u,                          // first index
+                    command.base_vertex,         // vertex offset
+                    0u                           // first instance
+    );
+  } else {
+    cmd.draw(vertex_buffer.vertex_count,  // vertex count
+             command.instance_count,      // instance count
+             command.base_vertex,         // vertex offset
+             0u                           // first instance
+    );
+  }
+  return true;
+}
+
+static std::shared_ptr<TrackedObjectsVK> RecordSecondaryCommandBuffer(
+    const std::shared_ptr<const ContextVK>& context_vk,
+    const vk::CommandBufferInheritanceInfo& inheritance_info,
+    const Command* commands,
+    size_t command_count,
+    const TextureVK& color_image,
+    const ISize& target_size) {
+  TRACE_EVENT0("impeller", "RecordSecondaryCommandBuffer");
+  auto recycler = context_vk->GetCommandPoolRecycler();
+  if (!recycler) {
+    return nullptr;
+  }
+  // Uses the command pool of the current thread, so that threads can record
+  // without synchronizing with each other.
+  auto secondary = std::make_shared<TrackedObjectsVK>(
+      context_vk, recycler->Get(), nullptr, vk::CommandBufferLevel::eSecondary);
+  if (!secondary->IsValid()) {
+    return nullptr;
+  }
+
+  vk::CommandBuffer cmd = secondary->GetCommandBuffer();
+  vk::CommandBufferBeginInfo begin_info;
+  begin_info.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit |
+                     vk::CommandBufferUsageFlagBits::eRenderPassContinue;
+  begin_info.setPInheritanceInfo(&inheritance_info);
+  if (cmd.begin(begin_info) != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not begin secondary command buffer.";
+    return nullptr;
+  }
+
+  CommandDescriptorsVK descriptors;
+  for (size_t i = 0; i < command_count; i++) {
+    if (!EncodeCommand(*context_vk, commands[i], *secondary, descriptors,
+                       color_image, target_size)) {
+      VALIDATION_LOG << "Could not encode command into secondary command "
+                        "buffer.";
+      return nullptr;
+    }
+  }
+
+  if (cmd.end() != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not end secondary command buffer.";
+    return nullptr;
+  }
+  return secondary;
+}
+
+bool RenderPassVK::RecordCommandsInParallel(
+    const ContextVK& context_vk) const {
+  TRACE_EVENT0("impeller", "RenderPassVK::RecordCommandsInParallel");
+  const size_t command_count = commands_.size();
+  const size_t chunk_count =
+      (command_count + kCommandsPerSecondaryCommandBuffer - 1) /
+      kCommandsPerSecondaryCommandBuffer;
+
+  vk::CommandBufferInheritanceInfo inheritance_info;
+  inheritance_info.renderPass = *render_pass_;
+  inheritance_info.subpass = 0u;
+  inheritance_info.framebuffer = *framebuffer_;
+
+  // Chunks are claimed in order by whichever thread gets to them first. The
+  // calling thread records chunks as well, so the pass is encoded even if all
+  // workers are busy. Tasks that run after all chunks were claimed return
+  // without touching the pass.
+  auto recording = std::make_shared<ParallelRecordingVK>(chunk_count);
+  std::weak_ptr<const ContextVK> weak_context =
+      std::static_pointer_cast<const ContextVK>(context_);
+  auto record_chunks = [recording, weak_context, inheritance_info,
+                        commands = commands_.data(), command_count,
+                        color_image = color_image_vk_,
+                        target_size = render_target_.GetRenderTargetSize()]() {
+    size_t chunk = 0u;
+    while ((chunk = recording->next_chunk.fetch_add(1u)) <
+           recording->secondaries.size()) {
+      {
+        auto context = weak_context.lock();
+        const size_t offset = chunk * kCommandsPerSecondaryCommandBuffer;
+        auto secondary =
+            context ? RecordSecondaryCommandBuffer(
+                          context, inheritance_info, commands + offset,
+                          std::min(kCommandsPerSecondaryCommandBuffer,
+                                   command_count - offset),
+                          TextureVK::Cast(*color_image), target_size)
+                    : nullptr;
+        if (!secondary) {
+          recording->failed = true;
+        }
+        recording->secondaries[chunk] = std::move(secondary);
+      }
+      recording->latch.CountDown();
+    }
+  };
+
+  const auto& worker_task_runner = context_vk.GetConcurrentWorkerTaskRunner();
+  std::weak_ptr<CommandPoolRecyclerVK> weak_recycler =
+      context_vk.GetCommandPoolRecycler();
+  const size_t worker_count = std::min<size_t>(
+      chunk_count - 1u, std::thread::hardware_concurrency());
+  for (size_t i = 0; i < worker_count; i++) {
+    worker_task_runner->PostTask([record_chunks, weak_recycler]() {
+      record_chunks();
+      // Let the command pool of this thread be recycled once the recorded
+      // command buffers are done executing, like the pools of threads that
+      // dispose of them at the end of each frame.
+      if (auto recycler = weak_recycler.lock()) {
+        recycler->Dispose();
+      }
+    });
+  }
+  record_chunks();
+  recording->latch.Wait();
+
+  if (recording->failed) {
+    VALIDATION_LOG << "Could not record secondary command buffers.";
+    return false;
+  }
+
+  BeginRenderPass(vk::SubpassContents::eSecondaryCommandBuffers);
+  const std::shared_ptr<CommandEncoderVK>& encoder =
+      command_buffer_->GetEncoder();
+  std::vector<vk::CommandBuffer> secondary_buffers;
+  secondary_buffers.reserve(chunk_count);
+  for (auto& secondary : recording->secondaries) {
+    secondary_buffers.push_back(secondary->GetCommandBuffer());
+    if (!encoder->Track(std::move(secondary))) {
+      return false;
+    }
+  }
+  command_buffer_vk_.executeCommands(secondary_buffers);
+  return true;
+}
+
 bool RenderPassVK::OnEncodeCommands(const Context& context) const {
+  if (records_commands_in_parallel_ && !commands_.empty() &&
+      !RecordCommandsInParallel(ContextVK::Cast(context))) {
+    return false;
+  }
+  // Passes without any commands are begun here to clear their attachments.
+  BeginRenderPass(vk::SubpassContents::eInline);
   command_buffer_->GetEncoder()->GetCommandBuffer().endRenderPass();
 
   // If this render target will be consumed by a subsequent render pass,
@@ -641,9 +1117,11 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
 
     barrier.new_layout = vk::ImageLayout::eShaderReadOnlyOptimal;
 
-    if (!TextureVK::Cast(*result_texture).SetLayout(barrier)) {
+    BarrierBatchVK batch;
+    if (!TextureVK::Cast(*result_texture).SetLayout(barrier, batch)) {
       return false;
     }
+    command_buffer_->GetEncoder()->EncodeBarriers(batch);
   }
 
   return true;
@@ -21,16 +21,38 @@ class SamplerVK;
 
 class RenderPassVK final : public RenderPass {
  public:
+  /// Passes expected to contain at least this many commands record them into
+  /// secondary command buffers on the concurrent worker task runner.
+  static constexpr size_t kMinCommandsForParallelRecording = 256u;
+
+  /// The number of commands recorded into each secondary command buffer.
+  static constexpr size_t kCommandsPerSecondaryCommandBuffer = 64u;
+
   // |RenderPass|
   ~RenderPassVK() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the commands of this pass are collected and recorded
+  ///             into secondary command buffers in parallel when the pass is
+  ///             encoded, instead of being recorded into the primary command
+  ///             buffer as they are added.
+  ///
+  ///             Decided by the first call to |ReserveCommands|.
+  ///
+  bool RecordsCommandsInParallel() const;
+
  private:
   friend class CommandBufferVK;
 
   std::shared_ptr<CommandBufferVK> command_buffer_;
   std::string debug_label_;
   SharedHandleVK<vk::RenderPass> render_pass_;
+  SharedHandleVK<vk::Framebuffer> framebuffer_;
   bool is_valid_ = false;
+  bool records_commands_in_parallel_ = false;
+  // The render pass is begun lazily, once it is known whether its contents
+  // are inline or in secondary command buffers.
+  mutable bool has_begun_render_pass_ = false;
 
   vk::CommandBuffer command_buffer_vk_;
   std::shared_ptr<Texture> color_image_vk_;
@@ -49,7 +71,7 @@ class RenderPassVK final : public RenderPass {
   size_t vertex_count_ = 0u;
   bool has_index_buffer_ = false;
   bool has_label_ = false;
-  const Pipeline<PipelineDescriptor>* pipeline_;
+  const Pipeline<PipelineDescriptor>* pipeline_ = nullptr;
   bool pipeline_uses_input_attachments_ = false;
   std::shared_ptr<SamplerVK> immutable_sampler_;
 
@@ -86,7 +108,7 @@ class RenderPassVK final : public RenderPass {
   fml::Status Draw() override;
 
   // |RenderPass|
-  void ReserveCommands(size_t command_count) override {}
+  void ReserveCommands(size_t command_count) override;
 
   // |ResourceBinder|
   bool BindResource(ShaderStage stage,
@@ -123,6 +145,10 @@ class RenderPassVK final : public RenderPass {
   // |RenderPass|
   bool OnEncodeCommands(const Context& context) const override;
 
+  void BeginRenderPass(vk::SubpassContents contents) const;
+
+  bool RecordCommandsInParallel(const ContextVK& context_vk) const;
+
   SharedHandleVK<vk::RenderPass> CreateVKRenderPass(
       const ContextVK& context,
       const SharedHandleVK<vk::RenderPass>& recycled_renderpass,
@@ -130,7 +156,7 @@ class RenderPassVK final : public RenderPass {
 
   SharedHandleVK<vk::Framebuffer> CreateVKFramebuffer(
       const ContextVK& context,
-      const vk::RenderPass& pass) const;
+      const SharedHandleVK<vk::RenderPass>& pass) const;
 
   RenderPassVK(const RenderPassVK&) = delete;
 
@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "impeller/renderer/backend/vulkan/render_pass_cache_vk.h"
+#include "impeller/renderer/backend/vulkan/render_pass_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+
+// Measures the CPU cost of recording render passes with the given number of
+// draws, either directly into the primary command buffer or into secondary
+// command buffers on the concurrent worker threads. The driver is mocked, so
+// only the cost of encoding on the side of Impeller is measured.
+static void BM_RenderPassVKEncode(benchmark::State& state,  // NOLINT
+                                  bool parallel) {
+  auto context = testing::MockVulkanContextBuilder().Build();
+  PipelineDescriptor pipeline_desc;
+  pipeline_desc.SetVertexDescriptor(std::make_shared<VertexDescriptor>());
+  auto pipeline =
+      context->GetPipelineLibrary()->GetPipeline(pipeline_desc).Get();
+  auto vertex_buffer = context->GetResourceAllocator()->CreateBuffer(
+      DeviceBufferDescriptor{
+          .storage_mode = StorageMode::kHostVisible,
+          .size = 1024,
+      });
+  auto render_target =
+      RenderTargetAllocator(context->GetResourceAllocator())
+          .CreateOffscreen(*context, {100, 100}, /*mip_count=*/1);
+  if (!pipeline || !vertex_buffer) {
+    state.SkipWithError("Could not create the pipeline or vertex buffer.");
+    return;
+  }
+
+  const size_t draw_count = state.range(0);
+  for (auto _ : state) {
+    auto buffer = context->CreateCommandBuffer();
+    auto render_pass = buffer->CreateRenderPass(render_target);
+    // Passes only record in parallel when they reserve enough commands up
+    // front.
+    render_pass->ReserveCommands(
+        parallel ? std::max(draw_count,
+                            RenderPassVK::kMinCommandsForParallelRecording)
+                 : 0u);
+    for (size_t i = 0; i < draw_count; i++) {
+      render_pass->SetPipeline(pipeline);
+      render_pass->SetVertexBuffer(VertexBuffer{
+          .vertex_buffer = {.buffer = vertex_buffer, .range = Range(0, 36)},
+          .vertex_count = 3u,
+          .index_type = IndexType::kNone,
+      });
+      render_pass->Draw();
+    }
+    render_pass->EncodeCommands();
+  }
+  state.SetItemsProcessed(state.iterations() * draw_count);
+}
+
+BENCHMARK_CAPTURE(BM_RenderPassVKEncode, Inline, /*parallel=*/false)
+    ->RangeMultiplier(4)
+    ->Range(64, 16384);
+BENCHMARK_CAPTURE(BM_RenderPassVKEncode, Parallel, /*parallel=*/true)
+    ->RangeMultiplier(4)
+    ->Range(64, 16384);
+
+// Measures the CPU cost of setting up render passes for a number of offscreen
+// render targets, with the render pass and framebuffer objects of these either
+// found in the cache of the context or created for each pass.
+static void BM_RenderPassVKSetup(benchmark::State& state,  // NOLINT
+                                 bool cached) {
+  auto context = testing::MockVulkanContextBuilder().Build();
+  RenderTargetAllocator allocator(context->GetResourceAllocator());
+  std::vector<RenderTarget> render_targets;
+  for (auto i = 0; i < state.range(0); i++) {
+    render_targets.push_back(
+        allocator.CreateOffscreen(*context, {100, 100}, /*mip_count=*/1));
+  }
+
+  for (auto _ : state) {
+    if (!cached) {
+      state.PauseTiming();
+      context->GetRenderPassCache()->Clear();
+      state.ResumeTiming();
+    }
+    auto buffer = context->CreateCommandBuffer();
+    for (const auto& render_target : render_targets) {
+      auto render_pass = buffer->CreateRenderPass(render_target);
+      render_pass->EncodeCommands();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * render_targets.size());
+}
+
+BENCHMARK_CAPTURE(BM_RenderPassVKSetup, Uncached, /*cached=*/false)
+    ->RangeMultiplier(4)
+    ->Range(1, 64);
+BENCHMARK_CAPTURE(BM_RenderPassVKSetup, Cached, /*cached=*/true)
+    ->RangeMultiplier(4)
+    ->Range(1, 64);
+
+}  // namespace impeller
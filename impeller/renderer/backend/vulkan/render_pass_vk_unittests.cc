@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/vulkan/render_pass_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+struct RenderPassVKFixture {
+  std::shared_ptr<ContextVK> context = MockVulkanContextBuilder().Build();
+  std::shared_ptr<Pipeline<PipelineDescriptor>> pipeline;
+  std::shared_ptr<DeviceBuffer> vertex_buffer;
+  RenderTarget render_target;
+
+  RenderPassVKFixture() {
+    PipelineDescriptor pipeline_desc;
+    pipeline_desc.SetVertexDescriptor(std::make_shared<VertexDescriptor>());
+    pipeline = context->GetPipelineLibrary()->GetPipeline(pipeline_desc).Get();
+    vertex_buffer = context->GetResourceAllocator()->CreateBuffer(
+        DeviceBufferDescriptor{
+            .storage_mode = StorageMode::kHostVisible,
+            .size = 1024,
+        });
+    render_target =
+        RenderTargetAllocator(context->GetResourceAllocator())
+            .CreateOffscreen(*context, {100, 100}, /*mip_count=*/1);
+  }
+
+  void RecordDraws(RenderPass& pass, size_t draw_count) const {
+    for (size_t i = 0; i < draw_count; i++) {
+      pass.SetPipeline(pipeline);
+      pass.SetVertexBuffer(VertexBuffer{
+          .vertex_buffer = {.buffer = vertex_buffer, .range = Range(0, 36)},
+          .vertex_count = 3u,
+          .index_type = IndexType::kNone,
+      });
+      EXPECT_TRUE(pass.Draw().ok());
+    }
+  }
+};
+
+size_t CountCalls(const std::vector<std::string>& functions,
+                  const std::string& name) {
+  return std::count(functions.begin(), functions.end(), name);
+}
+
+}  // namespace
+
+TEST(RenderPassVKTest, RecordsSmallPassesInline) {
+  RenderPassVKFixture fixture;
+  ASSERT_TRUE(fixture.pipeline);
+
+  auto buffer = fixture.context->CreateCommandBuffer();
+  auto render_pass = buffer->CreateRenderPass(fixture.render_target);
+  render_pass->ReserveCommands(
+      RenderPassVK::kMinCommandsForParallelRecording - 1u);
+  EXPECT_FALSE(
+      static_cast<RenderPassVK&>(*render_pass).RecordsCommandsInParallel());
+
+  fixture.RecordDraws(*render_pass, 4u);
+  EXPECT_TRUE(render_pass->EncodeCommands());
+
+  auto functions = GetMockVulkanFunctions(fixture.context->GetDevice());
+  EXPECT_EQ(CountCalls(*functions, "vkCmdBindPipeline"), 4u);
+  EXPECT_EQ(CountCalls(*functions, "vkCmdExecuteCommands"), 0u);
+}
+
+TEST(RenderPassVKTest, RecordsLargePassesIntoSecondaryCommandBuffers) {
+  RenderPassVKFixture fixture;
+  ASSERT_TRUE(fixture.pipeline);
+
+  auto buffer = fixture.context->CreateCommandBuffer();
+  auto render_pass = buffer->CreateRenderPass(fixture.render_target);
+  const size_t draw_count = RenderPassVK::kMinCommandsForParallelRecording;
+  render_pass->ReserveCommands(draw_count);
+  EXPECT_TRUE(
+      static_cast<RenderPassVK&>(*render_pass).RecordsCommandsInParallel());
+
+  // Nothing is recorded until the pass is encoded.
+  fixture.RecordDraws(*render_pass, draw_count);
+  auto functions = GetMockVulkanFunctions(fixture.context->GetDevice());
+  EXPECT_EQ(CountCalls(*functions, "vkCmdBindPipeline"), 0u);
+
+  EXPECT_TRUE(render_pass->EncodeCommands());
+  functions = GetMockVulkanFunctions(fixture.context->GetDevice());
+  EXPECT_EQ(CountCalls(*functions, "vkCmdBindPipeline"), draw_count);
+  EXPECT_EQ(CountCalls(*functions, "vkCmdExecuteCommands"), 1u);
+}
+
+TEST(RenderPassVKTest, DoesNotRecordInParallelOnceRecordingStarted) {
+  RenderPassVKFixture fixture;
+  ASSERT_TRUE(fixture.pipeline);
+
+  auto buffer = fixture.context->CreateCommandBuffer();
+  auto render_pass = buffer->CreateRenderPass(fixture.render_target);
+  fixture.RecordDraws(*render_pass, 1u);
+  render_pass->ReserveCommands(
+      RenderPassVK::kMinCommandsForParallelRecording);
+  EXPECT_FALSE(
+      static_cast<RenderPassVK&>(*render_pass).RecordsCommandsInParallel());
+  EXPECT_TRUE(render_pass->EncodeCommands());
+}
+
+}  // namespace testing
+}  // namespace impeller
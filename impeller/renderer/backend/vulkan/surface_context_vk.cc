@@ -5,6 +5,8 @@
 #include "impeller/renderer/backend/vulkan/surface_context_vk.h"
 
 #include "flutter/fml/trace_event.h"
+#include "impeller/renderer/backend/vulkan/allocator_vk.h"
+#include "impeller/renderer/backend/vulkan/barrier_vk.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/swapchain/khr/khr_swapchain_vk.h"
@@ -87,7 +89,11 @@ std::unique_ptr<Surface> SurfaceContextVK::AcquireNextSurface() {
         .DidAcquireSurfaceFrame();
   }
   parent_->GetCommandPoolRecycler()->Dispose();
-  parent_->GetResourceAllocator()->DebugTraceMemoryStatistics();
+  if (auto allocator = parent_->GetResourceAllocator()) {
+    AllocatorVK::Cast(*allocator).DidAcquireSurfaceFrame();
+    allocator->DebugTraceMemoryStatistics();
+  }
+  parent_->GetBarrierCounters()->TraceAndReset();
   return surface;
 }
 
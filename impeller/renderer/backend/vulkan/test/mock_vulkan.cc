@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
 
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <utility>
@@ -20,11 +21,13 @@ namespace testing {
 
 namespace {
 
+class MockDevice;
+
 struct MockCommandBuffer {
-  explicit MockCommandBuffer(
-      std::shared_ptr<std::vector<std::string>> called_functions)
-      : called_functions_(std::move(called_functions)) {}
-  std::shared_ptr<std::vector<std::string>> called_functions_;
+  explicit MockCommandBuffer(MockDevice* device) : device_(device) {}
+  // Command buffers may be recorded on multiple threads, so calls are
+  // recorded through the device.
+  MockDevice* device_;
 };
 
 struct MockQueryPool {};
@@ -42,7 +45,10 @@ struct MockSwapchainKHR {
   size_t current_image = 0;
 };
 
-struct MockSemaphore {};
+struct MockSemaphore {
+  // The value of timeline semaphores.
+  std::atomic<uint64_t> value = 0;
+};
 
 struct MockFramebuffer {};
 
@@ -53,7 +59,7 @@ class MockDevice final {
   explicit MockDevice() : called_functions_(new std::vector<std::string>()) {}
 
   MockCommandBuffer* NewCommandBuffer() {
-    auto buffer = std::make_unique<MockCommandBuffer>(called_functions_);
+    auto buffer = std::make_unique<MockCommandBuffer>(this);
     MockCommandBuffer* result = buffer.get();
     Lock lock(command_buffers_mutex_);
     command_buffers_.emplace_back(std::move(buffer));
@@ -178,33 +184,67 @@ void vkGetPhysicalDeviceProperties(VkPhysicalDevice physicalDevice,
   pProperties->limits.timestampPeriod = 1;
 }
 
+static thread_local std::vector<vk::QueueFamilyProperties> g_queue_families;
+
 void vkGetPhysicalDeviceQueueFamilyProperties(
     VkPhysicalDevice physicalDevice,
     uint32_t* pQueueFamilyPropertyCount,
     VkQueueFamilyProperties* pQueueFamilyProperties) {
   if (!pQueueFamilyProperties) {
-    *pQueueFamilyPropertyCount = 1;
+    *pQueueFamilyPropertyCount = g_queue_families.size();
   } else {
-    pQueueFamilyProperties[0].queueCount = 3;
-    pQueueFamilyProperties[0].queueFlags = static_cast<VkQueueFlags>(
-        VK_QUEUE_TRANSFER_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_GRAPHICS_BIT);
+    for (size_t i = 0; i < g_queue_families.size(); i++) {
+      pQueueFamilyProperties[i] = g_queue_families[i];
+    }
   }
 }
 
+static thread_local std::vector<std::string> g_device_extensions;
+
 VkResult vkEnumerateDeviceExtensionProperties(
     VkPhysicalDevice physicalDevice,
     const char* pLayerName,
     uint32_t* pPropertyCount,
     VkExtensionProperties* pProperties) {
   if (!pProperties) {
-    *pPropertyCount = 1;
+    *pPropertyCount = g_device_extensions.size();
   } else {
-    strcpy(pProperties[0].extensionName, "VK_KHR_swapchain");
-    pProperties[0].specVersion = 0;
+    uint32_t count = 0;
+    for (const std::string& ext : g_device_extensions) {
+      strncpy(pProperties[count].extensionName, ext.c_str(),
+              sizeof(VkExtensionProperties::extensionName));
+      pProperties[count].specVersion = 0;
+      count++;
+    }
   }
   return VK_SUCCESS;
 }
 
+void vkGetPhysicalDeviceFeatures2(VkPhysicalDevice physicalDevice,
+                                  VkPhysicalDeviceFeatures2* pFeatures) {
+  for (auto* next = static_cast<VkBaseOutStructure*>(pFeatures->pNext); next;
+       next = next->pNext) {
+    if (next->sType ==
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES) {
+      reinterpret_cast<VkPhysicalDeviceTimelineSemaphoreFeatures*>(next)
+          ->timelineSemaphore = VK_TRUE;
+    }
+  }
+}
+
+void vkGetPhysicalDeviceProperties2(VkPhysicalDevice physicalDevice,
+                                    VkPhysicalDeviceProperties2* pProperties) {
+  vkGetPhysicalDeviceProperties(physicalDevice, &pProperties->properties);
+  for (auto* next = static_cast<VkBaseOutStructure*>(pProperties->pNext); next;
+       next = next->pNext) {
+    if (next->sType ==
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR) {
+      reinterpret_cast<VkPhysicalDevicePushDescriptorPropertiesKHR*>(next)
+          ->maxPushDescriptors = 32;
+    }
+  }
+}
+
 VkResult vkCreateDevice(VkPhysicalDevice physicalDevice,
                         const VkDeviceCreateInfo* pCreateInfo,
                         const VkAllocationCallbacks* pAllocator,
@@ -272,8 +312,10 @@ VkResult vkAllocateCommandBuffers(
     VkCommandBuffer* pCommandBuffers) {
   MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
   mock_device->AddCalledFunction("vkAllocateCommandBuffers");
-  *pCommandBuffers =
-      reinterpret_cast<VkCommandBuffer>(mock_device->NewCommandBuffer());
+  for (uint32_t i = 0; i < pAllocateInfo->commandBufferCount; i++) {
+    pCommandBuffers[i] =
+        reinterpret_cast<VkCommandBuffer>(mock_device->NewCommandBuffer());
+  }
   return VK_SUCCESS;
 }
 
@@ -432,7 +474,7 @@ void vkCmdBindPipeline(VkCommandBuffer commandBuffer,
                        VkPipeline pipeline) {
   MockCommandBuffer* mock_command_buffer =
       reinterpret_cast<MockCommandBuffer*>(commandBuffer);
-  mock_command_buffer->called_functions_->push_back("vkCmdBindPipeline");
+  mock_command_buffer->device_->AddCalledFunction("vkCmdBindPipeline");
 }
 
 void vkCmdSetStencilReference(VkCommandBuffer commandBuffer,
@@ -440,7 +482,7 @@ void vkCmdSetStencilReference(VkCommandBuffer commandBuffer,
                               uint32_t reference) {
   MockCommandBuffer* mock_command_buffer =
       reinterpret_cast<MockCommandBuffer*>(commandBuffer);
-  mock_command_buffer->called_functions_->push_back("vkCmdSetStencilReference");
+  mock_command_buffer->device_->AddCalledFunction("vkCmdSetStencilReference");
 }
 
 void vkCmdSetScissor(VkCommandBuffer commandBuffer,
@@ -449,7 +491,7 @@ void vkCmdSetScissor(VkCommandBuffer commandBuffer,
                      const VkRect2D* pScissors) {
   MockCommandBuffer* mock_command_buffer =
       reinterpret_cast<MockCommandBuffer*>(commandBuffer);
-  mock_command_buffer->called_functions_->push_back("vkCmdSetScissor");
+  mock_command_buffer->device_->AddCalledFunction("vkCmdSetScissor");
 }
 
 void vkCmdSetViewport(VkCommandBuffer commandBuffer,
@@ -458,7 +500,30 @@ void vkCmdSetViewport(VkCommandBuffer commandBuffer,
                       const VkViewport* pViewports) {
   MockCommandBuffer* mock_command_buffer =
       reinterpret_cast<MockCommandBuffer*>(commandBuffer);
-  mock_command_buffer->called_functions_->push_back("vkCmdSetViewport");
+  mock_command_buffer->device_->AddCalledFunction("vkCmdSetViewport");
+}
+
+void vkCmdPipelineBarrier(VkCommandBuffer commandBuffer,
+                          VkPipelineStageFlags srcStageMask,
+                          VkPipelineStageFlags dstStageMask,
+                          VkDependencyFlags dependencyFlags,
+                          uint32_t memoryBarrierCount,
+                          const VkMemoryBarrier* pMemoryBarriers,
+                          uint32_t bufferMemoryBarrierCount,
+                          const VkBufferMemoryBarrier* pBufferMemoryBarriers,
+                          uint32_t imageMemoryBarrierCount,
+                          const VkImageMemoryBarrier* pImageMemoryBarriers) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  mock_command_buffer->device_->AddCalledFunction("vkCmdPipelineBarrier");
+}
+
+void vkCmdExecuteCommands(VkCommandBuffer commandBuffer,
+                          uint32_t commandBufferCount,
+                          const VkCommandBuffer* pCommandBuffers) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  mock_command_buffer->device_->AddCalledFunction("vkCmdExecuteCommands");
 }
 
 void vkFreeCommandBuffers(VkDevice device,
@@ -488,6 +553,7 @@ VkResult vkCreateFence(VkDevice device,
                        VkFence* pFence) {
   MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
   *pFence = reinterpret_cast<VkFence>(new MockFence());
+  mock_device->AddCalledFunction("vkCreateFence");
   return VK_SUCCESS;
 }
 
@@ -502,6 +568,32 @@ VkResult vkQueueSubmit(VkQueue queue,
                        uint32_t submitCount,
                        const VkSubmitInfo* pSubmits,
                        VkFence fence) {
+  // Submissions complete immediately, signaling their timeline semaphores.
+  for (uint32_t i = 0; i < submitCount; i++) {
+    // Queues aren't mocked, so calls are recorded through the device of the
+    // submitted command buffers.
+    if (pSubmits[i].commandBufferCount > 0) {
+      MockDevice* mock_device =
+          reinterpret_cast<MockCommandBuffer*>(pSubmits[i].pCommandBuffers[0])
+              ->device_;
+      mock_device->AddCalledFunction("vkQueueSubmit");
+      for (uint32_t j = 0; j < pSubmits[i].waitSemaphoreCount; j++) {
+        mock_device->AddCalledFunction("vkQueueSubmit.pWaitSemaphores");
+      }
+    }
+    for (auto* next = static_cast<const VkBaseInStructure*>(pSubmits[i].pNext);
+         next; next = next->pNext) {
+      if (next->sType != VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO) {
+        continue;
+      }
+      auto* timeline_info =
+          reinterpret_cast<const VkTimelineSemaphoreSubmitInfo*>(next);
+      for (uint32_t j = 0; j < timeline_info->signalSemaphoreValueCount; j++) {
+        reinterpret_cast<MockSemaphore*>(pSubmits[i].pSignalSemaphores[j])
+            ->value = timeline_info->pSignalSemaphoreValues[j];
+      }
+    }
+  }
   return VK_SUCCESS;
 }
 
@@ -617,6 +709,15 @@ VkResult vkAllocateDescriptorSets(
   return VK_SUCCESS;
 }
 
+void vkUpdateDescriptorSets(VkDevice device,
+                            uint32_t descriptorWriteCount,
+                            const VkWriteDescriptorSet* pDescriptorWrites,
+                            uint32_t descriptorCopyCount,
+                            const VkCopyDescriptorSet* pDescriptorCopies) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkUpdateDescriptorSets");
+}
+
 VkResult vkGetPhysicalDeviceSurfaceFormatsKHR(
     VkPhysicalDevice physicalDevice,
     VkSurfaceKHR surface,
@@ -717,6 +818,27 @@ void vkDestroySemaphore(VkDevice device,
   delete reinterpret_cast<MockSemaphore*>(semaphore);
 }
 
+VkResult vkWaitSemaphores(VkDevice device,
+                          const VkSemaphoreWaitInfo* pWaitInfo,
+                          uint64_t timeout) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkWaitSemaphores");
+  for (uint32_t i = 0; i < pWaitInfo->semaphoreCount; i++) {
+    if (reinterpret_cast<MockSemaphore*>(pWaitInfo->pSemaphores[i])->value <
+        pWaitInfo->pValues[i]) {
+      return VK_TIMEOUT;
+    }
+  }
+  return VK_SUCCESS;
+}
+
+VkResult vkGetSemaphoreCounterValue(VkDevice device,
+                                    VkSemaphore semaphore,
+                                    uint64_t* pValue) {
+  *pValue = reinterpret_cast<MockSemaphore*>(semaphore)->value;
+  return VK_SUCCESS;
+}
+
 VkResult vkAcquireNextImageKHR(VkDevice device,
                                VkSwapchainKHR swapchain,
                                uint64_t timeout,
@@ -734,6 +856,8 @@ VkResult vkCreateFramebuffer(VkDevice device,
                              const VkAllocationCallbacks* pAllocator,
                              VkFramebuffer* pFramebuffer) {
   *pFramebuffer = reinterpret_cast<VkFramebuffer>(new MockFramebuffer());
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkCreateFramebuffer");
   return VK_SUCCESS;
 }
 
@@ -759,6 +883,12 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkGetPhysicalDeviceQueueFamilyProperties;
   } else if (strcmp("vkEnumerateDeviceExtensionProperties", pName) == 0) {
     return (PFN_vkVoidFunction)vkEnumerateDeviceExtensionProperties;
+  } else if (strcmp("vkGetPhysicalDeviceFeatures2KHR", pName) == 0 ||
+             strcmp("vkGetPhysicalDeviceFeatures2", pName) == 0) {
+    return (PFN_vkVoidFunction)vkGetPhysicalDeviceFeatures2;
+  } else if (strcmp("vkGetPhysicalDeviceProperties2KHR", pName) == 0 ||
+             strcmp("vkGetPhysicalDeviceProperties2", pName) == 0) {
+    return (PFN_vkVoidFunction)vkGetPhysicalDeviceProperties2;
   } else if (strcmp("vkCreateDevice", pName) == 0) {
     return (PFN_vkVoidFunction)vkCreateDevice;
   } else if (strcmp("vkCreateInstance", pName) == 0) {
@@ -823,6 +953,10 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkCmdSetScissor;
   } else if (strcmp("vkCmdSetViewport", pName) == 0) {
     return (PFN_vkVoidFunction)vkCmdSetViewport;
+  } else if (strcmp("vkCmdPipelineBarrier", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCmdPipelineBarrier;
+  } else if (strcmp("vkCmdExecuteCommands", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCmdExecuteCommands;
   } else if (strcmp("vkDestroyCommandPool", pName) == 0) {
     return (PFN_vkVoidFunction)vkDestroyCommandPool;
   } else if (strcmp("vkFreeCommandBuffers", pName) == 0) {
@@ -859,6 +993,8 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkResetDescriptorPool;
   } else if (strcmp("vkAllocateDescriptorSets", pName) == 0) {
     return (PFN_vkVoidFunction)vkAllocateDescriptorSets;
+  } else if (strcmp("vkUpdateDescriptorSets", pName) == 0) {
+    return (PFN_vkVoidFunction)vkUpdateDescriptorSets;
   } else if (strcmp("vkGetPhysicalDeviceSurfaceFormatsKHR", pName) == 0) {
     return (PFN_vkVoidFunction)vkGetPhysicalDeviceSurfaceFormatsKHR;
   } else if (strcmp("vkGetPhysicalDeviceSurfaceCapabilitiesKHR", pName) == 0) {
@@ -875,6 +1011,12 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkCreateSemaphore;
   } else if (strcmp("vkDestroySemaphore", pName) == 0) {
     return (PFN_vkVoidFunction)vkDestroySemaphore;
+  } else if (strcmp("vkWaitSemaphoresKHR", pName) == 0 ||
+             strcmp("vkWaitSemaphores", pName) == 0) {
+    return (PFN_vkVoidFunction)vkWaitSemaphores;
+  } else if (strcmp("vkGetSemaphoreCounterValueKHR", pName) == 0 ||
+             strcmp("vkGetSemaphoreCounterValue", pName) == 0) {
+    return (PFN_vkVoidFunction)vkGetSemaphoreCounterValue;
   } else if (strcmp("vkDestroySurfaceKHR", pName) == 0) {
     return (PFN_vkVoidFunction)vkDestroySurfaceKHR;
   } else if (strcmp("vkAcquireNextImageKHR", pName) == 0) {
@@ -891,6 +1033,12 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
 
 MockVulkanContextBuilder::MockVulkanContextBuilder()
     : instance_extensions_({"VK_KHR_surface", "VK_MVK_macos_surface"}),
+      device_extensions_({"VK_KHR_swapchain"}),
+      queue_families_({vk::QueueFamilyProperties{
+          vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute |
+              vk::QueueFlagBits::eTransfer,  // queue flags
+          3u,                                // queue count
+      }}),
       format_properties_callback_([](VkPhysicalDevice physicalDevice,
                                      VkFormat format,
                                      VkFormatProperties* pFormatProperties) {
@@ -918,7 +1066,9 @@ std::shared_ptr<ContextVK> MockVulkanContextBuilder::Build() {
   }
   g_instance_extensions = instance_extensions_;
   g_instance_layers = instance_layers_;
+  g_device_extensions = device_extensions_;
   g_format_properties_callback = format_properties_callback_;
+  g_queue_families = queue_families_;
   std::shared_ptr<ContextVK> result = ContextVK::Create(std::move(settings));
   return result;
 }
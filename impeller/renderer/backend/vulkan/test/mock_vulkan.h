@@ -83,12 +83,29 @@ class MockVulkanContextBuilder {
     return *this;
   }
 
+  /// Set the device extensions reported by
+  /// vkEnumerateDeviceExtensionProperties, by default only VK_KHR_swapchain.
+  MockVulkanContextBuilder& SetDeviceExtensions(
+      const std::vector<std::string>& device_extensions) {
+    device_extensions_ = device_extensions;
+    return *this;
+  }
+
   MockVulkanContextBuilder& SetInstanceLayers(
       const std::vector<std::string>& instance_layers) {
     instance_layers_ = instance_layers;
     return *this;
   }
 
+  /// Set the queue families reported by
+  /// vkGetPhysicalDeviceQueueFamilyProperties, by default a single family
+  /// that supports graphics, compute and transfers.
+  MockVulkanContextBuilder& SetQueueFamilies(
+      const std::vector<vk::QueueFamilyProperties>& queue_families) {
+    queue_families_ = queue_families;
+    return *this;
+  }
+
   /// Set the behavior of vkGetPhysicalDeviceFormatProperties, which needs to
   /// respond differently for different formats.
   MockVulkanContextBuilder& SetPhysicalDeviceFormatPropertiesCallback(
@@ -104,6 +121,8 @@ class MockVulkanContextBuilder {
   std::function<void(ContextVK::Settings&)> settings_callback_;
   std::vector<std::string> instance_extensions_;
   std::vector<std::string> instance_layers_;
+  std::vector<std::string> device_extensions_;
+  std::vector<vk::QueueFamilyProperties> queue_families_;
   std::function<void(VkPhysicalDevice physicalDevice,
                      VkFormat format,
                      VkFormatProperties* pFormatProperties)>
@@ -8,6 +8,7 @@
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/sampler_vk.h"
+#include "impeller/renderer/backend/vulkan/upload_queue_vk.h"
 
 namespace impeller {
 
@@ -58,6 +59,11 @@ bool TextureVK::OnSetContents(const uint8_t* contents,
     return false;
   }
 
+  if (UploadOnTransferQueue(DeviceBuffer::AsBufferView(staging_buffer),
+                            slice)) {
+    return true;
+  }
+
   auto cmd_buffer = context->CreateCommandBuffer();
 
   if (!cmd_buffer) {
@@ -136,6 +142,24 @@ bool TextureVK::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
   return OnSetContents(mapping->GetMapping(), mapping->GetSize(), slice);
 }
 
+bool TextureVK::UploadOnTransferQueue(BufferView source, uint32_t slice) const {
+  // Textures that haven't been used yet can be uploaded without waiting for
+  // the graphics queue, since their contents may be discarded.
+  if (!source_ || source_->IsSwapchainImage() ||
+      source_->GetLayout() != vk::ImageLayout::eUndefined) {
+    return false;
+  }
+  auto context = context_.lock();
+  if (!context) {
+    return false;
+  }
+  const auto& upload_queue = ContextVK::Cast(*context).GetUploadQueue();
+  if (!upload_queue) {
+    return false;
+  }
+  return upload_queue->UploadTexture(std::move(source), source_, slice);
+}
+
 bool TextureVK::IsValid() const {
   return !!source_;
 }
@@ -160,6 +184,15 @@ bool TextureVK::SetLayout(const BarrierVK& barrier) const {
   return source_ ? source_->SetLayout(barrier).ok() : false;
 }
 
+bool TextureVK::SetLayout(const BarrierVK& barrier,
+                          BarrierBatchVK& batch) const {
+  if (!source_) {
+    return false;
+  }
+  batch.AddTransition(*source_, barrier);
+  return true;
+}
+
 vk::ImageLayout TextureVK::SetLayoutWithoutEncoding(
     vk::ImageLayout layout) const {
   return source_ ? source_->SetLayoutWithoutEncoding(layout)
@@ -6,6 +6,7 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_TEXTURE_VK_H_
 
 #include "impeller/base/backend_cast.h"
+#include "impeller/core/buffer_view.h"
 #include "impeller/core/texture.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
@@ -32,10 +33,22 @@ class TextureVK final : public Texture, public BackendCast<TextureVK, Texture> {
 
   bool SetLayout(const BarrierVK& barrier) const;
 
+  /// @brief      Adds the layout transition to the batch instead of encoding it
+  ///             right away.
+  bool SetLayout(const BarrierVK& barrier, BarrierBatchVK& batch) const;
+
   vk::ImageLayout SetLayoutWithoutEncoding(vk::ImageLayout layout) const;
 
   vk::ImageLayout GetLayout() const;
 
+  /// @brief      Uploads the base mip level of a slice on the dedicated
+  ///             transfer queue if the device has one and the texture hasn't
+  ///             been used yet.
+  ///
+  /// @return     Whether the upload was submitted. If not, the caller must
+  ///             encode the upload on the graphics queue.
+  bool UploadOnTransferQueue(BufferView source, uint32_t slice) const;
+
   std::shared_ptr<const TextureSourceVK> GetTextureSource() const;
 
   // |Texture|
@@ -0,0 +1,180 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/timeline_waiter_vk.h"
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/cpu_affinity.h"
+#include "flutter/fml/thread.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+std::shared_ptr<TimelineWaiterVK> TimelineWaiterVK::Create(
+    std::weak_ptr<DeviceHolderVK> device_holder,
+    std::shared_ptr<QueueVK> queue) {
+  auto strong_device_holder = device_holder.lock();
+  if (!strong_device_holder || !queue) {
+    return nullptr;
+  }
+
+  vk::StructureChain<vk::SemaphoreCreateInfo, vk::SemaphoreTypeCreateInfoKHR>
+      semaphore_info;
+  semaphore_info.get<vk::SemaphoreTypeCreateInfoKHR>()
+      .setSemaphoreType(vk::SemaphoreType::eTimeline)
+      .setInitialValue(0);
+  auto [result, semaphore] =
+      strong_device_holder->GetDevice().createSemaphoreUnique(
+          semaphore_info.get());
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create timeline semaphore: "
+                   << vk::to_string(result);
+    return nullptr;
+  }
+
+  return std::shared_ptr<TimelineWaiterVK>(new TimelineWaiterVK(
+      std::move(device_holder), std::move(queue), std::move(semaphore)));
+}
+
+TimelineWaiterVK::TimelineWaiterVK(std::weak_ptr<DeviceHolderVK> device_holder,
+                                   std::shared_ptr<QueueVK> queue,
+                                   vk::UniqueSemaphore semaphore)
+    : device_holder_(std::move(device_holder)),
+      queue_(std::move(queue)),
+      semaphore_(std::move(semaphore)) {
+  waiter_thread_ = std::make_unique<std::thread>([&]() { Main(); });
+}
+
+TimelineWaiterVK::~TimelineWaiterVK() {
+  Terminate();
+  waiter_thread_->join();
+}
+
+fml::Status TimelineWaiterVK::Submit(const vk::SubmitInfo& submit_info,
+                                     const fml::closure& callback) {
+  FML_DCHECK(submit_info.signalSemaphoreCount == 0u);
+  std::scoped_lock submit_lock(submit_mutex_);
+  {
+    std::scoped_lock lock(pending_mutex_);
+    if (terminate_) {
+      return fml::Status(fml::StatusCode::kCancelled,
+                         "Timeline waiter was terminated.");
+    }
+  }
+
+  const uint64_t value = last_submitted_value_ + 1;
+  vk::TimelineSemaphoreSubmitInfoKHR timeline_info;
+  timeline_info.setSignalSemaphoreValues(value);
+  timeline_info.setPNext(submit_info.pNext);
+
+  vk::SubmitInfo timeline_submit_info = submit_info;
+  timeline_submit_info.setSignalSemaphores(semaphore_.get());
+  timeline_submit_info.setPNext(&timeline_info);
+
+  auto result = queue_->Submit(timeline_submit_info, {});
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Failed to submit queue: " << vk::to_string(result);
+    return fml::Status(fml::StatusCode::kCancelled, "Failed to submit queue.");
+  }
+  last_submitted_value_ = value;
+
+  {
+    std::scoped_lock lock(pending_mutex_);
+    pending_.push_back({value, fml::ScopedCleanupClosure(callback)});
+  }
+  pending_cv_.notify_one();
+  return fml::Status();
+}
+
+uint64_t TimelineWaiterVK::GetLastSubmittedValue() const {
+  std::scoped_lock lock(submit_mutex_);
+  return last_submitted_value_;
+}
+
+void TimelineWaiterVK::Main() {
+  fml::Thread::SetCurrentThreadName(
+      fml::Thread::ThreadConfig{"IplrVkTimelineWait"});
+  // Since this thread mostly waits on the device, it doesn't need to be fast.
+  fml::RequestAffinity(fml::CpuAffinity::kEfficiency);
+
+  while (Wait()) {
+    // Intentionally empty.
+  }
+}
+
+bool TimelineWaiterVK::Wait() {
+  uint64_t wait_value = 0;
+  {
+    std::unique_lock lock(pending_mutex_);
+    pending_cv_.wait(lock, [&]() { return !pending_.empty() || terminate_; });
+    // Once terminated, wait until all pending submissions are done.
+    if (pending_.empty()) {
+      return false;
+    }
+    wait_value = pending_.front().value;
+  }
+
+  // Check if the context had died in the meantime.
+  auto device_holder = device_holder_.lock();
+  if (!device_holder) {
+    return false;
+  }
+  const auto& device = device_holder->GetDevice();
+
+  // Wait for the oldest pending submission. Any newer submissions that are
+  // also done by then are released along with it. A timeout bails out the
+  // wait so that termination is noticed.
+  using namespace std::literals::chrono_literals;
+  vk::SemaphoreWaitInfoKHR wait_info;
+  wait_info.setSemaphores(semaphore_.get());
+  wait_info.setValues(wait_value);
+  auto wait_result = device.waitSemaphoresKHR(
+      wait_info, std::chrono::nanoseconds{100ms}.count());
+  if (!(wait_result == vk::Result::eSuccess ||
+        wait_result == vk::Result::eTimeout)) {
+    VALIDATION_LOG << "Timeline waiter encountered an unexpected error. "
+                      "Tearing down the waiter thread.";
+    return false;
+  }
+
+  auto [value_result, completed_value] =
+      device.getSemaphoreCounterValueKHR(semaphore_.get());
+  if (value_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not read the timeline semaphore value. Tearing "
+                      "down the waiter thread.";
+    return false;
+  }
+
+  // Make sure the mutex is unlocked before invoking the callbacks of the
+  // completed submissions. These might touch allocators.
+  std::vector<PendingSubmission> completed;
+  {
+    std::scoped_lock lock(pending_mutex_);
+    while (!pending_.empty() && pending_.front().value <= completed_value) {
+      completed.push_back(std::move(pending_.front()));
+      pending_.pop_front();
+    }
+  }
+
+  if (!completed.empty()) {
+    TRACE_EVENT0("impeller", "ClearCompletedSubmissions");
+    completed.clear();
+  }
+
+  return true;
+}
+
+void TimelineWaiterVK::Terminate() {
+  {
+    std::scoped_lock lock(pending_mutex_);
+    terminate_ = true;
+  }
+  pending_cv_.notify_one();
+}
+
+}  // namespace impeller
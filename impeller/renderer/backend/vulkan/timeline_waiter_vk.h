@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_TIMELINE_WAITER_VK_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_TIMELINE_WAITER_VK_H_
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/status.h"
+#include "impeller/renderer/backend/vulkan/device_holder_vk.h"
+#include "impeller/renderer/backend/vulkan/queue_vk.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Tracks the completion of the submissions to a queue with a
+///             single timeline semaphore, whose value is incremented by every
+///             submission.
+///
+///             Unlike |FenceWaiterVK|, no object is created per submission and
+///             completed submissions are found by comparing their value with
+///             the value of the semaphore, rather than by polling each of
+///             them. Requires |CapabilitiesVK::SupportsTimelineSemaphores|.
+///
+class TimelineWaiterVK {
+ public:
+  static std::shared_ptr<TimelineWaiterVK> Create(
+      std::weak_ptr<DeviceHolderVK> device_holder,
+      std::shared_ptr<QueueVK> queue);
+
+  ~TimelineWaiterVK();
+
+  void Terminate();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Submits work to the queue, signaling the next value of the
+  ///             timeline semaphore once it is done, and invokes |callback|
+  ///             on the waiter thread when the device reaches that value.
+  ///
+  ///             The submit info must not signal semaphores of its own.
+  ///
+  fml::Status Submit(const vk::SubmitInfo& submit_info,
+                     const fml::closure& callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The value signaled by the most recent successful submission.
+  ///
+  uint64_t GetLastSubmittedValue() const;
+
+ private:
+  struct PendingSubmission {
+    uint64_t value = 0;
+    fml::ScopedCleanupClosure callback;
+  };
+
+  std::weak_ptr<DeviceHolderVK> device_holder_;
+  const std::shared_ptr<QueueVK> queue_;
+  vk::UniqueSemaphore semaphore_;
+  // Held while assigning values and submitting, so that the values are
+  // signaled in submission order.
+  mutable std::mutex submit_mutex_;
+  uint64_t last_submitted_value_ = 0;
+  std::mutex pending_mutex_;
+  std::condition_variable pending_cv_;
+  // In increasing order of value.
+  std::deque<PendingSubmission> pending_;
+  bool terminate_ = false;
+  std::unique_ptr<std::thread> waiter_thread_;
+
+  TimelineWaiterVK(std::weak_ptr<DeviceHolderVK> device_holder,
+                   std::shared_ptr<QueueVK> queue,
+                   vk::UniqueSemaphore semaphore);
+
+  void Main();
+
+  bool Wait();
+
+  TimelineWaiterVK(const TimelineWaiterVK&) = delete;
+
+  TimelineWaiterVK& operator=(const TimelineWaiterVK&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_TIMELINE_WAITER_VK_H_
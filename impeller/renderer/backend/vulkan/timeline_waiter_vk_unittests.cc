@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "fml/synchronization/count_down_latch.h"
+#include "fml/synchronization/waitable_event.h"
+#include "gtest/gtest.h"  // IWYU pragma: keep
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "impeller/renderer/backend/vulkan/timeline_waiter_vk.h"  // IWYU pragma: keep
+#include "impeller/renderer/command_buffer.h"
+
+namespace impeller {
+namespace testing {
+
+static std::shared_ptr<ContextVK> CreateContextWithTimelineSemaphores() {
+  return MockVulkanContextBuilder()
+      .SetDeviceExtensions({"VK_KHR_swapchain", "VK_KHR_timeline_semaphore"})
+      .Build();
+}
+
+TEST(TimelineWaiterVKTest, IsOnlyCreatedWithTimelineSemaphores) {
+  auto const context = MockVulkanContextBuilder().Build();
+  EXPECT_FALSE(CapabilitiesVK::Cast(*context->GetCapabilities())
+                   .SupportsTimelineSemaphores());
+  EXPECT_EQ(context->GetTimelineWaiter(), nullptr);
+
+  auto const timeline_context = CreateContextWithTimelineSemaphores();
+  EXPECT_TRUE(CapabilitiesVK::Cast(*timeline_context->GetCapabilities())
+                  .SupportsTimelineSemaphores());
+  EXPECT_NE(timeline_context->GetTimelineWaiter(), nullptr);
+}
+
+TEST(TimelineWaiterVKTest, ExecutesCallbacksOfCompletedSubmissions) {
+  auto const context = CreateContextWithTimelineSemaphores();
+  auto const waiter = context->GetTimelineWaiter();
+  ASSERT_NE(waiter, nullptr);
+
+  fml::CountDownLatch latch(3);
+  for (size_t i = 0; i < 3; i++) {
+    EXPECT_TRUE(waiter->Submit({}, [&latch]() { latch.CountDown(); }).ok());
+  }
+  latch.Wait();
+  EXPECT_EQ(waiter->GetLastSubmittedValue(), 3u);
+}
+
+TEST(TimelineWaiterVKTest, DoesNotSubmitAfterTermination) {
+  auto const context = CreateContextWithTimelineSemaphores();
+  auto const waiter = context->GetTimelineWaiter();
+  ASSERT_NE(waiter, nullptr);
+
+  waiter->Terminate();
+  EXPECT_FALSE(waiter->Submit({}, []() {}).ok());
+  EXPECT_EQ(waiter->GetLastSubmittedValue(), 0u);
+}
+
+TEST(TimelineWaiterVKTest, CommandQueueSubmitsWithoutFences) {
+  auto const context = CreateContextWithTimelineSemaphores();
+  auto waiter = context->GetTimelineWaiter();
+  ASSERT_NE(waiter, nullptr);
+
+  fml::AutoResetWaitableEvent completed;
+  auto buffer = context->CreateCommandBuffer();
+  EXPECT_TRUE(context->GetCommandQueue()
+                  ->Submit({buffer},
+                           [&completed](CommandBuffer::Status status) {
+                             EXPECT_EQ(status,
+                                       CommandBuffer::Status::kCompleted);
+                             completed.Signal();
+                           })
+                  .ok());
+  completed.Wait();
+  EXPECT_EQ(waiter->GetLastSubmittedValue(), 1u);
+
+  // Join the waiter thread before reading the called functions.
+  auto called_functions = GetMockVulkanFunctions(context->GetDevice());
+  context->Shutdown();
+  waiter.reset();
+  EXPECT_NE(std::find(called_functions->begin(), called_functions->end(),
+                      "vkWaitSemaphores"),
+            called_functions->end());
+  EXPECT_EQ(std::find(called_functions->begin(), called_functions->end(),
+                      "vkCreateFence"),
+            called_functions->end());
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -11,12 +11,15 @@ namespace impeller {
 TrackedObjectsVK::TrackedObjectsVK(
     const std::weak_ptr<const ContextVK>& context,
     const std::shared_ptr<CommandPoolVK>& pool,
-    std::unique_ptr<GPUProbe> probe)
-    : desc_pool_(context), probe_(std::move(probe)) {
+    std::unique_ptr<GPUProbe> probe,
+    vk::CommandBufferLevel level)
+    : desc_pool_(context), level_(level), probe_(std::move(probe)) {
   if (!pool) {
     return;
   }
-  auto buffer = pool->CreateCommandBuffer();
+  auto buffer = level_ == vk::CommandBufferLevel::ePrimary
+                    ? pool->CreateCommandBuffer()
+                    : pool->CreateSecondaryCommandBuffer();
   if (!buffer) {
     return;
   }
@@ -29,6 +32,10 @@ TrackedObjectsVK::~TrackedObjectsVK() {
   if (!buffer_) {
     return;
   }
+  if (level_ == vk::CommandBufferLevel::eSecondary) {
+    pool_->CollectSecondaryCommandBuffer(std::move(buffer_));
+    return;
+  }
   pool_->CollectCommandBuffer(std::move(buffer_));
 }
 
@@ -73,6 +80,13 @@ bool TrackedObjectsVK::IsTracking(
   return tracked_textures_.find(texture) != tracked_textures_.end();
 }
 
+void TrackedObjectsVK::Track(std::shared_ptr<TrackedObjectsVK> secondary) {
+  if (!secondary) {
+    return;
+  }
+  tracked_secondaries_.push_back(std::move(secondary));
+}
+
 vk::CommandBuffer TrackedObjectsVK::GetCommandBuffer() const {
   return *buffer_;
 }
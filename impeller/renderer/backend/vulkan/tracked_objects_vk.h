@@ -16,9 +16,13 @@ namespace impeller {
 ///        command buffers and descriptor sets.
 class TrackedObjectsVK {
  public:
-  explicit TrackedObjectsVK(const std::weak_ptr<const ContextVK>& context,
-                            const std::shared_ptr<CommandPoolVK>& pool,
-                            std::unique_ptr<GPUProbe> probe);
+  /// @param[in]  level  The level of the command buffer. Secondary command
+  ///                    buffers don't need a |probe|.
+  explicit TrackedObjectsVK(
+      const std::weak_ptr<const ContextVK>& context,
+      const std::shared_ptr<CommandPoolVK>& pool,
+      std::unique_ptr<GPUProbe> probe,
+      vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary);
 
   ~TrackedObjectsVK();
 
@@ -34,6 +38,10 @@ class TrackedObjectsVK {
 
   bool IsTracking(const std::shared_ptr<const TextureSourceVK>& texture) const;
 
+  /// @brief      Keeps the objects of a secondary command buffer executed by
+  ///             this command buffer alive for as long as these are.
+  void Track(std::shared_ptr<TrackedObjectsVK> secondary);
+
   vk::CommandBuffer GetCommandBuffer() const;
 
   DescriptorPoolVK& GetDescriptorPool();
@@ -45,9 +53,11 @@ class TrackedObjectsVK {
   // `shared_ptr` since command buffers have a link to the command pool.
   std::shared_ptr<CommandPoolVK> pool_;
   vk::UniqueCommandBuffer buffer_;
+  vk::CommandBufferLevel level_;
   std::set<std::shared_ptr<SharedObjectVK>> tracked_objects_;
   std::set<std::shared_ptr<const DeviceBuffer>> tracked_buffers_;
   std::set<std::shared_ptr<const TextureSourceVK>> tracked_textures_;
+  std::vector<std::shared_ptr<TrackedObjectsVK>> tracked_secondaries_;
   std::unique_ptr<GPUProbe> probe_;
   bool is_valid_ = false;
 
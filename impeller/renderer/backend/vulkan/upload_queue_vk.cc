@@ -0,0 +1,326 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/upload_queue_vk.h"
+
+#include <iterator>
+#include <limits>
+#include <utility>
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
+#include "impeller/renderer/backend/vulkan/formats_vk.h"
+
+namespace impeller {
+
+static constexpr int64_t kImpellerUploadQueueTraceID = 2053;
+
+static vk::ImageSubresourceRange GetFullSubresourceRange(
+    const TextureDescriptor& desc) {
+  vk::ImageSubresourceRange range;
+  range.aspectMask = ToImageAspectFlags(desc.format);
+  range.baseMipLevel = 0u;
+  range.levelCount = desc.mip_count;
+  range.baseArrayLayer = 0u;
+  range.layerCount = ToArrayLayerCount(desc.type);
+  return range;
+}
+
+std::optional<QueueIndexVK> UploadQueueVK::PickQueue(
+    const std::vector<vk::QueueFamilyProperties>& families) {
+  for (size_t i = 0u; i < families.size(); i++) {
+    const vk::QueueFlags flags = families[i].queueFlags;
+    if (!(flags & vk::QueueFlagBits::eTransfer)) {
+      continue;
+    }
+    if (flags & (vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute)) {
+      continue;
+    }
+    if (families[i].queueCount == 0u) {
+      continue;
+    }
+    return QueueIndexVK{.family = i, .index = 0};
+  }
+  return std::nullopt;
+}
+
+std::shared_ptr<UploadQueueVK> UploadQueueVK::Create(
+    std::weak_ptr<DeviceHolderVK> device_holder,
+    std::shared_ptr<QueueVK> transfer_queue,
+    uint32_t graphics_queue_family) {
+  auto strong_device_holder = device_holder.lock();
+  if (!strong_device_holder || !transfer_queue) {
+    return nullptr;
+  }
+  const auto& device = strong_device_holder->GetDevice();
+
+  vk::CommandPoolCreateInfo pool_info;
+  pool_info.setQueueFamilyIndex(transfer_queue->GetIndex().family);
+  pool_info.setFlags(vk::CommandPoolCreateFlagBits::eTransient |
+                     vk::CommandPoolCreateFlagBits::eResetCommandBuffer);
+  auto [pool_result, pool] = device.createCommandPoolUnique(pool_info);
+  if (pool_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create upload command pool: "
+                   << vk::to_string(pool_result);
+    return nullptr;
+  }
+
+  vk::CommandBufferAllocateInfo buffer_info;
+  buffer_info.setCommandPool(pool.get());
+  buffer_info.setCommandBufferCount(kRingSize);
+  buffer_info.setLevel(vk::CommandBufferLevel::ePrimary);
+  auto [buffers_result, buffers] =
+      device.allocateCommandBuffersUnique(buffer_info);
+  if (buffers_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not allocate upload command buffers: "
+                   << vk::to_string(buffers_result);
+    return nullptr;
+  }
+
+  std::array<Slot, kRingSize> ring;
+  for (size_t i = 0u; i < kRingSize; i++) {
+    auto [fence_result, fence] = device.createFenceUnique({});
+    if (fence_result != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Could not create upload fence: "
+                     << vk::to_string(fence_result);
+      return nullptr;
+    }
+    ring[i].command_buffer = std::move(buffers[i]);
+    ring[i].fence = std::move(fence);
+  }
+
+  return std::shared_ptr<UploadQueueVK>(new UploadQueueVK(
+      std::move(device_holder), std::move(transfer_queue),
+      graphics_queue_family, std::move(pool), std::move(ring)));
+}
+
+UploadQueueVK::UploadQueueVK(std::weak_ptr<DeviceHolderVK> device_holder,
+                             std::shared_ptr<QueueVK> transfer_queue,
+                             uint32_t graphics_queue_family,
+                             vk::UniqueCommandPool command_pool,
+                             std::array<Slot, kRingSize> ring)
+    : device_holder_(std::move(device_holder)),
+      transfer_queue_(std::move(transfer_queue)),
+      graphics_queue_family_(graphics_queue_family),
+      command_pool_(std::move(command_pool)),
+      ring_(std::move(ring)) {}
+
+UploadQueueVK::~UploadQueueVK() {
+  Lock lock(ring_mutex_);
+  auto device_holder = device_holder_.lock();
+  if (!device_holder) {
+    // The device is gone and took the pool, buffers, and fences with it.
+    for (auto& slot : ring_) {
+      slot.command_buffer.release();
+      slot.fence.release();
+    }
+    command_pool_.release();
+    return;
+  }
+  // The command buffers may not be freed while they are pending execution.
+  for (auto& slot : ring_) {
+    if (slot.in_flight) {
+      [[maybe_unused]] auto result = device_holder->GetDevice().waitForFences(
+          slot.fence.get(),                      // fence
+          true,                                  // wait all
+          std::numeric_limits<uint64_t>::max()   // timeout (ns)
+      );
+    }
+  }
+}
+
+void UploadQueueVK::CollectCompletedSlots(const vk::Device& device,
+                                          bool wait_for_next) {
+  if (wait_for_next && ring_[next_slot_].in_flight) {
+    TRACE_EVENT0("impeller", "UploadQueueVK::WaitForSlot");
+    [[maybe_unused]] auto result = device.waitForFences(
+        ring_[next_slot_].fence.get(),         // fence
+        true,                                  // wait all
+        std::numeric_limits<uint64_t>::max()   // timeout (ns)
+    );
+  }
+
+  const fml::TimePoint now = fml::TimePoint::Now();
+  for (auto& slot : ring_) {
+    if (!slot.in_flight ||
+        device.getFenceStatus(slot.fence.get()) != vk::Result::eSuccess) {
+      continue;
+    }
+    // Completion is only observed when polled. So the latency is an upper
+    // bound on the time the upload took on the device.
+    [[maybe_unused]] const int64_t latency_us =
+        (now - slot.submit_time).ToMicroseconds();
+    [[maybe_unused]] const int64_t throughput_mbps =
+        latency_us > 0 ? static_cast<int64_t>(slot.bytes) / latency_us : 0;
+    FML_TRACE_COUNTER("impeller",                         //
+                      "UploadQueue",                      //
+                      kImpellerUploadQueueTraceID,        //
+                      "LatencyMicroseconds", latency_us,  //
+                      "ThroughputMBPerSecond", throughput_mbps);
+    slot.source.reset();
+    slot.destination.reset();
+    slot.in_flight = false;
+    completed_uploads_++;
+  }
+}
+
+bool UploadQueueVK::UploadTexture(
+    BufferView source,
+    std::shared_ptr<const TextureSourceVK> destination,
+    uint32_t slice) {
+  if (!source || !destination) {
+    return false;
+  }
+  auto device_holder = device_holder_.lock();
+  if (!device_holder) {
+    VALIDATION_LOG << "Device lost before uploading texture.";
+    return false;
+  }
+  const auto& device = device_holder->GetDevice();
+  const TextureDescriptor& desc = destination->GetTextureDescriptor();
+  const uint32_t transfer_queue_family = transfer_queue_->GetIndex().family;
+
+  auto [semaphore_result, semaphore] = device.createSemaphoreUnique({});
+  if (semaphore_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create upload semaphore: "
+                   << vk::to_string(semaphore_result);
+    return false;
+  }
+
+  vk::ImageMemoryBarrier release_barrier;
+  release_barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+  release_barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+  release_barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+  release_barrier.srcQueueFamilyIndex = transfer_queue_family;
+  release_barrier.dstQueueFamilyIndex = graphics_queue_family_;
+  release_barrier.image = destination->GetImage();
+  release_barrier.subresourceRange = GetFullSubresourceRange(desc);
+
+  // The acquire must match the release except for the access masks.
+  vk::ImageMemoryBarrier acquire_barrier = release_barrier;
+  acquire_barrier.srcAccessMask = {};
+  acquire_barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+
+  {
+    Lock lock(ring_mutex_);
+    CollectCompletedSlots(device, /*wait_for_next=*/true);
+
+    Slot& slot = ring_[next_slot_];
+    if (device.resetFences(slot.fence.get()) != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Could not reset upload fence.";
+      return false;
+    }
+    const vk::CommandBuffer& cmd_buffer = slot.command_buffer.get();
+    if (cmd_buffer.reset() != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Could not reset upload command buffer.";
+      return false;
+    }
+    vk::CommandBufferBeginInfo begin_info;
+    begin_info.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+    if (cmd_buffer.begin(begin_info) != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Could not begin upload command buffer.";
+      return false;
+    }
+
+    // The texture hasn't been used yet, so its contents may be discarded
+    // without acquiring it from the graphics queue family first.
+    vk::ImageMemoryBarrier transfer_barrier;
+    transfer_barrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
+    transfer_barrier.oldLayout = vk::ImageLayout::eUndefined;
+    transfer_barrier.newLayout = vk::ImageLayout::eTransferDstOptimal;
+    transfer_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    transfer_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    transfer_barrier.image = destination->GetImage();
+    transfer_barrier.subresourceRange = GetFullSubresourceRange(desc);
+    cmd_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe,  //
+                               vk::PipelineStageFlagBits::eTransfer,   //
+                               {}, nullptr, nullptr, transfer_barrier  //
+    );
+
+    vk::BufferImageCopy copy;
+    copy.bufferOffset = source.range.offset;
+    copy.bufferRowLength = 0u;    // 0u means tightly packed per spec.
+    copy.bufferImageHeight = 0u;  // 0u means tightly packed per spec.
+    copy.imageExtent.width = desc.size.width;
+    copy.imageExtent.height = desc.size.height;
+    copy.imageExtent.depth = 1u;
+    copy.imageSubresource.aspectMask = ToImageAspectFlags(desc.format);
+    copy.imageSubresource.mipLevel = 0u;
+    copy.imageSubresource.baseArrayLayer = slice;
+    copy.imageSubresource.layerCount = 1u;
+    cmd_buffer.copyBufferToImage(
+        DeviceBufferVK::Cast(*source.buffer).GetBuffer(),  // src buffer
+        destination->GetImage(),                           // dst image
+        vk::ImageLayout::eTransferDstOptimal,              // dst image layout
+        1u,                                                // region count
+        &copy                                              // regions
+    );
+
+    cmd_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,      //
+                               vk::PipelineStageFlagBits::eBottomOfPipe,  //
+                               {}, nullptr, nullptr, release_barrier      //
+    );
+
+    if (cmd_buffer.end() != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Could not end upload command buffer.";
+      return false;
+    }
+
+    vk::SubmitInfo submit_info;
+    submit_info.setCommandBuffers(cmd_buffer);
+    submit_info.setSignalSemaphores(semaphore.get());
+    const vk::Result submit_result =
+        transfer_queue_->Submit(submit_info, slot.fence.get());
+    if (submit_result != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Could not submit upload: "
+                     << vk::to_string(submit_result);
+      return false;
+    }
+
+    slot.bytes = source.range.length;
+    slot.source = std::move(source.buffer);
+    slot.destination = destination;
+    slot.submit_time = fml::TimePoint::Now();
+    slot.in_flight = true;
+    next_slot_ = (next_slot_ + 1u) % kRingSize;
+  }
+
+  // The layout is only valid on the graphics queue once the acquire is
+  // recorded. That happens before any command buffer using the texture can
+  // be submitted.
+  destination->SetLayoutWithoutEncoding(
+      vk::ImageLayout::eShaderReadOnlyOptimal);
+
+  Lock lock(acquires_mutex_);
+  pending_acquires_.semaphores.push_back(std::move(semaphore));
+  pending_acquires_.barriers.push_back(acquire_barrier);
+  pending_acquires_.textures.push_back(std::move(destination));
+  return true;
+}
+
+UploadQueueVK::PendingAcquires UploadQueueVK::TakePendingAcquires() {
+  Lock lock(acquires_mutex_);
+  return std::exchange(pending_acquires_, {});
+}
+
+template <class T>
+static void Prepend(std::vector<T>& to, std::vector<T> from) {
+  to.insert(to.begin(), std::make_move_iterator(from.begin()),
+            std::make_move_iterator(from.end()));
+}
+
+void UploadQueueVK::ReturnPendingAcquires(PendingAcquires acquires) {
+  Lock lock(acquires_mutex_);
+  Prepend(pending_acquires_.semaphores, std::move(acquires.semaphores));
+  Prepend(pending_acquires_.barriers, std::move(acquires.barriers));
+  Prepend(pending_acquires_.textures, std::move(acquires.textures));
+}
+
+size_t UploadQueueVK::GetCompletedUploadCount() const {
+  Lock lock(ring_mutex_);
+  return completed_uploads_;
+}
+
+}  // namespace impeller
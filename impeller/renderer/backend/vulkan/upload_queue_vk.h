@@ -0,0 +1,145 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_UPLOAD_QUEUE_VK_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_UPLOAD_QUEUE_VK_H_
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/time/time_point.h"
+#include "impeller/base/thread.h"
+#include "impeller/core/buffer_view.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/renderer/backend/vulkan/device_holder_vk.h"
+#include "impeller/renderer/backend/vulkan/queue_vk.h"
+#include "impeller/renderer/backend/vulkan/texture_source_vk.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Uploads texture contents on a dedicated transfer queue so that
+///             uploads don't contend with rendering on the graphics queue.
+///
+///             Uploads are recorded into a fixed ring of command buffers,
+///             which bounds the number of uploads in flight. Once an upload
+///             is submitted, ownership of the texture is released to the
+///             graphics queue family. The matching acquire must be recorded
+///             on the graphics queue before the texture is used, see
+///             |TakePendingAcquires|.
+///
+///             Only used if the device exposes a queue family that supports
+///             transfers but not graphics or compute.
+///
+class UploadQueueVK {
+ public:
+  static constexpr size_t kRingSize = 4u;
+
+  struct PendingAcquires {
+    std::vector<vk::UniqueSemaphore> semaphores;
+    std::vector<vk::ImageMemoryBarrier> barriers;
+    std::vector<std::shared_ptr<const TextureSourceVK>> textures;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Pick a queue family that supports transfers but neither
+  ///             graphics nor compute. These are usually backed by dedicated
+  ///             copy engines.
+  ///
+  static std::optional<QueueIndexVK> PickQueue(
+      const std::vector<vk::QueueFamilyProperties>& families);
+
+  static std::shared_ptr<UploadQueueVK> Create(
+      std::weak_ptr<DeviceHolderVK> device_holder,
+      std::shared_ptr<QueueVK> transfer_queue,
+      uint32_t graphics_queue_family);
+
+  ~UploadQueueVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copy the source buffer view into a layer of the base mip
+  ///             level of the texture and transition the texture to the
+  ///             shader read only layout.
+  ///
+  ///             The texture must not have been used yet. Its contents are
+  ///             discarded, so it needn't be acquired from the graphics
+  ///             queue first.
+  ///
+  ///             Blocks if all command buffers in the ring are in flight.
+  ///
+  bool UploadTexture(BufferView source,
+                     std::shared_ptr<const TextureSourceVK> destination,
+                     uint32_t slice);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Take the acquire barriers of the uploads submitted since the
+  ///             last call. The barriers must be recorded at the start of the
+  ///             next submission to the graphics queue, which must wait on the
+  ///             semaphores.
+  ///
+  PendingAcquires TakePendingAcquires();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Hand back acquires taken by |TakePendingAcquires| that could
+  ///             not be submitted. They are taken again, ahead of any newer
+  ///             ones, by the next call to |TakePendingAcquires|.
+  ///
+  void ReturnPendingAcquires(PendingAcquires acquires);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of uploads known to have completed on the device.
+  ///
+  size_t GetCompletedUploadCount() const;
+
+ private:
+  struct Slot {
+    vk::UniqueCommandBuffer command_buffer;
+    vk::UniqueFence fence;
+    std::shared_ptr<const DeviceBuffer> source;
+    std::shared_ptr<const TextureSourceVK> destination;
+    fml::TimePoint submit_time;
+    size_t bytes = 0u;
+    bool in_flight = false;
+  };
+
+  std::weak_ptr<DeviceHolderVK> device_holder_;
+  const std::shared_ptr<QueueVK> transfer_queue_;
+  const uint32_t graphics_queue_family_;
+
+  mutable Mutex ring_mutex_;
+  vk::UniqueCommandPool command_pool_ IPLR_GUARDED_BY(ring_mutex_);
+  std::array<Slot, kRingSize> ring_ IPLR_GUARDED_BY(ring_mutex_);
+  size_t next_slot_ IPLR_GUARDED_BY(ring_mutex_) = 0u;
+  size_t completed_uploads_ IPLR_GUARDED_BY(ring_mutex_) = 0u;
+
+  Mutex acquires_mutex_;
+  PendingAcquires pending_acquires_ IPLR_GUARDED_BY(acquires_mutex_);
+
+  UploadQueueVK(std::weak_ptr<DeviceHolderVK> device_holder,
+                std::shared_ptr<QueueVK> transfer_queue,
+                uint32_t graphics_queue_family,
+                vk::UniqueCommandPool command_pool,
+                std::array<Slot, kRingSize> ring);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Release the resources of the slots whose uploads are done
+  ///             and report their latency and throughput.
+  ///
+  /// @param[in]  wait_for_next  Whether to block till the upload of the next
+  ///                            slot is done if it is still in flight.
+  ///
+  void CollectCompletedSlots(const vk::Device& device, bool wait_for_next)
+      IPLR_REQUIRES(ring_mutex_);
+
+  UploadQueueVK(const UploadQueueVK&) = delete;
+
+  UploadQueueVK& operator=(const UploadQueueVK&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_UPLOAD_QUEUE_VK_H_
@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "impeller/renderer/backend/vulkan/texture_vk.h"
+#include "impeller/renderer/backend/vulkan/upload_queue_vk.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+vk::QueueFamilyProperties MakeFamily(vk::QueueFlags flags) {
+  vk::QueueFamilyProperties family;
+  family.queueFlags = flags;
+  family.queueCount = 1u;
+  return family;
+}
+
+size_t CountCalls(const ContextVK& context, const std::string& name) {
+  auto functions = GetMockVulkanFunctions(context.GetDevice());
+  return std::count(functions->begin(), functions->end(), name);
+}
+
+}  // namespace
+
+TEST(UploadQueueVKTest, PicksDedicatedTransferQueue) {
+  const std::vector<vk::QueueFamilyProperties> families = {
+      MakeFamily(vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute |
+                 vk::QueueFlagBits::eTransfer),
+      MakeFamily(vk::QueueFlagBits::eCompute | vk::QueueFlagBits::eTransfer),
+      MakeFamily(vk::QueueFlagBits::eTransfer |
+                 vk::QueueFlagBits::eSparseBinding),
+  };
+
+  auto index = UploadQueueVK::PickQueue(families);
+
+  ASSERT_TRUE(index.has_value());
+  EXPECT_EQ(index->family, 2u);
+  EXPECT_EQ(index->index, 0u);
+}
+
+TEST(UploadQueueVKTest, DoesNotPickGraphicsOrComputeQueues) {
+  const std::vector<vk::QueueFamilyProperties> families = {
+      MakeFamily(vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute |
+                 vk::QueueFlagBits::eTransfer),
+      MakeFamily(vk::QueueFlagBits::eCompute | vk::QueueFlagBits::eTransfer),
+  };
+
+  EXPECT_FALSE(UploadQueueVK::PickQueue(families).has_value());
+}
+
+TEST(UploadQueueVKTest, DoesNotPickEmptyFamilies) {
+  vk::QueueFamilyProperties family = MakeFamily(vk::QueueFlagBits::eTransfer);
+  family.queueCount = 0u;
+
+  EXPECT_FALSE(UploadQueueVK::PickQueue({family}).has_value());
+}
+
+TEST(UploadQueueVKTest, NoUploadQueueWithoutDedicatedTransferQueue) {
+  // The mock device only has a single queue family that supports everything.
+  auto const context = MockVulkanContextBuilder().Build();
+
+  EXPECT_EQ(context->GetUploadQueue(), nullptr);
+}
+
+TEST(UploadQueueVKTest, SubmitAcquiresUploadedTextures) {
+  auto const context =
+      MockVulkanContextBuilder()
+          .SetQueueFamilies({
+              MakeFamily(vk::QueueFlagBits::eGraphics |
+                         vk::QueueFlagBits::eCompute |
+                         vk::QueueFlagBits::eTransfer),
+              MakeFamily(vk::QueueFlagBits::eTransfer),
+          })
+          .Build();
+  ASSERT_TRUE(context);
+  const auto& upload_queue = context->GetUploadQueue();
+  ASSERT_NE(upload_queue, nullptr);
+
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {100, 100};
+  desc.usage = TextureUsage::kShaderRead;
+  auto texture = context->GetResourceAllocator()->CreateTexture(desc);
+  ASSERT_TRUE(texture);
+  auto buffer = context->GetResourceAllocator()->CreateBuffer(
+      DeviceBufferDescriptor{
+          .storage_mode = StorageMode::kHostVisible,
+          .size = desc.GetByteSizeOfBaseMipLevel(),
+      });
+  ASSERT_TRUE(buffer);
+
+  ASSERT_TRUE(upload_queue->UploadTexture(
+      DeviceBuffer::AsBufferView(buffer),
+      TextureVK::Cast(*texture).GetTextureSource(), 0u));
+  EXPECT_EQ(TextureVK::Cast(*texture).GetLayout(),
+            vk::ImageLayout::eShaderReadOnlyOptimal);
+
+  const auto barriers = CountCalls(*context, "vkCmdPipelineBarrier");
+  const auto submits = CountCalls(*context, "vkQueueSubmit");
+  const auto waits = CountCalls(*context, "vkQueueSubmit.pWaitSemaphores");
+
+  auto cmd_buffer = context->CreateCommandBuffer();
+  ASSERT_TRUE(context->GetCommandQueue()->Submit({cmd_buffer}).ok());
+
+  // The acquire barrier is recorded in the same submission as the command
+  // buffer, which waits on the semaphore signaled by the upload.
+  EXPECT_EQ(CountCalls(*context, "vkCmdPipelineBarrier"), barriers + 1u);
+  EXPECT_EQ(CountCalls(*context, "vkQueueSubmit"), submits + 1u);
+  EXPECT_EQ(CountCalls(*context, "vkQueueSubmit.pWaitSemaphores"), waits + 1u);
+  EXPECT_TRUE(upload_queue->TakePendingAcquires().barriers.empty());
+}
+
+}  // namespace testing
+}  // namespace impeller
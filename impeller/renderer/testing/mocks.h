@@ -41,6 +41,8 @@ class MockDeviceBuffer : public DeviceBuffer {
 
 class MockAllocator : public Allocator {
  public:
+  using Allocator::NotifyMemoryPressure;
+
   MOCK_METHOD(ISize, GetMaxTextureSizeSupported, (), (const, override));
   MOCK_METHOD(std::shared_ptr<DeviceBuffer>,
               OnCreateBuffer,
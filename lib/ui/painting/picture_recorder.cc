@@ -6,6 +6,7 @@
 
 #include "flutter/lib/ui/painting/canvas.h"
 #include "flutter/lib/ui/painting/picture.h"
+#include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -26,8 +27,10 @@ PictureRecorder::PictureRecorder() {}
 PictureRecorder::~PictureRecorder() {}
 
 sk_sp<DisplayListBuilder> PictureRecorder::BeginRecording(SkRect bounds) {
+  auto& pool = UIDartState::Current()->GetDisplayListBuilderPool();
+  call_site_ = pool.NextCallSite();
   display_list_builder_ =
-      sk_make_sp<DisplayListBuilder>(bounds, /*prepare_rtree=*/true);
+      pool.Acquire(call_site_, bounds, /*prepare_rtree=*/true);
   return display_list_builder_;
 }
 
@@ -38,6 +41,8 @@ void PictureRecorder::endRecording(Dart_Handle dart_picture) {
 
   auto display_list = display_list_builder_->Build();
   display_list_builder_ = nullptr;
+  UIDartState::Current()->GetDisplayListBuilderPool().Record(call_site_,
+                                                             *display_list);
 
   FML_DCHECK(display_list->has_rtree());
   Picture::CreateAndAssociateWithDartWrapper(dart_picture, display_list);
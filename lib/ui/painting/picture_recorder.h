@@ -6,6 +6,7 @@
 #define FLUTTER_LIB_UI_PAINTING_PICTURE_RECORDER_H_
 
 #include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_builder_pool.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 
 namespace flutter {
@@ -30,6 +31,7 @@ class PictureRecorder : public RefCountedDartWrappable<PictureRecorder> {
   PictureRecorder();
 
   sk_sp<DisplayListBuilder> display_list_builder_;
+  DisplayListBuilderPool::CallSite call_site_ = 0u;
 
   fml::RefPtr<Canvas> canvas_;
 };
@@ -11,6 +11,7 @@
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/display_list/dl_builder_pool.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -137,6 +138,12 @@ class UIDartState : public tonic::DartState {
 
   std::shared_ptr<VolatilePathTracker> GetVolatilePathTracker() const;
 
+  /// The pool from which |PictureRecorder|s obtain pre-sized builders.
+  /// Must only be used on the UI task runner.
+  DisplayListBuilderPool& GetDisplayListBuilderPool() {
+    return display_list_builder_pool_;
+  }
+
   std::shared_ptr<fml::ConcurrentTaskRunner> GetConcurrentTaskRunner() const;
 
   fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> GetSnapshotDelegate() const;
@@ -207,6 +214,7 @@ class UIDartState : public tonic::DartState {
   LogMessageCallback log_message_callback_;
   const std::shared_ptr<IsolateNameServer> isolate_name_server_;
   UIDartState::Context context_;
+  DisplayListBuilderPool display_list_builder_pool_;
 
   void AddOrRemoveTaskObserver(bool add);
 };
@@ -377,6 +377,8 @@ void PlatformConfiguration::BeginFrame(fml::TimePoint frameTime,
   }
   tonic::DartState::Scope scope(dart_state);
 
+  UIDartState::Current()->GetDisplayListBuilderPool().BeginFrame();
+
   int64_t microseconds = (frameTime - fml::TimePoint()).ToMicroseconds();
 
   tonic::CheckAndHandleError(
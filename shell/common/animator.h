@@ -45,9 +45,18 @@ class Animator final {
         std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) = 0;
   };
 
+  //--------------------------------------------------------------------------
+  /// @brief    Creates an animator.
+  ///
+  /// @param[in]  max_pipeline_depth  The largest depth the frame pipeline can
+  ///                                 be adapted to while the animator runs,
+  ///                                 see `FramePipeline::SetDepth`. 0 keeps
+  ///                                 the depth fixed.
+  ///
   Animator(Delegate& delegate,
            const TaskRunners& task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+           std::unique_ptr<VsyncWaiter> waiter,
+           uint32_t max_pipeline_depth = 0);
 
   ~Animator();
 
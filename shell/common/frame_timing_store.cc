@@ -0,0 +1,152 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_timing_store.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace flutter {
+
+// Fine grained around the common frame budgets of 8ms, 11ms and 16ms.
+const std::array<int64_t, FrameTimingStore::kBucketCount>
+    FrameTimingStore::kBucketUpperBoundsMicros = {
+        500,    1000,   2000,   4000,    6000,    8000,
+        10000,  12000,  14000,  16000,   20000,   25000,
+        33000,  50000,  100000, INT64_MAX,
+};
+
+namespace {
+
+int64_t ToMicros(fml::TimeDelta delta) {
+  return std::max<int64_t>(delta.ToMicroseconds(), 0);
+}
+
+}  // namespace
+
+int64_t FrameTimingStore::Histogram::PercentileMicros(
+    double percentile) const {
+  if (count == 0) {
+    return 0;
+  }
+  uint64_t rank = static_cast<uint64_t>(
+      std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * count));
+  rank = std::max<uint64_t>(rank, 1);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    seen += bucket_counts[i];
+    if (seen >= rank) {
+      return std::min(kBucketUpperBoundsMicros[i], max_micros);
+    }
+  }
+  return max_micros;
+}
+
+void FrameTimingStore::AtomicHistogram::Add(int64_t micros) {
+  size_t bucket = std::lower_bound(kBucketUpperBoundsMicros.begin(),
+                                   kBucketUpperBoundsMicros.end(), micros) -
+                  kBucketUpperBoundsMicros.begin();
+  bucket_counts[bucket].fetch_add(1, std::memory_order_relaxed);
+  sum_micros.fetch_add(micros, std::memory_order_relaxed);
+  // There is a single writer, so the maximum cannot change concurrently.
+  if (micros > max_micros.load(std::memory_order_relaxed)) {
+    max_micros.store(micros, std::memory_order_relaxed);
+  }
+  count.fetch_add(1, std::memory_order_relaxed);
+}
+
+FrameTimingStore::FrameTimingStore() = default;
+
+FrameTimingStore::~FrameTimingStore() = default;
+
+void FrameTimingStore::Record(const FrameTiming& timing) {
+  uint64_t index = write_count_.load(std::memory_order_relaxed);
+  Slot& slot = slots_[index % kCapacity];
+
+  slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (FrameTiming::Phase phase : FrameTiming::kPhases) {
+    slot.phases[phase].store(timing.Get(phase).ToEpochDelta().ToNanoseconds(),
+                             std::memory_order_relaxed);
+  }
+  slot.frame_number.store(timing.GetFrameNumber(), std::memory_order_relaxed);
+  slot.layer_cache_count.store(timing.GetLayerCacheCount(),
+                               std::memory_order_relaxed);
+  slot.layer_cache_bytes.store(timing.GetLayerCacheBytes(),
+                               std::memory_order_relaxed);
+  slot.picture_cache_count.store(timing.GetPictureCacheCount(),
+                                 std::memory_order_relaxed);
+  slot.picture_cache_bytes.store(timing.GetPictureCacheBytes(),
+                                 std::memory_order_relaxed);
+  slot.sequence.store(2 * index + 2, std::memory_order_release);
+  write_count_.store(index + 1, std::memory_order_release);
+
+  fml::TimePoint vsync_start = timing.Get(FrameTiming::kVsyncStart);
+  fml::TimePoint build_start = timing.Get(FrameTiming::kBuildStart);
+  fml::TimePoint raster_finish = timing.Get(FrameTiming::kRasterFinish);
+  histograms_[static_cast<size_t>(Phase::kVsyncToBuildStart)].Add(
+      ToMicros(build_start - vsync_start));
+  histograms_[static_cast<size_t>(Phase::kBuild)].Add(
+      ToMicros(timing.Get(FrameTiming::kBuildFinish) - build_start));
+  histograms_[static_cast<size_t>(Phase::kRaster)].Add(
+      ToMicros(raster_finish - timing.Get(FrameTiming::kRasterStart)));
+  histograms_[static_cast<size_t>(Phase::kVsyncToRasterFinish)].Add(
+      ToMicros(raster_finish - vsync_start));
+}
+
+uint64_t FrameTimingStore::GetRecordedFrameCount() const {
+  return write_count_.load(std::memory_order_acquire);
+}
+
+std::vector<FrameTiming> FrameTimingStore::GetRecentFrames() const {
+  uint64_t end = write_count_.load(std::memory_order_acquire);
+  uint64_t begin = end > kCapacity ? end - kCapacity : 0;
+
+  std::vector<FrameTiming> frames;
+  frames.reserve(end - begin);
+  for (uint64_t index = begin; index < end; index++) {
+    const Slot& slot = slots_[index % kCapacity];
+    uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != 2 * index + 2) {
+      // The slot has already been reused for a newer frame.
+      continue;
+    }
+
+    FrameTiming timing;
+    for (FrameTiming::Phase phase : FrameTiming::kPhases) {
+      int64_t nanos = slot.phases[phase].load(std::memory_order_relaxed);
+      timing.Set(phase, fml::TimePoint::FromEpochDelta(
+                            fml::TimeDelta::FromNanoseconds(nanos)));
+    }
+    timing.SetFrameNumber(slot.frame_number.load(std::memory_order_relaxed));
+    timing.SetRasterCacheStatistics(
+        slot.layer_cache_count.load(std::memory_order_relaxed),
+        slot.layer_cache_bytes.load(std::memory_order_relaxed),
+        slot.picture_cache_count.load(std::memory_order_relaxed),
+        slot.picture_cache_bytes.load(std::memory_order_relaxed));
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+      // The slot was overwritten while it was being copied.
+      continue;
+    }
+    frames.push_back(timing);
+  }
+  return frames;
+}
+
+FrameTimingStore::Histogram FrameTimingStore::GetHistogram(Phase phase) const {
+  const AtomicHistogram& source = histograms_[static_cast<size_t>(phase)];
+  Histogram histogram;
+  histogram.count = source.count.load(std::memory_order_relaxed);
+  histogram.sum_micros = source.sum_micros.load(std::memory_order_relaxed);
+  histogram.max_micros = source.max_micros.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < kBucketCount; i++) {
+    histogram.bucket_counts[i] =
+        source.bucket_counts[i].load(std::memory_order_relaxed);
+  }
+  return histogram;
+}
+
+}  // namespace flutter
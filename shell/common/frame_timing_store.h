@@ -0,0 +1,124 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_TIMING_STORE_H_
+#define FLUTTER_SHELL_COMMON_FRAME_TIMING_STORE_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A fixed-size store of the timings of the most recently rasterized frames,
+/// along with latency histograms of every frame recorded since the store was
+/// created.
+///
+/// Frames are recorded by a single writer, the raster thread, and may be read
+/// from any thread at any time without blocking the writer. Readers never see
+/// a partially written frame: a frame that is overwritten while it is being
+/// read is skipped.
+///
+class FrameTimingStore {
+ public:
+  /// The number of recent frames that are retained.
+  static constexpr size_t kCapacity = 256;
+
+  enum class Phase {
+    /// From the vsync to the start of the build on the UI thread.
+    kVsyncToBuildStart,
+    /// The build on the UI thread.
+    kBuild,
+    /// The rasterization on the raster thread.
+    kRaster,
+    /// From the vsync to the end of the rasterization.
+    kVsyncToRasterFinish,
+  };
+  static constexpr size_t kPhaseCount = 4;
+
+  /// The number of buckets of each histogram.
+  static constexpr size_t kBucketCount = 16;
+
+  /// The inclusive upper bound of each bucket, in microseconds. The last
+  /// bucket is unbounded.
+  static const std::array<int64_t, kBucketCount> kBucketUpperBoundsMicros;
+
+  struct Histogram {
+    uint64_t count = 0;
+    int64_t sum_micros = 0;
+    int64_t max_micros = 0;
+    std::array<uint64_t, kBucketCount> bucket_counts = {};
+
+    /// The upper bound of the bucket that contains the given percentile
+    /// (0 to 100) of the recorded durations, or |max_micros| if that is
+    /// smaller. 0 if no durations have been recorded.
+    int64_t PercentileMicros(double percentile) const;
+  };
+
+  FrameTimingStore();
+
+  ~FrameTimingStore();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the timings of a rasterized frame. Must not be
+  ///             called concurrently with itself.
+  ///
+  void Record(const FrameTiming& timing);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The total number of frames recorded, including those that
+  ///             are no longer retained.
+  ///
+  uint64_t GetRecordedFrameCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copies the retained frames, oldest first.
+  ///
+  std::vector<FrameTiming> GetRecentFrames() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copies the histogram of a phase. The counters are updated
+  ///             independently, so a histogram copied while a frame is being
+  ///             recorded may only partially include that frame.
+  ///
+  Histogram GetHistogram(Phase phase) const;
+
+ private:
+  // A seqlock protected copy of a |FrameTiming|. |sequence| is odd while the
+  // slot is being written and |2 * index + 2| once the frame with the given
+  // index has been written to it.
+  struct Slot {
+    std::atomic<uint64_t> sequence = 0;
+    std::atomic<int64_t> phases[FrameTiming::kCount] = {};
+    std::atomic<uint64_t> frame_number = 0;
+    std::atomic<uint64_t> layer_cache_count = 0;
+    std::atomic<uint64_t> layer_cache_bytes = 0;
+    std::atomic<uint64_t> picture_cache_count = 0;
+    std::atomic<uint64_t> picture_cache_bytes = 0;
+  };
+
+  struct AtomicHistogram {
+    std::atomic<uint64_t> count = 0;
+    std::atomic<int64_t> sum_micros = 0;
+    std::atomic<int64_t> max_micros = 0;
+    std::atomic<uint64_t> bucket_counts[kBucketCount] = {};
+
+    void Add(int64_t micros);
+  };
+
+  std::atomic<uint64_t> write_count_ = 0;
+  Slot slots_[kCapacity];
+  AtomicHistogram histograms_[kPhaseCount];
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameTimingStore);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_TIMING_STORE_H_
@@ -0,0 +1,144 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_timing_store.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+fml::TimePoint TimeAt(int64_t millis) {
+  return fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(millis));
+}
+
+// Returns a frame that starts at |start_ms| and spends |build_ms| building and
+// |raster_ms| rasterizing.
+FrameTiming MakeFrameTiming(uint64_t frame_number,
+                            int64_t start_ms,
+                            int64_t build_ms,
+                            int64_t raster_ms) {
+  FrameTiming timing;
+  timing.SetFrameNumber(frame_number);
+  timing.Set(FrameTiming::kVsyncStart, TimeAt(start_ms));
+  timing.Set(FrameTiming::kBuildStart, TimeAt(start_ms + 1));
+  timing.Set(FrameTiming::kBuildFinish, TimeAt(start_ms + 1 + build_ms));
+  timing.Set(FrameTiming::kRasterStart, TimeAt(start_ms + 1 + build_ms));
+  timing.Set(FrameTiming::kRasterFinish,
+             TimeAt(start_ms + 1 + build_ms + raster_ms));
+  timing.Set(FrameTiming::kRasterFinishWallTime,
+             TimeAt(start_ms + 1 + build_ms + raster_ms));
+  timing.SetRasterCacheStatistics(frame_number, 2 * frame_number, 3, 4);
+  return timing;
+}
+
+}  // namespace
+
+TEST(FrameTimingStoreTest, StartsEmpty) {
+  FrameTimingStore store;
+  EXPECT_EQ(store.GetRecordedFrameCount(), 0u);
+  EXPECT_TRUE(store.GetRecentFrames().empty());
+  FrameTimingStore::Histogram histogram =
+      store.GetHistogram(FrameTimingStore::Phase::kBuild);
+  EXPECT_EQ(histogram.count, 0u);
+  EXPECT_EQ(histogram.PercentileMicros(50), 0);
+}
+
+TEST(FrameTimingStoreTest, RecordsFrames) {
+  FrameTimingStore store;
+  store.Record(MakeFrameTiming(1, 0, 5, 3));
+  store.Record(MakeFrameTiming(2, 16, 7, 9));
+
+  std::vector<FrameTiming> frames = store.GetRecentFrames();
+  ASSERT_EQ(frames.size(), 2u);
+  EXPECT_EQ(frames[0].GetFrameNumber(), 1u);
+  EXPECT_EQ(frames[1].GetFrameNumber(), 2u);
+  EXPECT_EQ(frames[1].Get(FrameTiming::kVsyncStart), TimeAt(16));
+  EXPECT_EQ(frames[1].Get(FrameTiming::kRasterFinish), TimeAt(33));
+  EXPECT_EQ(frames[1].GetLayerCacheCount(), 2u);
+  EXPECT_EQ(frames[1].GetLayerCacheBytes(), 4u);
+  EXPECT_EQ(frames[1].GetPictureCacheCount(), 3u);
+  EXPECT_EQ(frames[1].GetPictureCacheBytes(), 4u);
+}
+
+TEST(FrameTimingStoreTest, RetainsMostRecentFrames) {
+  FrameTimingStore store;
+  const uint64_t frame_count = FrameTimingStore::kCapacity + 10;
+  for (uint64_t i = 0; i < frame_count; i++) {
+    store.Record(MakeFrameTiming(i, i * 16, 4, 4));
+  }
+  EXPECT_EQ(store.GetRecordedFrameCount(), frame_count);
+
+  std::vector<FrameTiming> frames = store.GetRecentFrames();
+  ASSERT_EQ(frames.size(), FrameTimingStore::kCapacity);
+  EXPECT_EQ(frames.front().GetFrameNumber(), 10u);
+  EXPECT_EQ(frames.back().GetFrameNumber(), frame_count - 1);
+
+  // The histograms include frames that are no longer retained.
+  EXPECT_EQ(store.GetHistogram(FrameTimingStore::Phase::kRaster).count,
+            frame_count);
+}
+
+TEST(FrameTimingStoreTest, HistogramsMeasurePhases) {
+  FrameTimingStore store;
+  for (int i = 0; i < 9; i++) {
+    store.Record(MakeFrameTiming(i, i * 16, 3, 5));
+  }
+  store.Record(MakeFrameTiming(9, 144, 30, 5));
+
+  FrameTimingStore::Histogram vsync_to_build_start =
+      store.GetHistogram(FrameTimingStore::Phase::kVsyncToBuildStart);
+  EXPECT_EQ(vsync_to_build_start.count, 10u);
+  EXPECT_EQ(vsync_to_build_start.sum_micros, 10000);
+  EXPECT_EQ(vsync_to_build_start.max_micros, 1000);
+
+  FrameTimingStore::Histogram build =
+      store.GetHistogram(FrameTimingStore::Phase::kBuild);
+  EXPECT_EQ(build.count, 10u);
+  EXPECT_EQ(build.max_micros, 30000);
+  // 3ms falls in the (2ms, 4ms] bucket.
+  EXPECT_EQ(build.PercentileMicros(50), 4000);
+  EXPECT_EQ(build.PercentileMicros(90), 4000);
+  // 30ms falls in the (25ms, 33ms] bucket, but no frame took longer than
+  // 30ms.
+  EXPECT_EQ(build.PercentileMicros(99), 30000);
+
+  FrameTimingStore::Histogram total =
+      store.GetHistogram(FrameTimingStore::Phase::kVsyncToRasterFinish);
+  EXPECT_EQ(total.max_micros, 36000);
+}
+
+TEST(FrameTimingStoreTest, CanBeReadWhileRecording) {
+  FrameTimingStore store;
+  const uint64_t frame_count = 20 * FrameTimingStore::kCapacity;
+  std::thread writer([&store]() {
+    for (uint64_t i = 0; i < frame_count; i++) {
+      store.Record(MakeFrameTiming(i, i, 1, 1));
+    }
+  });
+
+  while (store.GetRecordedFrameCount() < frame_count) {
+    std::vector<FrameTiming> frames = store.GetRecentFrames();
+    ASSERT_LE(frames.size(), FrameTimingStore::kCapacity);
+    for (size_t i = 0; i < frames.size(); i++) {
+      // Every frame is copied in its entirety.
+      uint64_t frame_number = frames[i].GetFrameNumber();
+      ASSERT_EQ(frames[i].Get(FrameTiming::kVsyncStart),
+                TimeAt(static_cast<int64_t>(frame_number)));
+      ASSERT_EQ(frames[i].GetLayerCacheBytes(), 2 * frame_number);
+      if (i > 0) {
+        ASSERT_GT(frame_number, frames[i - 1].GetFrameNumber());
+      }
+    }
+  }
+  writer.join();
+}
+
+}  // namespace testing
+}  // namespace flutter
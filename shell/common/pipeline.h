@@ -5,6 +5,7 @@
 #ifndef FLUTTER_SHELL_COMMON_PIPELINE_H_
 #define FLUTTER_SHELL_COMMON_PIPELINE_H_
 
+#include <algorithm>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -39,6 +40,12 @@ size_t GetNextPipelineTraceID();
 /// A thread-safe queue of resources for a single consumer and a single
 /// producer, with a maximum queue depth.
 ///
+/// The depth may be changed while the pipeline is in use with |SetDepth|, up
+/// to the maximum depth the pipeline was created with. Lowering the depth
+/// below the number of resources in flight does not drop any of them, it
+/// only prevents new resources from being produced until enough of them have
+/// been consumed.
+///
 /// Pipelines support two key operations: produce and consume.
 ///
 /// The consumer calls |Consume| to wait for a resource to be produced and
@@ -128,20 +135,42 @@ class Pipeline {
     FML_DISALLOW_COPY_AND_ASSIGN(ProducerContinuation);
   };
 
-  explicit Pipeline(uint32_t depth)
-      : empty_(depth), available_(0), inflight_(0) {}
+  explicit Pipeline(uint32_t depth, uint32_t max_depth = 0)
+      : empty_(std::max(depth, max_depth)),
+        available_(0),
+        inflight_(0),
+        depth_(depth),
+        max_depth_(std::max(depth, max_depth)) {}
 
   ~Pipeline() = default;
 
   bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
 
+  /// The number of resources that may be in flight before |Produce| fails.
+  uint32_t GetDepth() const { return depth_.load(); }
+
+  /// The largest depth |SetDepth| accepts.
+  uint32_t GetMaxDepth() const { return max_depth_; }
+
+  /// Sets the number of resources that may be in flight, clamped to
+  /// [1, |GetMaxDepth|]. May be called from any thread.
+  void SetDepth(uint32_t depth) {
+    depth = std::clamp(depth, 1u, max_depth_);
+    if (depth_.exchange(depth) != depth) {
+      FML_TRACE_COUNTER("flutter", "Pipeline Max Depth",
+                        reinterpret_cast<int64_t>(this),  //
+                        "max frames in flight", depth     //
+      );
+    }
+  }
+
   /// Creates a `ProducerContinuation` that a producer can use to add a
   /// resource to the queue.
   ///
   /// If the queue is already at its maximum depth, the `ProducerContinuation`
   /// is returned with success = false.
   ProducerContinuation Produce() {
-    if (!empty_.TryWait()) {
+    if (!HasCapacity() || !empty_.TryWait()) {
       return {};
     }
     ++inflight_;
@@ -162,7 +191,7 @@ class Pipeline {
   /// Prefer using |Produce|. ProducerContinuation returned by this method
   /// doesn't guarantee that the frame will be rendered.
   ProducerContinuation ProduceIfEmpty() {
-    if (!empty_.TryWait()) {
+    if (!HasCapacity() || !empty_.TryWait()) {
       return {};
     }
     ++inflight_;
@@ -216,9 +245,17 @@ class Pipeline {
   fml::Semaphore empty_;
   fml::Semaphore available_;
   std::atomic<int> inflight_;
+  std::atomic<uint32_t> depth_;
+  const uint32_t max_depth_;
   std::mutex queue_mutex_;
   std::deque<std::pair<ResourcePtr, size_t>> queue_;
 
+  /// Whether fewer resources than the current depth are in flight. The
+  /// |empty_| semaphore enforces the maximum depth.
+  bool HasCapacity() const {
+    return inflight_.load() < static_cast<int>(depth_.load());
+  }
+
   /// Commits a produced resource to the queue and signals the consumer that a
   /// resource is available.
   PipelineProduceResult ProducerCommit(ResourcePtr resource, size_t trace_id) {
@@ -0,0 +1,75 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pipeline_depth_policy.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// The weight of the latest frame in the moving averages.
+constexpr double kAverageWeight = 0.1;
+
+}  // namespace
+
+PipelineDepthPolicy::PipelineDepthPolicy(uint32_t min_depth,
+                                         uint32_t max_depth,
+                                         uint32_t initial_depth)
+    : min_depth_(std::max(min_depth, 1u)),
+      max_depth_(std::max(max_depth, min_depth_)),
+      depth_(std::clamp(initial_depth, min_depth_, max_depth_)) {}
+
+PipelineDepthPolicy::~PipelineDepthPolicy() = default;
+
+bool PipelineDepthPolicy::OnFrameRasterized(fml::TimeDelta build_duration,
+                                            fml::TimeDelta raster_duration,
+                                            fml::TimeDelta frame_budget) {
+  double build_ms = build_duration.ToMillisecondsF();
+  double raster_ms = raster_duration.ToMillisecondsF();
+  if (has_averages_) {
+    average_build_ms_ += kAverageWeight * (build_ms - average_build_ms_);
+    average_raster_ms_ += kAverageWeight * (raster_ms - average_raster_ms_);
+  } else {
+    average_build_ms_ = build_ms;
+    average_raster_ms_ = raster_ms;
+    has_averages_ = true;
+  }
+
+  uint32_t old_depth = depth_;
+  if (build_duration > frame_budget) {
+    // A build spike. Let the UI thread get ahead of the raster thread so
+    // that the next spike does not cost a frame.
+    raster_bound_frames_ = 0;
+    if (depth_ < max_depth_) {
+      SetDepth(depth_ + 1, "BuildSpike");
+    }
+  } else if (average_raster_ms_ > average_build_ms_) {
+    if (++raster_bound_frames_ >= kRasterBoundFramesBeforeShrink) {
+      raster_bound_frames_ = 0;
+      if (depth_ > min_depth_) {
+        SetDepth(depth_ - 1, "RasterBound");
+      }
+    }
+  } else {
+    raster_bound_frames_ = 0;
+  }
+  return depth_ != old_depth;
+}
+
+void PipelineDepthPolicy::SetDepth(uint32_t depth, const char* reason) {
+  FML_DCHECK(depth >= min_depth_ && depth <= max_depth_);
+  depth_ = depth;
+  TRACE_EVENT_INSTANT1("flutter", "PipelineDepthChanged", "reason", reason);
+  FML_TRACE_COUNTER("flutter", "Pipeline Target Depth",
+                    reinterpret_cast<int64_t>(this),  //
+                    "depth", depth_                   //
+  );
+}
+
+}  // namespace flutter
@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_PIPELINE_DEPTH_POLICY_H_
+#define FLUTTER_SHELL_COMMON_PIPELINE_DEPTH_POLICY_H_
+
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Chooses the depth of the frame pipeline from the build and raster
+/// durations of recent frames.
+///
+/// A deeper pipeline lets the UI thread build frames ahead of the raster
+/// thread, which absorbs occasional slow builds at the cost of latency. That
+/// only pays off while the UI thread is the bottleneck: when rasterization is
+/// the slower phase the extra frames just wait in the queue.
+///
+/// The policy grows the depth by one whenever a frame's build takes longer
+/// than the frame budget. It shrinks the depth by one after
+/// |kRasterBoundFramesBeforeShrink| consecutive frames without a build spike
+/// in which the average raster duration exceeded the average build
+/// duration. The policy starts at the depth the pipeline was created with
+/// and always stays within the bounds the policy was created with.
+///
+/// Depth changes are reported on the timeline as `PipelineDepthChanged`
+/// instant events and the `Pipeline Target Depth` counter.
+///
+class PipelineDepthPolicy {
+ public:
+  static constexpr int kRasterBoundFramesBeforeShrink = 60;
+
+  PipelineDepthPolicy(uint32_t min_depth,
+                      uint32_t max_depth,
+                      uint32_t initial_depth);
+
+  ~PipelineDepthPolicy();
+
+  uint32_t min_depth() const { return min_depth_; }
+
+  uint32_t max_depth() const { return max_depth_; }
+
+  /// The depth the pipeline should currently have.
+  uint32_t depth() const { return depth_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Updates the policy with the durations of a rasterized frame.
+  ///
+  /// @param[in]  build_duration   The time the UI thread spent building the
+  ///                              frame.
+  /// @param[in]  raster_duration  The time the raster thread spent
+  ///                              rasterizing the frame.
+  /// @param[in]  frame_budget     The time between vsyncs.
+  ///
+  /// @return     Whether |depth| changed.
+  ///
+  bool OnFrameRasterized(fml::TimeDelta build_duration,
+                         fml::TimeDelta raster_duration,
+                         fml::TimeDelta frame_budget);
+
+ private:
+  const uint32_t min_depth_;
+  const uint32_t max_depth_;
+  uint32_t depth_;
+  // Exponential moving averages of the build and raster durations in
+  // milliseconds.
+  double average_build_ms_ = 0.0;
+  double average_raster_ms_ = 0.0;
+  bool has_averages_ = false;
+  int raster_bound_frames_ = 0;
+
+  void SetDepth(uint32_t depth, const char* reason);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PipelineDepthPolicy);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_PIPELINE_DEPTH_POLICY_H_
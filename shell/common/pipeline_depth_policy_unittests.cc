@@ -0,0 +1,94 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pipeline_depth_policy.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::TimeDelta kBudget = fml::TimeDelta::FromMilliseconds(16);
+
+fml::TimeDelta Ms(int64_t millis) {
+  return fml::TimeDelta::FromMilliseconds(millis);
+}
+
+}  // namespace
+
+TEST(PipelineDepthPolicyTest, StartsAtInitialDepthWithinBounds) {
+  EXPECT_EQ(PipelineDepthPolicy(1, 4, 1).depth(), 1u);
+  EXPECT_EQ(PipelineDepthPolicy(1, 4, 2).depth(), 2u);
+  EXPECT_EQ(PipelineDepthPolicy(3, 4, 2).depth(), 3u);
+  EXPECT_EQ(PipelineDepthPolicy(1, 1, 2).depth(), 1u);
+}
+
+TEST(PipelineDepthPolicyTest, SanitizesBounds) {
+  PipelineDepthPolicy policy(0, 0, 2);
+  EXPECT_EQ(policy.min_depth(), 1u);
+  EXPECT_EQ(policy.max_depth(), 1u);
+  EXPECT_EQ(policy.depth(), 1u);
+}
+
+TEST(PipelineDepthPolicyTest, GrowsOnBuildSpikes) {
+  PipelineDepthPolicy policy(1, 3, 2);
+  EXPECT_FALSE(policy.OnFrameRasterized(Ms(4), Ms(4), kBudget));
+  EXPECT_EQ(policy.depth(), 2u);
+
+  EXPECT_TRUE(policy.OnFrameRasterized(Ms(30), Ms(4), kBudget));
+  EXPECT_EQ(policy.depth(), 3u);
+
+  // The depth never exceeds the maximum.
+  EXPECT_FALSE(policy.OnFrameRasterized(Ms(30), Ms(4), kBudget));
+  EXPECT_EQ(policy.depth(), 3u);
+}
+
+TEST(PipelineDepthPolicyTest, ShrinksWhenRasterBound) {
+  PipelineDepthPolicy policy(1, 3, 2);
+  for (int i = 1; i < PipelineDepthPolicy::kRasterBoundFramesBeforeShrink;
+       i++) {
+    EXPECT_FALSE(policy.OnFrameRasterized(Ms(2), Ms(12), kBudget));
+  }
+  EXPECT_TRUE(policy.OnFrameRasterized(Ms(2), Ms(12), kBudget));
+  EXPECT_EQ(policy.depth(), 1u);
+
+  // The depth never drops below the minimum.
+  for (int i = 0; i < PipelineDepthPolicy::kRasterBoundFramesBeforeShrink;
+       i++) {
+    EXPECT_FALSE(policy.OnFrameRasterized(Ms(2), Ms(12), kBudget));
+  }
+  EXPECT_EQ(policy.depth(), 1u);
+}
+
+TEST(PipelineDepthPolicyTest, BuildSpikeResetsRasterBoundStreak) {
+  PipelineDepthPolicy policy(1, 3, 2);
+  for (int i = 1; i < PipelineDepthPolicy::kRasterBoundFramesBeforeShrink;
+       i++) {
+    policy.OnFrameRasterized(Ms(2), Ms(12), kBudget);
+  }
+  EXPECT_TRUE(policy.OnFrameRasterized(Ms(20), Ms(12), kBudget));
+  EXPECT_EQ(policy.depth(), 3u);
+
+  // A full streak of raster bound frames is needed again before shrinking.
+  for (int i = 1; i < PipelineDepthPolicy::kRasterBoundFramesBeforeShrink;
+       i++) {
+    EXPECT_FALSE(policy.OnFrameRasterized(Ms(2), Ms(12), kBudget));
+  }
+  EXPECT_TRUE(policy.OnFrameRasterized(Ms(2), Ms(12), kBudget));
+  EXPECT_EQ(policy.depth(), 2u);
+}
+
+TEST(PipelineDepthPolicyTest, KeepsDepthWhenUIBound) {
+  PipelineDepthPolicy policy(1, 3, 2);
+  for (int i = 0; i < 2 * PipelineDepthPolicy::kRasterBoundFramesBeforeShrink;
+       i++) {
+    EXPECT_FALSE(policy.OnFrameRasterized(Ms(12), Ms(2), kBudget));
+  }
+  EXPECT_EQ(policy.depth(), 2u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -144,5 +144,50 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, DepthCanBeAdjustedUpToMaxDepth) {
+  std::shared_ptr<IntPipeline> pipeline =
+      std::make_shared<IntPipeline>(/*depth=*/1, /*max_depth=*/3);
+  ASSERT_EQ(pipeline->GetDepth(), 1u);
+  ASSERT_EQ(pipeline->GetMaxDepth(), 3u);
+
+  Continuation continuation_1 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1);
+  ASSERT_FALSE(pipeline->Produce());
+
+  pipeline->SetDepth(2);
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_TRUE(continuation_2);
+  ASSERT_FALSE(pipeline->Produce());
+
+  // The depth is clamped to the maximum depth.
+  pipeline->SetDepth(10);
+  ASSERT_EQ(pipeline->GetDepth(), 3u);
+  Continuation continuation_3 = pipeline->Produce();
+  ASSERT_TRUE(continuation_3);
+  ASSERT_FALSE(pipeline->Produce());
+}
+
+TEST(PipelineTest, ShrinkingDepthKeepsResourcesInFlight) {
+  std::shared_ptr<IntPipeline> pipeline =
+      std::make_shared<IntPipeline>(/*depth=*/2, /*max_depth=*/2);
+
+  Continuation continuation_1 = pipeline->Produce();
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)).success);
+  ASSERT_TRUE(continuation_2.Complete(std::make_unique<int>(2)).success);
+
+  pipeline->SetDepth(0);
+  ASSERT_EQ(pipeline->GetDepth(), 1u);
+
+  ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) { ASSERT_EQ(*v, 1); }),
+            PipelineConsumeResult::MoreAvailable);
+  // One resource is still in flight, which is the new depth.
+  ASSERT_FALSE(pipeline->Produce());
+
+  ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) { ASSERT_EQ(*v, 2); }),
+            PipelineConsumeResult::Done);
+  ASSERT_TRUE(pipeline->Produce());
+}
+
 }  // namespace testing
 }  // namespace flutter
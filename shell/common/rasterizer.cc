@@ -5,13 +5,17 @@
 #include "flutter/shell/common/rasterizer.h"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
+#include <thread>
 #include <utility>
 
 #include "display_list/dl_builder.h"
 #include "flow/frame_timings.h"
 #include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/display_list/benchmarking/dl_complexity_model.h"
+#include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/offscreen_surface.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
@@ -19,6 +23,7 @@
 #include "flutter/shell/common/serialization_callbacks.h"
 #include "fml/closure.h"
 #include "fml/make_copyable.h"
+#include "fml/synchronization/count_down_latch.h"
 #include "fml/synchronization/waitable_event.h"
 #include "third_party/skia/include/core/SkColorSpace.h"
 #include "third_party/skia/include/core/SkData.h"
@@ -59,6 +64,21 @@ Rasterizer::Rasterizer(Delegate& delegate,
           SnapshotController::Make(*this, delegate.GetSettings())),
       weak_factory_(this) {
   FML_DCHECK(compositor_context_);
+#if !SLIMPELLER
+  const std::string& cost_model =
+      delegate.GetSettings().raster_cache_cost_model;
+  if (!cost_model.empty()) {
+    auto* calculator =
+        DisplayListModelComplexityCalculator::GetInstance(cost_model);
+    if (!calculator) {
+      FML_LOG(ERROR) << "Unknown raster cache cost model \"" << cost_model
+                     << "\", using the default complexity calculator.";
+    }
+    compositor_context_->raster_cache().SetComplexityCalculator(calculator);
+  }
+  compositor_context_->raster_cache().SetScaleBand(
+      static_cast<float>(delegate.GetSettings().raster_cache_scale_band));
+#endif  //  !SLIMPELLER
 }
 
 Rasterizer::~Rasterizer() = default;
@@ -72,6 +92,17 @@ fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> Rasterizer::GetSnapshotDelegate()
   return weak_factory_.GetWeakPtr();
 }
 
+void Rasterizer::SetWorkerTaskRunner(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+#if !SLIMPELLER
+  if (delegate_.GetSettings().enable_raster_cache_background_population) {
+    compositor_context_->raster_cache().EnableBackgroundPopulation(
+        task_runner);
+  }
+#endif  //  !SLIMPELLER
+  worker_task_runner_ = std::move(task_runner);
+}
+
 void Rasterizer::SetImpellerContext(
     std::weak_ptr<impeller::Context> impeller_context) {
   impeller_context_ = std::move(impeller_context);
@@ -253,6 +284,15 @@ DrawStatus Rasterizer::Draw(const std::shared_ptr<FramePipeline>& pipeline) {
                  .GetRasterTaskRunner()
                  ->RunsTasksOnCurrentThread());
 
+  const Settings& settings = delegate_.GetSettings();
+  if (!pipeline_depth_policy_ && settings.frame_pipeline_max_depth > 0) {
+    // Start from the depth the animator picked for the pipeline, which is
+    // shallower when the platform and raster threads are the same.
+    pipeline_depth_policy_ = std::make_unique<PipelineDepthPolicy>(
+        settings.frame_pipeline_min_depth, settings.frame_pipeline_max_depth,
+        pipeline->GetDepth());
+  }
+
   DoDrawResult draw_result;
   FramePipeline::Consumer consumer = [&draw_result,
                                       this](std::unique_ptr<FrameItem> item) {
@@ -264,6 +304,9 @@ DrawStatus Rasterizer::Draw(const std::shared_ptr<FramePipeline>& pipeline) {
   if (consume_result == PipelineConsumeResult::NoneAvailable) {
     return DrawStatus::kPipelineEmpty;
   }
+  if (pipeline_depth_policy_) {
+    pipeline->SetDepth(pipeline_depth_policy_->depth());
+  }
   // if the raster status is to resubmit the frame, we push the frame to the
   // front of the queue and also change the consume status to more available.
 
@@ -509,6 +552,14 @@ Rasterizer::DoDrawResult Rasterizer::DoDraw(
   // for Fuchsia to capture SceneUpdateContext::ExecutePaintTasks.
   delegate_.OnFrameRasterized(frame_timings_recorder->GetRecordedTime());
 
+  if (pipeline_depth_policy_) {
+    pipeline_depth_policy_->OnFrameRasterized(
+        frame_timings_recorder->GetBuildDuration(),
+        frame_timings_recorder->GetRasterEndTime() -
+            frame_timings_recorder->GetRasterStartTime(),
+        fml::TimeDelta::FromMillisecondsF(delegate_.GetFrameBudget().count()));
+  }
+
 // SceneDisplayLag events are disabled on Fuchsia.
 // see: https://github.com/flutter/flutter/issues/56598
 #if !defined(OS_FUCHSIA)
@@ -648,15 +699,20 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
 
   frame_timings_recorder.RecordRasterStart(fml::TimePoint::Now());
 
+  std::vector<sk_sp<DisplayList>> recordings =
+      RecordLayerTreesConcurrently(tasks);
+
   // Second traverse: draw all layer trees.
   std::vector<std::unique_ptr<LayerTreeTask>> resubmitted_tasks;
-  for (std::unique_ptr<LayerTreeTask>& task : tasks) {
+  for (size_t i = 0; i < tasks.size(); i++) {
+    std::unique_ptr<LayerTreeTask>& task = tasks[i];
     int64_t view_id = task->view_id;
     std::unique_ptr<LayerTree> layer_tree = std::move(task->layer_tree);
     float device_pixel_ratio = task->device_pixel_ratio;
 
-    DrawSurfaceStatus status = DrawToSurfaceUnsafe(
-        view_id, *layer_tree, device_pixel_ratio, presentation_time);
+    DrawSurfaceStatus status =
+        DrawToSurfaceUnsafe(view_id, *layer_tree, device_pixel_ratio,
+                            presentation_time, recordings[i]);
     FML_DCHECK(status != DrawSurfaceStatus::kDiscarded);
 
     auto& view_record = EnsureViewRecord(task->view_id);
@@ -692,12 +748,129 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
   }
 }
 
+// Whether the layer and its children can be prerolled and painted off of
+// the raster thread. Platform views and external textures are managed by
+// the external view embedder and the texture registry on the raster thread.
+static bool CanRecordOffRasterThread(const Layer* layer) {
+  if (layer->as_platform_view_layer() || layer->as_texture_layer()) {
+    return false;
+  }
+  const ContainerLayer* container = layer->as_container_layer();
+  if (container) {
+    for (const std::shared_ptr<Layer>& child : container->layers()) {
+      if (!CanRecordOffRasterThread(child.get())) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static sk_sp<DisplayList> RecordLayerTree(
+    flutter::CompositorContext& compositor_context,
+    flutter::LayerTree& layer_tree) {
+  TRACE_EVENT0("flutter", "Rasterizer::RecordLayerTree");
+  DisplayListBuilder builder(SkRect::Make(layer_tree.frame_size()));
+  auto frame = compositor_context.AcquireFrame(
+      nullptr,     // skia GrContext
+      &builder,    // root surface canvas
+      nullptr,     // external view embedder
+      SkMatrix{},  // root surface transformation
+      false,       // instrumentation enabled
+      true,        // surface supports pixel reads
+      nullptr,     // thread merger
+      nullptr      // aiks context
+  );
+  // The raster cache is not thread safe and its entries can only be
+  // rasterized with the context of the raster thread, so it is ignored.
+  // Layer trees are only recorded concurrently for surfaces that don't use
+  // the raster cache anyway.
+  frame->Raster(layer_tree, true, nullptr);
+  return builder.Build();
+}
+
+std::vector<sk_sp<DisplayList>> Rasterizer::RecordLayerTreesConcurrently(
+    const std::vector<std::unique_ptr<LayerTreeTask>>& tasks) {
+  std::vector<sk_sp<DisplayList>> recordings(tasks.size());
+  if (!worker_task_runner_ ||
+      !delegate_.GetSettings().enable_parallel_view_rasterization ||
+      tasks.size() < 2) {
+    return recordings;
+  }
+  // Recording without the raster cache would lose the cached layers and
+  // pictures of every view, see RecordLayerTree.
+  if (surface_ && surface_->EnableRasterCache()) {
+    return recordings;
+  }
+
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < tasks.size(); i++) {
+    const LayerTree& layer_tree = *tasks[i]->layer_tree;
+    if (layer_tree.root_layer() &&
+        !layer_tree.is_leaf_layer_tracing_enabled() &&
+        CanRecordOffRasterThread(layer_tree.root_layer())) {
+      indices.push_back(i);
+    }
+  }
+  if (indices.size() < 2) {
+    return recordings;
+  }
+
+  TRACE_EVENT0("flutter", "Rasterizer::RecordLayerTreesConcurrently");
+  const Settings& settings = delegate_.GetSettings();
+  auto record = [&](size_t index) {
+    LayerTree& layer_tree = *tasks[index]->layer_tree;
+    layer_tree.enable_display_list_optimization(
+        settings.enable_display_list_optimizer);
+    layer_tree.enable_incremental_preroll(settings.enable_incremental_preroll);
+    recordings[index] = RecordLayerTree(*compositor_context_, layer_tree);
+  };
+
+  // Layer trees are claimed in order by whichever thread gets to them first.
+  // This thread records layer trees as well instead of just waiting, so the
+  // frame isn't held up by busy workers. Tasks that run after all layer trees
+  // were claimed return without using |record|, whose captures are only
+  // alive till this method returns.
+  struct ConcurrentRecording {
+    explicit ConcurrentRecording(std::vector<size_t> p_indices)
+        : indices(std::move(p_indices)), latch(indices.size()) {}
+
+    const std::vector<size_t> indices;
+    std::atomic_size_t next_index = 0u;
+    fml::CountDownLatch latch;
+  };
+  auto recording = std::make_shared<ConcurrentRecording>(std::move(indices));
+  auto record_layer_trees = [recording, &record]() {
+    size_t i = 0u;
+    while ((i = recording->next_index.fetch_add(1u)) <
+           recording->indices.size()) {
+      record(recording->indices[i]);
+      recording->latch.CountDown();
+    }
+  };
+
+  const size_t worker_count = std::min<size_t>(
+      recording->indices.size() - 1u, std::thread::hardware_concurrency());
+  for (size_t i = 0; i < worker_count; i++) {
+    worker_task_runner_->PostTask(record_layer_trees);
+  }
+  record_layer_trees();
+  recording->latch.Wait();
+  concurrently_recorded_layer_tree_count_ += recording->indices.size();
+  return recordings;
+}
+
+size_t Rasterizer::GetConcurrentlyRecordedLayerTreeCount() const {
+  return concurrently_recorded_layer_tree_count_;
+}
+
 /// \see Rasterizer::DrawToSurfaces
 DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
     int64_t view_id,
     flutter::LayerTree& layer_tree,
     float device_pixel_ratio,
-    std::optional<fml::TimePoint> presentation_time) {
+    std::optional<fml::TimePoint> presentation_time,
+    const sk_sp<DisplayList>& recording) {
   FML_DCHECK(surface_);
 
   DlCanvas* embedder_root_canvas = nullptr;
@@ -763,17 +936,36 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
       }
     }
 
+    layer_tree.enable_display_list_optimization(
+        delegate_.GetSettings().enable_display_list_optimizer);
+    layer_tree.enable_incremental_preroll(
+        delegate_.GetSettings().enable_incremental_preroll);
+
     bool ignore_raster_cache = true;
     if (surface_->EnableRasterCache() &&
         !layer_tree.is_leaf_layer_tracing_enabled()) {
       ignore_raster_cache = false;
     }
 
-    RasterStatus frame_status =
-        compositor_frame->Raster(layer_tree,           // layer tree
-                                 ignore_raster_cache,  // ignore raster cache
-                                 damage.get()          // frame damage
-        );
+    RasterStatus frame_status;
+    if (recording) {
+      // The layer tree was prerolled and painted on a worker thread, see
+      // RecordLayerTreesConcurrently. The recording covers the whole frame,
+      // but the layer tree is still diffed so that its paint regions are
+      // known when the next frame of the view is diffed against it.
+      if (damage) {
+        damage->ComputeClipRect(layer_tree, !ignore_raster_cache,
+                                surface_->GetContext() == nullptr);
+      }
+      root_surface_canvas->DrawDisplayList(recording);
+      frame_status = RasterStatus::kSuccess;
+    } else {
+      frame_status =
+          compositor_frame->Raster(layer_tree,           // layer tree
+                                   ignore_raster_cache,  // ignore raster cache
+                                   damage.get()          // frame damage
+          );
+    }
     if (frame_status == RasterStatus::kSkipAndRetry) {
       return DrawSurfaceStatus::kRetry;
     }
@@ -22,6 +22,7 @@
 #include "flutter/fml/raster_thread_merger.h"
 #include "flutter/fml/synchronization/sync_switch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #if IMPELLER_SUPPORTS_RENDERING
@@ -32,6 +33,7 @@
 #endif  // IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/snapshot_delegate.h"
 #include "flutter/shell/common/pipeline.h"
+#include "flutter/shell/common/pipeline_depth_policy.h"
 #include "flutter/shell/common/snapshot_controller.h"
 #include "flutter/shell/common/snapshot_surface_producer.h"
 #include "third_party/skia/include/core/SkData.h"
@@ -207,6 +209,52 @@ class Rasterizer final : public SnapshotDelegate,
 
   void SetImpellerContext(std::weak_ptr<impeller::Context> impeller_context);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the task runner used for work that the rasterizer moves
+  ///             off of the raster thread. That is, rasterizing new raster
+  ///             cache entries when
+  ///             `Settings::enable_raster_cache_background_population` is set,
+  ///             and recording the layer trees of multiple views concurrently
+  ///             when `Settings::enable_parallel_view_rasterization` is set.
+  ///
+  /// @param[in]  task_runner  A concurrent task runner whose tasks run off of
+  ///                          the raster thread.
+  ///
+  void SetWorkerTaskRunner(std::shared_ptr<fml::BasicTaskRunner> task_runner);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Prerolls and paints the layer trees of the tasks into display
+  ///             lists concurrently on the worker task runner, when
+  ///             `Settings::enable_parallel_view_rasterization` is set and
+  ///             the surface doesn't use the raster cache. The raster cache
+  ///             can only be used on the raster thread. The calling thread
+  ///             records layer trees as well until all of them are recorded.
+  ///
+  ///             Only recording is concurrent. The recordings are drawn to
+  ///             the surfaces and submitted on the raster thread.
+  ///
+  ///             Called by the rasterizer when drawing multiple views. Public
+  ///             for benchmarks.
+  ///
+  /// @param[in]  tasks  The layer tree tasks of a frame.
+  ///
+  /// @return     A recording for each task, in order. The recording is null
+  ///             for the tasks that must be drawn on the raster thread, such as
+  ///             those with platform views or external textures, and for all
+  ///             of the tasks if they are not recorded concurrently.
+  ///
+  std::vector<sk_sp<DisplayList>> RecordLayerTreesConcurrently(
+      const std::vector<std::unique_ptr<LayerTreeTask>>& tasks);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of layer trees recorded by
+  ///             `RecordLayerTreesConcurrently` since the rasterizer was
+  ///             created.
+  ///
+  /// @attention  This method must be called on the raster task runner.
+  ///
+  size_t GetConcurrentlyRecordedLayerTreeCount() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Rasterizers may be created well before an on-screen surface is
   ///             available for rendering. Shells usually create a rasterizer in
@@ -732,11 +780,15 @@ class Rasterizer final : public SnapshotDelegate,
   //
   // This method is not affiliated with the frame timing recorder, but must be
   // included between the RasterStart and RasterEnd.
+  //
+  // If a |recording| of the layer tree is given, it is drawn to the surface
+  // in place of prerolling and painting the layer tree.
   DrawSurfaceStatus DrawToSurfaceUnsafe(
       int64_t view_id,
       flutter::LayerTree& layer_tree,
       float device_pixel_ratio,
-      std::optional<fml::TimePoint> presentation_time);
+      std::optional<fml::TimePoint> presentation_time,
+      const sk_sp<DisplayList>& recording = nullptr);
 
   ViewRecord& EnsureViewRecord(int64_t view_id);
 
@@ -759,6 +811,11 @@ class Rasterizer final : public SnapshotDelegate,
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
   std::unique_ptr<SnapshotController> snapshot_controller_;
+  std::shared_ptr<fml::BasicTaskRunner> worker_task_runner_;
+  size_t concurrently_recorded_layer_tree_count_ = 0u;
+  // Adapts the depth of the pipelines drawn by |Draw| when
+  // `Settings::frame_pipeline_max_depth` is set. Created by the first |Draw|.
+  std::unique_ptr<PipelineDepthPolicy> pipeline_depth_policy_;
 
   // WeakPtrFactory must be the last member.
   fml::TaskRunnerAffineWeakPtrFactory<Rasterizer> weak_factory_;
@@ -10,6 +10,7 @@
 #include <optional>
 
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/layers/container_layer.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/thread_host.h"
@@ -70,6 +71,10 @@ class MockDelegate : public Rasterizer::Delegate {
 
 class MockSurface : public Surface {
  public:
+  MockSurface() {
+    ON_CALL(*this, EnableRasterCache()).WillByDefault(Return(true));
+  }
+
   MOCK_METHOD(bool, IsValid, (), (override));
   MOCK_METHOD(std::unique_ptr<SurfaceFrame>,
               AcquireFrame,
@@ -83,6 +88,7 @@ class MockSurface : public Surface {
               (override));
   MOCK_METHOD(bool, ClearRenderContext, (), (override));
   MOCK_METHOD(bool, AllowsDrawingWhenGpuDisabled, (), (const, override));
+  MOCK_METHOD(bool, EnableRasterCache, (), (const, override));
 };
 
 class MockExternalViewEmbedder : public ExternalViewEmbedder {
@@ -1384,4 +1390,70 @@ TEST(RasterizerTest, presentationTimeNotSetWhenVsyncTargetInPast) {
 #endif  // false
 }
 
+namespace {
+
+class InlineTaskRunner : public fml::BasicTaskRunner {
+ public:
+  // |fml::BasicTaskRunner|
+  void PostTask(const fml::closure& task) override { task(); }
+};
+
+std::vector<std::unique_ptr<LayerTreeTask>> MultipleLayerTreeList(
+    size_t view_count) {
+  std::vector<std::unique_ptr<LayerTreeTask>> tasks;
+  for (size_t i = 0; i < view_count; i++) {
+    auto layer_tree = std::make_unique<LayerTree>(
+        std::make_shared<ContainerLayer>(), SkISize::Make(100, 100));
+    tasks.push_back(std::make_unique<LayerTreeTask>(
+        static_cast<int64_t>(i), std::move(layer_tree), kDevicePixelRatio));
+  }
+  return tasks;
+}
+
+}  // namespace
+
+TEST(RasterizerTest, RecordsLayerTreesConcurrentlyWithoutRasterCache) {
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  settings.enable_parallel_view_rasterization = true;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  Rasterizer rasterizer(delegate);
+  rasterizer.SetWorkerTaskRunner(std::make_shared<InlineTaskRunner>());
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+  EXPECT_CALL(*surface, MakeRenderContextCurrent())
+      .WillOnce(Return(ByMove(std::make_unique<GLContextDefaultResult>(true))));
+  EXPECT_CALL(*surface, EnableRasterCache()).WillRepeatedly(Return(false));
+  rasterizer.Setup(std::move(surface));
+
+  auto recordings =
+      rasterizer.RecordLayerTreesConcurrently(MultipleLayerTreeList(3));
+  ASSERT_EQ(recordings.size(), 3u);
+  for (const auto& recording : recordings) {
+    EXPECT_NE(recording, nullptr);
+  }
+  EXPECT_EQ(rasterizer.GetConcurrentlyRecordedLayerTreeCount(), 3u);
+}
+
+TEST(RasterizerTest, DoesNotRecordLayerTreesConcurrentlyWithRasterCache) {
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  settings.enable_parallel_view_rasterization = true;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  Rasterizer rasterizer(delegate);
+  rasterizer.SetWorkerTaskRunner(std::make_shared<InlineTaskRunner>());
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+  EXPECT_CALL(*surface, MakeRenderContextCurrent())
+      .WillOnce(Return(ByMove(std::make_unique<GLContextDefaultResult>(true))));
+  rasterizer.Setup(std::move(surface));
+
+  // The raster cache can only be used on the raster thread.
+  auto recordings =
+      rasterizer.RecordLayerTreesConcurrently(MultipleLayerTreeList(3));
+  ASSERT_EQ(recordings.size(), 3u);
+  for (const auto& recording : recordings) {
+    EXPECT_EQ(recording, nullptr);
+  }
+  EXPECT_EQ(rasterizer.GetConcurrentlyRecordedLayerTreeCount(), 0u);
+}
+
 }  // namespace flutter
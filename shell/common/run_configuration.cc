@@ -28,15 +28,30 @@ RunConfiguration RunConfiguration::InferFromSettings(
     asset_manager->PushBack(std::unique_ptr<JarAssetBundle>(
         JarAssetBundle::delegate.Create(settings.assets_path)));
   } else {
+    std::vector<std::string> prefetch_asset_names;
+    if (io_worker && !settings.asset_prefetch_manifest_path.empty()) {
+      prefetch_asset_names = DirectoryAssetBundle::ReadPrefetchManifest(
+          settings.asset_prefetch_manifest_path);
+    }
+    // Assets are resolved by the first bundle that has them, so only that
+    // bundle prefetches them. Mappings prefetched by later bundles would
+    // never be handed out.
+    auto push_directory_asset_bundle = [&](fml::UniqueFD descriptor) {
+      auto bundle =
+          std::make_unique<DirectoryAssetBundle>(std::move(descriptor), true);
+      if (!prefetch_asset_names.empty() &&
+          bundle->Prefetch(prefetch_asset_names, *io_worker)) {
+        prefetch_asset_names.clear();
+      }
+      asset_manager->PushBack(std::move(bundle));
+    };
+
     if (fml::UniqueFD::traits_type::IsValid(settings.assets_dir)) {
-      asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
-          fml::Duplicate(settings.assets_dir), true));
+      push_directory_asset_bundle(fml::Duplicate(settings.assets_dir));
     }
 
-    asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
-        fml::OpenDirectory(settings.assets_path.c_str(), false,
-                           fml::FilePermission::kRead),
-        true));
+    push_directory_asset_bundle(fml::OpenDirectory(
+        settings.assets_path.c_str(), false, fml::FilePermission::kRead));
   }
 
   return {IsolateConfiguration::InferFromSettings(settings, asset_manager,
@@ -270,6 +270,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
         rasterizer->SetImpellerContext(impeller_context);
+        rasterizer->SetWorkerTaskRunner(shell->GetConcurrentWorkerTaskRunner());
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
@@ -349,8 +350,9 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            shell->GetSettings().frame_pipeline_max_depth);
 
         engine_promise.set_value(on_create_engine(
             *shell,                               //
@@ -815,6 +817,10 @@ const TaskRunners& Shell::GetTaskRunners() const {
   return task_runners_;
 }
 
+const FrameTimingStore& Shell::GetFrameTimingStore() const {
+  return frame_timing_store_;
+}
+
 const fml::RefPtr<fml::RasterThreadMerger> Shell::GetParentRasterThreadMerger()
     const {
   return parent_raster_thread_merger_;
@@ -1568,6 +1574,29 @@ void Shell::ReportTimings() {
   });
 }
 
+void Shell::WriteAssetPrefetchManifest() {
+  FML_DCHECK(is_set_up_);
+  if (settings_.asset_prefetch_manifest_path.empty()) {
+    return;
+  }
+  task_runners_.GetUITaskRunner()->PostTask(
+      [engine = weak_engine_, io_task_runner = task_runners_.GetIOTaskRunner(),
+       path = settings_.asset_prefetch_manifest_path]() {
+        if (!engine || !engine->GetAssetManager()) {
+          return;
+        }
+        auto asset_names = engine->GetAssetManager()->GetRequestedAssetNames();
+        io_task_runner->PostTask(
+            [path, asset_names = std::move(asset_names)]() {
+              if (!DirectoryAssetBundle::WritePrefetchManifest(path,
+                                                               asset_names)) {
+                FML_DLOG(WARNING)
+                    << "Could not write the asset prefetch manifest: " << path;
+              }
+            });
+      });
+}
+
 size_t Shell::UnreportedFramesCount() const {
   // Check that this is running on the raster thread to avoid race conditions.
   FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
@@ -1579,6 +1608,13 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
 
+  frame_timing_store_.Record(timing);
+
+  if (!asset_prefetch_manifest_written_) {
+    asset_prefetch_manifest_written_ = true;
+    WriteAssetPrefetchManifest();
+  }
+
   // The C++ callback defined in settings.h and set by Flutter runner. This is
   // independent of the timings report to the Dart side.
   if (settings_.frame_rasterized_callback) {
@@ -36,6 +36,7 @@
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/frame_timing_store.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/resource_cache_limit_calculator.h"
@@ -238,6 +239,15 @@ class Shell final : public PlatformView::Delegate,
   ///
   const TaskRunners& GetTaskRunners() const override;
 
+  //------------------------------------------------------------------------------
+  /// @brief      The timings of the most recently rasterized frames and the
+  ///             latency histograms of all frames rasterized by this shell.
+  ///             The store can be read from any thread without a Dart
+  ///             isolate, unlike the timings reported to
+  ///             `PlatformDispatcher.onReportTimings`.
+  ///
+  const FrameTimingStore& GetFrameTimingStore() const;
+
   //------------------------------------------------------------------------------
   /// @brief      Getting the raster thread merger from parent shell, it can be
   ///             a null RefPtr when it's a root Shell or the
@@ -472,6 +482,9 @@ class Shell final : public PlatformView::Delegate,
   uint64_t next_pointer_flow_id_ = 0;
 
   bool first_frame_rasterized_ = false;
+  // Whether the asset prefetch manifest has been written, which happens once
+  // the first frame is rasterized. Only accessed on the raster thread.
+  bool asset_prefetch_manifest_written_ = false;
   std::atomic<bool> waiting_for_first_frame_ = true;
   std::mutex waiting_for_first_frame_mutex_;
   std::condition_variable waiting_for_first_frame_condition_;
@@ -489,6 +502,9 @@ class Shell final : public PlatformView::Delegate,
   // stored here for easier conversions to Dart objects.
   std::vector<int64_t> unreported_timings_;
 
+  // The timings of every rasterized frame, see |GetFrameTimingStore|.
+  FrameTimingStore frame_timing_store_;
+
   /// Manages the displays. This class is thread safe, can be accessed from
   /// any of the threads.
   std::unique_ptr<DisplayManager> display_manager_;
@@ -553,6 +569,10 @@ class Shell final : public PlatformView::Delegate,
 
   void ReportTimings();
 
+  // Replaces the manifest at |Settings::asset_prefetch_manifest_path| with the
+  // assets requested so far, so that the next launch prefetches them.
+  void WriteAssetPrefetchManifest();
+
   // |PlatformView::Delegate|
   void OnPlatformViewCreated(std::unique_ptr<Surface> surface) override;
 
@@ -4,9 +4,21 @@
 
 #include "flutter/shell/common/shell.h"
 
+#include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/file.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/message_loop.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/common/frame_timing_store.h"
+#include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/elf_loader.h"
 #include "flutter/testing/testing.h"
@@ -120,4 +132,243 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+static FrameTiming MakeBenchmarkFrameTiming(uint64_t frame_number) {
+  // Builds take 2-9ms and rasterization 4-15ms, so that the histograms
+  // spread over several buckets.
+  int64_t n = static_cast<int64_t>(frame_number);
+  int64_t start = n * 16000;
+  int64_t build = 2000 + (n * 7919) % 8000;
+  int64_t raster = 4000 + (n * 104729) % 12000;
+  auto at = [](int64_t micros) {
+    return fml::TimePoint::FromEpochDelta(
+        fml::TimeDelta::FromMicroseconds(micros));
+  };
+  FrameTiming timing;
+  timing.SetFrameNumber(frame_number);
+  timing.Set(FrameTiming::kVsyncStart, at(start));
+  timing.Set(FrameTiming::kBuildStart, at(start + 500));
+  timing.Set(FrameTiming::kBuildFinish, at(start + 500 + build));
+  timing.Set(FrameTiming::kRasterStart, at(start + 500 + build));
+  timing.Set(FrameTiming::kRasterFinish, at(start + 500 + build + raster));
+  timing.Set(FrameTiming::kRasterFinishWallTime,
+             at(start + 500 + build + raster));
+  timing.SetRasterCacheStatistics(0, 0, 0, 0);
+  return timing;
+}
+
+static void BM_FrameTimingStoreRecord(benchmark::State& state) {
+  FrameTimingStore store;
+  FrameTiming timing = MakeBenchmarkFrameTiming(1);
+  while (state.KeepRunning()) {
+    store.Record(timing);
+  }
+}
+
+BENCHMARK(BM_FrameTimingStoreRecord);
+
+// Measures the cost of reading the recent frames and histograms while the
+// store is full, and reports the latency percentiles of the recorded frames
+// as counters.
+static void BM_FrameTimingStoreDump(benchmark::State& state) {
+  FrameTimingStore store;
+  for (uint64_t i = 0; i < 4 * FrameTimingStore::kCapacity; i++) {
+    store.Record(MakeBenchmarkFrameTiming(i));
+  }
+
+  std::vector<FrameTiming> frames;
+  FrameTimingStore::Histogram histograms[FrameTimingStore::kPhaseCount];
+  while (state.KeepRunning()) {
+    frames = store.GetRecentFrames();
+    for (size_t i = 0; i < FrameTimingStore::kPhaseCount; i++) {
+      histograms[i] =
+          store.GetHistogram(static_cast<FrameTimingStore::Phase>(i));
+    }
+    benchmark::DoNotOptimize(frames.data());
+    benchmark::DoNotOptimize(histograms);
+  }
+
+  static const char* kPhaseNames[FrameTimingStore::kPhaseCount] = {
+      "vsync_to_build_start", "build", "raster", "vsync_to_raster_finish"};
+  for (size_t i = 0; i < FrameTimingStore::kPhaseCount; i++) {
+    const FrameTimingStore::Histogram& histogram = histograms[i];
+    std::string name = kPhaseNames[i];
+    state.counters[name + "_p50_us"] = histogram.PercentileMicros(50);
+    state.counters[name + "_p90_us"] = histogram.PercentileMicros(90);
+    state.counters[name + "_p99_us"] = histogram.PercentileMicros(99);
+    state.counters[name + "_max_us"] = histogram.max_micros;
+  }
+  state.counters["frames"] = frames.size();
+}
+
+BENCHMARK(BM_FrameTimingStoreDump);
+
+// Measures the time the UI thread spends getting and reading the assets used
+// by the first frames, with and without prefetching them on the IO thread
+// first. The files are in the page cache after the first iteration, so this
+// measures opening, mapping and faulting in the assets rather than the disk.
+static void BM_DirectoryAssetBundleStartupAssets(benchmark::State& state,
+                                                 bool prefetch) {
+  const size_t asset_count = state.range(0);
+  const size_t asset_size = 64 * 1024;
+  fml::ScopedTemporaryDirectory asset_dir;
+  std::vector<std::string> asset_names;
+  for (size_t i = 0; i < asset_count; i++) {
+    asset_names.push_back("asset" + std::to_string(i));
+    std::vector<uint8_t> data(asset_size, static_cast<uint8_t>(i));
+    FML_CHECK(fml::WriteAtomically(asset_dir.fd(), asset_names.back().c_str(),
+                                   fml::DataMapping(std::move(data))));
+  }
+
+  fml::Thread io_thread("io");
+  std::unique_ptr<DirectoryAssetBundle> bundle;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    bundle = std::make_unique<DirectoryAssetBundle>(
+        fml::OpenDirectory(asset_dir.path().c_str(), false,
+                           fml::FilePermission::kRead),
+        false);
+    if (prefetch) {
+      bundle->Prefetch(asset_names, *io_thread.GetTaskRunner());
+      fml::AutoResetWaitableEvent prefetched;
+      io_thread.GetTaskRunner()->PostTask([&]() { prefetched.Signal(); });
+      prefetched.Wait();
+    }
+    state.ResumeTiming();
+
+    AssetResolver& resolver = *bundle;
+    for (const auto& asset_name : asset_names) {
+      auto mapping = resolver.GetAsMapping(asset_name);
+      uint8_t sum = 0;
+      for (size_t i = 0; i < mapping->GetSize(); i += 4096) {
+        sum += mapping->GetMapping()[i];
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * asset_count);
+}
+
+BENCHMARK_CAPTURE(BM_DirectoryAssetBundleStartupAssets, OnDemand, false)
+    ->RangeMultiplier(4)
+    ->Range(16, 256);
+BENCHMARK_CAPTURE(BM_DirectoryAssetBundleStartupAssets, Prefetched, true)
+    ->RangeMultiplier(4)
+    ->Range(16, 256);
+
+namespace {
+
+class RecordingRasterizerDelegate : public Rasterizer::Delegate {
+ public:
+  RecordingRasterizerDelegate() {
+    settings_.enable_parallel_view_rasterization = true;
+  }
+
+  // |Rasterizer::Delegate|
+  void OnFrameRasterized(const FrameTiming& frame_timing) override {}
+
+  // |Rasterizer::Delegate|
+  fml::Milliseconds GetFrameBudget() override {
+    return fml::kDefaultFrameBudget;
+  }
+
+  // |Rasterizer::Delegate|
+  fml::TimePoint GetLatestFrameTargetTime() const override { return {}; }
+
+  // |Rasterizer::Delegate|
+  const TaskRunners& GetTaskRunners() const override { return task_runners_; }
+
+  // |Rasterizer::Delegate|
+  const fml::RefPtr<fml::RasterThreadMerger> GetParentRasterThreadMerger()
+      const override {
+    return nullptr;
+  }
+
+  // |Rasterizer::Delegate|
+  std::shared_ptr<const fml::SyncSwitch> GetIsGpuDisabledSyncSwitch()
+      const override {
+    return is_gpu_disabled_sync_switch_;
+  }
+
+  // |Rasterizer::Delegate|
+  const Settings& GetSettings() const override { return settings_; }
+
+  // |Rasterizer::Delegate|
+  bool ShouldDiscardLayerTree(int64_t view_id,
+                              const flutter::LayerTree& tree) override {
+    return false;
+  }
+
+ private:
+  Settings settings_;
+  TaskRunners task_runners_{"test", nullptr, nullptr, nullptr, nullptr};
+  std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch_ =
+      std::make_shared<fml::SyncSwitch>();
+};
+
+// Runs the posted tasks right away, so that the layer trees are recorded one
+// after the other on the calling thread.
+class InlineTaskRunner : public fml::BasicTaskRunner {
+ public:
+  // |fml::BasicTaskRunner|
+  void PostTask(const fml::closure& task) override { task(); }
+};
+
+std::unique_ptr<LayerTree> MakeBenchmarkLayerTree(size_t rect_count) {
+  DisplayListBuilder builder;
+  DlPaint paint;
+  for (size_t i = 0; i < rect_count; i++) {
+    paint.setColor(DlColor(0xFF000000 | static_cast<uint32_t>(i * 0x9E3779B1)));
+    builder.DrawRect(SkRect::MakeXYWH(i % 80 * 10, i / 80 % 60 * 10, 10, 10),
+                     paint);
+  }
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(std::make_shared<DisplayListLayer>(SkPoint::Make(0, 0),
+                                               builder.Build(),
+                                               /*is_complex=*/false,
+                                               /*will_change=*/true));
+  return std::make_unique<LayerTree>(root, SkISize::Make(800, 600));
+}
+
+}  // namespace
+
+// Measures how long the raster thread takes to record the layer trees of a
+// frame with several views, when they are recorded one after the other and
+// when the worker threads help recording them.
+static void BM_RasterizerRecordLayerTrees(benchmark::State& state,
+                                          bool concurrent) {
+  const size_t view_count = state.range(0);
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  std::shared_ptr<fml::ConcurrentMessageLoop> worker_loop;
+  RecordingRasterizerDelegate delegate;
+  Rasterizer rasterizer(delegate, Rasterizer::MakeGpuImageBehavior::kBitmap);
+  if (concurrent) {
+    worker_loop = fml::ConcurrentMessageLoop::Create();
+    rasterizer.SetWorkerTaskRunner(worker_loop->GetTaskRunner());
+  } else {
+    rasterizer.SetWorkerTaskRunner(std::make_shared<InlineTaskRunner>());
+  }
+
+  std::vector<std::unique_ptr<LayerTreeTask>> tasks;
+  for (size_t i = 0; i < view_count; i++) {
+    tasks.push_back(std::make_unique<LayerTreeTask>(
+        static_cast<int64_t>(i), MakeBenchmarkLayerTree(10000), 1.0f));
+  }
+
+  while (state.KeepRunning()) {
+    auto recordings = rasterizer.RecordLayerTreesConcurrently(tasks);
+    FML_CHECK(recordings.back());
+    benchmark::DoNotOptimize(recordings.data());
+  }
+  state.SetItemsProcessed(state.iterations() * view_count);
+}
+
+BENCHMARK_CAPTURE(BM_RasterizerRecordLayerTrees, Serial, false)
+    ->RangeMultiplier(2)
+    ->Range(2, 8)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_RasterizerRecordLayerTrees, Concurrent, true)
+    ->RangeMultiplier(2)
+    ->Range(2, 8)
+    ->UseRealTime();
+
 }  // namespace flutter
@@ -31,8 +31,10 @@
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/paths.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
@@ -3201,6 +3203,128 @@ TEST_F(ShellTest, AssetManagerMultiSubdir) {
 }
 #endif  // OS_FUCHSIA
 
+TEST_F(ShellTest, DirectoryAssetBundleRecordsRequestedAssets) {
+  fml::ScopedTemporaryDirectory asset_dir;
+  fml::UniqueFD asset_dir_fd = fml::OpenDirectory(
+      asset_dir.path().c_str(), false, fml::FilePermission::kRead);
+  for (const char* filename : {"a", "b"}) {
+    ASSERT_TRUE(fml::WriteAtomically(asset_dir_fd, filename,
+                                     fml::DataMapping(filename)));
+  }
+
+  DirectoryAssetBundle bundle(std::move(asset_dir_fd), false);
+  AssetResolver& resolver = bundle;
+  EXPECT_NE(resolver.GetAsMapping("b"), nullptr);
+  EXPECT_NE(resolver.GetAsMapping("a"), nullptr);
+  EXPECT_NE(resolver.GetAsMapping("b"), nullptr);
+  EXPECT_EQ(resolver.GetAsMapping("missing"), nullptr);
+
+  EXPECT_EQ(bundle.GetRequestedAssetNames(),
+            std::vector<std::string>({"b", "a"}));
+}
+
+// Unlinking files that are mapped fails on Windows.
+#if !defined(FML_OS_WIN)
+TEST_F(ShellTest, DirectoryAssetBundleReturnsPrefetchedAssets) {
+  fml::ScopedTemporaryDirectory asset_dir;
+  fml::UniqueFD asset_dir_fd = fml::OpenDirectory(
+      asset_dir.path().c_str(), false, fml::FilePermission::kRead);
+  std::vector<std::string> filenames;
+  for (size_t i = 0; i < DirectoryAssetBundle::kPrefetchBatchSize * 2 + 1;
+       i++) {
+    filenames.push_back("asset" + std::to_string(i));
+    ASSERT_TRUE(fml::WriteAtomically(asset_dir_fd, filenames.back().c_str(),
+                                     fml::DataMapping(filenames.back())));
+  }
+  fml::UniqueFD unlink_fd = fml::Duplicate(asset_dir_fd.get());
+
+  DirectoryAssetBundle bundle(std::move(asset_dir_fd), false);
+  fml::Thread io_thread("io");
+  std::vector<std::string> manifest = filenames;
+  manifest.push_back("missing");
+  bundle.Prefetch(manifest, *io_thread.GetTaskRunner());
+  fml::AutoResetWaitableEvent prefetched;
+  io_thread.GetTaskRunner()->PostTask([&]() { prefetched.Signal(); });
+  prefetched.Wait();
+
+  // The prefetched assets no longer need the files.
+  for (const auto& filename : filenames) {
+    ASSERT_TRUE(fml::UnlinkFile(unlink_fd, filename.c_str()));
+  }
+
+  AssetResolver& resolver = bundle;
+  for (const auto& filename : filenames) {
+    auto mapping = resolver.GetAsMapping(filename);
+    ASSERT_NE(mapping, nullptr);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                          mapping->GetSize()),
+              filename);
+  }
+  EXPECT_EQ(resolver.GetAsMapping("missing"), nullptr);
+  // Prefetched assets are only returned once.
+  EXPECT_EQ(resolver.GetAsMapping(filenames.front()), nullptr);
+  EXPECT_EQ(bundle.GetRequestedAssetNames(), filenames);
+}
+
+TEST_F(ShellTest, DirectoryAssetBundleDoesNotPrefetchRequestedAssets) {
+  fml::ScopedTemporaryDirectory asset_dir;
+  fml::UniqueFD asset_dir_fd = fml::OpenDirectory(
+      asset_dir.path().c_str(), false, fml::FilePermission::kRead);
+  ASSERT_TRUE(fml::WriteAtomically(asset_dir_fd, "a", fml::DataMapping("a")));
+  fml::UniqueFD unlink_fd = fml::Duplicate(asset_dir_fd.get());
+
+  DirectoryAssetBundle bundle(std::move(asset_dir_fd), false);
+  AssetResolver& resolver = bundle;
+  EXPECT_NE(resolver.GetAsMapping("a"), nullptr);
+
+  fml::Thread io_thread("io");
+  EXPECT_TRUE(bundle.Prefetch({"a"}, *io_thread.GetTaskRunner()));
+  fml::AutoResetWaitableEvent prefetched;
+  io_thread.GetTaskRunner()->PostTask([&]() { prefetched.Signal(); });
+  prefetched.Wait();
+
+  // A prefetched mapping would have outlived the file.
+  ASSERT_TRUE(fml::UnlinkFile(unlink_fd, "a"));
+  EXPECT_EQ(resolver.GetAsMapping("a"), nullptr);
+}
+
+TEST_F(ShellTest, RunConfigurationPrefetchesAssetsOfManifest) {
+  fml::ScopedTemporaryDirectory asset_dir;
+  fml::UniqueFD asset_dir_fd = fml::OpenDirectory(
+      asset_dir.path().c_str(), false, fml::FilePermission::kRead);
+  for (const char* filename : {"a", "b"}) {
+    ASSERT_TRUE(fml::WriteAtomically(asset_dir_fd, filename,
+                                     fml::DataMapping(filename)));
+  }
+  fml::ScopedTemporaryDirectory manifest_dir;
+  const std::string manifest_path =
+      fml::paths::JoinPaths({manifest_dir.path(), "manifest"});
+  ASSERT_TRUE(
+      DirectoryAssetBundle::WritePrefetchManifest(manifest_path, {"a"}));
+  EXPECT_EQ(DirectoryAssetBundle::ReadPrefetchManifest(manifest_path),
+            std::vector<std::string>({"a"}));
+
+  Settings settings;
+  settings.assets_path = asset_dir.path();
+  settings.asset_prefetch_manifest_path = manifest_path;
+  fml::Thread io_thread("io");
+  auto configuration =
+      RunConfiguration::InferFromSettings(settings, io_thread.GetTaskRunner());
+  fml::AutoResetWaitableEvent prefetched;
+  io_thread.GetTaskRunner()->PostTask([&]() { prefetched.Signal(); });
+  prefetched.Wait();
+
+  // Only the assets listed in the manifest outlive their files.
+  ASSERT_TRUE(fml::UnlinkFile(asset_dir_fd, "a"));
+  ASSERT_TRUE(fml::UnlinkFile(asset_dir_fd, "b"));
+  auto asset_manager = configuration.GetAssetManager();
+  EXPECT_NE(asset_manager->GetAsMapping("a"), nullptr);
+  EXPECT_EQ(asset_manager->GetAsMapping("b"), nullptr);
+  EXPECT_EQ(asset_manager->GetRequestedAssetNames(),
+            std::vector<std::string>({"a"}));
+}
+#endif  // !defined(FML_OS_WIN)
+
 TEST_F(ShellTest, Spawn) {
   auto settings = CreateSettingsForFixture();
   auto shell = CreateShell(settings);
@@ -364,6 +364,10 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   command_line.GetOptionValue(FlagForSwitch(Switch::FlutterAssetsDir),
                               &settings.assets_path);
 
+  command_line.GetOptionValue(
+      FlagForSwitch(Switch::AssetPrefetchManifestPath),
+      &settings.asset_prefetch_manifest_path);
+
   std::vector<std::string_view> aot_shared_library_name =
       command_line.GetOptionValues(FlagForSwitch(Switch::AotSharedLibraryName));
 
@@ -469,6 +473,38 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
       command_line.HasOption(FlagForSwitch(Switch::EnableOpenGLGPUTracing));
   settings.enable_vulkan_gpu_tracing =
       command_line.HasOption(FlagForSwitch(Switch::EnableVulkanGPUTracing));
+  settings.enable_display_list_optimizer =
+      command_line.HasOption(FlagForSwitch(Switch::EnableDisplayListOptimizer));
+
+  command_line.GetOptionValue(FlagForSwitch(Switch::RasterCacheCostModel),
+                              &settings.raster_cache_cost_model);
+
+  settings.enable_raster_cache_background_population = command_line.HasOption(
+      FlagForSwitch(Switch::EnableRasterCacheBackgroundPopulation));
+
+  double raster_cache_scale_band = 1.0;
+  if (GetSwitchValue(command_line, Switch::RasterCacheScaleBand,
+                     &raster_cache_scale_band) &&
+      raster_cache_scale_band >= 1.0) {
+    settings.raster_cache_scale_band = raster_cache_scale_band;
+  }
+
+  settings.enable_parallel_view_rasterization = command_line.HasOption(
+      FlagForSwitch(Switch::EnableParallelViewRasterization));
+
+  uint32_t frame_pipeline_depth = 0;
+  if (GetSwitchValue(command_line, Switch::FramePipelineMinDepth,
+                     &frame_pipeline_depth) &&
+      frame_pipeline_depth > 0) {
+    settings.frame_pipeline_min_depth = frame_pipeline_depth;
+  }
+  if (GetSwitchValue(command_line, Switch::FramePipelineMaxDepth,
+                     &frame_pipeline_depth)) {
+    settings.frame_pipeline_max_depth = frame_pipeline_depth;
+  }
+
+  settings.enable_incremental_preroll =
+      command_line.HasOption(FlagForSwitch(Switch::EnableIncrementalPreroll));
 
   settings.enable_embedder_api =
       command_line.HasOption(FlagForSwitch(Switch::EnableEmbedderAPI));
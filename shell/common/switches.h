@@ -144,6 +144,11 @@ DEF_SWITCH(SkiaDeterministicRendering,
 DEF_SWITCH(FlutterAssetsDir,
            "flutter-assets-dir",
            "Path to the Flutter assets directory.")
+DEF_SWITCH(AssetPrefetchManifestPath,
+           "asset-prefetch-manifest-path",
+           "Path to the file that lists the assets to prefetch at launch. The "
+           "file is replaced with the assets requested till the first frame is "
+           "rasterized.")
 DEF_SWITCH(Help, "help", "Display this help text.")
 DEF_SWITCH(LogTag, "log-tag", "Tag associated with log messages.")
 DEF_SWITCH(DisableServiceAuthCodes,
@@ -283,6 +288,47 @@ DEF_SWITCH(EnableVulkanGPUTracing,
            "enable-vulkan-gpu-tracing",
            "Enable tracing of GPU execution time when using the Impeller "
            "Vulkan backend.")
+DEF_SWITCH(EnableDisplayListOptimizer,
+           "enable-display-list-optimizer",
+           "Optimize the display lists of pictures that are retained across "
+           "frames by removing occluded operations and folding opacity "
+           "layers before they are rendered.")
+DEF_SWITCH(RasterCacheCostModel,
+           "raster-cache-cost-model",
+           "The name of a display list cost model (ex `bootstrap`) that the "
+           "raster cache uses to decide which pictures are expensive enough "
+           "to cache.")
+DEF_SWITCH(EnableRasterCacheBackgroundPopulation,
+           "enable-raster-cache-background-population",
+           "Rasterize new raster cache entries for pictures on a worker "
+           "thread and use them once they are ready, instead of rasterizing "
+           "them during the frame in which they are first cached.")
+DEF_SWITCH(RasterCacheScaleBand,
+           "raster-cache-scale-band",
+           "The factor by which the scale of a cached layer or picture may "
+           "differ from the scale it is drawn at before it is rasterized "
+           "again (ex `1.5`). Defaults to 1, which requires an exact match.")
+DEF_SWITCH(EnableParallelViewRasterization,
+           "enable-parallel-view-rasterization",
+           "When more than one view is rendered in a frame, record the layer "
+           "trees of the views on worker threads concurrently before drawing "
+           "them to their surfaces. Only applies to surfaces that don't use "
+           "the raster cache, such as those of Impeller.")
+DEF_SWITCH(FramePipelineMinDepth,
+           "frame-pipeline-min-depth",
+           "The smallest number of frames that may be in flight between the "
+           "UI and raster threads when the frame pipeline depth is adaptive. "
+           "Defaults to 1.")
+DEF_SWITCH(FramePipelineMaxDepth,
+           "frame-pipeline-max-depth",
+           "Adapt the number of frames that may be in flight between the UI "
+           "and raster threads to the build and raster times of recent "
+           "frames, up to this many frames. By default the depth is fixed.")
+DEF_SWITCH(EnableIncrementalPreroll,
+           "enable-incremental-preroll",
+           "Reuse the results of the last Preroll of layer subtrees that are "
+           "retained from an earlier frame and drawn under the same "
+           "transform and cull rect.")
 DEF_SWITCH(LeakVM,
            "leak-vm",
            "When the last shell shuts down, the shared VM is leaked by default "
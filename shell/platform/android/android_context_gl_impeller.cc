@@ -9,6 +9,7 @@
 #include "flutter/impeller/renderer/backend/gles/reactor_gles.h"
 #include "flutter/impeller/toolkit/egl/context.h"
 #include "flutter/impeller/toolkit/egl/surface.h"
+#include "impeller/entity/gles/entity_gles3_shaders_gles.h"
 #include "impeller/entity/gles/entity_shaders_gles.h"
 #include "impeller/entity/gles/framebuffer_blend_shaders_gles.h"
 
@@ -73,8 +74,15 @@ static std::shared_ptr<impeller::Context> CreateImpellerContext(
 #endif  // IMPELLER_ENABLE_3D
   };
 
+  std::vector<std::shared_ptr<fml::Mapping>> gles3_shader_mappings = {
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_entity_gles3_shaders_gles_data,
+          impeller_entity_gles3_shaders_gles_length),
+  };
+
   auto context = impeller::ContextGLES::Create(
-      std::move(proc_table), shader_mappings, enable_gpu_tracing);
+      std::move(proc_table), shader_mappings, enable_gpu_tracing,
+      gles3_shader_mappings);
   if (!context) {
     FML_LOG(ERROR) << "Could not create OpenGLES Impeller Context.";
     return nullptr;
@@ -49,6 +49,7 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/shell/common/frame_timing_store.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/platform/embedder/embedder.h"
@@ -3387,6 +3388,92 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
   return kSuccess;
 }
 
+static FlutterFrameTimingHistogram ToFlutterFrameTimingHistogram(
+    const flutter::FrameTimingStore::Histogram& histogram) {
+  FlutterFrameTimingHistogram result = {};
+  result.struct_size = sizeof(FlutterFrameTimingHistogram);
+  result.count = histogram.count;
+  result.sum_micros = histogram.sum_micros;
+  result.max_micros = histogram.max_micros;
+  result.bucket_count = histogram.bucket_counts.size();
+  result.bucket_upper_bounds_micros =
+      flutter::FrameTimingStore::kBucketUpperBoundsMicros.data();
+  result.bucket_counts = histogram.bucket_counts.data();
+  return result;
+}
+
+FlutterEngineResult FlutterEngineGetFrameTimings(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingsCallback callback,
+    void* user_data) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Frame timings callback was null.");
+  }
+
+  const flutter::FrameTimingStore& store =
+      reinterpret_cast<flutter::EmbedderEngine*>(engine)
+          ->GetShell()
+          .GetFrameTimingStore();
+
+  auto to_nanos = [](fml::TimePoint time_point) -> uint64_t {
+    return time_point.ToEpochDelta().ToNanoseconds();
+  };
+  std::vector<flutter::FrameTiming> recent_frames = store.GetRecentFrames();
+  std::vector<FlutterFrameTiming> frames;
+  frames.reserve(recent_frames.size());
+  for (const flutter::FrameTiming& timing : recent_frames) {
+    FlutterFrameTiming frame = {};
+    frame.struct_size = sizeof(FlutterFrameTiming);
+    frame.frame_number = timing.GetFrameNumber();
+    frame.vsync_start_nanos =
+        to_nanos(timing.Get(flutter::FrameTiming::kVsyncStart));
+    frame.build_start_nanos =
+        to_nanos(timing.Get(flutter::FrameTiming::kBuildStart));
+    frame.build_finish_nanos =
+        to_nanos(timing.Get(flutter::FrameTiming::kBuildFinish));
+    frame.raster_start_nanos =
+        to_nanos(timing.Get(flutter::FrameTiming::kRasterStart));
+    frame.raster_finish_nanos =
+        to_nanos(timing.Get(flutter::FrameTiming::kRasterFinish));
+    frame.raster_finish_wall_time_nanos =
+        to_nanos(timing.Get(flutter::FrameTiming::kRasterFinishWallTime));
+    frame.layer_cache_count = timing.GetLayerCacheCount();
+    frame.layer_cache_bytes = timing.GetLayerCacheBytes();
+    frame.picture_cache_count = timing.GetPictureCacheCount();
+    frame.picture_cache_bytes = timing.GetPictureCacheBytes();
+    frames.push_back(frame);
+  }
+
+  using Phase = flutter::FrameTimingStore::Phase;
+  flutter::FrameTimingStore::Histogram vsync_to_build_start =
+      store.GetHistogram(Phase::kVsyncToBuildStart);
+  flutter::FrameTimingStore::Histogram build =
+      store.GetHistogram(Phase::kBuild);
+  flutter::FrameTimingStore::Histogram raster =
+      store.GetHistogram(Phase::kRaster);
+  flutter::FrameTimingStore::Histogram vsync_to_raster_finish =
+      store.GetHistogram(Phase::kVsyncToRasterFinish);
+
+  FlutterFrameTimings timings = {};
+  timings.struct_size = sizeof(FlutterFrameTimings);
+  timings.frame_count = frames.size();
+  timings.frames = frames.data();
+  timings.vsync_to_build_start =
+      ToFlutterFrameTimingHistogram(vsync_to_build_start);
+  timings.build = ToFlutterFrameTimingHistogram(build);
+  timings.raster = ToFlutterFrameTimingHistogram(raster);
+  timings.vsync_to_raster_finish =
+      ToFlutterFrameTimingHistogram(vsync_to_raster_finish);
+
+  callback(&timings, user_data);
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineGetProcAddresses(
     FlutterEngineProcTable* table) {
   if (!table) {
@@ -3441,6 +3528,7 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(SetNextFrameCallback, FlutterEngineSetNextFrameCallback);
   SET_PROC(AddView, FlutterEngineAddView);
   SET_PROC(RemoveView, FlutterEngineRemoveView);
+  SET_PROC(GetFrameTimings, FlutterEngineGetFrameTimings);
 #undef SET_PROC
 
   return kSuccess;
@@ -2007,6 +2007,76 @@ typedef enum {
   kFlutterEngineDisplaysUpdateTypeCount,
 } FlutterEngineDisplaysUpdateType;
 
+/// The timings of a rasterized frame, as reported by
+/// `FlutterEngineGetFrameTimings`. Timestamps are in nanoseconds on the clock
+/// of `FlutterEngineGetCurrentTime`, except for
+/// `raster_finish_wall_time_nanos`, which is in nanoseconds since the Unix
+/// epoch.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameTiming).
+  size_t struct_size;
+  uint64_t frame_number;
+  uint64_t vsync_start_nanos;
+  uint64_t build_start_nanos;
+  uint64_t build_finish_nanos;
+  uint64_t raster_start_nanos;
+  uint64_t raster_finish_nanos;
+  uint64_t raster_finish_wall_time_nanos;
+  /// The number of layers in the raster cache after the frame.
+  uint64_t layer_cache_count;
+  /// The size of the layers in the raster cache after the frame, in bytes.
+  uint64_t layer_cache_bytes;
+  /// The number of pictures in the raster cache after the frame.
+  uint64_t picture_cache_count;
+  /// The size of the pictures in the raster cache after the frame, in bytes.
+  uint64_t picture_cache_bytes;
+} FlutterFrameTiming;
+
+/// A histogram of the duration of a phase of every frame rasterized by the
+/// engine.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameTimingHistogram).
+  size_t struct_size;
+  /// The number of frames in the histogram.
+  uint64_t count;
+  /// The sum of the durations of all frames, in microseconds.
+  int64_t sum_micros;
+  /// The longest duration of any frame, in microseconds.
+  int64_t max_micros;
+  /// The number of buckets.
+  size_t bucket_count;
+  /// The inclusive upper bound of each bucket in microseconds. The last bucket
+  /// is unbounded and its upper bound is `INT64_MAX`.
+  const int64_t* bucket_upper_bounds_micros;
+  /// The number of frames in each bucket.
+  const uint64_t* bucket_counts;
+} FlutterFrameTimingHistogram;
+
+/// The frame timings passed to a `FlutterFrameTimingsCallback`.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameTimings).
+  size_t struct_size;
+  /// The number of recent frames in `frames`.
+  size_t frame_count;
+  /// The timings of the most recently rasterized frames, oldest first.
+  const FlutterFrameTiming* frames;
+  /// From the vsync to the start of the build on the UI thread.
+  FlutterFrameTimingHistogram vsync_to_build_start;
+  /// The build on the UI thread.
+  FlutterFrameTimingHistogram build;
+  /// The rasterization on the raster thread.
+  FlutterFrameTimingHistogram raster;
+  /// From the vsync to the end of the rasterization.
+  FlutterFrameTimingHistogram vsync_to_raster_finish;
+} FlutterFrameTimings;
+
+/// Called by `FlutterEngineGetFrameTimings` on the calling thread. The
+/// timings and all of the pointers they contain are only valid for the
+/// duration of the callback.
+typedef void (*FlutterFrameTimingsCallback)(
+    const FlutterFrameTimings* /* timings */,
+    void* /* user data */);
+
 typedef int64_t FlutterEngineDartPort;
 
 typedef enum {
@@ -3189,6 +3259,28 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
     VoidCallback callback,
     void* user_data);
 
+//------------------------------------------------------------------------------
+/// @brief      Reports the timings of the most recently rasterized frames and
+///             the latency histograms of all frames rasterized by the engine.
+///             The timings are kept by the engine whether or not the Dart
+///             application listens to `PlatformDispatcher.onReportTimings`,
+///             and reading them never blocks rendering. This may be called
+///             from any thread.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[in]  callback   The callback that is synchronously invoked with the
+///                        timings.
+/// @param[in]  user_data  A baton passed by the engine to the callback. This
+///                        baton is not interpreted by the engine in any way.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetFrameTimings(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingsCallback callback,
+    void* user_data);
+
 #endif  // !FLUTTER_ENGINE_NO_PROTOTYPES
 
 // Typedefs for the function pointers in FlutterEngineProcTable.
@@ -3317,6 +3409,10 @@ typedef FlutterEngineResult (*FlutterEngineAddViewFnPtr)(
 typedef FlutterEngineResult (*FlutterEngineRemoveViewFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterRemoveViewInfo* info);
+typedef FlutterEngineResult (*FlutterEngineGetFrameTimingsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingsCallback callback,
+    void* user_data);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -3365,6 +3461,7 @@ typedef struct {
   FlutterEngineSetNextFrameCallbackFnPtr SetNextFrameCallback;
   FlutterEngineAddViewFnPtr AddView;
   FlutterEngineRemoveViewFnPtr RemoveView;
+  FlutterEngineGetFrameTimingsFnPtr GetFrameTimings;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "impeller/entity/gles/entity_gles3_shaders_gles.h"
 #include "impeller/entity/gles/entity_shaders_gles.h"
 #include "impeller/entity/gles/framebuffer_blend_shaders_gles.h"
 #include "impeller/entity/gles/modern_shaders_gles.h"
@@ -81,6 +82,11 @@ EmbedderSurfaceGLImpeller::EmbedderSurfaceGLImpeller(
           impeller_scene_shaders_gles_data, impeller_scene_shaders_gles_length),
 #endif  // IMPELLER_ENABLE_3D
   };
+  std::vector<std::shared_ptr<fml::Mapping>> gles3_shader_mappings = {
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_entity_gles3_shaders_gles_data,
+          impeller_entity_gles3_shaders_gles_length),
+  };
   auto gl = std::make_unique<impeller::ProcTableGLES>(
       gl_dispatch_table_.gl_proc_resolver);
   if (!gl->IsValid()) {
@@ -88,7 +94,8 @@ EmbedderSurfaceGLImpeller::EmbedderSurfaceGLImpeller(
   }
 
   impeller_context_ = impeller::ContextGLES::Create(
-      std::move(gl), shader_mappings, /*enable_gpu_tracing=*/false);
+      std::move(gl), shader_mappings, /*enable_gpu_tracing=*/false,
+      gles3_shader_mappings);
 
   if (!impeller_context_) {
     FML_LOG(ERROR) << "Could not create Impeller context.";
@@ -4806,6 +4806,22 @@ TEST_F(EmbedderTest, CanRenderWithImpellerOpenGL) {
   ASSERT_FALSE(present_called);
 }
 
+TEST_F(EmbedderTest, CanRenderMultipleViewsInParallelWithImpellerOpenGL) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+  EmbedderConfigBuilder builder(context);
+  builder.AddCommandLineArgument("--enable-impeller");
+  builder.AddCommandLineArgument("--enable-parallel-view-rasterization");
+  builder.SetOpenGLRendererConfig(SkISize::Make(800, 600));
+  builder.SetCompositor();
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kOpenGLFramebuffer);
+
+  auto engine = RenderAllViewsAndWaitForPresent(context, builder,
+                                                /*view_count=*/4);
+  // The frame that presented the last view rendered the implicit view too.
+  EXPECT_GE(GetConcurrentlyRecordedLayerTreeCount(engine), 2u);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     EmbedderTestGlVk,
     EmbedderTestMultiBackend,
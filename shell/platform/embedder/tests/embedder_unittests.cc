@@ -1814,6 +1814,35 @@ TEST_F(EmbedderTest, CanRenderMultipleViews) {
   latch123.Wait();
 }
 
+TEST_F(EmbedderTest, DoesNotRenderMultipleViewsInParallelWithRasterCache) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetCompositor();
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kSoftwareBuffer);
+  builder.AddCommandLineArgument("--enable-parallel-view-rasterization");
+
+  // Software surfaces use the raster cache, which can't be used off the
+  // raster thread.
+  auto engine = RenderAllViewsAndWaitForPresent(context, builder,
+                                                /*view_count=*/4);
+  EXPECT_EQ(GetConcurrentlyRecordedLayerTreeCount(engine), 0u);
+}
+
+TEST_F(EmbedderTest, DoesNotRenderMultipleViewsInParallelByDefault) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetCompositor();
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kSoftwareBuffer);
+
+  auto engine = RenderAllViewsAndWaitForPresent(context, builder,
+                                                /*view_count=*/4);
+  EXPECT_EQ(GetConcurrentlyRecordedLayerTreeCount(engine), 0u);
+}
+
 //------------------------------------------------------------------------------
 /// Test that the backing store is created with the correct view ID, is used
 /// for the correct view, and is cached according to their views.
@@ -3428,6 +3457,93 @@ TEST_F(EmbedderTest, CanSetNextFrameCallback) {
   callback_latch.Wait();
 }
 
+TEST_F(EmbedderTest, CanGetFrameTimings) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("draw_solid_red");
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  auto get_frame_count = [&engine]() {
+    size_t frame_count = 0;
+    EXPECT_EQ(FlutterEngineGetFrameTimings(
+                  engine.get(),
+                  [](const FlutterFrameTimings* timings, void* user_data) {
+                    *static_cast<size_t*>(user_data) = timings->frame_count;
+                  },
+                  &frame_count),
+              kSuccess);
+    return frame_count;
+  };
+  ASSERT_EQ(get_frame_count(), 0u);
+
+  fml::AutoResetWaitableEvent frame_latch;
+  ASSERT_EQ(FlutterEngineSetNextFrameCallback(
+                engine.get(),
+                [](void* user_data) {
+                  static_cast<fml::AutoResetWaitableEvent*>(user_data)
+                      ->Signal();
+                },
+                &frame_latch),
+            kSuccess);
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  frame_latch.Wait();
+
+  // The frame timings are recorded after the next frame callback, so wait for
+  // the raster thread to finish the frame.
+  fml::AutoResetWaitableEvent raster_latch;
+  ASSERT_EQ(FlutterEnginePostRenderThreadTask(
+                engine.get(),
+                [](void* user_data) {
+                  static_cast<fml::AutoResetWaitableEvent*>(user_data)
+                      ->Signal();
+                },
+                &raster_latch),
+            kSuccess);
+  raster_latch.Wait();
+
+  FlutterEngineResult result = FlutterEngineGetFrameTimings(
+      engine.get(),
+      [](const FlutterFrameTimings* timings, void* user_data) {
+        ASSERT_EQ(timings->struct_size, sizeof(FlutterFrameTimings));
+        ASSERT_GE(timings->frame_count, 1u);
+        const FlutterFrameTiming& frame = timings->frames[0];
+        EXPECT_LE(frame.vsync_start_nanos, frame.build_start_nanos);
+        EXPECT_LE(frame.build_start_nanos, frame.build_finish_nanos);
+        EXPECT_LE(frame.build_finish_nanos, frame.raster_start_nanos);
+        EXPECT_LE(frame.raster_start_nanos, frame.raster_finish_nanos);
+
+        for (const FlutterFrameTimingHistogram* histogram :
+             {&timings->vsync_to_build_start, &timings->build,
+              &timings->raster, &timings->vsync_to_raster_finish}) {
+          EXPECT_GE(histogram->count, 1u);
+          uint64_t bucketed = 0;
+          for (size_t i = 0; i < histogram->bucket_count; i++) {
+            bucketed += histogram->bucket_counts[i];
+          }
+          EXPECT_GE(bucketed, 1u);
+          EXPECT_EQ(
+              histogram->bucket_upper_bounds_micros[histogram->bucket_count -
+                                                    1],
+              INT64_MAX);
+        }
+      },
+      nullptr);
+  ASSERT_EQ(result, kSuccess);
+
+  EXPECT_EQ(FlutterEngineGetFrameTimings(engine.get(), nullptr, nullptr),
+            kInvalidArguments);
+}
+
 #if defined(FML_OS_MACOSX)
 
 static void MockThreadConfigSetter(const fml::Thread::ThreadConfig& config) {
@@ -4,9 +4,17 @@
 
 #define FML_USED_ON_EMBEDDER
 
+#include <atomic>
 #include <limits>
+#include <memory>
 #include <utility>
+#include <vector>
 
+#include "embedder_engine.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/shell/platform/embedder/tests/embedder_assertions.h"
 #include "flutter/shell/platform/embedder/tests/embedder_test_backingstore_producer.h"
 #include "flutter/shell/platform/embedder/tests/embedder_unittests_util.h"
 
@@ -307,5 +315,70 @@ SkMatrix GetTotalMutationTransformationMatrix(const FlutterPlatformView* view) {
                                               view->mutations_count);
 }
 
+UniqueEngine RenderAllViewsAndWaitForPresent(EmbedderTestContext& context,
+                                             EmbedderConfigBuilder& builder,
+                                             size_t view_count) {
+  FML_CHECK(view_count > 0);
+  builder.SetDartEntrypoint("render_all_views");
+
+  // View IDs are 0 for the implicit view and 1 through |view_count - 1| for
+  // the added views. The state is shared with the callback since the engine
+  // keeps presenting frames after this returns.
+  auto presented = std::make_shared<std::vector<std::atomic_bool>>(view_count);
+  auto latch = std::make_shared<fml::CountDownLatch>(view_count);
+  context.GetCompositor().SetPresentCallback(
+      [presented, latch, view_count](FlutterViewId view_id,
+                                     const FlutterLayer** layers,
+                                     size_t layers_count) {
+        FML_CHECK(view_id >= 0 && static_cast<size_t>(view_id) < view_count);
+        if (!(*presented)[view_id].exchange(true)) {
+          latch->CountDown();
+        }
+      },
+      /* one_shot= */ false);
+
+  auto engine = builder.LaunchEngine();
+  FML_CHECK(engine.is_valid());
+
+  for (size_t i = 0; i < view_count; i++) {
+    FlutterWindowMetricsEvent metrics = {};
+    metrics.struct_size = sizeof(FlutterWindowMetricsEvent);
+    metrics.width = 800;
+    metrics.height = 600;
+    metrics.pixel_ratio = 1.0;
+    metrics.view_id = i;
+    if (i == 0) {
+      FML_CHECK(FlutterEngineSendWindowMetricsEvent(engine.get(), &metrics) ==
+                kSuccess);
+      continue;
+    }
+
+    FlutterAddViewInfo add_view_info = {};
+    add_view_info.struct_size = sizeof(FlutterAddViewInfo);
+    add_view_info.view_id = i;
+    add_view_info.view_metrics = &metrics;
+    add_view_info.add_view_callback = [](const FlutterAddViewResult* result) {
+      FML_CHECK(result->added);
+    };
+    FML_CHECK(FlutterEngineAddView(engine.get(), &add_view_info) == kSuccess);
+  }
+
+  latch->Wait();
+  return engine;
+}
+
+size_t GetConcurrentlyRecordedLayerTreeCount(const UniqueEngine& engine) {
+  flutter::Shell& shell = ToEmbedderEngine(engine.get())->GetShell();
+  size_t count = 0u;
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      shell.GetTaskRunners().GetRasterTaskRunner(), [&]() {
+        count = shell.GetRasterizer()->GetConcurrentlyRecordedLayerTreeCount();
+        latch.Signal();
+      });
+  latch.Wait();
+  return count;
+}
+
 }  // namespace testing
 }  // namespace flutter
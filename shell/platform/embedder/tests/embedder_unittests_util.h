@@ -95,6 +95,27 @@ SkMatrix GetTotalMutationTransformationMatrix(
 
 SkMatrix GetTotalMutationTransformationMatrix(const FlutterPlatformView* view);
 
+//------------------------------------------------------------------------------
+/// @brief      Launches the `render_all_views` fixture with the implicit view
+///             and `view_count - 1` added views of 800x600, and waits until
+///             every view has been presented to the compositor.
+///
+/// @param[in]  context     The test context, whose compositor must be set.
+/// @param[in]  builder     The configured builder to launch the engine with.
+/// @param[in]  view_count  The number of views, including the implicit view.
+///
+/// @return     The running engine.
+///
+UniqueEngine RenderAllViewsAndWaitForPresent(EmbedderTestContext& context,
+                                             EmbedderConfigBuilder& builder,
+                                             size_t view_count);
+
+//------------------------------------------------------------------------------
+/// @brief      The number of layer trees the rasterizer of the engine recorded
+///             concurrently when rendering multiple views.
+///
+size_t GetConcurrentlyRecordedLayerTreeCount(const UniqueEngine& engine);
+
 //------------------------------------------------------------------------------
 /// @brief      A task runner that we expect the embedder to provide but whose
 ///             implementation is a real FML task runner.
@@ -122,6 +122,22 @@ TEST_F(EmbedderTest, CanSwapOutVulkanCalls) {
   EXPECT_TRUE(g_vulkan_proc_info.did_call_queue_submit);
 }
 
+TEST_F(EmbedderTest, DoesNotRenderMultipleViewsInParallelWithVulkanSkia) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kVulkanContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetVulkanRendererConfig(SkISize::Make(800, 600));
+  builder.SetCompositor();
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kVulkanImage);
+  builder.AddCommandLineArgument("--enable-parallel-view-rasterization");
+
+  // Skia's Vulkan surfaces use the raster cache, which can't be used off the
+  // raster thread.
+  auto engine = RenderAllViewsAndWaitForPresent(context, builder,
+                                                /*view_count=*/4);
+  EXPECT_EQ(GetConcurrentlyRecordedLayerTreeCount(engine), 0u);
+}
+
 }  // namespace testing
 }  // namespace flutter
 